@@ -0,0 +1,416 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unordered_map>
+
+namespace Cue::Bench
+{
+    namespace
+    {
+        // 反復回数の上限（空のループでも 1 サンプルが終わるように）
+        constexpr uint64_t k_maxIterations = 1ull << 30;
+
+        struct BenchmarkEntry
+        {
+            const char* name;
+            BenchmarkFunction function;
+            bool isLarge;
+        };
+
+        std::vector<BenchmarkEntry>& get_registry()
+        {
+            // 静的初期化の順序に依らないよう関数内の静的変数に置く
+            static std::vector<BenchmarkEntry> registry;
+            return registry;
+        }
+
+        std::vector<BenchmarkEntry> get_sorted_entries(std::string_view filter, bool isLargeIncluded)
+        {
+            std::vector<BenchmarkEntry> entries;
+            for (const BenchmarkEntry& entry : get_registry())
+            {
+                if (entry.isLarge && !isLargeIncluded)
+                {
+                    continue;
+                }
+                if (filter.empty() || std::string_view(entry.name).find(filter) != std::string_view::npos)
+                {
+                    entries.push_back(entry);
+                }
+            }
+            std::sort(entries.begin(), entries.end(), [](const BenchmarkEntry& a, const BenchmarkEntry& b)
+                {
+                    return std::strcmp(a.name, b.name) < 0;
+                });
+            return entries;
+        }
+
+        double percentile(const std::vector<double>& sorted, double p)
+        {
+            if (sorted.empty())
+            {
+                return 0.0;
+            }
+            const size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+
+        const char* get_build_type()
+        {
+#if defined(CUE_RELEASE)
+            return "Release";
+#elif defined(CUE_RELWITHDEBINFO)
+            return "RelWithDebInfo";
+#elif defined(CUE_DEBUG)
+            return "Debug";
+#else
+            return "Unknown";
+#endif
+        }
+
+        const char* get_simd_name()
+        {
+#if defined(CUE_SIMD_AVX2)
+            return "AVX2";
+#elif defined(CUE_SIMD_SSE41)
+            return "SSE41";
+#else
+            return "SCALAR";
+#endif
+        }
+
+        void write_json_string(std::FILE* file, std::string_view text)
+        {
+            std::fputc('"', file);
+            for (const char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    std::fputc('\\', file);
+                }
+                std::fputc(c, file);
+            }
+            std::fputc('"', file);
+        }
+
+        /// @brief key の後の値の位置（無ければ npos）
+        size_t find_value(std::string_view text, std::string_view key, size_t from, size_t until)
+        {
+            const size_t at = text.find(key, from);
+            if (at == std::string_view::npos || at >= until)
+            {
+                return std::string_view::npos;
+            }
+            const size_t colon = text.find(':', at + key.size());
+            if (colon == std::string_view::npos || colon >= until)
+            {
+                return std::string_view::npos;
+            }
+            size_t value = colon + 1;
+            while (value < text.size() && (text[value] == ' ' || text[value] == '\t'))
+            {
+                ++value;
+            }
+            return value;
+        }
+    }
+
+    BenchmarkRegistration::BenchmarkRegistration(const char* name, BenchmarkFunction function, bool isLarge) noexcept
+    {
+        get_registry().push_back({ name, function, isLarge });
+    }
+
+    bool run_benchmarks(const RunOptions& options, std::vector<BenchmarkResult>& outResults)
+    {
+        bool isAllOk = true;
+        const double minSampleNs = options.minSampleMs * 1.0e6;
+        const uint32_t sampleCount = std::max(options.sampleCount, 1u);
+
+        for (const BenchmarkEntry& entry : get_sorted_entries(options.filter, options.isLargeEnabled))
+        {
+            // 1) 1 サンプルが最短時間を超えるまで反復回数を増やす
+            uint64_t iterations = 1;
+            const char* error = nullptr;
+            for (;;)
+            {
+                State state(iterations);
+                entry.function(state);
+                error = state.get_error();
+                const double elapsedNs = state.get_elapsed_ns();
+                if (error || elapsedNs >= minSampleNs || iterations >= k_maxIterations)
+                {
+                    break;
+                }
+                // 目標の 1.4 倍を狙い、1 回で 2〜100 倍の範囲で増やす
+                const double scale = elapsedNs > 0.0 ? minSampleNs * 1.4 / elapsedNs : 100.0;
+                iterations = std::min(k_maxIterations,
+                    static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 100.0)));
+            }
+
+            // 2) 同じ反復回数でサンプルを取る
+            std::vector<double> samples;
+            samples.reserve(sampleCount);
+            uint64_t bytesPerIteration = 0;
+            uint64_t itemsPerIteration = 0;
+            std::vector<std::pair<const char*, std::vector<double>>> counterSamples;
+            for (uint32_t i = 0; i < sampleCount && !error; ++i)
+            {
+                State state(iterations);
+                entry.function(state);
+                error = state.get_error();
+                bytesPerIteration = state.get_bytes_per_iteration();
+                itemsPerIteration = state.get_items_per_iteration();
+                samples.push_back(state.get_elapsed_ns() / static_cast<double>(iterations));
+                for (const State::Counter& counter : state.get_counters())
+                {
+                    auto found = std::find_if(counterSamples.begin(), counterSamples.end(),
+                        [&counter](const auto& c) { return std::strcmp(c.first, counter.name) == 0; });
+                    if (found == counterSamples.end())
+                    {
+                        found = counterSamples.insert(counterSamples.end(), { counter.name, {} });
+                    }
+                    found->second.push_back(counter.value);
+                }
+            }
+            if (error)
+            {
+                std::fprintf(stderr, "%-56s ERROR: %s\n", entry.name, error);
+                isAllOk = false;
+                continue;
+            }
+
+            // 3) 外れ値に引きずられないよう中央値を代表値にする
+            std::sort(samples.begin(), samples.end());
+            double total = 0.0;
+            for (const double sample : samples)
+            {
+                total += sample;
+            }
+
+            BenchmarkResult result{};
+            result.name = entry.name;
+            result.iterations = iterations;
+            result.sampleCount = static_cast<uint32_t>(samples.size());
+            result.medianNs = percentile(samples, 0.50);
+            result.p99Ns = percentile(samples, 0.99);
+            result.minNs = samples.front();
+            result.meanNs = total / static_cast<double>(samples.size());
+            if (bytesPerIteration != 0 && result.medianNs > 0.0)
+            {
+                result.bytesPerSecond = static_cast<double>(bytesPerIteration) * 1.0e9 / result.medianNs;
+            }
+            if (itemsPerIteration != 0 && result.medianNs > 0.0)
+            {
+                result.itemsPerSecond = static_cast<double>(itemsPerIteration) * 1.0e9 / result.medianNs;
+            }
+            for (auto& [name, values] : counterSamples)
+            {
+                std::sort(values.begin(), values.end());
+                result.counters.emplace_back(name, percentile(values, 0.50));
+            }
+
+            std::printf("%-56s %14.2f ns  p99 %14.2f ns  min %14.2f ns  x%llu", result.name.c_str(),
+                result.medianNs, result.p99Ns, result.minNs, static_cast<unsigned long long>(iterations));
+            if (result.bytesPerSecond > 0.0)
+            {
+                std::printf("  %.3f GB/s", result.bytesPerSecond / 1.0e9);
+            }
+            if (result.itemsPerSecond > 0.0)
+            {
+                std::printf("  %.3f M/s", result.itemsPerSecond / 1.0e6);
+            }
+            for (const auto& [name, value] : result.counters)
+            {
+                std::printf("  %s %.3f", name.c_str(), value);
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+            outResults.push_back(std::move(result));
+        }
+        return isAllOk;
+    }
+
+    void list_benchmarks(std::string_view filter)
+    {
+        for (const BenchmarkEntry& entry : get_sorted_entries(filter, true))
+        {
+            std::printf("%s%s\n", entry.name, entry.isLarge ? "  (--large)" : "");
+        }
+    }
+
+    bool write_json(const char* path, const RunOptions& options, const std::vector<BenchmarkResult>& results)
+    {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file)
+        {
+            std::fprintf(stderr, "cue_benchmarks: failed to open %s\n", path);
+            return false;
+        }
+
+        // 1) 比べる時に条件が揃っているか確かめられるよう、ビルドの情報を添える
+        char date[32] = {};
+        const std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+        std::fprintf(file, "{\n  \"context\": {\n");
+        std::fprintf(file, "    \"date\": \"%s\",\n", date);
+        std::fprintf(file, "    \"build_type\": \"%s\",\n", get_build_type());
+        std::fprintf(file, "    \"compiler\": ");
+        write_json_string(file, __VERSION__);
+        std::fprintf(file, ",\n    \"simd\": \"%s\",\n", get_simd_name());
+        std::fprintf(file, "    \"samples\": %u,\n", options.sampleCount);
+        std::fprintf(file, "    \"min_sample_ms\": %.3f\n  },\n", options.minSampleMs);
+
+        // 2) 1 計測 1 オブジェクト（read_json は name と median_ns だけを読む）
+        std::fprintf(file, "  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchmarkResult& result = results[i];
+            std::fprintf(file, "    {\"name\": ");
+            write_json_string(file, result.name);
+            std::fprintf(file, ", \"iterations\": %llu, \"samples\": %u, \"median_ns\": %.3f, \"p99_ns\": %.3f,"
+                " \"min_ns\": %.3f, \"mean_ns\": %.3f",
+                static_cast<unsigned long long>(result.iterations), result.sampleCount,
+                result.medianNs, result.p99Ns, result.minNs, result.meanNs);
+            if (result.bytesPerSecond > 0.0)
+            {
+                std::fprintf(file, ", \"bytes_per_second\": %.0f", result.bytesPerSecond);
+            }
+            if (result.itemsPerSecond > 0.0)
+            {
+                std::fprintf(file, ", \"items_per_second\": %.0f", result.itemsPerSecond);
+            }
+            if (!result.counters.empty())
+            {
+                // 3) 独自の値は counters にまとめる（比較には使わない）
+                std::fprintf(file, ", \"counters\": {");
+                for (size_t c = 0; c < result.counters.size(); ++c)
+                {
+                    write_json_string(file, result.counters[c].first);
+                    std::fprintf(file, ": %.6g%s", result.counters[c].second, c + 1 < result.counters.size() ? ", " : "");
+                }
+                std::fprintf(file, "}");
+            }
+            std::fprintf(file, "}%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+
+        const bool isOk = std::ferror(file) == 0;
+        std::fclose(file);
+        return isOk;
+    }
+
+    bool read_json(const char* path, std::vector<BenchmarkResult>& outResults)
+    {
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file)
+        {
+            std::fprintf(stderr, "cue_benchmarks: failed to open %s\n", path);
+            return false;
+        }
+        std::string text;
+        char buffer[4096];
+        size_t readSize = 0;
+        while ((readSize = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+        {
+            text.append(buffer, readSize);
+        }
+        std::fclose(file);
+
+        // 1) 自前の形式だけを読むので、汎用の構文解析はせずにキーを順に拾う
+        const std::string_view view = text;
+        size_t cursor = view.find("\"benchmarks\"");
+        if (cursor == std::string_view::npos)
+        {
+            std::fprintf(stderr, "cue_benchmarks: %s has no \"benchmarks\" array\n", path);
+            return false;
+        }
+        for (;;)
+        {
+            const size_t nameValue = find_value(view, "\"name\"", cursor, view.size());
+            if (nameValue == std::string_view::npos)
+            {
+                break;
+            }
+            const size_t nameEnd = view.find('"', nameValue + 1);
+            if (view[nameValue] != '"' || nameEnd == std::string_view::npos)
+            {
+                std::fprintf(stderr, "cue_benchmarks: malformed name in %s\n", path);
+                return false;
+            }
+
+            // 2) 次の計測の手前までで中央値を探す
+            const size_t next = std::min(view.find("\"name\"", nameEnd), view.size());
+            const size_t medianValue = find_value(view, "\"median_ns\"", nameEnd, next);
+            if (medianValue == std::string_view::npos)
+            {
+                std::fprintf(stderr, "cue_benchmarks: %s has no median_ns for an entry\n", path);
+                return false;
+            }
+
+            BenchmarkResult result{};
+            result.name = std::string(view.substr(nameValue + 1, nameEnd - nameValue - 1));
+            result.medianNs = std::strtod(text.c_str() + medianValue, nullptr);
+            const size_t p99Value = find_value(view, "\"p99_ns\"", nameEnd, next);
+            if (p99Value != std::string_view::npos)
+            {
+                result.p99Ns = std::strtod(text.c_str() + p99Value, nullptr);
+            }
+            outResults.push_back(std::move(result));
+            cursor = next;
+        }
+        return true;
+    }
+
+    uint32_t compare_results(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current,
+        const CompareOptions& options)
+    {
+        std::unordered_map<std::string_view, const BenchmarkResult*> baselineByName;
+        for (const BenchmarkResult& result : baseline)
+        {
+            baselineByName.emplace(result.name, &result);
+        }
+
+        // 1) 今回の結果の並びで、基準の中央値との比を出す
+        uint32_t regressionCount = 0;
+        std::printf("%-56s %14s %14s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+        for (const BenchmarkResult& result : current)
+        {
+            const auto found = baselineByName.find(result.name);
+            if (found == baselineByName.end())
+            {
+                std::printf("%-56s %14s %14.2f %9s  new\n", result.name.c_str(), "-", result.medianNs, "-");
+                continue;
+            }
+            const BenchmarkResult& base = *found->second;
+            baselineByName.erase(found);
+
+            const double change = base.medianNs > 0.0 ? result.medianNs / base.medianNs - 1.0 : 0.0;
+            const bool isRegressed = change > options.threshold && (result.medianNs - base.medianNs) >= options.minDeltaNs;
+            const char* status = isRegressed ? "REGRESSED" : (change < -options.threshold ? "improved" : "");
+            std::printf("%-56s %14.2f %14.2f %+8.1f%%  %s\n", result.name.c_str(), base.medianNs, result.medianNs,
+                change * 100.0, status);
+            if (isRegressed)
+            {
+                ++regressionCount;
+            }
+        }
+
+        // 2) 今回回っていない計測は失敗にしない（フィルタで絞った実行と比べることがあるため）
+        for (const BenchmarkResult& result : baseline)
+        {
+            if (baselineByName.contains(result.name))
+            {
+                std::printf("%-56s %14.2f %14s %9s  missing\n", result.name.c_str(), result.medianNs, "-", "-");
+            }
+        }
+        std::printf("%u regression(s) beyond %.1f%%\n", regressionCount, options.threshold * 100.0);
+        return regressionCount;
+    }
+} // namespace Cue::Bench
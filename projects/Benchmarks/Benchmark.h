@@ -0,0 +1,195 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cue::Bench
+{
+    /// @brief 1 回の計測（サンプル）に渡される状態
+    /// @details 本体は while (state.keep_running()) の中に書く。最初の keep_running で時計を始め、
+    ///          決められた反復回数を終えた時点で止めるので、ループの外の準備と後始末は計測に入らない。
+    class State final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief 計測が独自に報告する値（帯域以外の指標。名前は静的な文字列）
+        struct Counter
+        {
+            const char* name = nullptr;
+            double value = 0.0;
+        };
+        static constexpr uint32_t k_maxCounters = 4;
+
+        explicit State(uint64_t iterations) noexcept
+            : m_iterations(iterations)
+            , m_remaining(iterations)
+        {
+        }
+        State(const State&) = delete;
+        State& operator=(const State&) = delete;
+
+        [[nodiscard]] bool keep_running() noexcept
+        {
+            if (m_remaining != 0) [[likely]]
+            {
+                if (m_remaining-- == m_iterations)
+                {
+                    m_begin = Clock::now();
+                }
+                return true;
+            }
+            m_end = Clock::now();
+            return false;
+        }
+
+        /// @brief 反復の中で計測に入れたくない処理を挟む
+        void pause_timing() noexcept
+        {
+            m_pauseBegin = Clock::now();
+        }
+        void resume_timing() noexcept
+        {
+            m_paused += Clock::now() - m_pauseBegin;
+        }
+
+        /// @brief 1 反復で処理するバイト数（指定すると JSON にスループットを出す）
+        void set_bytes_per_iteration(uint64_t bytes) noexcept { m_bytesPerIteration = bytes; }
+        /// @brief 1 反復で処理する件数（指定すると件数/秒を出す）
+        void set_items_per_iteration(uint64_t items) noexcept { m_itemsPerIteration = items; }
+        /// @brief サンプル毎の値を報告する（サンプル間の中央値を出す。同じ名前なら上書き、k_maxCounters を超えた分は捨てる）
+        void set_counter(const char* name, double value) noexcept
+        {
+            for (uint32_t i = 0; i < m_counterCount; ++i)
+            {
+                if (m_counters[i].name == name)
+                {
+                    m_counters[i].value = value;
+                    return;
+                }
+            }
+            if (m_counterCount < k_maxCounters)
+            {
+                m_counters[m_counterCount++] = { name, value };
+            }
+        }
+        /// @brief 計測できない状態を報告する（静的な文字列。以降のサンプルは取らずに失敗扱いにする）
+        void set_error(const char* message) noexcept
+        {
+            m_error = message;
+            m_remaining = 0;
+        }
+
+        [[nodiscard]] uint64_t get_iterations() const noexcept { return m_iterations; }
+        [[nodiscard]] uint64_t get_bytes_per_iteration() const noexcept { return m_bytesPerIteration; }
+        [[nodiscard]] uint64_t get_items_per_iteration() const noexcept { return m_itemsPerIteration; }
+        [[nodiscard]] std::span<const Counter> get_counters() const noexcept { return { m_counters, m_counterCount }; }
+        [[nodiscard]] const char* get_error() const noexcept { return m_error; }
+        /// @brief 計測した時間（一時停止した分を除く）
+        [[nodiscard]] double get_elapsed_ns() const noexcept
+        {
+            if (m_end <= m_begin)
+            {
+                return 0.0;
+            }
+            return std::chrono::duration<double, std::nano>(m_end - m_begin - m_paused).count();
+        }
+    private:
+        uint64_t m_iterations;
+        uint64_t m_remaining;
+        uint64_t m_bytesPerIteration = 0;
+        uint64_t m_itemsPerIteration = 0;
+        Counter m_counters[k_maxCounters]{};
+        uint32_t m_counterCount = 0;
+        const char* m_error = nullptr;
+        Clock::time_point m_begin{};
+        Clock::time_point m_end{};
+        Clock::time_point m_pauseBegin{};
+        Clock::duration m_paused{};
+    };
+
+    /// @brief 値を使ったことにして、計算が最適化で消えないようにする
+    template<typename T>
+    inline void do_not_optimize(const T& value) noexcept
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /// @brief それまでのメモリへの書き込みを消させない
+    inline void clobber_memory() noexcept
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    using BenchmarkFunction = void (*)(State& state);
+
+    /// @brief 静的初期化で計測を登録する（CUE_BENCHMARK から使う）
+    struct BenchmarkRegistration final
+    {
+        BenchmarkRegistration(const char* name, BenchmarkFunction function, bool isLarge = false) noexcept;
+    };
+
+    /// @brief 1 つの計測の集計（時間は全て 1 反復あたり）
+    struct BenchmarkResult
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        uint32_t sampleCount = 0;
+        double medianNs = 0.0;
+        double p99Ns = 0.0;
+        double minNs = 0.0;
+        double meanNs = 0.0;
+        // 0 ならスループットを出さない
+        double bytesPerSecond = 0.0;
+        double itemsPerSecond = 0.0;
+        // set_counter で報告された値（サンプル間の中央値）
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    struct RunOptions
+    {
+        // 名前にこの文字列を含む計測だけを回す（空なら全部）
+        std::string_view filter{};
+        uint32_t sampleCount = 15;
+        // 1 サンプルがこの時間を超えるまで反復回数を増やす
+        double minSampleMs = 5.0;
+        // CUE_BENCHMARK_LARGE で登録した計測（準備だけで秒単位かかるもの）も回す
+        bool isLargeEnabled = false;
+    };
+
+    /// @brief 登録された計測を名前順に回す
+    /// @return 全て計測できたら true（set_error されたものがあれば false）
+    bool run_benchmarks(const RunOptions& options, std::vector<BenchmarkResult>& outResults);
+    /// @brief 登録された計測の名前を書き出す（--large 専用のものも印を付けて出す）
+    void list_benchmarks(std::string_view filter);
+
+    /// @brief 結果を JSON で書き出す
+    bool write_json(const char* path, const RunOptions& options, const std::vector<BenchmarkResult>& results);
+    /// @brief write_json で書いた JSON から名前と中央値を読む
+    bool read_json(const char* path, std::vector<BenchmarkResult>& outResults);
+
+    struct CompareOptions
+    {
+        // 中央値がこの割合を超えて遅くなったら退行とみなす（0.10 で 10%）
+        double threshold = 0.10;
+        // 差がこれ未満なら割合に関わらず退行とみなさない（数 ns の計測の揺れを拾わないため）
+        double minDeltaNs = 0.0;
+    };
+
+    /// @brief 2 つの実行結果を比べて表を書き出す
+    /// @return 退行した計測の数
+    uint32_t compare_results(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current,
+        const CompareOptions& options);
+} // namespace Cue::Bench
+
+#define CUE_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define CUE_BENCHMARK_CONCAT(a, b) CUE_BENCHMARK_CONCAT_INNER(a, b)
+// 関数を名前付きで登録する（名前は "Module/Subject/case" の形に揃える）
+#define CUE_BENCHMARK(name, function) \
+    static const ::Cue::Bench::BenchmarkRegistration CUE_BENCHMARK_CONCAT(cueBenchmark, __LINE__)(name, function)
+// 既定では回さず、--large を付けた時だけ回す計測を登録する
+#define CUE_BENCHMARK_LARGE(name, function) \
+    static const ::Cue::Bench::BenchmarkRegistration CUE_BENCHMARK_CONCAT(cueBenchmark, __LINE__)(name, function, true)
@@ -0,0 +1,447 @@
+#include <FlatHashMap.h>
+#include <SlotMap.h>
+#include <SmallVector.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    using Cue::Bench::State;
+    namespace Core = Cue::Core;
+
+    // ---- ハッシュマップ（FlatHashMap と std::unordered_map） ----
+
+    using FlatMap = Core::FlatHashMap<uint64_t, uint64_t>;
+    using StdMap = std::unordered_map<uint64_t, uint64_t>;
+
+    std::vector<uint64_t> make_keys(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint64_t> keys(count);
+        for (uint64_t& key : keys)
+        {
+            key = rng();
+        }
+        return keys;
+    }
+
+    /// @brief 挿入とは別の順に並べ替えた鍵（挿入順に引くとキャッシュに乗ったまま測ってしまう）
+    std::vector<uint64_t> shuffled(std::vector<uint64_t> keys, uint64_t seed)
+    {
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(seed));
+        return keys;
+    }
+
+    template<typename Map>
+    void fill(Map& map, const std::vector<uint64_t>& keys)
+    {
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            map.try_emplace(keys[i], i);
+        }
+    }
+
+    const uint64_t* lookup(const FlatMap& map, uint64_t key) noexcept
+    {
+        return map.find(key);
+    }
+    const uint64_t* lookup(const StdMap& map, uint64_t key) noexcept
+    {
+        const auto it = map.find(key);
+        return it != map.end() ? &it->second : nullptr;
+    }
+
+    uint64_t sum_values(const FlatMap& map) noexcept
+    {
+        uint64_t sum = 0;
+        for (const FlatMap::Entry& entry : map)
+        {
+            sum += entry.value;
+        }
+        return sum;
+    }
+    uint64_t sum_values(const StdMap& map) noexcept
+    {
+        uint64_t sum = 0;
+        for (const auto& [key, value] : map)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+
+    /// @brief 1 反復で空の表に N 個挿入する（破棄は計測に入れない）
+    template<typename Map, size_t N>
+    void hash_insert(State& state)
+    {
+        const std::vector<uint64_t> keys = make_keys(N, 1);
+        while (state.keep_running())
+        {
+            auto map = std::make_unique<Map>();
+            fill(*map, keys);
+            Cue::Bench::do_not_optimize(map->size());
+            state.pause_timing();
+            map.reset();
+            state.resume_timing();
+        }
+    }
+
+    /// @brief 1 反復で 1 回、有るキーを引く
+    template<typename Map, size_t N>
+    void hash_find_hit(State& state)
+    {
+        const std::vector<uint64_t> keys = make_keys(N, 1);
+        Map map;
+        fill(map, keys);
+        const std::vector<uint64_t> order = shuffled(keys, 2);
+        size_t index = 0;
+        while (state.keep_running())
+        {
+            Cue::Bench::do_not_optimize(lookup(map, order[index]));
+            index = (index + 1 == N) ? 0 : index + 1;
+        }
+    }
+
+    /// @brief 1 反復で 1 回、無いキーを引く
+    template<typename Map, size_t N>
+    void hash_find_miss(State& state)
+    {
+        Map map;
+        fill(map, make_keys(N, 1));
+        const std::vector<uint64_t> missing = make_keys(N, 3);
+        size_t index = 0;
+        while (state.keep_running())
+        {
+            Cue::Bench::do_not_optimize(lookup(map, missing[index]));
+            index = (index + 1 == N) ? 0 : index + 1;
+        }
+    }
+
+    /// @brief 1 反復で全要素の値を足す
+    template<typename Map, size_t N>
+    void hash_iterate(State& state)
+    {
+        Map map;
+        fill(map, make_keys(N, 1));
+        state.set_bytes_per_iteration(N * sizeof(uint64_t) * 2);
+        while (state.keep_running())
+        {
+            Cue::Bench::do_not_optimize(sum_values(map));
+        }
+    }
+
+    /// @brief 1 反復で N 個入った表から全て消す（作り直しは計測に入れない）
+    template<typename Map, size_t N>
+    void hash_erase(State& state)
+    {
+        const std::vector<uint64_t> keys = make_keys(N, 1);
+        const std::vector<uint64_t> order = shuffled(keys, 2);
+        while (state.keep_running())
+        {
+            state.pause_timing();
+            auto map = std::make_unique<Map>();
+            fill(*map, keys);
+            state.resume_timing();
+            for (const uint64_t key : order)
+            {
+                map->erase(key);
+            }
+            Cue::Bench::do_not_optimize(map->size());
+            state.pause_timing();
+            map.reset();
+            state.resume_timing();
+        }
+    }
+
+    CUE_BENCHMARK("Core/HashMap/flat_insert_1k", (hash_insert<FlatMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/std_insert_1k", (hash_insert<StdMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/flat_insert_100k", (hash_insert<FlatMap, 100000>));
+    CUE_BENCHMARK("Core/HashMap/std_insert_100k", (hash_insert<StdMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_insert_1m", (hash_insert<FlatMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_insert_1m", (hash_insert<StdMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_insert_10m", (hash_insert<FlatMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_insert_10m", (hash_insert<StdMap, 10000000>));
+
+    CUE_BENCHMARK("Core/HashMap/flat_find_hit_1k", (hash_find_hit<FlatMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/std_find_hit_1k", (hash_find_hit<StdMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/flat_find_hit_100k", (hash_find_hit<FlatMap, 100000>));
+    CUE_BENCHMARK("Core/HashMap/std_find_hit_100k", (hash_find_hit<StdMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_find_hit_1m", (hash_find_hit<FlatMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_find_hit_1m", (hash_find_hit<StdMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_find_hit_10m", (hash_find_hit<FlatMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_find_hit_10m", (hash_find_hit<StdMap, 10000000>));
+
+    CUE_BENCHMARK("Core/HashMap/flat_find_miss_1k", (hash_find_miss<FlatMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/std_find_miss_1k", (hash_find_miss<StdMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/flat_find_miss_100k", (hash_find_miss<FlatMap, 100000>));
+    CUE_BENCHMARK("Core/HashMap/std_find_miss_100k", (hash_find_miss<StdMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_find_miss_1m", (hash_find_miss<FlatMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_find_miss_1m", (hash_find_miss<StdMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_find_miss_10m", (hash_find_miss<FlatMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_find_miss_10m", (hash_find_miss<StdMap, 10000000>));
+
+    CUE_BENCHMARK("Core/HashMap/flat_iterate_1k", (hash_iterate<FlatMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/std_iterate_1k", (hash_iterate<StdMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/flat_iterate_100k", (hash_iterate<FlatMap, 100000>));
+    CUE_BENCHMARK("Core/HashMap/std_iterate_100k", (hash_iterate<StdMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_iterate_1m", (hash_iterate<FlatMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_iterate_1m", (hash_iterate<StdMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_iterate_10m", (hash_iterate<FlatMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_iterate_10m", (hash_iterate<StdMap, 10000000>));
+
+    CUE_BENCHMARK("Core/HashMap/flat_erase_1k", (hash_erase<FlatMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/std_erase_1k", (hash_erase<StdMap, 1000>));
+    CUE_BENCHMARK("Core/HashMap/flat_erase_100k", (hash_erase<FlatMap, 100000>));
+    CUE_BENCHMARK("Core/HashMap/std_erase_100k", (hash_erase<StdMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_erase_1m", (hash_erase<FlatMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_erase_1m", (hash_erase<StdMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/flat_erase_10m", (hash_erase<FlatMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/HashMap/std_erase_10m", (hash_erase<StdMap, 10000000>));
+
+    // ---- 小さな配列（SmallVector と std::vector） ----
+
+    constexpr size_t k_listCount = 4096;
+
+    /// @brief 0〜8 個の要素を持つ配列を多数並べる（ECS の変更リストや描画のバッチの様な使い方）
+    std::vector<uint32_t> make_list_lengths()
+    {
+        std::mt19937 rng(4);
+        std::vector<uint32_t> lengths(k_listCount);
+        for (uint32_t& length : lengths)
+        {
+            length = rng() % 9;
+        }
+        return lengths;
+    }
+
+    template<typename List>
+    void build_lists(std::vector<List>& lists, const std::vector<uint32_t>& lengths)
+    {
+        for (size_t i = 0; i < lists.size(); ++i)
+        {
+            for (uint32_t k = 0; k < lengths[i]; ++k)
+            {
+                lists[i].push_back(k);
+            }
+        }
+    }
+
+    /// @brief 1 反復で 4096 本の配列を作って破棄する
+    template<typename List>
+    void small_lists_build(State& state)
+    {
+        const std::vector<uint32_t> lengths = make_list_lengths();
+        while (state.keep_running())
+        {
+            std::vector<List> lists(k_listCount);
+            build_lists(lists, lengths);
+            Cue::Bench::do_not_optimize(lists.data());
+        }
+    }
+
+    /// @brief 1 反復で 4096 本の配列の全要素を足す
+    template<typename List>
+    void small_lists_iterate(State& state)
+    {
+        const std::vector<uint32_t> lengths = make_list_lengths();
+        std::vector<List> lists(k_listCount);
+        build_lists(lists, lengths);
+        while (state.keep_running())
+        {
+            uint32_t sum = 0;
+            for (const List& list : lists)
+            {
+                for (const uint32_t value : list)
+                {
+                    sum += value;
+                }
+            }
+            Cue::Bench::do_not_optimize(sum);
+        }
+    }
+
+    CUE_BENCHMARK("Core/SmallVector/small_build_4k_lists", (small_lists_build<Core::SmallVector<uint32_t, 8>>));
+    CUE_BENCHMARK("Core/SmallVector/std_build_4k_lists", (small_lists_build<std::vector<uint32_t>>));
+    CUE_BENCHMARK("Core/SmallVector/small_iterate_4k_lists", (small_lists_iterate<Core::SmallVector<uint32_t, 8>>));
+    CUE_BENCHMARK("Core/SmallVector/std_iterate_4k_lists", (small_lists_iterate<std::vector<uint32_t>>));
+
+    // ---- ハンドルで引く表（SlotMap と、連番 ID を鍵にした std::unordered_map） ----
+
+    /// @brief 描画オブジェクト程度の大きさの要素
+    struct Payload
+    {
+        float position[3];
+        float radius;
+        uint32_t meshId;
+        uint32_t materialId;
+        uint64_t flags;
+    };
+
+    /// @brief SlotMap と同じ使い方（挿入で鍵を受け取る）をする std::unordered_map
+    class StdHandleMap final
+    {
+    public:
+        using Handle = uint32_t;
+
+        Handle insert(const Payload& payload)
+        {
+            m_map.emplace(m_nextId, payload);
+            return m_nextId++;
+        }
+        bool erase(Handle handle) { return m_map.erase(handle) != 0; }
+        [[nodiscard]] const Payload* get(Handle handle) const noexcept
+        {
+            const auto it = m_map.find(handle);
+            return it != m_map.end() ? &it->second : nullptr;
+        }
+        [[nodiscard]] size_t size() const noexcept { return m_map.size(); }
+        [[nodiscard]] uint64_t sum_mesh_ids() const noexcept
+        {
+            uint64_t sum = 0;
+            for (const auto& [handle, payload] : m_map)
+            {
+                sum += payload.meshId;
+            }
+            return sum;
+        }
+    private:
+        std::unordered_map<uint32_t, Payload> m_map;
+        uint32_t m_nextId = 0;
+    };
+
+    class SlotHandleMap final
+    {
+    public:
+        using Handle = Core::SlotHandle;
+
+        Handle insert(const Payload& payload) { return m_map.insert(payload); }
+        bool erase(Handle handle) { return m_map.erase(handle); }
+        [[nodiscard]] const Payload* get(Handle handle) const noexcept { return m_map.get(handle); }
+        [[nodiscard]] size_t size() const noexcept { return m_map.size(); }
+        [[nodiscard]] uint64_t sum_mesh_ids() const noexcept
+        {
+            uint64_t sum = 0;
+            for (const Payload& payload : m_map)
+            {
+                sum += payload.meshId;
+            }
+            return sum;
+        }
+    private:
+        Core::SlotMap<Payload> m_map;
+    };
+
+    template<typename Map>
+    std::vector<typename Map::Handle> fill_handles(Map& map, size_t count)
+    {
+        std::vector<typename Map::Handle> handles;
+        handles.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            handles.push_back(map.insert({ { static_cast<float>(i), 0.0f, 0.0f }, 1.0f, static_cast<uint32_t>(i), 0, 0 }));
+        }
+        return handles;
+    }
+
+    template<typename Map, size_t N>
+    void handle_insert(State& state)
+    {
+        while (state.keep_running())
+        {
+            auto map = std::make_unique<Map>();
+            Cue::Bench::do_not_optimize(fill_handles(*map, N).data());
+            state.pause_timing();
+            map.reset();
+            state.resume_timing();
+        }
+    }
+
+    template<typename Map, size_t N>
+    void handle_get(State& state)
+    {
+        Map map;
+        std::vector<typename Map::Handle> handles = fill_handles(map, N);
+        std::shuffle(handles.begin(), handles.end(), std::mt19937_64(5));
+        size_t index = 0;
+        while (state.keep_running())
+        {
+            Cue::Bench::do_not_optimize(map.get(handles[index]));
+            index = (index + 1 == N) ? 0 : index + 1;
+        }
+    }
+
+    template<typename Map, size_t N>
+    void handle_iterate(State& state)
+    {
+        Map map;
+        (void)fill_handles(map, N);
+        state.set_bytes_per_iteration(N * sizeof(Payload));
+        while (state.keep_running())
+        {
+            Cue::Bench::do_not_optimize(map.sum_mesh_ids());
+        }
+    }
+
+    template<typename Map, size_t N>
+    void handle_erase(State& state)
+    {
+        while (state.keep_running())
+        {
+            state.pause_timing();
+            auto map = std::make_unique<Map>();
+            std::vector<typename Map::Handle> handles = fill_handles(*map, N);
+            std::shuffle(handles.begin(), handles.end(), std::mt19937_64(6));
+            state.resume_timing();
+            for (const typename Map::Handle handle : handles)
+            {
+                map->erase(handle);
+            }
+            Cue::Bench::do_not_optimize(map->size());
+            state.pause_timing();
+            map.reset();
+            state.resume_timing();
+        }
+    }
+
+    CUE_BENCHMARK("Core/SlotMap/slot_insert_1k", (handle_insert<SlotHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/std_insert_1k", (handle_insert<StdHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/slot_insert_100k", (handle_insert<SlotHandleMap, 100000>));
+    CUE_BENCHMARK("Core/SlotMap/std_insert_100k", (handle_insert<StdHandleMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_insert_1m", (handle_insert<SlotHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_insert_1m", (handle_insert<StdHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_insert_10m", (handle_insert<SlotHandleMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_insert_10m", (handle_insert<StdHandleMap, 10000000>));
+
+    CUE_BENCHMARK("Core/SlotMap/slot_get_1k", (handle_get<SlotHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/std_get_1k", (handle_get<StdHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/slot_get_100k", (handle_get<SlotHandleMap, 100000>));
+    CUE_BENCHMARK("Core/SlotMap/std_get_100k", (handle_get<StdHandleMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_get_1m", (handle_get<SlotHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_get_1m", (handle_get<StdHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_get_10m", (handle_get<SlotHandleMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_get_10m", (handle_get<StdHandleMap, 10000000>));
+
+    CUE_BENCHMARK("Core/SlotMap/slot_iterate_1k", (handle_iterate<SlotHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/std_iterate_1k", (handle_iterate<StdHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/slot_iterate_100k", (handle_iterate<SlotHandleMap, 100000>));
+    CUE_BENCHMARK("Core/SlotMap/std_iterate_100k", (handle_iterate<StdHandleMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_iterate_1m", (handle_iterate<SlotHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_iterate_1m", (handle_iterate<StdHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_iterate_10m", (handle_iterate<SlotHandleMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_iterate_10m", (handle_iterate<StdHandleMap, 10000000>));
+
+    CUE_BENCHMARK("Core/SlotMap/slot_erase_1k", (handle_erase<SlotHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/std_erase_1k", (handle_erase<StdHandleMap, 1000>));
+    CUE_BENCHMARK("Core/SlotMap/slot_erase_100k", (handle_erase<SlotHandleMap, 100000>));
+    CUE_BENCHMARK("Core/SlotMap/std_erase_100k", (handle_erase<StdHandleMap, 100000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_erase_1m", (handle_erase<SlotHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_erase_1m", (handle_erase<StdHandleMap, 1000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/slot_erase_10m", (handle_erase<SlotHandleMap, 10000000>));
+    CUE_BENCHMARK_LARGE("Core/SlotMap/std_erase_10m", (handle_erase<StdHandleMap, 10000000>));
+} // namespace
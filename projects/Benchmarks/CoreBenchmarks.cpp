@@ -0,0 +1,980 @@
+#include <Compression.h>
+#include <FrameArena.h>
+#include <JobSystem.h>
+#include <Logger.h>
+#include <MathBatch.h>
+#include <MemoryTracker.h>
+#include <NameId.h>
+#include <PoolAllocator.h>
+#include <Profiler.h>
+#include <Result.h>
+#include <Sha256.h>
+#include <Utf.h>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    using Cue::Bench::State;
+    namespace Core = Cue::Core;
+
+    // ---- Result の伝播 ----
+
+    /// @brief 8 バイトに詰める前の Result と同じ並び（診断情報を値で持つ）。比較の基準として残す
+    struct WideResult
+    {
+        Core::Facility facility = Core::Facility::Core;
+        Core::Code code = Core::Code::Ok;
+        Core::Severity severity = Core::Severity::Info;
+        uint32_t native = 0;
+        std::string_view message{};
+        const char* file = "";
+        const char* function = "";
+        uint32_t line = 0;
+
+        static WideResult ok() noexcept
+        {
+            return {};
+        }
+        static WideResult fail(Core::Facility f, Core::Code c, Core::Severity s, uint32_t nativeCode, std::string_view msg,
+            const std::source_location& loc = std::source_location::current()) noexcept
+        {
+            WideResult r{};
+            r.facility = f;
+            r.code = c;
+            r.severity = s;
+            r.native = nativeCode;
+            r.message = msg;
+            r.file = loc.file_name();
+            r.function = loc.function_name();
+            r.line = loc.line();
+            return r;
+        }
+        explicit operator bool() const noexcept
+        {
+            return code == Core::Code::Ok;
+        }
+    };
+
+    constexpr int k_propagationDepth = 16;
+    // この値を渡した呼び出しだけが末端で失敗する（定数畳み込みで経路が消えないよう volatile）
+    volatile int g_failValue = -1;
+
+    template<typename R>
+    [[gnu::noinline]] R leaf_call(int value) noexcept
+    {
+        if (value == g_failValue)
+        {
+            return R::fail(Core::Facility::IO, Core::Code::IoError, Core::Severity::Error, 5, "leaf failed");
+        }
+        return R::ok();
+    }
+
+    template<typename R, int Depth>
+    [[gnu::noinline]] R propagate(int value) noexcept
+    {
+        if constexpr (Depth == 0)
+        {
+            return leaf_call<R>(value);
+        }
+        else
+        {
+            const R r = propagate<R, Depth - 1>(value);
+            if (!r)
+            {
+                return r;
+            }
+            return R::ok();
+        }
+    }
+
+    template<typename R>
+    void run_propagation(State& state, bool isFailing)
+    {
+        int value = 0;
+        while (state.keep_running())
+        {
+            if (isFailing)
+            {
+                g_failValue = value;
+            }
+            const R r = propagate<R, k_propagationDepth>(value++);
+            Cue::Bench::do_not_optimize(r);
+        }
+        g_failValue = -1;
+    }
+
+    void result_ok_depth16(State& state)
+    {
+        run_propagation<Core::Result>(state, false);
+    }
+    void result_fail_depth16(State& state)
+    {
+        run_propagation<Core::Result>(state, true);
+    }
+    void wide_result_ok_depth16(State& state)
+    {
+        run_propagation<WideResult>(state, false);
+    }
+    void wide_result_fail_depth16(State& state)
+    {
+        run_propagation<WideResult>(state, true);
+    }
+
+    [[gnu::noinline]] Core::Expected<int> parse_positive(int value) noexcept
+    {
+        if (value < 0)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidArg, Core::Severity::Error, 0, "negative");
+        }
+        return value * 2;
+    }
+
+    void expected_int_value(State& state)
+    {
+        int value = 0;
+        while (state.keep_running())
+        {
+            const Core::Expected<int> e = parse_positive(value++ & 0xFFFF);
+            Cue::Bench::do_not_optimize(e);
+        }
+    }
+
+    void result_get_diagnostic(State& state)
+    {
+        const Core::Result r = Core::Result::fail(Core::Facility::IO, Core::Code::NotFound, Core::Severity::Warning, 2, "missing");
+        while (state.keep_running())
+        {
+            const Core::ResultDiagnostic diagnostic = r.get_diagnostic();
+            Cue::Bench::do_not_optimize(diagnostic);
+        }
+    }
+
+    CUE_BENCHMARK("Core/Result/ok_depth16", result_ok_depth16);
+    CUE_BENCHMARK("Core/Result/fail_depth16", result_fail_depth16);
+    CUE_BENCHMARK("Core/Result/wide_ok_depth16", wide_result_ok_depth16);
+    CUE_BENCHMARK("Core/Result/wide_fail_depth16", wide_result_fail_depth16);
+    CUE_BENCHMARK("Core/Result/get_diagnostic", result_get_diagnostic);
+    CUE_BENCHMARK("Core/Expected/int_value", expected_int_value);
+
+    // ---- 文字列変換 ----
+
+    constexpr size_t k_textBytes = 64 * 1024;
+
+    void append_utf8(std::string& text, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            text += static_cast<char>(codePoint);
+        }
+        else
+        {
+            text += static_cast<char>(0xE0 | (codePoint >> 12));
+            text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    /// @brief アセットのパスに近い ASCII か、漢字とかなを主にした文字列を作る
+    const std::string& get_utf8_text(bool isCjk)
+    {
+        static const std::string ascii = []()
+            {
+                std::string text;
+                for (uint32_t i = 0; text.size() < k_textBytes; ++i)
+                {
+                    text += "assets/textures/character_" + std::to_string(i) + "_albedo.dds ";
+                }
+                text.resize(k_textBytes);
+                return text;
+            }();
+        static const std::string cjk = []()
+            {
+                std::string text;
+                uint32_t state = 1;
+                while (text.size() + 3 <= k_textBytes)
+                {
+                    state = state * 1664525u + 1013904223u;
+                    const uint32_t roll = (state >> 24) % 100;
+                    append_utf8(text, roll < 85 ? 0x4E00 + (state >> 8) % 0x5000 : roll < 95 ? 0x3040 + (state >> 8) % 0x50 : '_');
+                }
+                return text;
+            }();
+        return isCjk ? cjk : ascii;
+    }
+
+    void run_utf8_to_utf16(State& state, bool isCjk)
+    {
+        const std::string& text = get_utf8_text(isCjk);
+        std::vector<char16_t> buffer(Core::get_utf16_capacity(text.size()));
+        state.set_bytes_per_iteration(text.size());
+        size_t written = 0;
+        while (state.keep_running())
+        {
+            if (!Core::utf8_to_utf16(text, buffer, written))
+            {
+                state.set_error("utf8_to_utf16 rejected generated text");
+            }
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    void run_utf16_to_utf8(State& state, bool isCjk)
+    {
+        const std::string& text = get_utf8_text(isCjk);
+        std::pmr::u16string wide;
+        if (!Core::utf8_to_utf16(text, wide))
+        {
+            state.set_error("utf8_to_utf16 rejected generated text");
+            return;
+        }
+        std::vector<char> buffer(Core::get_utf8_capacity(wide.size()));
+        state.set_bytes_per_iteration(text.size());
+        size_t written = 0;
+        while (state.keep_running())
+        {
+            if (!Core::utf16_to_utf8(wide, buffer, written))
+            {
+                state.set_error("utf16_to_utf8 rejected converted text");
+            }
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    void utf8_to_utf16_ascii(State& state)
+    {
+        run_utf8_to_utf16(state, false);
+    }
+    void utf8_to_utf16_cjk(State& state)
+    {
+        run_utf8_to_utf16(state, true);
+    }
+    void utf16_to_utf8_ascii(State& state)
+    {
+        run_utf16_to_utf8(state, false);
+    }
+    void utf16_to_utf8_cjk(State& state)
+    {
+        run_utf16_to_utf8(state, true);
+    }
+
+    CUE_BENCHMARK("Core/Utf/utf8_to_utf16_ascii_64k", utf8_to_utf16_ascii);
+    CUE_BENCHMARK("Core/Utf/utf8_to_utf16_cjk_64k", utf8_to_utf16_cjk);
+    CUE_BENCHMARK("Core/Utf/utf16_to_utf8_ascii_64k", utf16_to_utf8_ascii);
+    CUE_BENCHMARK("Core/Utf/utf16_to_utf8_cjk_64k", utf16_to_utf8_cjk);
+
+    // ---- 名前の ID ----
+
+    constexpr uint32_t k_nameCount = 4096;
+
+    const std::vector<std::string>& get_names()
+    {
+        static const std::vector<std::string> names = []()
+            {
+                std::vector<std::string> result;
+                for (uint32_t i = 0; i < k_nameCount; ++i)
+                {
+                    result.push_back("textures/キャラクター/chara_" + std::to_string(i) + ".dds");
+                }
+                return result;
+            }();
+        return names;
+    }
+
+    void name_id_intern(State& state)
+    {
+        const std::vector<std::string>& names = get_names();
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            const Core::NameId id = Core::NameId::intern(names[index++ & (k_nameCount - 1)]);
+            Cue::Bench::do_not_optimize(id);
+        }
+    }
+
+    void name_id_map_find(State& state)
+    {
+        const std::vector<std::string>& names = get_names();
+        std::unordered_map<Core::NameId, uint32_t> map;
+        std::vector<Core::NameId> ids;
+        for (uint32_t i = 0; i < k_nameCount; ++i)
+        {
+            ids.push_back(Core::NameId::intern(names[i]));
+            map.emplace(ids.back(), i);
+        }
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            const auto found = map.find(ids[index++ & (k_nameCount - 1)]);
+            Cue::Bench::do_not_optimize(found->second);
+        }
+    }
+
+    void string_map_find(State& state)
+    {
+        const std::vector<std::string>& names = get_names();
+        std::unordered_map<std::string, uint32_t> map;
+        for (uint32_t i = 0; i < k_nameCount; ++i)
+        {
+            map.emplace(names[i], i);
+        }
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            const auto found = map.find(names[index++ & (k_nameCount - 1)]);
+            Cue::Bench::do_not_optimize(found->second);
+        }
+    }
+
+    CUE_BENCHMARK("Core/NameId/intern_existing", name_id_intern);
+    CUE_BENCHMARK("Core/NameId/map_find", name_id_map_find);
+    CUE_BENCHMARK("Core/NameId/string_map_find", string_map_find);
+
+    // ---- アロケータ ----
+
+    struct alignas(16) PoolObject
+    {
+        float values[16];
+    };
+
+    void frame_arena_allocate_64(State& state)
+    {
+        Core::FrameArena arena;
+        if (!arena.initialize({}))
+        {
+            state.set_error("FrameArena initialize failed");
+            return;
+        }
+        while (state.keep_running())
+        {
+            void* p = arena.try_allocate(64);
+            if (!p)
+            {
+                // 使い切ったらフレームを進める（16MB で約 26 万回に 1 回）
+                if (!arena.begin_frame())
+                {
+                    state.set_error("FrameArena begin_frame failed");
+                }
+                p = arena.try_allocate(64);
+            }
+            Cue::Bench::do_not_optimize(p);
+        }
+    }
+
+    void pool_create_destroy(State& state)
+    {
+        Core::PoolAllocator<PoolObject> pool(256);
+        PoolObject* live[64] = {};
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            PoolObject*& slot = live[index++ & 63];
+            pool.destroy(slot);
+            slot = pool.create();
+            Cue::Bench::do_not_optimize(slot);
+        }
+        for (PoolObject* p : live)
+        {
+            pool.destroy(p);
+        }
+    }
+
+    void new_delete_64(State& state)
+    {
+        // 追跡が有効なビルドでは置き換えた operator new を通る（追跡の上乗せ分は malloc_free_64 と比べる）
+        void* live[64] = {};
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            void*& slot = live[index++ & 63];
+            ::operator delete(slot);
+            slot = ::operator new(64);
+            Cue::Bench::do_not_optimize(slot);
+        }
+        for (void* p : live)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    void malloc_free_64(State& state)
+    {
+        void* live[64] = {};
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            void*& slot = live[index++ & 63];
+            std::free(slot);
+            slot = std::malloc(64);
+            Cue::Bench::do_not_optimize(slot);
+        }
+        for (void* p : live)
+        {
+            std::free(p);
+        }
+    }
+
+    void memory_tag_scope(State& state)
+    {
+        while (state.keep_running())
+        {
+            CUE_MEMORY_TAG(Core::Facility::Graphics);
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    CUE_BENCHMARK("Core/FrameArena/allocate_64", frame_arena_allocate_64);
+    CUE_BENCHMARK("Core/PoolAllocator/create_destroy_64", pool_create_destroy);
+    CUE_BENCHMARK("Core/Allocator/new_delete_64", new_delete_64);
+    CUE_BENCHMARK("Core/Allocator/malloc_free_64", malloc_free_64);
+    CUE_BENCHMARK("Core/MemoryTracker/tag_scope", memory_tag_scope);
+
+    // ---- ジョブ・ログ・プロファイラ ----
+
+    void job_system_parallel_for_64k(State& state)
+    {
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({}))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::vector<uint32_t> values(64 * 1024, 1);
+        std::atomic<uint64_t> sum{ 0 };
+        state.set_bytes_per_iteration(values.size() * sizeof(uint32_t));
+        while (state.keep_running())
+        {
+            jobSystem.parallel_for(static_cast<uint32_t>(values.size()), 4096, [&values, &sum](uint32_t begin, uint32_t end)
+                {
+                    uint64_t local = 0;
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        local += values[i];
+                    }
+                    sum.fetch_add(local, std::memory_order_relaxed);
+                });
+        }
+        Cue::Bench::do_not_optimize(sum.load());
+        jobSystem.shutdown();
+    }
+
+    void job_system_run_wait_64(State& state)
+    {
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({}))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::atomic<uint32_t> count{ 0 };
+        Core::JobDecl decls[64];
+        for (Core::JobDecl& decl : decls)
+        {
+            decl = { [](void* data) { static_cast<std::atomic<uint32_t>*>(data)->fetch_add(1, std::memory_order_relaxed); }, &count };
+        }
+        while (state.keep_running())
+        {
+            Core::JobCounter counter;
+            jobSystem.run(decls, 64, &counter);
+            jobSystem.wait(counter);
+        }
+        jobSystem.shutdown();
+    }
+
+    /// @brief 細かいジョブ 1 つ分（自分の出力にだけ書くので、ジョブ同士は競合しない）
+    struct TinyJob
+    {
+        const float* input = nullptr;
+        float output = 0.0f;
+    };
+
+    /// @brief 64 要素の和だけを行うジョブを 2048 個流し、投入と盗みのコストをワーカー数毎に測る
+    template<uint32_t Workers>
+    void job_system_tiny_jobs(State& state)
+    {
+        constexpr uint32_t k_jobCount = 2048;
+        constexpr uint32_t k_elementsPerJob = 64;
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({ Workers }))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::vector<float> input(k_jobCount * k_elementsPerJob, 1.0f);
+        std::vector<TinyJob> jobs(k_jobCount);
+        std::vector<Core::JobDecl> decls(k_jobCount);
+        for (uint32_t i = 0; i < k_jobCount; ++i)
+        {
+            jobs[i].input = input.data() + i * k_elementsPerJob;
+            decls[i] = { [](void* data)
+                {
+                    TinyJob* job = static_cast<TinyJob*>(data);
+                    float sum = 0.0f;
+                    for (uint32_t e = 0; e < k_elementsPerJob; ++e)
+                    {
+                        sum += job->input[e];
+                    }
+                    job->output = sum;
+                }, &jobs[i] };
+        }
+        state.set_items_per_iteration(k_jobCount);
+        while (state.keep_running())
+        {
+            Core::JobCounter counter;
+            jobSystem.run(decls.data(), k_jobCount, &counter);
+            jobSystem.wait(counter);
+        }
+        Cue::Bench::do_not_optimize(jobs[k_jobCount - 1].output);
+        jobSystem.shutdown();
+    }
+
+    /// @brief 16MB を 16 個の大きなジョブに分けて畳み込み、ワーカー数に対する伸びを測る
+    template<uint32_t Workers>
+    void job_system_large_jobs(State& state)
+    {
+        constexpr uint32_t k_jobCount = 16;
+        constexpr uint32_t k_elementCount = 4u * 1024u * 1024u;
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({ Workers }))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::vector<float> values(k_elementCount, 1.0f);
+        std::vector<float> sums(k_jobCount);
+        state.set_bytes_per_iteration(values.size() * sizeof(float));
+        while (state.keep_running())
+        {
+            jobSystem.parallel_for(k_elementCount, k_elementCount / k_jobCount, [&values, &sums](uint32_t begin, uint32_t end)
+                {
+                    float sum = 0.0f;
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        sum += values[i] * values[i];
+                    }
+                    sums[begin / (k_elementCount / k_jobCount)] = sum;
+                });
+        }
+        Cue::Bench::do_not_optimize(sums[0]);
+        jobSystem.shutdown();
+    }
+
+    void logger_log(State& state)
+    {
+        Core::Logger logger;
+        Core::LoggerDesc desc{};
+        desc.isStderrEnabled = false;
+        desc.ringCapacity = 4096;
+        // 捨てると計測が書き出しスレッドの速さで揺れるので、待たせて全件を通す
+        desc.overflowPolicy = Core::LogOverflowPolicy::Block;
+        if (!logger.initialize(desc))
+        {
+            state.set_error("Logger initialize failed");
+            return;
+        }
+        const Core::Result r = Core::Result::fail(Core::Facility::IO, Core::Code::IoError, Core::Severity::Error, 5, "disk on fire");
+        while (state.keep_running())
+        {
+            logger.log(r);
+        }
+        logger.shutdown();
+    }
+
+    template<uint32_t Producers>
+    void logger_log_concurrent(State& state)
+    {
+        // 複数スレッドが同時に積む。リングはスレッド毎なので、競合するのは書き出しスレッドの掃き出しだけ
+        constexpr uint32_t k_recordsPerProducer = 4096;
+        Core::Logger logger;
+        Core::LoggerDesc desc{};
+        desc.isStderrEnabled = false;
+        desc.ringCapacity = 4096;
+        desc.overflowPolicy = Core::LogOverflowPolicy::Block;
+        if (!logger.initialize(desc))
+        {
+            state.set_error("Logger initialize failed");
+            return;
+        }
+        const Core::Result r = Core::Result::fail(Core::Facility::IO, Core::Code::IoError, Core::Severity::Error, 5, "disk on fire");
+
+        // 1) スレッドは使い回し、反復毎に開始と終了をバリアで揃える（生成コストを計測に入れない）
+        std::barrier sync(Producers + 1);
+        std::atomic<bool> isStopping = false;
+        std::vector<std::thread> producers;
+        producers.reserve(Producers);
+        for (uint32_t t = 0; t < Producers; ++t)
+        {
+            producers.emplace_back([&]
+                {
+                    while (true)
+                    {
+                        sync.arrive_and_wait();
+                        if (isStopping.load(std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                        for (uint32_t i = 0; i < k_recordsPerProducer; ++i)
+                        {
+                            logger.log(r);
+                        }
+                        sync.arrive_and_wait();
+                    }
+                });
+        }
+
+        // 2) 全スレッドが積み終えるまでを 1 反復とする
+        state.set_items_per_iteration(uint64_t{ Producers } * k_recordsPerProducer);
+        while (state.keep_running())
+        {
+            sync.arrive_and_wait();
+            sync.arrive_and_wait();
+        }
+        isStopping.store(true, std::memory_order_relaxed);
+        sync.arrive_and_wait();
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+        logger.shutdown();
+    }
+
+    void profile_scope(State& state)
+    {
+        while (state.keep_running())
+        {
+            const Core::ProfileScope scope("Bench");
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    CUE_BENCHMARK("Core/JobSystem/parallel_for_64k", job_system_parallel_for_64k);
+    CUE_BENCHMARK("Core/JobSystem/run_wait_64", job_system_run_wait_64);
+    // ワーカー数 1..16 での伸び（コア数を超えた分は過剰な割り当ての影響を見る）
+    CUE_BENCHMARK("Core/JobSystem/tiny_jobs_2k_workers_01", job_system_tiny_jobs<1>);
+    CUE_BENCHMARK("Core/JobSystem/tiny_jobs_2k_workers_02", job_system_tiny_jobs<2>);
+    CUE_BENCHMARK("Core/JobSystem/tiny_jobs_2k_workers_04", job_system_tiny_jobs<4>);
+    CUE_BENCHMARK("Core/JobSystem/tiny_jobs_2k_workers_08", job_system_tiny_jobs<8>);
+    CUE_BENCHMARK("Core/JobSystem/tiny_jobs_2k_workers_16", job_system_tiny_jobs<16>);
+    CUE_BENCHMARK("Core/JobSystem/large_jobs_16_workers_01", job_system_large_jobs<1>);
+    CUE_BENCHMARK("Core/JobSystem/large_jobs_16_workers_02", job_system_large_jobs<2>);
+    CUE_BENCHMARK("Core/JobSystem/large_jobs_16_workers_04", job_system_large_jobs<4>);
+    CUE_BENCHMARK("Core/JobSystem/large_jobs_16_workers_08", job_system_large_jobs<8>);
+    CUE_BENCHMARK("Core/JobSystem/large_jobs_16_workers_16", job_system_large_jobs<16>);
+    CUE_BENCHMARK("Core/Logger/log", logger_log);
+    CUE_BENCHMARK("Core/Logger/log_concurrent_producers_1", logger_log_concurrent<1>);
+    CUE_BENCHMARK("Core/Logger/log_concurrent_producers_2", logger_log_concurrent<2>);
+    CUE_BENCHMARK("Core/Logger/log_concurrent_producers_4", logger_log_concurrent<4>);
+    CUE_BENCHMARK("Core/Logger/log_concurrent_producers_8", logger_log_concurrent<8>);
+    CUE_BENCHMARK("Core/Profiler/scope", profile_scope);
+
+    // ---- 数学・ハッシュ・圧縮 ----
+
+    /// @brief SoA の点列を一括変換する（IsSimd が false ならスカラーの参照実装で同じ処理をする）
+    template<size_t Count, bool IsSimd>
+    void math_transform_points(State& state)
+    {
+        constexpr size_t k_count = Count;
+        std::vector<float> x(k_count), y(k_count), z(k_count), ox(k_count), oy(k_count), oz(k_count);
+        for (size_t i = 0; i < k_count; ++i)
+        {
+            x[i] = static_cast<float>(i);
+            y[i] = static_cast<float>(i) * 0.5f;
+            z[i] = -static_cast<float>(i);
+        }
+        const Cue::Math::float4x4 m = Cue::Math::multiply(
+            Cue::Math::to_matrix(Cue::Math::from_axis_angle({ 0.0f, 1.0f, 0.0f }, 0.7f)), Cue::Math::translation({ 1.0f, 2.0f, 3.0f }));
+        state.set_bytes_per_iteration(k_count * sizeof(float) * 3);
+        while (state.keep_running())
+        {
+            if constexpr (IsSimd)
+            {
+                Cue::Math::transform_points(m, { x.data(), y.data(), z.data() }, { ox.data(), oy.data(), oz.data() }, k_count);
+            }
+            else
+            {
+                Cue::Math::Scalar::transform_points(m, { x.data(), y.data(), z.data() }, { ox.data(), oy.data(), oz.data() }, k_count);
+            }
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    template<size_t Count, bool IsSimd>
+    void math_multiply_matrices(State& state)
+    {
+        constexpr size_t k_count = Count;
+        std::vector<Cue::Math::float4x4> a(k_count), b(k_count), out(k_count);
+        for (size_t i = 0; i < k_count; ++i)
+        {
+            a[i] = Cue::Math::translation({ static_cast<float>(i), 1.0f, 2.0f });
+            b[i] = Cue::Math::to_matrix(Cue::Math::from_axis_angle({ 0.0f, 0.0f, 1.0f }, static_cast<float>(i) * 0.01f));
+        }
+        state.set_bytes_per_iteration(k_count * sizeof(Cue::Math::float4x4) * 2);
+        while (state.keep_running())
+        {
+            if constexpr (IsSimd)
+            {
+                Cue::Math::multiply_matrices(a.data(), b.data(), out.data(), k_count);
+            }
+            else
+            {
+                Cue::Math::Scalar::multiply_matrices(a.data(), b.data(), out.data(), k_count);
+            }
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    const std::vector<std::byte>& get_payload()
+    {
+        // 圧縮が効く程度に繰り返しのある 256KB（文字列を混ぜたバイナリに近い）
+        static const std::vector<std::byte> payload = []()
+            {
+                std::vector<std::byte> data;
+                uint32_t state = 7;
+                while (data.size() < 256 * 1024)
+                {
+                    state = state * 1664525u + 1013904223u;
+                    const std::string& text = get_utf8_text(false);
+                    const size_t offset = (state >> 8) % (text.size() - 64);
+                    for (size_t i = 0; i < 48; ++i)
+                    {
+                        data.push_back(static_cast<std::byte>(text[offset + i]));
+                    }
+                    for (size_t i = 0; i < 16; ++i)
+                    {
+                        state = state * 1664525u + 1013904223u;
+                        data.push_back(static_cast<std::byte>(state >> 24));
+                    }
+                }
+                return data;
+            }();
+        return payload;
+    }
+
+    void sha256_256k(State& state)
+    {
+        const std::vector<std::byte>& payload = get_payload();
+        state.set_bytes_per_iteration(payload.size());
+        while (state.keep_running())
+        {
+            const Core::Sha256Digest digest = Core::sha256(payload);
+            Cue::Bench::do_not_optimize(digest);
+        }
+    }
+
+    void lz_compress_256k(State& state)
+    {
+        const std::vector<std::byte>& payload = get_payload();
+        std::vector<std::byte> compressed(Core::lz_compress_bound(payload.size()));
+        state.set_bytes_per_iteration(payload.size());
+        while (state.keep_running())
+        {
+            const size_t size = Core::lz_compress(payload, compressed);
+            Cue::Bench::do_not_optimize(size);
+        }
+    }
+
+    void lz_decompress_256k(State& state)
+    {
+        const std::vector<std::byte>& payload = get_payload();
+        std::vector<std::byte> compressed(Core::lz_compress_bound(payload.size()));
+        compressed.resize(Core::lz_compress(payload, compressed));
+        std::vector<std::byte> output(payload.size());
+        state.set_bytes_per_iteration(payload.size());
+        while (state.keep_running())
+        {
+            if (!Core::lz_decompress(compressed, output))
+            {
+                state.set_error("lz_decompress failed");
+            }
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    /// @brief 種類の違うアセットを並べた圧縮の計測用の集まり（各アセットを別々にブロック圧縮する）
+    struct AssetCorpus
+    {
+        std::vector<std::vector<std::byte>> assets;
+        std::vector<std::vector<std::byte>> compressed;
+        uint64_t uncompressedBytes = 0;
+        uint64_t compressedBytes = 0;
+        bool isReady = false;
+    };
+
+    /// @brief マテリアル定義のようなテキスト・頂点列・RGBA8 のテクスチャ・圧縮済みの音声（乱数）の 7MB
+    const AssetCorpus& get_asset_corpus()
+    {
+        static const AssetCorpus corpus = []()
+            {
+                AssetCorpus c;
+                uint32_t random = 11;
+                auto next_random = [&random]()
+                    {
+                        random = random * 1664525u + 1013904223u;
+                        return random;
+                    };
+
+                // 1) テキスト 2MB
+                std::string text;
+                char line[256];
+                for (uint32_t i = 0; text.size() < 2u << 20; ++i)
+                {
+                    std::snprintf(line, sizeof(line),
+                        "{\"name\": \"material_%u\", \"albedo\": \"textures/props/prop_%u_albedo.dds\", "
+                        "\"roughness\": 0.%02u, \"metallic\": %u, \"shader\": \"lit_%s\"}\n",
+                        i, i % 700, next_random() % 100, next_random() % 2, (i % 3) == 0 ? "opaque" : "masked");
+                    text += line;
+                }
+                c.assets.emplace_back(reinterpret_cast<const std::byte*>(text.data()),
+                    reinterpret_cast<const std::byte*>(text.data()) + text.size());
+
+                // 2) 位置・法線・UV を並べた頂点 2MB（滑らかな面）
+                std::vector<float> vertices;
+                for (uint32_t i = 0; vertices.size() * sizeof(float) < 2u << 20; ++i)
+                {
+                    const float u = static_cast<float>(i % 256) / 255.0f;
+                    const float v = static_cast<float>(i / 256) / 255.0f;
+                    const float height = std::sin(u * 6.0f) * std::cos(v * 4.0f);
+                    vertices.insert(vertices.end(), { u * 100.0f, height, v * 100.0f, 0.0f, 1.0f, 0.0f, u, v });
+                }
+                const auto* vertexBytes = reinterpret_cast<const std::byte*>(vertices.data());
+                c.assets.emplace_back(vertexBytes, vertexBytes + vertices.size() * sizeof(float));
+
+                // 3) 緩やかな階調にノイズを載せた 1024x512 の RGBA8 テクスチャ 2MB
+                std::vector<std::byte> texture;
+                for (uint32_t y = 0; y < 512; ++y)
+                {
+                    for (uint32_t x = 0; x < 1024; ++x)
+                    {
+                        const uint32_t noise = next_random() >> 29;
+                        texture.push_back(static_cast<std::byte>((x / 4 + noise) & 0xFF));
+                        texture.push_back(static_cast<std::byte>((y / 2 + noise) & 0xFF));
+                        texture.push_back(static_cast<std::byte>(((x + y) / 8) & 0xFF));
+                        texture.push_back(std::byte{ 0xFF });
+                    }
+                }
+                c.assets.push_back(std::move(texture));
+
+                // 4) 既に圧縮された音声に見立てた乱数 1MB（縮まないのでそのまま置かれる）
+                std::vector<std::byte> audio(1u << 20);
+                for (std::byte& b : audio)
+                {
+                    b = static_cast<std::byte>(next_random() >> 24);
+                }
+                c.assets.push_back(std::move(audio));
+
+                // 5) pak に詰める時と同じく、アセット毎に既定のブロックの大きさで圧縮しておく
+                for (const std::vector<std::byte>& asset : c.assets)
+                {
+                    std::vector<std::byte>& out = c.compressed.emplace_back();
+                    if (!Core::compress_blocks(asset, Core::k_defaultCompressedBlockSize, out))
+                    {
+                        return c;
+                    }
+                    c.uncompressedBytes += asset.size();
+                    c.compressedBytes += out.size();
+                }
+                c.isReady = true;
+                return c;
+            }();
+        return corpus;
+    }
+
+    void compression_corpus_compress(State& state)
+    {
+        const AssetCorpus& corpus = get_asset_corpus();
+        if (!corpus.isReady)
+        {
+            state.set_error("compress_blocks failed on the asset corpus");
+            return;
+        }
+        std::vector<std::byte> out;
+        state.set_bytes_per_iteration(corpus.uncompressedBytes);
+        while (state.keep_running())
+        {
+            for (const std::vector<std::byte>& asset : corpus.assets)
+            {
+                if (!Core::compress_blocks(asset, Core::k_defaultCompressedBlockSize, out))
+                {
+                    state.set_error("compress_blocks failed");
+                }
+            }
+        }
+        state.set_counter("ratio", static_cast<double>(corpus.uncompressedBytes) / static_cast<double>(corpus.compressedBytes));
+    }
+
+    /// @brief 集まり全体を Workers 本のワーカーで展開し、ワーカー 1 本あたりの GB/s を counters に出す
+    template<uint32_t Workers>
+    void compression_corpus_decompress(State& state)
+    {
+        const AssetCorpus& corpus = get_asset_corpus();
+        if (!corpus.isReady)
+        {
+            state.set_error("compress_blocks failed on the asset corpus");
+            return;
+        }
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({ Workers }))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::vector<Core::CompressedBlockReader> readers(corpus.compressed.size());
+        std::vector<std::vector<std::byte>> outputs(corpus.compressed.size());
+        for (size_t i = 0; i < readers.size(); ++i)
+        {
+            if (!readers[i].open(corpus.compressed[i]))
+            {
+                state.set_error("CompressedBlockReader open failed");
+                return;
+            }
+            outputs[i].resize(static_cast<size_t>(readers[i].get_uncompressed_size()));
+        }
+        state.set_bytes_per_iteration(corpus.uncompressedBytes);
+        while (state.keep_running())
+        {
+            for (size_t i = 0; i < readers.size(); ++i)
+            {
+                if (!readers[i].decompress(outputs[i], &jobSystem))
+                {
+                    state.set_error("CompressedBlockReader decompress failed");
+                }
+            }
+            Cue::Bench::clobber_memory();
+        }
+        const double elapsedNs = state.get_elapsed_ns();
+        if (elapsedNs > 0.0)
+        {
+            const double bytesPerSecond = static_cast<double>(corpus.uncompressedBytes * state.get_iterations()) * 1.0e9 / elapsedNs;
+            state.set_counter("gb_per_second_per_worker", bytesPerSecond / 1.0e9 / Workers);
+        }
+        state.set_counter("ratio", static_cast<double>(corpus.uncompressedBytes) / static_cast<double>(corpus.compressedBytes));
+        jobSystem.shutdown();
+    }
+
+    CUE_BENCHMARK("Core/Math/transform_points_4k", (math_transform_points<4096, true>));
+    CUE_BENCHMARK("Core/Math/scalar_transform_points_4k", (math_transform_points<4096, false>));
+    CUE_BENCHMARK("Core/Math/multiply_matrices_1k", (math_multiply_matrices<1024, true>));
+    CUE_BENCHMARK("Core/Math/scalar_multiply_matrices_1k", (math_multiply_matrices<1024, false>));
+    CUE_BENCHMARK_LARGE("Core/Math/transform_points_1m", (math_transform_points<1000000, true>));
+    CUE_BENCHMARK_LARGE("Core/Math/scalar_transform_points_1m", (math_transform_points<1000000, false>));
+    CUE_BENCHMARK_LARGE("Core/Math/multiply_matrices_1m", (math_multiply_matrices<1000000, true>));
+    CUE_BENCHMARK_LARGE("Core/Math/scalar_multiply_matrices_1m", (math_multiply_matrices<1000000, false>));
+    CUE_BENCHMARK("Core/Sha256/256k", sha256_256k);
+    CUE_BENCHMARK("Core/Compression/lz_compress_256k", lz_compress_256k);
+    CUE_BENCHMARK("Core/Compression/lz_decompress_256k", lz_decompress_256k);
+    CUE_BENCHMARK("Core/Compression/corpus_compress", compression_corpus_compress);
+    CUE_BENCHMARK("Core/Compression/corpus_decompress_workers_01", compression_corpus_decompress<1>);
+    CUE_BENCHMARK("Core/Compression/corpus_decompress_workers_02", compression_corpus_decompress<2>);
+    CUE_BENCHMARK("Core/Compression/corpus_decompress_workers_04", compression_corpus_decompress<4>);
+    CUE_BENCHMARK("Core/Compression/corpus_decompress_workers_08", compression_corpus_decompress<8>);
+} // namespace
@@ -0,0 +1,422 @@
+#include <Culling.h>
+#include <Engine.h>
+#include <FramePipeline.h>
+#include <Query.h>
+#include <headless_platform.h>
+#include <null_backend.h>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    using Cue::Bench::State;
+    namespace Core = Cue::Core;
+    namespace Ecs = Cue::Ecs;
+    namespace Math = Cue::Math;
+
+    struct Position
+    {
+        float x, y, z;
+    };
+    struct Velocity
+    {
+        float x, y, z;
+    };
+    struct Tagged
+    {
+        uint32_t value;
+    };
+
+    /// @brief HeadlessRunner と同じ組み合わせ（ヘッドレス + Null バックエンド）で Engine を立てる
+    class EngineHarness final
+    {
+    public:
+        explicit EngineHarness(Cue::EngineInitInfo initInfo)
+        {
+            // 1) 計測の出力を汚さないよう、ログとリーク報告は止める
+            initInfo.platform = &m_platform;
+            initInfo.graphicsBackend = &m_backend;
+            initInfo.logger.isStderrEnabled = false;
+            initInfo.isMemoryReportEnabled = false;
+            if (!m_platform.setup() || !m_platform.start() || !m_backend.initialize())
+            {
+                return;
+            }
+            m_isReady = static_cast<bool>(m_engine.initialize(initInfo));
+        }
+        ~EngineHarness()
+        {
+            if (m_isReady)
+            {
+                m_engine.shutdown();
+            }
+            (void)m_backend.shutdown();
+            (void)m_platform.shutdown();
+        }
+        EngineHarness(const EngineHarness&) = delete;
+        EngineHarness& operator=(const EngineHarness&) = delete;
+
+        [[nodiscard]] bool is_ready() const noexcept { return m_isReady; }
+        [[nodiscard]] Cue::Engine& get_engine() noexcept { return m_engine; }
+    private:
+        Cue::Platform::Headless::HeadlessPlatform m_platform;
+        Cue::Graphics::Null::NullBackend m_backend;
+        Cue::Engine m_engine;
+        bool m_isReady = false;
+    };
+
+    void run_ticks(State& state, EngineHarness& harness)
+    {
+        if (!harness.is_ready())
+        {
+            state.set_error("Engine initialize failed");
+            return;
+        }
+        while (state.keep_running())
+        {
+            if (!harness.get_engine().tick())
+            {
+                state.set_error("Engine tick failed");
+            }
+        }
+    }
+
+    void tick_empty(State& state)
+    {
+        EngineHarness harness({});
+        run_ticks(state, harness);
+    }
+
+    void tick_move_system_10k(State& state)
+    {
+        EngineHarness harness({});
+        if (harness.is_ready())
+        {
+            Ecs::World& world = harness.get_engine().get_world();
+            for (uint32_t i = 0; i < 10000; ++i)
+            {
+                (void)world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }, Velocity{ 1.0f, 2.0f, 3.0f });
+            }
+            Ecs::SystemDesc desc{};
+            desc.name = "Move";
+            desc.reads = Ecs::make_mask<Velocity>();
+            desc.writes = Ecs::make_mask<Position>();
+            desc.function = [](Ecs::SystemContext& context)
+                {
+                    Ecs::Query<Position, const Velocity> query;
+                    query.parallel_for_each(context.world, context.jobSystem, [](Position& p, const Velocity& v)
+                        {
+                            p.x += v.x * 0.016f;
+                            p.y += v.y * 0.016f;
+                            p.z += v.z * 0.016f;
+                        });
+                };
+            harness.get_engine().get_system_scheduler().add_system(std::move(desc));
+        }
+        run_ticks(state, harness);
+    }
+
+    void tick_pipelined_256_objects(State& state)
+    {
+        // 描画スレッドと並走させた時の受け渡しの上乗せ分（描画はパケットを読むだけ）
+        Cue::EngineInitInfo initInfo{};
+        initInfo.framePipeline.depth = 2;
+        initInfo.framePipeline.objectCapacity = 256;
+        initInfo.extractFrame = [](Ecs::World&, Cue::FramePacket& packet)
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    Cue::RenderObject object{};
+                    object.world.r[3] = { static_cast<float>(i), 0.0f, 0.0f, 1.0f };
+                    object.meshId = i;
+                    packet.objects.push_back(object);
+                }
+            };
+        initInfo.renderFrame = [](const Cue::FramePacket& packet)
+            {
+                float sum = 0.0f;
+                for (const Cue::RenderObject& object : packet.objects)
+                {
+                    sum += object.world.r[3].x;
+                }
+                Cue::Bench::do_not_optimize(sum);
+                return Core::Result::ok();
+            };
+        EngineHarness harness(std::move(initInfo));
+        run_ticks(state, harness);
+    }
+
+    CUE_BENCHMARK("Engine/Tick/empty", tick_empty);
+    CUE_BENCHMARK("Engine/Tick/move_system_10k", tick_move_system_10k);
+    CUE_BENCHMARK("Engine/Tick/pipelined_256_objects", tick_pipelined_256_objects);
+
+    // ---- ECS ----
+
+    template<uint32_t Count>
+    void query_for_each(State& state)
+    {
+        Ecs::World world;
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            (void)world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }, Velocity{ 1.0f, 2.0f, 3.0f });
+        }
+        Ecs::Query<Position, const Velocity> query;
+        state.set_bytes_per_iteration(uint64_t{ Count } * (sizeof(Position) + sizeof(Velocity)));
+        state.set_items_per_iteration(Count);
+        while (state.keep_running())
+        {
+            query.for_each(world, [](Position& p, const Velocity& v)
+                {
+                    p.x += v.x;
+                    p.y += v.y;
+                    p.z += v.z;
+                });
+            Cue::Bench::clobber_memory();
+        }
+    }
+
+    void create_destroy_entity(State& state)
+    {
+        Ecs::World world;
+        std::vector<Ecs::Entity> live(256);
+        for (Ecs::Entity& entity : live)
+        {
+            entity = world.create_entity(Position{}, Velocity{});
+        }
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            Ecs::Entity& entity = live[index++ & 255];
+            world.destroy_entity(entity);
+            entity = world.create_entity(Position{}, Velocity{});
+        }
+    }
+
+    void add_remove_component(State& state)
+    {
+        // アーキタイプ間の移動（列のコピー）が主なコスト
+        Ecs::World world;
+        std::vector<Ecs::Entity> entities(256);
+        for (Ecs::Entity& entity : entities)
+        {
+            entity = world.create_entity(Position{}, Velocity{});
+        }
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            const Ecs::Entity entity = entities[index++ & 255];
+            if (world.has_component<Tagged>(entity))
+            {
+                world.remove_component<Tagged>(entity);
+            }
+            else
+            {
+                world.add_component(entity, Tagged{ index });
+            }
+        }
+    }
+
+    template<uint32_t Count>
+    void add_remove_component_churn(State& state)
+    {
+        // 大きな集団に散らばった 4096 体へ遅延コマンドでタグを付け外しする。
+        // 1 反復で付与と削除を 1 回ずつ行うので、アーキタイプ間の移動は 8192 回
+        constexpr uint32_t k_batch = 4096;
+        constexpr uint32_t k_stride = Count / k_batch;
+        static_assert(k_stride > 0, "Count must be at least the batch size");
+
+        Ecs::World world;
+        std::vector<Ecs::Entity> entities(Count);
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            entities[i] = world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }, Velocity{});
+        }
+        Ecs::CommandBuffer& commands = world.get_command_buffer();
+        uint32_t offset = 0;
+        state.set_items_per_iteration(k_batch * 2);
+        while (state.keep_running())
+        {
+            // 1) 毎回ずらした位置から選び、同じチャンクばかり触らないようにする
+            for (uint32_t i = 0; i < k_batch; ++i)
+            {
+                commands.add_component(entities[i * k_stride + offset], Tagged{ i });
+            }
+            world.flush_commands();
+            // 2) 付けたものを外して元のアーキタイプへ戻す
+            for (uint32_t i = 0; i < k_batch; ++i)
+            {
+                commands.remove_component<Tagged>(entities[i * k_stride + offset]);
+            }
+            world.flush_commands();
+            offset = (offset + 1) % k_stride;
+        }
+    }
+
+    void frame_pipeline_handoff(State& state)
+    {
+        // 同じスレッドで書いて読む 1 往復（ロックと条件変数の分だけ）
+        Cue::FramePipeline pipeline;
+        if (!pipeline.initialize({ .depth = 2, .objectCapacity = 16 }))
+        {
+            state.set_error("FramePipeline initialize failed");
+            return;
+        }
+        uint64_t frameIndex = 0;
+        while (state.keep_running())
+        {
+            Cue::FramePacket* packet = pipeline.begin_write();
+            packet->constants.frameIndex = frameIndex++;
+            pipeline.end_write();
+            const Cue::FramePacket* read = pipeline.begin_read();
+            Cue::Bench::do_not_optimize(read->constants.frameIndex);
+            pipeline.end_read();
+        }
+        pipeline.shutdown();
+    }
+
+    CUE_BENCHMARK("Engine/Ecs/query_for_each_100k", (query_for_each<100000>));
+    CUE_BENCHMARK_LARGE("Engine/Ecs/query_for_each_1m", (query_for_each<1000000>));
+    CUE_BENCHMARK("Engine/Ecs/create_destroy_entity", create_destroy_entity);
+    CUE_BENCHMARK("Engine/Ecs/add_remove_component", add_remove_component);
+    CUE_BENCHMARK("Engine/Ecs/add_remove_component_churn_100k", (add_remove_component_churn<100000>));
+    CUE_BENCHMARK_LARGE("Engine/Ecs/add_remove_component_churn_1m", (add_remove_component_churn<1000000>));
+    CUE_BENCHMARK("Engine/FramePipeline/handoff", frame_pipeline_handoff);
+
+    // ---- カリング ----
+
+    constexpr uint32_t k_cullObjectCount = 100000;
+
+    /// @brief 2km 四方に散らばった 10 万個の物体
+    std::vector<Cue::Aabb> make_cull_scene()
+    {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> size(0.5f, 4.0f);
+        std::vector<Cue::Aabb> bounds(k_cullObjectCount);
+        for (Cue::Aabb& box : bounds)
+        {
+            const Math::Float3 center{ position(rng), position(rng) * 0.05f, position(rng) };
+            const Math::Float3 half{ size(rng), size(rng), size(rng) };
+            box = { center - half, center + half };
+        }
+        return bounds;
+    }
+
+    /// @brief 主カメラと、シャドウのカスケード 3 段（平行投影で段毎に範囲を広げる）
+    std::vector<Cue::Frustum> make_cull_cameras()
+    {
+        std::vector<Cue::Frustum> frustums;
+        const Math::Float4x4 view = Math::look_at({ 0.0f, 30.0f, -50.0f }, { 0.0f, 0.0f, 100.0f }, { 0.0f, 1.0f, 0.0f });
+        frustums.push_back(Cue::make_frustum(view * Math::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f)));
+        const Math::Float4x4 lightView = Math::look_at({ 0.0f, 500.0f, 100.0f }, { 0.0f, 0.0f, 150.0f }, { 0.0f, 0.0f, 1.0f });
+        for (const float extent : { 100.0f, 300.0f, 900.0f })
+        {
+            frustums.push_back(Cue::make_frustum(lightView * Math::orthographic(extent, extent, 1.0f, 1000.0f)));
+        }
+        return frustums;
+    }
+
+    void culling_build_100k(State& state)
+    {
+        const std::vector<Cue::Aabb> bounds = make_cull_scene();
+        Cue::CullingBvh bvh;
+        while (state.keep_running())
+        {
+            if (!bvh.build(bounds))
+            {
+                state.set_error("CullingBvh build failed");
+            }
+        }
+    }
+
+    void culling_refit_100k_10pct(State& state)
+    {
+        // 1 割の物体が毎フレーム少しずつ動く想定（update と refit の合計）
+        const std::vector<Cue::Aabb> bounds = make_cull_scene();
+        Cue::CullingBvh bvh;
+        if (!bvh.build(bounds))
+        {
+            state.set_error("CullingBvh build failed");
+            return;
+        }
+        float offset = 0.0f;
+        while (state.keep_running())
+        {
+            offset = offset > 1.0f ? 0.0f : offset + 0.01f;
+            const Math::Float3 delta{ offset, 0.0f, offset };
+            for (uint32_t i = 0; i < k_cullObjectCount; i += 10)
+            {
+                bvh.update(i, { bounds[i].min + delta, bounds[i].max + delta });
+            }
+            bvh.refit();
+        }
+    }
+
+    void run_cull(State& state, Core::JobSystem* jobSystem)
+    {
+        Cue::CullingBvh bvh;
+        if (!bvh.build(make_cull_scene()))
+        {
+            state.set_error("CullingBvh build failed");
+            return;
+        }
+        const std::vector<Cue::Frustum> frustums = make_cull_cameras();
+        std::vector<std::vector<uint32_t>> visible(frustums.size());
+        while (state.keep_running())
+        {
+            if (!bvh.cull(frustums, visible, jobSystem))
+            {
+                state.set_error("CullingBvh cull failed");
+            }
+            Cue::Bench::do_not_optimize(visible[0].data());
+        }
+    }
+
+    void culling_cull_100k_4cameras(State& state)
+    {
+        run_cull(state, nullptr);
+    }
+
+    void culling_cull_100k_4cameras_parallel(State& state)
+    {
+        Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({}))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        run_cull(state, &jobSystem);
+        jobSystem.shutdown();
+    }
+
+    void culling_brute_force_100k_4cameras(State& state)
+    {
+        // BVH を使わず全ての箱を判定する基準
+        const std::vector<Cue::Aabb> bounds = make_cull_scene();
+        const std::vector<Cue::Frustum> frustums = make_cull_cameras();
+        std::vector<std::vector<uint32_t>> visible(frustums.size());
+        while (state.keep_running())
+        {
+            for (size_t c = 0; c < frustums.size(); ++c)
+            {
+                visible[c].clear();
+                for (uint32_t i = 0; i < k_cullObjectCount; ++i)
+                {
+                    if (Cue::is_visible(frustums[c], bounds[i]))
+                    {
+                        visible[c].push_back(i);
+                    }
+                }
+            }
+            Cue::Bench::do_not_optimize(visible[0].data());
+        }
+    }
+
+    CUE_BENCHMARK("Engine/Culling/build_100k", culling_build_100k);
+    CUE_BENCHMARK("Engine/Culling/refit_100k_10pct", culling_refit_100k_10pct);
+    CUE_BENCHMARK("Engine/Culling/cull_100k_4cameras", culling_cull_100k_4cameras);
+    CUE_BENCHMARK("Engine/Culling/cull_100k_4cameras_parallel", culling_cull_100k_4cameras_parallel);
+    CUE_BENCHMARK("Engine/Culling/brute_force_100k_4cameras", culling_brute_force_100k_4cameras);
+} // namespace
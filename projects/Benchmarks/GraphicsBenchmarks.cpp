@@ -0,0 +1,302 @@
+#include <CommandList.h>
+#include <DescriptorAllocator.h>
+#include <JobSystem.h>
+#include <RenderGraph.h>
+#include <ShaderCache.h>
+#include <UploadRing.h>
+#include <cstdio>
+#include <replay_queue.h>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    using Cue::Bench::State;
+    namespace Graphics = Cue::Graphics;
+
+    /// @brief G バッファ・SSAO・ライティング・ブルーム 4 段・トーンマップの 1 フレーム分を組む
+    void build_deferred_frame(Graphics::RenderGraph& graph)
+    {
+        const Graphics::TextureDesc full{ 1920, 1080, 1, 1, 1, Graphics::Format::RGBA8_UNORM };
+        const Graphics::ResourceHandle backBuffer = graph.import_texture("backbuffer", full,
+            Graphics::ResourceState::Present, Graphics::ResourceState::Present);
+        Graphics::ResourceHandle albedo, normal, depth, ao, hdr;
+        graph.add_pass("gbuffer", [&](Graphics::RenderGraphBuilder& b)
+            {
+                albedo = b.write(b.create_texture("albedo", full));
+                Graphics::TextureDesc n = full;
+                n.format = Graphics::Format::RGBA16_FLOAT;
+                normal = b.write(b.create_texture("normal", n));
+                Graphics::TextureDesc d = full;
+                d.format = Graphics::Format::D32_FLOAT;
+                depth = b.write(b.create_texture("depth", d), Graphics::ResourceState::DepthWrite);
+            }, {});
+        graph.add_pass("ssao", [&](Graphics::RenderGraphBuilder& b)
+            {
+                b.read(depth);
+                b.read(normal);
+                Graphics::TextureDesc a = full;
+                a.format = Graphics::Format::R8_UNORM;
+                ao = b.write(b.create_texture("ao", a), Graphics::ResourceState::UnorderedAccess);
+            }, {});
+        graph.add_pass("lighting", [&](Graphics::RenderGraphBuilder& b)
+            {
+                b.read(albedo);
+                b.read(normal);
+                b.read(depth);
+                b.read(ao);
+                Graphics::TextureDesc h = full;
+                h.format = Graphics::Format::RGBA16_FLOAT;
+                hdr = b.write(b.create_texture("hdr", h));
+            }, {});
+        Graphics::ResourceHandle previous = hdr;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            static constexpr const char* k_bloomNames[] = { "bloom0", "bloom1", "bloom2", "bloom3" };
+            graph.add_pass(k_bloomNames[i], [&](Graphics::RenderGraphBuilder& b)
+                {
+                    b.read(previous);
+                    const Graphics::TextureDesc h{ 1920u >> (i + 1), 1080u >> (i + 1), 1, 1, 1, Graphics::Format::RGBA16_FLOAT };
+                    previous = b.write(b.create_texture(k_bloomNames[i], h));
+                }, {});
+        }
+        graph.add_pass("tonemap", [&](Graphics::RenderGraphBuilder& b)
+            {
+                b.read(hdr);
+                b.read(previous);
+                b.write(backBuffer);
+            }, {});
+    }
+
+    void render_graph_compile(State& state)
+    {
+        Graphics::RenderGraph graph;
+        while (state.keep_running())
+        {
+            // 毎フレーム組み直す使い方（reset は確保済みの領域を使い回す）
+            graph.reset();
+            build_deferred_frame(graph);
+            if (!graph.compile())
+            {
+                state.set_error("RenderGraph compile failed");
+            }
+        }
+    }
+
+    void descriptor_allocate_transient(State& state)
+    {
+        Graphics::DescriptorAllocator allocator;
+        if (!allocator.initialize({}))
+        {
+            state.set_error("DescriptorAllocator initialize failed");
+            return;
+        }
+        // 1 フレーム 2000 回確保し、GPU は 2 フレーム遅れで追いつく想定で回す
+        uint64_t fence = 0;
+        uint32_t inFrame = 0;
+        allocator.begin_frame(0);
+        while (state.keep_running())
+        {
+            const Graphics::DescriptorRange range = allocator.allocate_transient(4);
+            Cue::Bench::do_not_optimize(range);
+            if (++inFrame == 2000)
+            {
+                inFrame = 0;
+                if (!allocator.end_frame(++fence))
+                {
+                    state.set_error("DescriptorAllocator end_frame failed");
+                }
+                allocator.begin_frame(fence >= 2 ? fence - 2 : 0);
+            }
+        }
+        (void)allocator.end_frame(++fence);
+    }
+
+    void upload_ring_allocate_256(State& state)
+    {
+        Graphics::HostUploadMemory memory;
+        Graphics::UploadRing ring;
+        Graphics::UploadRingDesc desc{};
+        desc.memory = &memory;
+        if (!ring.initialize(desc))
+        {
+            state.set_error("UploadRing initialize failed");
+            return;
+        }
+        uint64_t fence = 0;
+        uint32_t inFrame = 0;
+        while (state.keep_running())
+        {
+            const Graphics::UploadAllocation allocation = ring.allocate(256);
+            Cue::Bench::do_not_optimize(allocation.cpuAddress);
+            if (++inFrame == 4096)
+            {
+                inFrame = 0;
+                ring.end_frame(++fence);
+                ring.begin_frame(fence >= 2 ? fence - 2 : 0);
+            }
+        }
+        ring.shutdown();
+    }
+
+    void command_list_record_256_draws(State& state)
+    {
+        Graphics::CommandList list;
+        if (!list.initialize(1u << 20))
+        {
+            state.set_error("CommandList initialize failed");
+            return;
+        }
+        const uint32_t constants[4] = { 1, 2, 3, 4 };
+        while (state.keep_running())
+        {
+            list.begin(0);
+            list.set_pipeline(1);
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                list.set_constants(0, constants);
+                list.set_vertex_buffer(0, i, 0, 32);
+                list.draw(3, 1, i, 0);
+            }
+            if (!list.close())
+            {
+                state.set_error("CommandList close failed");
+            }
+        }
+    }
+
+    /// @brief 16384 回の描画を Threads 本のコマンドリストに分けて同時に記録する
+    /// @details 1 本を 1 ジョブが記録するので、スレッド数に対する記録の伸びが見える。
+    ///          全体のコマンド数/秒を件数として、1 スレッドあたりのコマンド数/秒を counters に出す。
+    template<uint32_t Threads>
+    void command_list_record_parallel(State& state)
+    {
+        constexpr uint32_t k_drawCount = 16384;
+        constexpr uint32_t k_drawsPerList = k_drawCount / Threads;
+        Cue::Core::JobSystem jobSystem;
+        if (!jobSystem.initialize({ Threads }))
+        {
+            state.set_error("JobSystem initialize failed");
+            return;
+        }
+        std::vector<Graphics::CommandList> lists(Threads);
+        for (Graphics::CommandList& list : lists)
+        {
+            if (!list.initialize(8u << 20))
+            {
+                state.set_error("CommandList initialize failed");
+                return;
+            }
+        }
+
+        struct RecordJob
+        {
+            Graphics::CommandList* list = nullptr;
+            uint32_t firstDraw = 0;
+            bool isClosed = false;
+        };
+        std::vector<RecordJob> jobs(Threads);
+        std::vector<Cue::Core::JobDecl> decls(Threads);
+        for (uint32_t i = 0; i < Threads; ++i)
+        {
+            jobs[i] = { &lists[i], i * k_drawsPerList, false };
+            decls[i] = { [](void* data)
+                {
+                    RecordJob* job = static_cast<RecordJob*>(data);
+                    const uint32_t constants[4] = { 1, 2, 3, 4 };
+                    Graphics::CommandList& list = *job->list;
+                    list.begin(job->firstDraw);
+                    list.set_pipeline(1);
+                    for (uint32_t d = job->firstDraw; d < job->firstDraw + k_drawsPerList; ++d)
+                    {
+                        list.set_constants(0, constants);
+                        list.set_vertex_buffer(0, d, 0, 32);
+                        list.draw(3, 1, d, 0);
+                    }
+                    job->isClosed = static_cast<bool>(list.close());
+                }, &jobs[i] };
+        }
+
+        uint64_t commandCount = 0;
+        while (state.keep_running())
+        {
+            Cue::Core::JobCounter counter;
+            jobSystem.run(decls.data(), Threads, &counter);
+            jobSystem.wait(counter);
+        }
+        for (uint32_t i = 0; i < Threads; ++i)
+        {
+            if (!jobs[i].isClosed)
+            {
+                state.set_error("CommandList close failed");
+            }
+            commandCount += lists[i].get_command_count();
+        }
+        state.set_items_per_iteration(commandCount);
+        const double elapsedNs = state.get_elapsed_ns();
+        if (elapsedNs > 0.0)
+        {
+            const double perSecond = static_cast<double>(commandCount * state.get_iterations()) * 1.0e9 / elapsedNs;
+            state.set_counter("commands_per_second_per_thread", perSecond / Threads);
+        }
+        jobSystem.shutdown();
+    }
+
+    void replay_queue_execute_256_draws(State& state)
+    {
+        Graphics::CommandList list;
+        if (!list.initialize(1u << 20))
+        {
+            state.set_error("CommandList initialize failed");
+            return;
+        }
+        const uint32_t constants[4] = { 1, 2, 3, 4 };
+        list.begin(0);
+        list.set_pipeline(1);
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            list.set_constants(0, constants);
+            list.set_vertex_buffer(0, i, 0, 32);
+            list.draw(3, 1, i, 0);
+        }
+        if (!list.close())
+        {
+            state.set_error("CommandList close failed");
+            return;
+        }
+        Graphics::Null::ReplayQueue queue;
+        const Graphics::CommandList* lists[] = { &list };
+        while (state.keep_running())
+        {
+            if (!queue.execute(lists))
+            {
+                state.set_error("ReplayQueue execute failed");
+            }
+        }
+    }
+
+    void shader_cache_make_key(State& state)
+    {
+        static constexpr char k_source[] =
+            "cbuffer Frame : register(b0) { float4x4 viewProjection; };\n"
+            "float4 main(float3 position : POSITION) : SV_Position { return mul(viewProjection, float4(position, 1)); }\n";
+        const Graphics::ShaderDefine defines[] = { { "USE_SKINNING", "1" }, { "MAX_LIGHTS", "16" } };
+        while (state.keep_running())
+        {
+            const Cue::Core::Sha256Digest key = Graphics::make_shader_cache_key({ k_source, defines, "main", "vs_6_6", "dxc-1.8" });
+            Cue::Bench::do_not_optimize(key);
+        }
+    }
+
+    CUE_BENCHMARK("Graphics/RenderGraph/build_compile_deferred", render_graph_compile);
+    CUE_BENCHMARK("Graphics/DescriptorAllocator/allocate_transient", descriptor_allocate_transient);
+    CUE_BENCHMARK("Graphics/UploadRing/allocate_256", upload_ring_allocate_256);
+    CUE_BENCHMARK("Graphics/CommandList/record_256_draws", command_list_record_256_draws);
+    CUE_BENCHMARK("Graphics/CommandList/record_16k_draws_threads_01", command_list_record_parallel<1>);
+    CUE_BENCHMARK("Graphics/CommandList/record_16k_draws_threads_02", command_list_record_parallel<2>);
+    CUE_BENCHMARK("Graphics/CommandList/record_16k_draws_threads_04", command_list_record_parallel<4>);
+    CUE_BENCHMARK("Graphics/CommandList/record_16k_draws_threads_08", command_list_record_parallel<8>);
+    CUE_BENCHMARK("Graphics/ReplayQueue/execute_256_draws", replay_queue_execute_256_draws);
+    CUE_BENCHMARK("Graphics/ShaderCache/make_key", shader_cache_make_key);
+} // namespace
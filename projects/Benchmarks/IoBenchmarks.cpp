@@ -0,0 +1,509 @@
+#include <AsyncIo.h>
+#include <BlobCache.h>
+#include <algorithm>
+#include <chrono>
+#include <Pak.h>
+#include <Sha256.h>
+#include <Vfs.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    using Cue::Bench::State;
+    namespace Core = Cue::Core;
+
+    constexpr uint32_t k_fileCount = 1024;
+    constexpr size_t k_bigFileBytes = 8u * 1024u * 1024u;
+    // 起動時に全シェーダーを引く想定の件数
+    constexpr uint32_t k_startupEntryCount = 4096;
+    // 深さ毎の読み込みで使うファイル群（合計 64MB）
+    constexpr uint32_t k_streamFileCount = 16;
+    constexpr size_t k_streamFileBytes = 4u * 1024u * 1024u;
+
+    std::vector<std::byte> make_payload(uint32_t seed, size_t size)
+    {
+        std::vector<std::byte> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<std::byte>((seed * 31u + i * 7u) & 0xFF);
+        }
+        return data;
+    }
+
+    Core::Sha256Digest make_key(uint32_t index)
+    {
+        const std::string text = "key" + std::to_string(index);
+        return Core::sha256(std::as_bytes(std::span(text.data(), text.size())));
+    }
+
+    std::string make_virtual_path(uint32_t index)
+    {
+        return "data/level" + std::to_string(index % 8) + "/file" + std::to_string(index) + ".bin";
+    }
+
+    bool write_file(const std::filesystem::path& path, std::span<const std::byte> data)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::FILE* file = std::fopen(path.string().c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+        const bool isOk = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        std::fclose(file);
+        return isOk;
+    }
+
+    /// @brief I/O の計測で共有する一時ファイル群（最初に使う時に 1 度だけ作り、終了時に消す）
+    struct IoFixture
+    {
+        std::filesystem::path root;
+        std::string pakPath;
+        std::string loosePath;
+        std::string bigFilePath;
+        std::string cachePath;
+        std::string startupCachePath;
+        bool isReady = false;
+
+        IoFixture()
+        {
+            // 1) 同時に走る別の実行とぶつからないよう、プロセス毎のディレクトリに作る
+            root = std::filesystem::temp_directory_path() / ("cue_benchmarks_" + std::to_string(getpid()));
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+            loosePath = (root / "loose").string();
+            pakPath = (root / "assets.pak").string();
+            bigFilePath = (root / "big.bin").string();
+            cachePath = (root / "cache.bin").string();
+            startupCachePath = (root / "startup_cache.bin").string();
+
+            // 2) 同じ内容をばらのファイルと pak の両方に置く
+            Core::PakWriter writer;
+            for (uint32_t i = 0; i < k_fileCount; ++i)
+            {
+                const std::vector<std::byte> data = make_payload(i, 1024 + (i % 13) * 256);
+                const std::string virtualPath = make_virtual_path(i);
+                if (!write_file(root / "loose" / virtualPath, data))
+                {
+                    return;
+                }
+                writer.add_data(virtualPath, data);
+            }
+            if (!writer.write(pakPath))
+            {
+                return;
+            }
+            if (!write_file(bigFilePath, make_payload(0, k_bigFileBytes)))
+            {
+                return;
+            }
+
+            // 3) キャッシュは温まった状態から測る
+            Core::BlobCache cache;
+            if (!cache.open({ cachePath, 1ull << 30 }))
+            {
+                return;
+            }
+            for (uint32_t i = 0; i < k_fileCount; ++i)
+            {
+                if (!cache.store(make_key(i), make_payload(i, 2000 + (i % 13) * 300)))
+                {
+                    return;
+                }
+            }
+
+            // 4) 起動の計測用に、数千件を持つ別のキャッシュを作る
+            Core::BlobCache startupCache;
+            if (!startupCache.open({ startupCachePath, 1ull << 30 }))
+            {
+                return;
+            }
+            for (uint32_t i = 0; i < k_startupEntryCount; ++i)
+            {
+                if (!startupCache.store(make_key(i), make_payload(i, 2000 + (i % 13) * 300)))
+                {
+                    return;
+                }
+            }
+            isReady = true;
+        }
+        ~IoFixture()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+    };
+
+    const IoFixture* get_fixture(State& state)
+    {
+        static const IoFixture fixture;
+        if (!fixture.isReady)
+        {
+            state.set_error("failed to create the I/O fixture in the temporary directory");
+            return nullptr;
+        }
+        return &fixture;
+    }
+
+    void run_vfs_open(State& state, bool isPak)
+    {
+        const IoFixture* fixture = get_fixture(state);
+        if (!fixture)
+        {
+            return;
+        }
+        Core::VirtualFileSystem vfs;
+        if (!(isPak ? vfs.mount_pak(fixture->pakPath) : vfs.mount_directory(fixture->loosePath)))
+        {
+            state.set_error("VirtualFileSystem mount failed");
+            return;
+        }
+        std::vector<std::string> paths;
+        for (uint32_t i = 0; i < k_fileCount; ++i)
+        {
+            paths.push_back(make_virtual_path(i));
+        }
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            Core::VfsFile file;
+            if (!vfs.open(paths[index++ & (k_fileCount - 1)], file))
+            {
+                state.set_error("VirtualFileSystem open failed");
+            }
+            Cue::Bench::do_not_optimize(file.get_data().data());
+        }
+    }
+
+    void vfs_open_pak(State& state)
+    {
+        run_vfs_open(state, true);
+    }
+    void vfs_open_loose(State& state)
+    {
+        run_vfs_open(state, false);
+    }
+
+    void async_io_read_64k(State& state)
+    {
+        const IoFixture* fixture = get_fixture(state);
+        if (!fixture)
+        {
+            return;
+        }
+        Core::AsyncIo io;
+        Core::IoFile file;
+        if (!io.initialize() || !io.open_file(fixture->bigFilePath, file))
+        {
+            state.set_error("AsyncIo setup failed");
+            return;
+        }
+
+        // 1) 1 要求の往復（発行から Polled の完了通知まで）を測る
+        constexpr uint64_t k_readBytes = 64 * 1024;
+        std::vector<std::byte> buffer(k_readBytes);
+        bool isDone = false;
+        Core::IoReadRequest request{};
+        request.file = file;
+        request.size = k_readBytes;
+        request.destination = buffer.data();
+        request.callback = [](const Core::IoCompletion& completion) { *static_cast<bool*>(completion.userData) = true; };
+        request.userData = &isDone;
+        state.set_bytes_per_iteration(k_readBytes);
+        uint64_t offset = 0;
+        while (state.keep_running())
+        {
+            isDone = false;
+            request.offset = offset;
+            offset = (offset + k_readBytes) % k_bigFileBytes;
+            Core::IoRequestId id = Core::k_invalidIoRequestId;
+            if (!io.read(request, id))
+            {
+                state.set_error("AsyncIo read failed");
+                break;
+            }
+            while (!isDone)
+            {
+                if (io.poll_completions() == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        io.close_file(file);
+        io.shutdown();
+    }
+
+    /// @brief 深さ毎の読み込みに使うファイル群（使う時に 1 度だけ作る。他の計測の準備を重くしない）
+    struct StreamFixture
+    {
+        std::filesystem::path root;
+        std::vector<std::string> paths;
+        bool isReady = false;
+
+        StreamFixture()
+        {
+            root = std::filesystem::temp_directory_path() / ("cue_benchmarks_stream_" + std::to_string(getpid()));
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+            for (uint32_t i = 0; i < k_streamFileCount; ++i)
+            {
+                paths.push_back((root / ("stream" + std::to_string(i) + ".bin")).string());
+                if (!write_file(paths.back(), make_payload(i, k_streamFileBytes)))
+                {
+                    return;
+                }
+            }
+            isReady = true;
+        }
+        ~StreamFixture()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+    };
+
+    /// @brief 深さ Depth を保って 64KB の読み込みを流し、帯域と要求毎の待ち時間を測る
+    /// @details 1 反復で k_requestCount 件を読む。完了した分だけ次を発行するので、常に Depth 件が未完了になる。
+    ///          待ち時間は read から Polled の完了通知までで、p50/p99 を counters に出す。
+    template<uint32_t Depth>
+    void async_io_read_queue_depth(State& state)
+    {
+        static const StreamFixture fixture;
+        if (!fixture.isReady)
+        {
+            state.set_error("failed to create the AsyncIo file set in the temporary directory");
+            return;
+        }
+        using Clock = std::chrono::steady_clock;
+        constexpr uint64_t k_readBytes = 64 * 1024;
+        constexpr uint32_t k_requestCount = 256;
+        constexpr uint64_t k_blocksPerFile = k_streamFileBytes / k_readBytes;
+
+        Core::AsyncIo io;
+        if (!io.initialize({ .maxQueueDepth = Depth }))
+        {
+            state.set_error("AsyncIo initialize failed");
+            return;
+        }
+        std::vector<Core::IoFile> files(k_streamFileCount);
+        for (uint32_t i = 0; i < k_streamFileCount; ++i)
+        {
+            if (!io.open_file(fixture.paths[i], files[i]))
+            {
+                state.set_error("AsyncIo open_file failed");
+                return;
+            }
+        }
+
+        // 1) 深さ分の読み込み先を用意し、空いたものから使い回す
+        struct Context;
+        struct Slot
+        {
+            std::vector<std::byte> buffer;
+            Clock::time_point start{};
+            Context* context = nullptr;
+        };
+        struct Context
+        {
+            std::vector<Slot*> freeSlots;
+            std::vector<double> latenciesUs;
+        };
+        Context context;
+        std::vector<Slot> slots(Depth);
+        for (Slot& slot : slots)
+        {
+            slot.buffer.resize(k_readBytes);
+            slot.context = &context;
+            context.freeSlots.push_back(&slot);
+        }
+
+        Core::IoReadRequest request{};
+        request.size = k_readBytes;
+        request.callback = [](const Core::IoCompletion& completion)
+            {
+                Slot* slot = static_cast<Slot*>(completion.userData);
+                slot->context->latenciesUs.push_back(
+                    std::chrono::duration<double, std::micro>(Clock::now() - slot->start).count());
+                slot->context->freeSlots.push_back(slot);
+            };
+        state.set_bytes_per_iteration(k_readBytes * k_requestCount);
+        uint64_t sequence = 0;
+        while (state.keep_running())
+        {
+            // 2) 空きがある限り発行し、無ければ完了を刈り取る
+            uint32_t issuedCount = 0;
+            while (issuedCount < k_requestCount || context.freeSlots.size() < Depth)
+            {
+                if (issuedCount < k_requestCount && !context.freeSlots.empty())
+                {
+                    Slot* slot = context.freeSlots.back();
+                    context.freeSlots.pop_back();
+                    // ファイルと位置を散らす（同じ区間を続けて読まない）
+                    const uint64_t block = (sequence++ * 2654435761u) % (k_streamFileCount * k_blocksPerFile);
+                    request.file = files[block / k_blocksPerFile];
+                    request.offset = (block % k_blocksPerFile) * k_readBytes;
+                    request.destination = slot->buffer.data();
+                    request.userData = slot;
+                    slot->start = Clock::now();
+                    Core::IoRequestId id = Core::k_invalidIoRequestId;
+                    if (!io.read(request, id))
+                    {
+                        state.set_error("AsyncIo read failed");
+                        break;
+                    }
+                    ++issuedCount;
+                    continue;
+                }
+                if (io.poll_completions() == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // 3) 待ち時間の分布はサンプル毎に出す（計測の外で並べ替える）
+        std::sort(context.latenciesUs.begin(), context.latenciesUs.end());
+        if (!context.latenciesUs.empty())
+        {
+            const size_t last = context.latenciesUs.size() - 1;
+            state.set_counter("p50_latency_us", context.latenciesUs[last / 2]);
+            state.set_counter("p99_latency_us", context.latenciesUs[last * 99 / 100]);
+        }
+        for (const Core::IoFile file : files)
+        {
+            io.close_file(file);
+        }
+        io.shutdown();
+    }
+
+    void blob_cache_find(State& state)
+    {
+        const IoFixture* fixture = get_fixture(state);
+        if (!fixture)
+        {
+            return;
+        }
+        Core::BlobCache cache;
+        if (!cache.open({ fixture->cachePath, 1ull << 30 }))
+        {
+            state.set_error("BlobCache open failed");
+            return;
+        }
+        std::vector<Core::Sha256Digest> keys;
+        for (uint32_t i = 0; i < k_fileCount; ++i)
+        {
+            keys.push_back(make_key(i));
+        }
+        std::vector<std::byte> payload;
+        uint32_t index = 0;
+        while (state.keep_running())
+        {
+            if (!cache.find(keys[index++ & (k_fileCount - 1)], payload))
+            {
+                state.set_error("BlobCache find missed a stored key");
+            }
+        }
+    }
+
+    void blob_cache_open_1k(State& state)
+    {
+        const IoFixture* fixture = get_fixture(state);
+        if (!fixture)
+        {
+            return;
+        }
+        while (state.keep_running())
+        {
+            Core::BlobCache cache;
+            if (!cache.open({ fixture->cachePath, 1ull << 30 }))
+            {
+                state.set_error("BlobCache open failed");
+            }
+        }
+    }
+
+    /// @brief OS のページキャッシュからファイルを追い出す（root 権限なしで冷えた読み込みを再現する）
+    bool evict_page_cache(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        const bool isOk = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        ::close(fd);
+        return isOk;
+    }
+
+    /// @brief 起動時の流れ（開いて索引を作り、全件を引く）を測る
+    void run_blob_cache_startup(State& state, bool isCold)
+    {
+        const IoFixture* fixture = get_fixture(state);
+        if (!fixture)
+        {
+            return;
+        }
+        std::vector<Core::Sha256Digest> keys;
+        for (uint32_t i = 0; i < k_startupEntryCount; ++i)
+        {
+            keys.push_back(make_key(i));
+        }
+        std::vector<std::byte> payload;
+        while (state.keep_running())
+        {
+            if (isCold)
+            {
+                state.pause_timing();
+                if (!evict_page_cache(fixture->startupCachePath))
+                {
+                    state.set_error("posix_fadvise failed to evict the cache file");
+                }
+                state.resume_timing();
+            }
+            Core::BlobCache cache;
+            if (!cache.open({ fixture->startupCachePath, 1ull << 30 }))
+            {
+                state.set_error("BlobCache open failed");
+                break;
+            }
+            for (const Core::Sha256Digest& key : keys)
+            {
+                if (!cache.find(key, payload))
+                {
+                    state.set_error("BlobCache find missed a stored key");
+                    break;
+                }
+            }
+        }
+    }
+
+    void blob_cache_startup_cold(State& state)
+    {
+        run_blob_cache_startup(state, true);
+    }
+    void blob_cache_startup_warm(State& state)
+    {
+        run_blob_cache_startup(state, false);
+    }
+
+    CUE_BENCHMARK("Core/Vfs/open_pak", vfs_open_pak);
+    CUE_BENCHMARK("Core/Vfs/open_loose", vfs_open_loose);
+    CUE_BENCHMARK("Core/AsyncIo/read_64k_roundtrip", async_io_read_64k);
+    CUE_BENCHMARK("Core/AsyncIo/read_64k_qd1", async_io_read_queue_depth<1>);
+    CUE_BENCHMARK("Core/AsyncIo/read_64k_qd4", async_io_read_queue_depth<4>);
+    CUE_BENCHMARK("Core/AsyncIo/read_64k_qd16", async_io_read_queue_depth<16>);
+    CUE_BENCHMARK("Core/AsyncIo/read_64k_qd64", async_io_read_queue_depth<64>);
+    CUE_BENCHMARK("Core/BlobCache/find_warm", blob_cache_find);
+    CUE_BENCHMARK("Core/BlobCache/open_1k_entries", blob_cache_open_1k);
+    CUE_BENCHMARK("Core/BlobCache/startup_cold_4k_entries", blob_cache_startup_cold);
+    CUE_BENCHMARK("Core/BlobCache/startup_warm_4k_entries", blob_cache_startup_warm);
+} // namespace
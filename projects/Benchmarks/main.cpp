@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        Cue::Bench::RunOptions run{};
+        Cue::Bench::CompareOptions compare{};
+        const char* jsonPath = nullptr;
+        // 両方指定されたら計測せずに比べる
+        const char* baselinePath = nullptr;
+        const char* currentPath = nullptr;
+        bool isListOnly = false;
+    };
+
+    void print_usage()
+    {
+        std::fprintf(stderr,
+            "usage: cue_benchmarks [--filter text] [--samples N] [--min-time-ms X] [--json path] [--list] [--large]\n"
+            "       cue_benchmarks --compare baseline.json current.json [--threshold 0.10] [--min-delta-ns X]\n");
+    }
+
+    bool parse_options(int argc, char** argv, BenchmarkOptions& options)
+    {
+        // 1) 引数は "--name value" 形式のみ受け付ける（--compare だけ値を 2 つ取る）
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool hasValue = (i + 1) < argc;
+            if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            {
+                options.run.filter = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+            {
+                options.run.sampleCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--min-time-ms") == 0 && hasValue)
+            {
+                options.run.minSampleMs = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+            {
+                options.jsonPath = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--list") == 0)
+            {
+                options.isListOnly = true;
+            }
+            else if (std::strcmp(argv[i], "--large") == 0)
+            {
+                options.run.isLargeEnabled = true;
+            }
+            else if (std::strcmp(argv[i], "--compare") == 0 && (i + 2) < argc)
+            {
+                options.baselinePath = argv[++i];
+                options.currentPath = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+            {
+                options.compare.threshold = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--min-delta-ns") == 0 && hasValue)
+            {
+                options.compare.minDeltaNs = std::strtod(argv[++i], nullptr);
+            }
+            else
+            {
+                print_usage();
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// Core / Engine / GraphicsCore のマイクロベンチマークを回し、中央値と p99 を JSON に残す。
+// --compare で 2 回分の JSON を比べ、閾値を超えて遅くなった計測があれば失敗で終わる。
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parse_options(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // 1) 比較だけなら計測しない
+    if (options.baselinePath)
+    {
+        std::vector<Cue::Bench::BenchmarkResult> baseline;
+        std::vector<Cue::Bench::BenchmarkResult> current;
+        if (!Cue::Bench::read_json(options.baselinePath, baseline) || !Cue::Bench::read_json(options.currentPath, current))
+        {
+            return EXIT_FAILURE;
+        }
+        return Cue::Bench::compare_results(baseline, current, options.compare) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (options.isListOnly)
+    {
+        Cue::Bench::list_benchmarks(options.run.filter);
+        return EXIT_SUCCESS;
+    }
+
+    // 2) 計測して結果を書き出す（計測できなかったものがあっても残りは書く）
+    std::vector<Cue::Bench::BenchmarkResult> results;
+    const bool isAllOk = Cue::Bench::run_benchmarks(options.run, results);
+    if (options.jsonPath && !Cue::Bench::write_json(options.jsonPath, options.run, results))
+    {
+        return EXIT_FAILURE;
+    }
+    return isAllOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,731 @@
+#include "AsyncIo.h"
+#include "IoBackend.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Cue::Core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // パスを終端付きで写すための上限（動的確保を避ける）
+        constexpr size_t k_maxPath = 1024;
+        // 1 回の読み込みの上限（大きな要求は分けて発行し、帯域の上限を細かく効かせる）
+        constexpr uint64_t k_maxOperationSize = 8ull * 1024 * 1024;
+        // io_uring は後から深さを上げられるよう、この数以上のリングで作る
+        constexpr uint32_t k_minRingEntries = 256;
+        // 帯域の上限を超えて溜められる量（秒あたりの上限に対する割合）
+        constexpr double k_burstSeconds = 0.05;
+        constexpr uint32_t k_invalidSlot = 0xFFFFFFFFu;
+
+        enum class RequestState : uint8_t
+        {
+            Free,
+            Pending,
+            InFlight,
+        };
+
+        struct Request
+        {
+            IoReadRequest desc{};
+            Detail::NativeFile native{};
+            // ファイル末尾で切り詰めた大きさ
+            uint64_t expected = 0;
+            uint64_t transferred = 0;
+            uint32_t generation = 1;
+            // 優先度毎の待ち行列の前後（途中の取り消しを O(1) にする）
+            uint32_t prev = k_invalidSlot;
+            uint32_t next = k_invalidSlot;
+            RequestState state = RequestState::Free;
+        };
+
+        struct FileEntry
+        {
+            Detail::NativeFile native{};
+            uint64_t size = 0;
+            uint32_t generation = 1;
+            bool isOpen = false;
+        };
+
+        struct Finished
+        {
+            IoCompletion completion{};
+            IoCallback callback = nullptr;
+            IoDelivery delivery = IoDelivery::Polled;
+        };
+
+        constexpr IoRequestId make_id(uint32_t slot, uint32_t generation) noexcept
+        {
+            return (static_cast<uint64_t>(generation) << 32) | slot;
+        }
+
+        void close_native(Detail::NativeFile native) noexcept
+        {
+#if defined(_WIN32)
+            ::CloseHandle(native);
+#else
+            ::close(native);
+#endif
+        }
+    } // namespace
+
+    struct AsyncIo::Impl
+    {
+        std::unique_ptr<Detail::IoBackend> backend;
+        IoBackendType backendType = IoBackendType::Auto;
+        std::thread ioThread;
+        bool isInitialized = false;
+
+        // 要求・ファイル・上限はこのロックで守る（I/O スレッドは発行と刈り取りの間だけ取る）
+        mutable std::mutex mutex;
+        std::vector<Request> slots;
+        std::vector<uint32_t> freeSlots;
+        uint32_t queueHeads[static_cast<size_t>(IoPriority::Count)]{};
+        uint32_t queueTails[static_cast<size_t>(IoPriority::Count)]{};
+        std::vector<FileEntry> files;
+        std::vector<uint32_t> freeFiles;
+        uint32_t maxQueueDepth = 0;
+        uint64_t maxBytesPerSecond = 0;
+        double tokens = 0.0;
+        Clock::time_point lastRefill{};
+        // I/O スレッドが次の発行を見直す前に起こし済みなら、重ねて起こさない
+        bool isWakePending = false;
+        bool isStopping = false;
+        AsyncIoStats stats{};
+        // 呼び出し側で取り消した要求の完了（I/O スレッドが delivery に従って配る）
+        std::vector<Finished> cancelled;
+
+        // Polled の完了通知
+        std::mutex completionMutex;
+        std::deque<Finished> completions;
+
+        void link_back(uint32_t slot) noexcept
+        {
+            Request& request = slots[slot];
+            const size_t priority = static_cast<size_t>(request.desc.priority);
+            request.prev = queueTails[priority];
+            request.next = k_invalidSlot;
+            if (request.prev != k_invalidSlot)
+            {
+                slots[request.prev].next = slot;
+            }
+            else
+            {
+                queueHeads[priority] = slot;
+            }
+            queueTails[priority] = slot;
+            request.state = RequestState::Pending;
+            ++stats.pendingCount;
+        }
+
+        void link_front(uint32_t slot) noexcept
+        {
+            Request& request = slots[slot];
+            const size_t priority = static_cast<size_t>(request.desc.priority);
+            request.prev = k_invalidSlot;
+            request.next = queueHeads[priority];
+            if (request.next != k_invalidSlot)
+            {
+                slots[request.next].prev = slot;
+            }
+            else
+            {
+                queueTails[priority] = slot;
+            }
+            queueHeads[priority] = slot;
+            request.state = RequestState::Pending;
+            ++stats.pendingCount;
+        }
+
+        void unlink(uint32_t slot) noexcept
+        {
+            Request& request = slots[slot];
+            const size_t priority = static_cast<size_t>(request.desc.priority);
+            if (request.prev != k_invalidSlot)
+            {
+                slots[request.prev].next = request.next;
+            }
+            else
+            {
+                queueHeads[priority] = request.next;
+            }
+            if (request.next != k_invalidSlot)
+            {
+                slots[request.next].prev = request.prev;
+            }
+            else
+            {
+                queueTails[priority] = request.prev;
+            }
+            request.prev = k_invalidSlot;
+            request.next = k_invalidSlot;
+            --stats.pendingCount;
+        }
+
+        uint32_t front() const noexcept
+        {
+            for (uint32_t head : queueHeads)
+            {
+                if (head != k_invalidSlot)
+                {
+                    return head;
+                }
+            }
+            return k_invalidSlot;
+        }
+
+        /// @brief 要求を終えてスロットを返す（通知は呼び出し側がロックの外で配る）
+        void finish(uint32_t slot, const Result& result, std::vector<Finished>& out)
+        {
+            Request& request = slots[slot];
+            Finished finished{};
+            finished.completion.id = make_id(slot, request.generation);
+            finished.completion.result = result;
+            finished.completion.bytesRead = request.transferred;
+            finished.completion.userData = request.desc.userData;
+            finished.callback = request.desc.callback;
+            finished.delivery = request.desc.delivery;
+            out.push_back(finished);
+
+            if (result)
+            {
+                ++stats.completedCount;
+                stats.bytesRead += request.transferred;
+            }
+            else if (result.get_code() == Code::Cancelled)
+            {
+                ++stats.cancelledCount;
+            }
+            else
+            {
+                ++stats.failedCount;
+            }
+
+            // 世代を進めて古い識別子での取り消しを弾く（0 は無効な識別子になるので飛ばす）
+            request.generation = request.generation + 1 == 0 ? 1 : request.generation + 1;
+            request.state = RequestState::Free;
+            freeSlots.push_back(slot);
+        }
+
+        void deliver(std::vector<Finished>& finished)
+        {
+            // 1) I/O スレッドで呼ぶものはその場で、残りは poll_completions まで預かる
+            bool hasPolled = false;
+            for (const Finished& f : finished)
+            {
+                if (!f.callback)
+                {
+                    continue;
+                }
+                if (f.delivery == IoDelivery::IoThread)
+                {
+                    f.callback(f.completion);
+                }
+                else
+                {
+                    hasPolled = true;
+                }
+            }
+            if (hasPolled)
+            {
+                std::lock_guard lock(completionMutex);
+                for (const Finished& f : finished)
+                {
+                    if (f.callback && f.delivery == IoDelivery::Polled)
+                    {
+                        completions.push_back(f);
+                    }
+                }
+            }
+            finished.clear();
+        }
+
+        void refill_tokens(Clock::time_point now) noexcept
+        {
+            if (maxBytesPerSecond == 0)
+            {
+                return;
+            }
+            const double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+            lastRefill = now;
+            const double rate = static_cast<double>(maxBytesPerSecond);
+            tokens = std::min(tokens + elapsed * rate, rate * k_burstSeconds);
+        }
+
+        void io_thread_main()
+        {
+            set_thread_memory_tag(Facility::IO);
+            std::vector<Detail::IoOperation> batch;
+            std::vector<Detail::IoOperationResult> results;
+            std::vector<Finished> finished;
+
+            for (;;)
+            {
+                // 1) 深さと帯域の上限の中で、優先度の高い順に発行する読み込みを集める
+                int64_t timeoutNs = -1;
+                bool isDone = false;
+                {
+                    std::lock_guard lock(mutex);
+                    isWakePending = false;
+                    // 取り消された完了を引き取り、IoThread 指定のものもこのスレッドで呼ぶ
+                    finished.insert(finished.end(), cancelled.begin(), cancelled.end());
+                    cancelled.clear();
+                    // 止める時も、引き取った完了を配ってから抜ける（待ち行列は空なので下は何も発行しない）
+                    isDone = isStopping && stats.inFlightCount == 0 && stats.pendingCount == 0;
+                    refill_tokens(Clock::now());
+                    while (stats.inFlightCount < maxQueueDepth)
+                    {
+                        const uint32_t slot = front();
+                        if (slot == k_invalidSlot)
+                        {
+                            break;
+                        }
+                        Request& request = slots[slot];
+                        if (request.transferred >= request.expected)
+                        {
+                            // ファイル末尾より後ろを指す要求は読まずに終える
+                            unlink(slot);
+                            finish(slot, Result::ok(), finished);
+                            continue;
+                        }
+                        if (maxBytesPerSecond != 0 && tokens <= 0.0)
+                        {
+                            // 足りない分が溜まる頃に起きる
+                            timeoutNs = static_cast<int64_t>((1.0 - tokens) * 1e9 / static_cast<double>(maxBytesPerSecond));
+                            break;
+                        }
+                        const uint64_t size = std::min(request.expected - request.transferred, k_maxOperationSize);
+                        tokens -= static_cast<double>(size);
+                        unlink(slot);
+                        request.state = RequestState::InFlight;
+                        ++stats.inFlightCount;
+
+                        Detail::IoOperation operation{};
+                        operation.slot = slot;
+                        operation.file = request.native;
+                        operation.offset = request.desc.offset + request.transferred;
+                        operation.size = static_cast<uint32_t>(size);
+                        operation.destination = static_cast<std::byte*>(request.desc.destination) + request.transferred;
+                        batch.push_back(operation);
+                    }
+                }
+                deliver(finished);
+                if (isDone)
+                {
+                    break;
+                }
+
+                // 2) まとめて発行し、完了か起床か帯域の回復まで待つ
+                backend->submit(batch);
+                batch.clear();
+                backend->wait(results, timeoutNs);
+
+                // 3) 完了を反映する（途中までしか読めなかったものは続きを先頭に積み直す）
+                {
+                    std::lock_guard lock(mutex);
+                    for (const Detail::IoOperationResult& result : results)
+                    {
+                        Request& request = slots[result.slot];
+                        --stats.inFlightCount;
+                        if (result.error != 0)
+                        {
+                            finish(result.slot, Result::fail(Facility::IO, Code::IoError, Severity::Error, result.error,
+                                "AsyncIo read failed."), finished);
+                            continue;
+                        }
+                        request.transferred += result.bytesRead;
+                        if (result.bytesRead == 0 || request.transferred >= request.expected)
+                        {
+                            finish(result.slot, Result::ok(), finished);
+                        }
+                        else
+                        {
+                            link_front(result.slot);
+                        }
+                    }
+                }
+                results.clear();
+                deliver(finished);
+            }
+        }
+    };
+
+    AsyncIo::AsyncIo()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    AsyncIo::~AsyncIo()
+    {
+        shutdown();
+    }
+
+    Result AsyncIo::initialize(const AsyncIoDesc& desc)
+    {
+        Impl& impl = *m_impl;
+        if (impl.isInitialized)
+        {
+            return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "AsyncIo is already initialized.");
+        }
+
+        // 1) バックエンドを選ぶ（io_uring が作れなければスレッドプールへ落とす）
+#if defined(__linux__)
+        if (desc.backend == IoBackendType::Auto || desc.backend == IoBackendType::IoUring)
+        {
+            impl.backend = Detail::create_io_uring_backend(std::max(desc.maxQueueDepth, k_minRingEntries));
+            impl.backendType = IoBackendType::IoUring;
+        }
+#endif
+        if (!impl.backend)
+        {
+            if (desc.backend == IoBackendType::IoUring)
+            {
+                return Result::fail(Facility::IO, Code::Unsupported, Severity::Error, 0,
+                    "AsyncIo io_uring backend is not available.");
+            }
+            impl.backend = Detail::create_thread_pool_backend(desc.threadCount);
+            impl.backendType = IoBackendType::ThreadPool;
+        }
+
+        // 2) 待ち行列と上限を整えて I/O スレッドを起動する
+        for (size_t i = 0; i < static_cast<size_t>(IoPriority::Count); ++i)
+        {
+            impl.queueHeads[i] = k_invalidSlot;
+            impl.queueTails[i] = k_invalidSlot;
+        }
+        impl.isStopping = false;
+        impl.isWakePending = false;
+        impl.stats = AsyncIoStats{};
+        impl.isInitialized = true;
+        set_limits(desc.maxQueueDepth, desc.maxBytesPerSecond);
+        impl.ioThread = std::thread([&impl]()
+        {
+            impl.io_thread_main();
+        });
+        return Result::ok();
+    }
+
+    void AsyncIo::shutdown()
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isInitialized)
+        {
+            return;
+        }
+
+        // 1) 未発行の要求を取り消し、発行済みのものが終わるのを待つ（取り消しの通知は I/O スレッドが配る）
+        {
+            std::lock_guard lock(impl.mutex);
+            impl.isStopping = true;
+            for (uint32_t slot = impl.front(); slot != k_invalidSlot; slot = impl.front())
+            {
+                impl.unlink(slot);
+                impl.finish(slot, Result::fail(Facility::IO, Code::Cancelled, Severity::Info, 0,
+                    "AsyncIo request was cancelled by shutdown."), impl.cancelled);
+            }
+        }
+        impl.backend->wake();
+        impl.ioThread.join();
+        impl.backend.reset();
+
+        // 2) 受け取られていない完了をここで通知し、ファイルを閉じる
+        poll_completions();
+        for (FileEntry& file : impl.files)
+        {
+            if (file.isOpen)
+            {
+                close_native(file.native);
+            }
+        }
+        impl.files.clear();
+        impl.freeFiles.clear();
+        impl.slots.clear();
+        impl.freeSlots.clear();
+        impl.isInitialized = false;
+    }
+
+    Result AsyncIo::open_file(std::string_view path, IoFile& outFile)
+    {
+        Impl& impl = *m_impl;
+        outFile = IoFile{};
+        if (!impl.isInitialized)
+        {
+            return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "AsyncIo is not initialized.");
+        }
+        if (path.empty() || path.size() >= k_maxPath)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "AsyncIo path is invalid.");
+        }
+
+        // 1) ファイルを開いて大きさを取る
+        FileEntry entry{};
+#if defined(_WIN32)
+        wchar_t widePath[k_maxPath];
+        const int length = ::MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()),
+            widePath, static_cast<int>(k_maxPath - 1));
+        if (length <= 0)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, ::GetLastError(),
+                "AsyncIo path is not valid UTF-8.");
+        }
+        widePath[length] = L'\0';
+        HANDLE file = ::CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            const DWORD error = ::GetLastError();
+            return Result::fail(Facility::IO,
+                error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND ? Code::NotFound : Code::IoError,
+                Severity::Error, error, "AsyncIo failed to open the file.");
+        }
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size))
+        {
+            const DWORD error = ::GetLastError();
+            ::CloseHandle(file);
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, error, "AsyncIo failed to get the size.");
+        }
+        entry.native = file;
+        entry.size = static_cast<uint64_t>(size.QuadPart);
+#else
+        char terminated[k_maxPath];
+        path.copy(terminated, path.size());
+        terminated[path.size()] = '\0';
+        const int fd = ::open(terminated, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            const int error = errno;
+            return Result::fail(Facility::IO, error == ENOENT ? Code::NotFound : Code::IoError, Severity::Error,
+                static_cast<uint32_t>(error), "AsyncIo failed to open the file.");
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, static_cast<uint32_t>(error),
+                "AsyncIo failed to get the size.");
+        }
+        entry.native = fd;
+        entry.size = static_cast<uint64_t>(st.st_size);
+#endif
+        entry.isOpen = true;
+
+        // 2) ファイル表に登録する
+        std::lock_guard lock(impl.mutex);
+        uint32_t index = 0;
+        if (!impl.freeFiles.empty())
+        {
+            index = impl.freeFiles.back();
+            impl.freeFiles.pop_back();
+            entry.generation = impl.files[index].generation;
+            impl.files[index] = entry;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(impl.files.size());
+            impl.files.push_back(entry);
+        }
+        outFile.index = index;
+        outFile.generation = entry.generation;
+        return Result::ok();
+    }
+
+    void AsyncIo::close_file(IoFile file)
+    {
+        Impl& impl = *m_impl;
+        std::lock_guard lock(impl.mutex);
+        if (!file.is_valid() || file.index >= impl.files.size())
+        {
+            return;
+        }
+        FileEntry& entry = impl.files[file.index];
+        if (!entry.isOpen || entry.generation != file.generation)
+        {
+            return;
+        }
+        close_native(entry.native);
+        entry.isOpen = false;
+        ++entry.generation;
+        impl.freeFiles.push_back(file.index);
+    }
+
+    uint64_t AsyncIo::get_file_size(IoFile file) const noexcept
+    {
+        const Impl& impl = *m_impl;
+        std::lock_guard lock(impl.mutex);
+        if (!file.is_valid() || file.index >= impl.files.size())
+        {
+            return 0;
+        }
+        const FileEntry& entry = impl.files[file.index];
+        return entry.isOpen && entry.generation == file.generation ? entry.size : 0;
+    }
+
+    Result AsyncIo::read(const IoReadRequest& request, IoRequestId& outId)
+    {
+        Impl& impl = *m_impl;
+        outId = k_invalidIoRequestId;
+        if (!request.destination || request.size == 0 || request.priority >= IoPriority::Count)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "AsyncIo read request is invalid.");
+        }
+
+        bool shouldWake = false;
+        {
+            std::lock_guard lock(impl.mutex);
+            if (!impl.isInitialized || impl.isStopping)
+            {
+                return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "AsyncIo is not running.");
+            }
+            if (!request.file.is_valid() || request.file.index >= impl.files.size()
+                || !impl.files[request.file.index].isOpen
+                || impl.files[request.file.index].generation != request.file.generation)
+            {
+                return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "AsyncIo file is not open.");
+            }
+            const FileEntry& file = impl.files[request.file.index];
+
+            // 1) スロットを取り、末尾で切り詰めた大きさを決める
+            uint32_t slot = 0;
+            if (!impl.freeSlots.empty())
+            {
+                slot = impl.freeSlots.back();
+                impl.freeSlots.pop_back();
+            }
+            else
+            {
+                slot = static_cast<uint32_t>(impl.slots.size());
+                impl.slots.emplace_back();
+            }
+            Request& entry = impl.slots[slot];
+            entry.desc = request;
+            entry.native = file.native;
+            entry.expected = request.offset >= file.size ? 0 : std::min(request.size, file.size - request.offset);
+            entry.transferred = 0;
+
+            // 2) 待ち行列の末尾に積み、I/O スレッドに発行の余地があれば起こす
+            impl.link_back(slot);
+            ++impl.stats.submittedCount;
+            outId = make_id(slot, entry.generation);
+            if (!impl.isWakePending && impl.stats.inFlightCount < impl.maxQueueDepth)
+            {
+                impl.isWakePending = true;
+                shouldWake = true;
+            }
+        }
+        if (shouldWake)
+        {
+            impl.backend->wake();
+        }
+        return Result::ok();
+    }
+
+    bool AsyncIo::cancel(IoRequestId id)
+    {
+        Impl& impl = *m_impl;
+        const uint32_t slot = static_cast<uint32_t>(id);
+        const uint32_t generation = static_cast<uint32_t>(id >> 32);
+        bool shouldWake = false;
+        {
+            std::lock_guard lock(impl.mutex);
+            if (slot >= impl.slots.size())
+            {
+                return false;
+            }
+            Request& request = impl.slots[slot];
+            if (request.generation != generation || request.state != RequestState::Pending)
+            {
+                return false;
+            }
+            // 1) 完了は I/O スレッドに預け、delivery で指定したスレッドから通知させる
+            impl.unlink(slot);
+            impl.finish(slot, Result::fail(Facility::IO, Code::Cancelled, Severity::Info, 0,
+                "AsyncIo request was cancelled."), impl.cancelled);
+            if (!impl.isWakePending)
+            {
+                impl.isWakePending = true;
+                shouldWake = true;
+            }
+        }
+        if (shouldWake)
+        {
+            impl.backend->wake();
+        }
+        return true;
+    }
+
+    uint32_t AsyncIo::poll_completions(uint32_t maxCount)
+    {
+        Impl& impl = *m_impl;
+
+        // 1) ロック中は手元へ取り出すだけにし、コールバックはロックの外で呼ぶ（複数のスレッドが同時に呼んでもよい）
+        std::vector<Finished> polling;
+        {
+            std::lock_guard lock(impl.completionMutex);
+            const size_t count = std::min<size_t>(maxCount, impl.completions.size());
+            if (count == 0)
+            {
+                return 0;
+            }
+            polling.assign(impl.completions.begin(), impl.completions.begin() + static_cast<ptrdiff_t>(count));
+            impl.completions.erase(impl.completions.begin(), impl.completions.begin() + static_cast<ptrdiff_t>(count));
+        }
+        for (const Finished& f : polling)
+        {
+            f.callback(f.completion);
+        }
+        return static_cast<uint32_t>(polling.size());
+    }
+
+    void AsyncIo::set_limits(uint32_t maxQueueDepth, uint64_t maxBytesPerSecond)
+    {
+        Impl& impl = *m_impl;
+        {
+            std::lock_guard lock(impl.mutex);
+            if (!impl.isInitialized)
+            {
+                return;
+            }
+            impl.maxQueueDepth = std::clamp(maxQueueDepth, 1u, impl.backend->get_max_queue_depth());
+            if (impl.maxBytesPerSecond != maxBytesPerSecond)
+            {
+                // 上限を変えたら溜まっていた分を捨てて測り直す
+                impl.maxBytesPerSecond = maxBytesPerSecond;
+                impl.tokens = 0.0;
+                impl.lastRefill = Clock::now();
+            }
+        }
+        impl.backend->wake();
+    }
+
+    AsyncIoStats AsyncIo::get_stats() const noexcept
+    {
+        std::lock_guard lock(m_impl->mutex);
+        return m_impl->stats;
+    }
+
+    IoBackendType AsyncIo::get_backend_type() const noexcept
+    {
+        return m_impl->backendType;
+    }
+} // namespace Cue::Core
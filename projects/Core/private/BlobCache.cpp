@@ -0,0 +1,954 @@
+#include "BlobCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // "CBLC"
+        constexpr uint32_t k_fileMagic = 0x434C4243u;
+        constexpr uint32_t k_fileVersion = 1;
+        // "CREC"
+        constexpr uint32_t k_recordMagic = 0x43455243u;
+        // 記録の先頭アライメント（ヘッダをそのまま写し取れるように）
+        constexpr uint64_t k_recordAlignment = 16;
+        // 追記で毎回マップし直さないよう、ファイルより大きく予約する単位（POSIX のみ）
+        constexpr uint64_t k_minMappingCapacity = 1ull * 1024 * 1024;
+
+        struct FileHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t reserved[3];
+        };
+
+        struct RecordHeader
+        {
+            uint32_t magic;
+            uint32_t payloadSize;
+            uint64_t payloadChecksum;
+            Sha256Digest key;
+            // ここより前のフィールドの検査値
+            uint64_t headerChecksum;
+            uint64_t reserved;
+        };
+
+        static_assert(sizeof(FileHeader) == 32 && sizeof(RecordHeader) == 64, "cache layout must not change silently.");
+
+        constexpr uint64_t align_up(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        /// @brief 書きかけや壊れた内容を見分けるための検査値（8 バイトずつ混ぜる）
+        uint64_t checksum64(const std::byte* data, size_t size) noexcept
+        {
+            uint64_t h = 14695981039346656037ull;
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                h = (h ^ word) * 1099511628211ull;
+                h ^= h >> 29;
+            }
+            for (; i < size; ++i)
+            {
+                h = (h ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+            }
+            return h;
+        }
+
+        uint64_t header_checksum(const RecordHeader& header) noexcept
+        {
+            return checksum64(reinterpret_cast<const std::byte*>(&header), offsetof(RecordHeader, headerChecksum));
+        }
+
+        uint64_t get_record_size(uint32_t payloadSize) noexcept
+        {
+            return align_up(sizeof(RecordHeader) + payloadSize, k_recordAlignment);
+        }
+
+        struct DigestHash
+        {
+            size_t operator()(const Sha256Digest& digest) const noexcept
+            {
+                return static_cast<size_t>(digest.get_prefix());
+            }
+        };
+
+        // ファイルの同一性（詰め直しで置き換えられたかを調べる）
+        struct FileIdentity
+        {
+            uint64_t volume = 0;
+            uint64_t index = 0;
+
+            bool operator==(const FileIdentity&) const noexcept = default;
+        };
+
+#if defined(_WIN32)
+        using FileHandle = HANDLE;
+        const FileHandle k_invalidFile = INVALID_HANDLE_VALUE;
+
+        constexpr size_t k_maxPath = 1024;
+
+        bool to_wide(const std::string& path, wchar_t (&out)[k_maxPath]) noexcept
+        {
+            const int length = ::MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()),
+                out, static_cast<int>(k_maxPath - 1));
+            if (length <= 0)
+            {
+                return false;
+            }
+            out[length] = L'\0';
+            return true;
+        }
+
+        FileHandle open_file(const std::string& path, bool isTruncated) noexcept
+        {
+            wchar_t widePath[k_maxPath];
+            if (!to_wide(path, widePath))
+            {
+                return k_invalidFile;
+            }
+            // 他のプロセスが詰め直しで置き換えられるよう、削除の共有も許す
+            return ::CreateFileW(widePath, GENERIC_READ | GENERIC_WRITE,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                isTruncated ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        }
+
+        void close_file(FileHandle file) noexcept
+        {
+            ::CloseHandle(file);
+        }
+
+        bool get_file_size(FileHandle file, uint64_t& outSize) noexcept
+        {
+            LARGE_INTEGER size{};
+            if (!::GetFileSizeEx(file, &size))
+            {
+                return false;
+            }
+            outSize = static_cast<uint64_t>(size.QuadPart);
+            return true;
+        }
+
+        bool write_at(FileHandle file, uint64_t offset, const std::byte* data, size_t size) noexcept
+        {
+            while (size != 0)
+            {
+                OVERLAPPED overlapped{};
+                overlapped.Offset = static_cast<DWORD>(offset);
+                overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+                DWORD written = 0;
+                if (!::WriteFile(file, data, chunk, &written, &overlapped) || written == 0)
+                {
+                    return false;
+                }
+                data += written;
+                size -= written;
+                offset += written;
+            }
+            return true;
+        }
+
+        bool truncate_file(FileHandle file, uint64_t size) noexcept
+        {
+            FILE_END_OF_FILE_INFO info{};
+            info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+            return ::SetFileInformationByHandle(file, FileEndOfFileInfo, &info, sizeof(info)) != 0;
+        }
+
+        bool lock_file(FileHandle file) noexcept
+        {
+            OVERLAPPED overlapped{};
+            return ::LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+        }
+
+        void unlock_file(FileHandle file) noexcept
+        {
+            OVERLAPPED overlapped{};
+            ::UnlockFileEx(file, 0, MAXDWORD, MAXDWORD, &overlapped);
+        }
+
+        bool get_identity(FileHandle file, FileIdentity& out) noexcept
+        {
+            BY_HANDLE_FILE_INFORMATION info{};
+            if (!::GetFileInformationByHandle(file, &info))
+            {
+                return false;
+            }
+            out.volume = info.dwVolumeSerialNumber;
+            out.index = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+            return true;
+        }
+
+        bool get_path_identity(const std::string& path, FileIdentity& out) noexcept
+        {
+            wchar_t widePath[k_maxPath];
+            if (!to_wide(path, widePath))
+            {
+                return false;
+            }
+            HANDLE file = ::CreateFileW(widePath, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+            const bool isOk = get_identity(file, out);
+            ::CloseHandle(file);
+            return isOk;
+        }
+
+        bool replace_file(const std::string& from, const std::string& to) noexcept
+        {
+            wchar_t wideFrom[k_maxPath];
+            wchar_t wideTo[k_maxPath];
+            return to_wide(from, wideFrom) && to_wide(to, wideTo)
+                && ::MoveFileExW(wideFrom, wideTo, MOVEFILE_REPLACE_EXISTING) != 0;
+        }
+
+        void remove_file(const std::string& path) noexcept
+        {
+            wchar_t widePath[k_maxPath];
+            if (to_wide(path, widePath))
+            {
+                ::DeleteFileW(widePath);
+            }
+        }
+
+        uint32_t get_last_error() noexcept
+        {
+            return ::GetLastError();
+        }
+
+        struct Mapping
+        {
+            const std::byte* data = nullptr;
+            uint64_t capacity = 0;
+            HANDLE section = nullptr;
+        };
+
+        void unmap(Mapping& mapping) noexcept
+        {
+            if (mapping.data)
+            {
+                ::UnmapViewOfFile(mapping.data);
+                ::CloseHandle(mapping.section);
+            }
+            mapping = Mapping{};
+        }
+
+        bool map(FileHandle file, uint64_t size, Mapping& mapping) noexcept
+        {
+            // 読み取り専用の割り当てはファイルより大きくできないので、伸びるたびに作り直す
+            unmap(mapping);
+            HANDLE section = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!section)
+            {
+                return false;
+            }
+            void* view = ::MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+            if (!view)
+            {
+                ::CloseHandle(section);
+                return false;
+            }
+            mapping.data = static_cast<const std::byte*>(view);
+            mapping.capacity = size;
+            mapping.section = section;
+            return true;
+        }
+#else
+        using FileHandle = int;
+        constexpr FileHandle k_invalidFile = -1;
+
+        FileHandle open_file(const std::string& path, bool isTruncated) noexcept
+        {
+            return ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (isTruncated ? O_TRUNC : 0), 0644);
+        }
+
+        void close_file(FileHandle file) noexcept
+        {
+            ::close(file);
+        }
+
+        bool get_file_size(FileHandle file, uint64_t& outSize) noexcept
+        {
+            struct stat st{};
+            if (::fstat(file, &st) != 0)
+            {
+                return false;
+            }
+            outSize = static_cast<uint64_t>(st.st_size);
+            return true;
+        }
+
+        bool write_at(FileHandle file, uint64_t offset, const std::byte* data, size_t size) noexcept
+        {
+            while (size != 0)
+            {
+                const ssize_t written = ::pwrite(file, data, size, static_cast<off_t>(offset));
+                if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (written <= 0)
+                {
+                    return false;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+                offset += static_cast<uint64_t>(written);
+            }
+            return true;
+        }
+
+        bool truncate_file(FileHandle file, uint64_t size) noexcept
+        {
+            return ::ftruncate(file, static_cast<off_t>(size)) == 0;
+        }
+
+        bool lock_file(FileHandle file) noexcept
+        {
+            for (;;)
+            {
+                if (::flock(file, LOCK_EX) == 0)
+                {
+                    return true;
+                }
+                if (errno != EINTR)
+                {
+                    return false;
+                }
+            }
+        }
+
+        void unlock_file(FileHandle file) noexcept
+        {
+            ::flock(file, LOCK_UN);
+        }
+
+        bool get_identity(FileHandle file, FileIdentity& out) noexcept
+        {
+            struct stat st{};
+            if (::fstat(file, &st) != 0)
+            {
+                return false;
+            }
+            out.volume = static_cast<uint64_t>(st.st_dev);
+            out.index = static_cast<uint64_t>(st.st_ino);
+            return true;
+        }
+
+        bool get_path_identity(const std::string& path, FileIdentity& out) noexcept
+        {
+            struct stat st{};
+            if (::stat(path.c_str(), &st) != 0)
+            {
+                return false;
+            }
+            out.volume = static_cast<uint64_t>(st.st_dev);
+            out.index = static_cast<uint64_t>(st.st_ino);
+            return true;
+        }
+
+        bool replace_file(const std::string& from, const std::string& to) noexcept
+        {
+            return ::rename(from.c_str(), to.c_str()) == 0;
+        }
+
+        void remove_file(const std::string& path) noexcept
+        {
+            ::unlink(path.c_str());
+        }
+
+        uint32_t get_last_error() noexcept
+        {
+            return static_cast<uint32_t>(errno);
+        }
+
+        struct Mapping
+        {
+            const std::byte* data = nullptr;
+            uint64_t capacity = 0;
+        };
+
+        void unmap(Mapping& mapping) noexcept
+        {
+            if (mapping.data)
+            {
+                ::munmap(const_cast<std::byte*>(mapping.data), static_cast<size_t>(mapping.capacity));
+            }
+            mapping = Mapping{};
+        }
+
+        bool map(FileHandle file, uint64_t size, Mapping& mapping) noexcept
+        {
+            // ファイル末尾より先も予約しておき、追記の度にマップし直さない（末尾より先には触れない）
+            unmap(mapping);
+            const uint64_t capacity = align_up(std::max(size * 2, k_minMappingCapacity), k_minMappingCapacity);
+            void* view = ::mmap(nullptr, static_cast<size_t>(capacity), PROT_READ, MAP_SHARED, file, 0);
+            if (view == MAP_FAILED)
+            {
+                return false;
+            }
+            mapping.data = static_cast<const std::byte*>(view);
+            mapping.capacity = capacity;
+            return true;
+        }
+#endif
+
+        /// @brief プロセス間のロック（スコープを抜けると外す）
+        class FileLockGuard final
+        {
+        public:
+            explicit FileLockGuard(FileHandle file) noexcept
+                : m_file(file)
+                , m_isLocked(lock_file(file))
+            {
+            }
+            ~FileLockGuard()
+            {
+                if (m_isLocked)
+                {
+                    unlock_file(m_file);
+                }
+            }
+            FileLockGuard(const FileLockGuard&) = delete;
+            FileLockGuard& operator=(const FileLockGuard&) = delete;
+
+            [[nodiscard]] bool is_locked() const noexcept { return m_isLocked; }
+        private:
+            FileHandle m_file;
+            bool m_isLocked;
+        };
+    } // namespace
+
+    struct BlobCache::Impl
+    {
+        struct Entry
+        {
+            uint64_t offset = 0;
+            uint32_t payloadSize = 0;
+            // このプロセスで最後に使った順番（詰め直しで残す優先度に使う）
+            std::atomic<uint64_t> lastUse{ 0 };
+        };
+
+        std::string path;
+        std::string lockPath;
+        uint64_t sizeBudget = 0;
+        FileHandle file = k_invalidFile;
+        FileHandle lockFile = k_invalidFile;
+        FileIdentity identity{};
+        Mapping mapping{};
+        // 検証済みの記録の末尾と、最後に見たファイルの大きさ
+        uint64_t validEnd = 0;
+        uint64_t fileSize = 0;
+        bool isOpen = false;
+
+        // 読み込みは共有、走査・追記・詰め直しは排他
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Sha256Digest, Entry, DigestHash> index;
+        std::vector<std::byte> recordScratch;
+
+        std::atomic<uint64_t> useClock{ 0 };
+        std::atomic<uint64_t> hitCount{ 0 };
+        std::atomic<uint64_t> missCount{ 0 };
+        std::atomic<uint64_t> corruptCount{ 0 };
+        uint64_t storeCount = 0;
+        uint32_t compactionCount = 0;
+
+        static Result fail_io(std::string_view message) noexcept
+        {
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, get_last_error(), message);
+        }
+
+        /// @brief 内容を検査して写す（壊れていれば false）
+        bool copy_payload(const Entry& entry, std::vector<std::byte>& out) const
+        {
+            RecordHeader header;
+            std::memcpy(&header, mapping.data + entry.offset, sizeof(header));
+            const std::byte* payload = mapping.data + entry.offset + sizeof(RecordHeader);
+            if (checksum64(payload, entry.payloadSize) != header.payloadChecksum)
+            {
+                return false;
+            }
+            out.assign(payload, payload + entry.payloadSize);
+            return true;
+        }
+
+        void close_data_file() noexcept
+        {
+            unmap(mapping);
+            if (file != k_invalidFile)
+            {
+                close_file(file);
+                file = k_invalidFile;
+            }
+            validEnd = 0;
+            fileSize = 0;
+        }
+
+        /// @brief 空のキャッシュファイルを一時ファイルに作り、置き換える（読み手がマップしていても壊さない）
+        Result replace_with_empty()
+        {
+            const std::string tempPath = path + ".tmp";
+            FileHandle temp = open_file(tempPath, true);
+            if (temp == k_invalidFile)
+            {
+                return fail_io("BlobCache failed to create a temporary file.");
+            }
+            const FileHeader header{ k_fileMagic, k_fileVersion, {} };
+            const bool isWritten = write_at(temp, 0, reinterpret_cast<const std::byte*>(&header), sizeof(header));
+            close_file(temp);
+            close_data_file();
+            if (!isWritten || !replace_file(tempPath, path))
+            {
+                remove_file(tempPath);
+                return fail_io("BlobCache failed to replace the cache file.");
+            }
+            return Result::ok();
+        }
+
+        /// @brief キャッシュファイルを開いてヘッダを確かめる（isLocked なら壊れたファイルを作り直せる）
+        Result open_data_file(bool isLocked)
+        {
+            close_data_file();
+            index.clear();
+            file = open_file(path, false);
+            if (file == k_invalidFile)
+            {
+                return fail_io("BlobCache failed to open the cache file.");
+            }
+            uint64_t size = 0;
+            if (!get_file_size(file, size))
+            {
+                return fail_io("BlobCache failed to get the cache size.");
+            }
+
+            // 1) 新しいファイルにはヘッダを書く（作ったのはロック中の自分だけなので他に読み手はいない）
+            if (size == 0 && isLocked)
+            {
+                const FileHeader header{ k_fileMagic, k_fileVersion, {} };
+                if (!write_at(file, 0, reinterpret_cast<const std::byte*>(&header), sizeof(header)))
+                {
+                    return fail_io("BlobCache failed to write the header.");
+                }
+                size = sizeof(header);
+            }
+
+            // 2) 形式が違えば空のファイルに置き換える（古い形式を読んでいるプロセスがいても壊さない）
+            FileHeader header{};
+            bool isValid = size >= sizeof(header) && map(file, size, mapping);
+            if (isValid)
+            {
+                std::memcpy(&header, mapping.data, sizeof(header));
+                isValid = header.magic == k_fileMagic && header.version == k_fileVersion;
+            }
+            if (!isValid)
+            {
+                if (!isLocked)
+                {
+                    close_data_file();
+                    return Result::fail(Facility::IO, Code::InvalidState, Severity::Warning, 0,
+                        "BlobCache file is being recreated by another process.");
+                }
+                Result r = replace_with_empty();
+                if (!r)
+                {
+                    return r;
+                }
+                return open_data_file(true);
+            }
+            if (!get_identity(file, identity))
+            {
+                return fail_io("BlobCache failed to identify the cache file.");
+            }
+            validEnd = sizeof(FileHeader);
+            fileSize = size;
+            return Result::ok();
+        }
+
+        /// @brief 前回の末尾から後ろの記録を索引に足す（検査に通らない記録で止まる）
+        Result scan()
+        {
+            if (!get_file_size(file, fileSize))
+            {
+                return fail_io("BlobCache failed to get the cache size.");
+            }
+            if (fileSize > mapping.capacity && !map(file, fileSize, mapping))
+            {
+                return fail_io("BlobCache failed to map the cache file.");
+            }
+            while (validEnd + sizeof(RecordHeader) <= fileSize)
+            {
+                RecordHeader header;
+                std::memcpy(&header, mapping.data + validEnd, sizeof(header));
+                if (header.magic != k_recordMagic || header.headerChecksum != header_checksum(header))
+                {
+                    break;
+                }
+                const uint64_t recordSize = get_record_size(header.payloadSize);
+                if (validEnd + recordSize > fileSize)
+                {
+                    break;
+                }
+                // 同じ鍵が後から足されていれば新しい方を使う
+                Entry& entry = index[header.key];
+                entry.offset = validEnd;
+                entry.payloadSize = header.payloadSize;
+                validEnd += recordSize;
+            }
+            return Result::ok();
+        }
+
+        /// @brief 他のプロセスの追記や置き換えを取り込む
+        Result refresh(bool isLocked)
+        {
+            FileIdentity current{};
+            if (get_path_identity(path, current) && !(current == identity))
+            {
+                // 1) 詰め直しで置き換えられていれば開き直す（このプロセスでの使用順は引き継ぐ）
+                std::unordered_map<Sha256Digest, uint64_t, DigestHash> uses;
+                for (const auto& [key, entry] : index)
+                {
+                    uses.emplace(key, entry.lastUse.load(std::memory_order_relaxed));
+                }
+                Result r = open_data_file(isLocked);
+                if (!r)
+                {
+                    return r;
+                }
+                r = scan();
+                for (auto& [key, entry] : index)
+                {
+                    auto it = uses.find(key);
+                    entry.lastUse.store(it != uses.end() ? it->second : 0, std::memory_order_relaxed);
+                }
+                return r;
+            }
+            return scan();
+        }
+
+        Result compact_locked()
+        {
+            // 1) このプロセスで最近使ったもの、次に新しく書かれたものの順に、予算の 3/4 まで残す
+            std::vector<std::pair<const Sha256Digest*, const Entry*>> order;
+            order.reserve(index.size());
+            for (const auto& [key, entry] : index)
+            {
+                order.emplace_back(&key, &entry);
+            }
+            std::sort(order.begin(), order.end(), [](const auto& a, const auto& b)
+            {
+                const uint64_t useA = a.second->lastUse.load(std::memory_order_relaxed);
+                const uint64_t useB = b.second->lastUse.load(std::memory_order_relaxed);
+                return useA != useB ? useA > useB : a.second->offset > b.second->offset;
+            });
+
+            // 2) 残すものを一時ファイルへ書き出す（壊れた記録は落とす）
+            const std::string tempPath = path + ".tmp";
+            FileHandle temp = open_file(tempPath, true);
+            if (temp == k_invalidFile)
+            {
+                return fail_io("BlobCache failed to create a temporary file.");
+            }
+            const FileHeader fileHeader{ k_fileMagic, k_fileVersion, {} };
+            bool isWritten = write_at(temp, 0, reinterpret_cast<const std::byte*>(&fileHeader), sizeof(fileHeader));
+            uint64_t offset = sizeof(FileHeader);
+            const uint64_t target = sizeBudget / 4 * 3;
+            std::unordered_map<Sha256Digest, uint64_t, DigestHash> uses;
+            for (const auto& [key, entry] : order)
+            {
+                const uint64_t recordSize = get_record_size(entry->payloadSize);
+                if (!isWritten || offset + recordSize > target)
+                {
+                    break;
+                }
+                RecordHeader header;
+                std::memcpy(&header, mapping.data + entry->offset, sizeof(header));
+                if (checksum64(mapping.data + entry->offset + sizeof(RecordHeader), entry->payloadSize) != header.payloadChecksum)
+                {
+                    corruptCount.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                isWritten = write_at(temp, offset, mapping.data + entry->offset, static_cast<size_t>(recordSize));
+                uses.emplace(*key, entry->lastUse.load(std::memory_order_relaxed));
+                offset += recordSize;
+            }
+            close_file(temp);
+            if (!isWritten)
+            {
+                remove_file(tempPath);
+                return fail_io("BlobCache failed to write the compacted file.");
+            }
+
+            // 3) 置き換えて開き直す（古いファイルをマップしているプロセスは次の refresh で気付く）
+            close_data_file();
+            const bool isReplaced = replace_file(tempPath, path);
+            const uint32_t error = get_last_error();
+            if (!isReplaced)
+            {
+                remove_file(tempPath);
+            }
+            Result r = open_data_file(true);
+            if (r)
+            {
+                r = scan();
+            }
+            for (auto& [key, entry] : index)
+            {
+                auto it = uses.find(key);
+                entry.lastUse.store(it != uses.end() ? it->second : 0, std::memory_order_relaxed);
+            }
+            if (!isReplaced)
+            {
+                // Windows では他のプロセスがマップしている間は置き換えられない（追記は続けられる）
+                return Result::fail(Facility::IO, Code::AccessDenied, Severity::Warning, error,
+                    "BlobCache could not replace the cache file while it is in use.");
+            }
+            ++compactionCount;
+            return r;
+        }
+    };
+
+    BlobCache::BlobCache()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    BlobCache::~BlobCache()
+    {
+        close();
+    }
+
+    Result BlobCache::open(const BlobCacheDesc& desc)
+    {
+        close();
+        Impl& impl = *m_impl;
+        std::unique_lock lock(impl.mutex);
+        if (desc.path.empty())
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "BlobCache path is empty.");
+        }
+        impl.path.assign(desc.path);
+        impl.lockPath = impl.path + ".lock";
+        impl.sizeBudget = desc.sizeBudget;
+
+        // 1) ロックファイルを開き、ロック中にキャッシュを開いて索引を作る
+        impl.lockFile = open_file(impl.lockPath, false);
+        if (impl.lockFile == k_invalidFile)
+        {
+            return Impl::fail_io("BlobCache failed to open the lock file.");
+        }
+        FileLockGuard fileLock(impl.lockFile);
+        if (!fileLock.is_locked())
+        {
+            return Impl::fail_io("BlobCache failed to lock the cache.");
+        }
+        Result r = impl.open_data_file(true);
+        if (r)
+        {
+            r = impl.scan();
+        }
+        if (!r)
+        {
+            impl.close_data_file();
+            close_file(impl.lockFile);
+            impl.lockFile = k_invalidFile;
+            return r;
+        }
+        impl.isOpen = true;
+        return Result::ok();
+    }
+
+    void BlobCache::close() noexcept
+    {
+        Impl& impl = *m_impl;
+        std::unique_lock lock(impl.mutex);
+        impl.close_data_file();
+        if (impl.lockFile != k_invalidFile)
+        {
+            close_file(impl.lockFile);
+            impl.lockFile = k_invalidFile;
+        }
+        impl.index.clear();
+        impl.isOpen = false;
+    }
+
+    Result BlobCache::find(const Sha256Digest& key, std::vector<std::byte>& outPayload)
+    {
+        Impl& impl = *m_impl;
+
+        // 1) 索引にあればロックを共有したまま写す
+        {
+            std::shared_lock lock(impl.mutex);
+            auto it = impl.index.find(key);
+            if (it != impl.index.end() && impl.copy_payload(it->second, outPayload))
+            {
+                it->second.lastUse.store(impl.useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                impl.hitCount.fetch_add(1, std::memory_order_relaxed);
+                return Result::ok();
+            }
+        }
+
+        // 2) 無ければ他のプロセスの追記を取り込んで引き直す（壊れていた記録は索引から外す）
+        std::unique_lock lock(impl.mutex);
+        if (!impl.isOpen)
+        {
+            return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "BlobCache is not open.");
+        }
+        Result r = impl.refresh(false);
+        if (r)
+        {
+            auto it = impl.index.find(key);
+            if (it != impl.index.end())
+            {
+                if (impl.copy_payload(it->second, outPayload))
+                {
+                    it->second.lastUse.store(impl.useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    impl.hitCount.fetch_add(1, std::memory_order_relaxed);
+                    return Result::ok();
+                }
+                impl.corruptCount.fetch_add(1, std::memory_order_relaxed);
+                impl.index.erase(it);
+            }
+        }
+        impl.missCount.fetch_add(1, std::memory_order_relaxed);
+        return Result::fail(Facility::IO, Code::NotFound, Severity::Info, 0, "BlobCache entry was not found.");
+    }
+
+    Result BlobCache::store(const Sha256Digest& key, std::span<const std::byte> payload)
+    {
+        Impl& impl = *m_impl;
+        if (payload.size() > 0xFFFFFFFFu)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "BlobCache payload is too large.");
+        }
+        std::unique_lock lock(impl.mutex);
+        if (!impl.isOpen)
+        {
+            return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "BlobCache is not open.");
+        }
+
+        // 1) プロセス間で追記を直列化し、他の書き手の記録を取り込む
+        FileLockGuard fileLock(impl.lockFile);
+        if (!fileLock.is_locked())
+        {
+            return Impl::fail_io("BlobCache failed to lock the cache.");
+        }
+        Result r = impl.refresh(true);
+        if (!r)
+        {
+            return r;
+        }
+        if (impl.index.find(key) != impl.index.end())
+        {
+            return Result::ok();
+        }
+
+        // 2) 書きかけで終わった末尾があれば切り詰める（ロック中なので書いている途中の者はいない）
+        if (impl.fileSize > impl.validEnd)
+        {
+            // 失敗しても記録は validEnd から書くので、残った屑は走査で弾かれる
+            (void)truncate_file(impl.file, impl.validEnd);
+        }
+
+        // 3) ヘッダと内容を 1 回で書き、索引に足す
+        RecordHeader header{};
+        header.magic = k_recordMagic;
+        header.payloadSize = static_cast<uint32_t>(payload.size());
+        header.payloadChecksum = checksum64(payload.data(), payload.size());
+        header.key = key;
+        header.headerChecksum = header_checksum(header);
+        const uint64_t recordSize = get_record_size(header.payloadSize);
+        impl.recordScratch.assign(static_cast<size_t>(recordSize), std::byte{ 0 });
+        std::memcpy(impl.recordScratch.data(), &header, sizeof(header));
+        if (!payload.empty())
+        {
+            std::memcpy(impl.recordScratch.data() + sizeof(header), payload.data(), payload.size());
+        }
+        if (!write_at(impl.file, impl.validEnd, impl.recordScratch.data(), impl.recordScratch.size()))
+        {
+            return Impl::fail_io("BlobCache failed to append a record.");
+        }
+        Impl::Entry& entry = impl.index[key];
+        entry.offset = impl.validEnd;
+        entry.payloadSize = header.payloadSize;
+        entry.lastUse.store(impl.useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        impl.validEnd += recordSize;
+        impl.fileSize = impl.validEnd;
+        ++impl.storeCount;
+        if (impl.validEnd > impl.mapping.capacity && !map(impl.file, impl.validEnd, impl.mapping))
+        {
+            return Impl::fail_io("BlobCache failed to map the cache file.");
+        }
+
+        // 4) 予算を超えたら詰め直す（失敗しても追記自体は済んでいる）
+        if (impl.validEnd > impl.sizeBudget)
+        {
+            (void)impl.compact_locked();
+        }
+        return Result::ok();
+    }
+
+    Result BlobCache::compact()
+    {
+        Impl& impl = *m_impl;
+        std::unique_lock lock(impl.mutex);
+        if (!impl.isOpen)
+        {
+            return Result::fail(Facility::IO, Code::InvalidState, Severity::Error, 0, "BlobCache is not open.");
+        }
+        FileLockGuard fileLock(impl.lockFile);
+        if (!fileLock.is_locked())
+        {
+            return Impl::fail_io("BlobCache failed to lock the cache.");
+        }
+        Result r = impl.refresh(true);
+        if (!r)
+        {
+            return r;
+        }
+        return impl.compact_locked();
+    }
+
+    BlobCacheStats BlobCache::get_stats() const
+    {
+        const Impl& impl = *m_impl;
+        std::shared_lock lock(impl.mutex);
+        BlobCacheStats stats{};
+        stats.hitCount = impl.hitCount.load(std::memory_order_relaxed);
+        stats.missCount = impl.missCount.load(std::memory_order_relaxed);
+        stats.corruptCount = impl.corruptCount.load(std::memory_order_relaxed);
+        stats.storeCount = impl.storeCount;
+        stats.compactionCount = impl.compactionCount;
+        stats.entryCount = static_cast<uint32_t>(impl.index.size());
+        stats.fileBytes = impl.validEnd;
+        return stats;
+    }
+} // namespace Cue::Core
@@ -0,0 +1,460 @@
+#include "Compression.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // 一致とみなす最短の長さ
+        constexpr size_t k_minMatch = 4;
+        // 一致の探索を始められる末尾からの距離（最後の 8 バイト比較が範囲内に収まるように）
+        constexpr size_t k_matchLimit = 12;
+        constexpr size_t k_maxOffset = 65535;
+        constexpr uint32_t k_hashBits = 14;
+        // 一致が見つからない間、探索の歩幅を広げる速さ（圧縮しにくいデータで時間を使わない）
+        constexpr uint32_t k_skipShift = 6;
+
+        uint32_t read32(const std::byte* p) noexcept
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint64_t read64(const std::byte* p) noexcept
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint32_t hash4(uint32_t v) noexcept
+        {
+            return (v * 2654435761u) >> (32 - k_hashBits);
+        }
+
+        /// @brief 長さの 4bit に入りきらない分を 255 区切りで書く
+        std::byte* write_length(std::byte* op, size_t length) noexcept
+        {
+            for (; length >= 255; length -= 255)
+            {
+                *op++ = std::byte{ 255 };
+            }
+            *op++ = static_cast<std::byte>(length);
+            return op;
+        }
+
+        std::byte* write_sequence(std::byte* op, const std::byte* literals, size_t literalLength,
+            size_t offset, size_t matchLength) noexcept
+        {
+            // 1) トークン（上位がリテラル長、下位が一致長 - 4。15 は続きがある印）
+            std::byte* token = op++;
+            const size_t matchCode = matchLength != 0 ? matchLength - k_minMatch : 0;
+            *token = static_cast<std::byte>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+            if (literalLength >= 15)
+            {
+                op = write_length(op, literalLength - 15);
+            }
+
+            // 2) リテラル
+            std::memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            // 3) 距離と一致長の続き（最後のシーケンスは一致を持たない）
+            if (matchLength != 0)
+            {
+                *op++ = static_cast<std::byte>(offset & 0xFF);
+                *op++ = static_cast<std::byte>(offset >> 8);
+                if (matchCode >= 15)
+                {
+                    op = write_length(op, matchCode - 15);
+                }
+            }
+            return op;
+        }
+
+        bool read_length(const std::byte*& ip, const std::byte* end, size_t& length) noexcept
+        {
+            for (;;)
+            {
+                if (ip >= end)
+                {
+                    return false;
+                }
+                const uint8_t b = static_cast<uint8_t>(*ip++);
+                length += b;
+                if (b != 255)
+                {
+                    return true;
+                }
+            }
+        }
+
+        void decompress_blocks(const CompressedBlockReader& reader, uint32_t begin, uint32_t end,
+            std::byte* destination, std::atomic<bool>& isFailed) noexcept
+        {
+            const uint64_t blockSize = reader.get_block_size();
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                std::span<std::byte> block(destination + i * blockSize, reader.get_block_uncompressed_size(i));
+                if (!reader.decompress_block(i, block))
+                {
+                    isFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    } // namespace
+
+    size_t lz_compress(std::span<const std::byte> source, std::span<std::byte> destination) noexcept
+    {
+        if (destination.size() < lz_compress_bound(source.size()))
+        {
+            return 0;
+        }
+        const std::byte* const base = source.data();
+        const size_t size = source.size();
+        std::byte* op = destination.data();
+
+        // 1) 4 バイトのハッシュで直近の出現位置を引き、貪欲に一致を取る
+        size_t anchor = 0;
+        if (size > k_matchLimit)
+        {
+            uint32_t table[1u << k_hashBits]{};
+            const size_t limit = size - k_matchLimit;
+            size_t ip = 1;
+            uint32_t misses = 0;
+            while (ip < limit)
+            {
+                const uint32_t sequence = read32(base + ip);
+                const uint32_t h = hash4(sequence);
+                size_t ref = table[h];
+                table[h] = static_cast<uint32_t>(ip);
+                if (ip - ref > k_maxOffset || read32(base + ref) != sequence)
+                {
+                    ip += 1 + (misses++ >> k_skipShift);
+                    continue;
+                }
+                misses = 0;
+
+                // 2) 手前へ伸ばす（リテラルを減らす）
+                while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1])
+                {
+                    --ip;
+                    --ref;
+                }
+
+                // 3) 先へ 8 バイトずつ伸ばす（異なる最初のバイトは下位から数える。リトルエンディアン前提）
+                size_t length = k_minMatch;
+                for (;;)
+                {
+                    if (ip + length + 8 > size)
+                    {
+                        while (ip + length < size && base[ip + length] == base[ref + length])
+                        {
+                            ++length;
+                        }
+                        break;
+                    }
+                    const uint64_t diff = read64(base + ip + length) ^ read64(base + ref + length);
+                    if (diff != 0)
+                    {
+                        length += static_cast<size_t>(std::countr_zero(diff)) / 8;
+                        break;
+                    }
+                    length += 8;
+                }
+                op = write_sequence(op, base + anchor, ip - anchor, ip - ref, length);
+                ip += length;
+                anchor = ip;
+
+                // 4) 一致の直前を登録しておくと、続く一致を拾いやすい
+                if (ip < limit)
+                {
+                    table[hash4(read32(base + ip - 2))] = static_cast<uint32_t>(ip - 2);
+                }
+            }
+        }
+
+        // 5) 残りをリテラルだけのシーケンスとして書く
+        op = write_sequence(op, base + anchor, size - anchor, 0, 0);
+        return static_cast<size_t>(op - destination.data());
+    }
+
+    bool lz_decompress(std::span<const std::byte> source, std::span<std::byte> destination) noexcept
+    {
+        const std::byte* ip = source.data();
+        const std::byte* const inputEnd = ip + source.size();
+        std::byte* op = destination.data();
+        std::byte* const outputBegin = op;
+        std::byte* const outputEnd = op + destination.size();
+
+        while (ip < inputEnd)
+        {
+            // 1) リテラルを写す（余裕があれば 16 バイトまとめて写し、はみ出しは後で上書きされる）
+            const uint8_t token = static_cast<uint8_t>(*ip++);
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !read_length(ip, inputEnd, literalLength))
+            {
+                return false;
+            }
+            if (literalLength > static_cast<size_t>(inputEnd - ip) || literalLength > static_cast<size_t>(outputEnd - op))
+            {
+                return false;
+            }
+            if (literalLength <= 16 && inputEnd - ip >= 16 && outputEnd - op >= 16)
+            {
+                std::memcpy(op, ip, 16);
+            }
+            else
+            {
+                std::memcpy(op, ip, literalLength);
+            }
+            ip += literalLength;
+            op += literalLength;
+            if (ip == inputEnd)
+            {
+                break;
+            }
+
+            // 2) 距離と一致長を読む
+            if (inputEnd - ip < 2)
+            {
+                return false;
+            }
+            const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !read_length(ip, inputEnd, matchLength))
+            {
+                return false;
+            }
+            matchLength += k_minMatch;
+            if (offset == 0 || offset > static_cast<size_t>(op - outputBegin)
+                || matchLength > static_cast<size_t>(outputEnd - op))
+            {
+                return false;
+            }
+
+            // 3) 一致を写す（距離が 8 以上なら 8 バイト単位で写しても読み元を追い越さない）
+            const std::byte* match = op - offset;
+            if (offset >= 8 && static_cast<size_t>(outputEnd - op) >= matchLength + 8)
+            {
+                for (size_t i = 0; i < matchLength; i += 8)
+                {
+                    std::memcpy(op + i, match + i, 8);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < matchLength; ++i)
+                {
+                    op[i] = match[i];
+                }
+            }
+            op += matchLength;
+        }
+        return op == outputEnd;
+    }
+
+    Result compress_blocks(std::span<const std::byte> source, uint32_t blockSize, std::vector<std::byte>& out,
+        JobSystem* jobSystem)
+    {
+        out.clear();
+        if (blockSize < k_minCompressedBlockSize || blockSize > k_maxCompressedBlockSize)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, blockSize,
+                "Compressed block size is out of range.");
+        }
+        const uint64_t blockCount64 = (source.size() + blockSize - 1) / blockSize;
+        if (blockCount64 > 0xFFFFFFFFu)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Compressed source is too large.");
+        }
+        const uint32_t blockCount = static_cast<uint32_t>(blockCount64);
+
+        // 1) ブロック毎に作業領域の決まった位置へ圧縮する（ブロック同士は独立なので並列にできる）
+        const size_t bound = lz_compress_bound(blockSize);
+        std::vector<std::byte> scratch(bound * blockCount);
+        std::vector<CompressedBlockEntry> blocks(blockCount);
+        const auto compress_range = [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const size_t offset = static_cast<size_t>(i) * blockSize;
+                const std::span<const std::byte> input = source.subspan(offset, std::min<size_t>(blockSize, source.size() - offset));
+                std::byte* output = scratch.data() + bound * i;
+                const size_t compressedSize = lz_compress(input, std::span<std::byte>(output, bound));
+                if (compressedSize == 0 || compressedSize >= input.size())
+                {
+                    // 縮まなければそのまま置く（展開はコピーだけになる）
+                    std::memcpy(output, input.data(), input.size());
+                    blocks[i] = CompressedBlockEntry{ 0, static_cast<uint32_t>(input.size()), k_compressedBlockStored };
+                }
+                else
+                {
+                    blocks[i] = CompressedBlockEntry{ 0, static_cast<uint32_t>(compressedSize), 0 };
+                }
+            }
+        };
+        if (jobSystem && blockCount > 1)
+        {
+            jobSystem->parallel_for(blockCount, 1, compress_range);
+        }
+        else
+        {
+            compress_range(0, blockCount);
+        }
+
+        // 2) ヘッダ・索引・ブロックの順に詰める
+        uint64_t offset = sizeof(CompressedHeader) + sizeof(CompressedBlockEntry) * blockCount;
+        for (CompressedBlockEntry& block : blocks)
+        {
+            block.offset = offset;
+            offset += block.compressedSize;
+        }
+        out.resize(static_cast<size_t>(offset));
+        const CompressedHeader header{ k_compressedMagic, k_compressedVersion, blockSize, blockCount, source.size(), 0 };
+        std::memcpy(out.data(), &header, sizeof(header));
+        if (blockCount != 0)
+        {
+            std::memcpy(out.data() + sizeof(header), blocks.data(), sizeof(CompressedBlockEntry) * blockCount);
+        }
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            std::memcpy(out.data() + blocks[i].offset, scratch.data() + bound * i, blocks[i].compressedSize);
+        }
+        return Result::ok();
+    }
+
+    bool CompressedBlockReader::is_compressed(std::span<const std::byte> data) noexcept
+    {
+        uint32_t magic = 0;
+        if (data.size() < sizeof(CompressedHeader))
+        {
+            return false;
+        }
+        std::memcpy(&magic, data.data(), sizeof(magic));
+        return magic == k_compressedMagic;
+    }
+
+    Result CompressedBlockReader::open(std::span<const std::byte> data)
+    {
+        m_data = {};
+        m_blocks = {};
+        m_header = CompressedHeader{};
+
+        // 1) ヘッダを検証する
+        if (!is_compressed(data))
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Compressed data has no valid header.");
+        }
+        if (reinterpret_cast<uintptr_t>(data.data()) % alignof(CompressedBlockEntry) != 0)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Compressed data is misaligned.");
+        }
+        CompressedHeader header{};
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.version != k_compressedVersion
+            || header.blockSize < k_minCompressedBlockSize || header.blockSize > k_maxCompressedBlockSize)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, header.version,
+                "Compressed header is corrupted or unsupported.");
+        }
+        // 切り上げの足し算は細工した大きさで桁あふれするので、商と余りからブロック数を出す
+        const uint64_t expectedBlockCount = header.uncompressedSize / header.blockSize
+            + (header.uncompressedSize % header.blockSize != 0 ? 1 : 0);
+        if (header.blockCount != expectedBlockCount
+            || (data.size() - sizeof(header)) / sizeof(CompressedBlockEntry) < header.blockCount)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, header.version,
+                "Compressed header is corrupted or unsupported.");
+        }
+
+        // 2) 索引が範囲内を指しているか確かめる（展開時には確かめ直さない）
+        const std::span<const CompressedBlockEntry> blocks(
+            reinterpret_cast<const CompressedBlockEntry*>(data.data() + sizeof(header)), header.blockCount);
+        for (const CompressedBlockEntry& block : blocks)
+        {
+            if (block.offset > data.size() || block.compressedSize > data.size() - block.offset
+                || block.compressedSize > lz_compress_bound(header.blockSize))
+            {
+                return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0,
+                    "Compressed block index is corrupted.");
+            }
+        }
+        m_data = data;
+        m_blocks = blocks;
+        m_header = header;
+        return Result::ok();
+    }
+
+    uint32_t CompressedBlockReader::get_block_uncompressed_size(uint32_t index) const noexcept
+    {
+        if (index >= m_header.blockCount)
+        {
+            return 0;
+        }
+        const uint64_t begin = static_cast<uint64_t>(index) * m_header.blockSize;
+        return static_cast<uint32_t>(std::min<uint64_t>(m_header.blockSize, m_header.uncompressedSize - begin));
+    }
+
+    Result CompressedBlockReader::decompress_block(uint32_t index, std::span<std::byte> destination) const noexcept
+    {
+        const uint32_t size = get_block_uncompressed_size(index);
+        if (index >= m_header.blockCount || destination.size() < size)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, index,
+                "Compressed block destination is invalid.");
+        }
+        const CompressedBlockEntry& block = m_blocks[index];
+        const std::span<const std::byte> input = m_data.subspan(static_cast<size_t>(block.offset), block.compressedSize);
+        if ((block.flags & k_compressedBlockStored) != 0)
+        {
+            if (input.size() != size)
+            {
+                return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, index,
+                    "Compressed stored block has a wrong size.");
+            }
+            std::memcpy(destination.data(), input.data(), size);
+            return Result::ok();
+        }
+        if (!lz_decompress(input, destination.first(size)))
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, index, "Compressed block is corrupted.");
+        }
+        return Result::ok();
+    }
+
+    Result CompressedBlockReader::decompress(std::span<std::byte> destination, JobSystem* jobSystem) const
+    {
+        if (destination.size() < m_header.uncompressedSize)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0,
+                "Compressed destination is too small.");
+        }
+
+        // 1) ブロックは独立しているので、展開先の決まった位置へワーカーが別々に書く
+        std::atomic<bool> isFailed{ false };
+        if (jobSystem && m_header.blockCount > 1)
+        {
+            jobSystem->parallel_for(m_header.blockCount, 1, [&](uint32_t begin, uint32_t end)
+            {
+                decompress_blocks(*this, begin, end, destination.data(), isFailed);
+            });
+        }
+        else
+        {
+            decompress_blocks(*this, 0, m_header.blockCount, destination.data(), isFailed);
+        }
+        if (isFailed.load(std::memory_order_relaxed))
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Compressed data is corrupted.");
+        }
+        return Result::ok();
+    }
+} // namespace Cue::Core
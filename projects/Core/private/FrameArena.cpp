@@ -0,0 +1,340 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        constexpr size_t k_cacheLine = 64;
+
+        // ブロック先頭に置く管理情報（デバッグ時の境界チェックで走査に使う）
+        struct alignas(16) BlockHeader
+        {
+            uint32_t blockCount;
+            std::atomic<uint32_t> used;
+        };
+
+#ifdef CUE_DEBUG
+        // デバッグ時のみ、各確保の前に置いて後ろのガードを辿れるようにする
+        struct AllocHeader
+        {
+            uint32_t payloadOffset;
+            uint32_t payloadSize;
+        };
+        constexpr size_t k_guardSize = 16;
+        constexpr unsigned char k_guardPattern = 0xFD;
+        constexpr unsigned char k_clearPattern = 0xCD;
+#endif
+
+        // スレッド毎の切り出し中ブロック
+        struct ThreadCursor
+        {
+            const FrameArena* owner = nullptr;
+            uint64_t epoch = 0;
+            std::byte* cursor = nullptr;
+            std::byte* end = nullptr;
+            BlockHeader* block = nullptr;
+        };
+        thread_local ThreadCursor t_cursor;
+
+        // アリーナの作り直しやアドレス再利用で古いカーソルを使わないよう、世代はプロセス内で一意にする
+        uint64_t next_epoch() noexcept
+        {
+            static std::atomic<uint64_t> s_epoch{ 0 };
+            return s_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        std::byte* align_up(std::byte* p, size_t alignment) noexcept
+        {
+            const uintptr_t v = reinterpret_cast<uintptr_t>(p);
+            return reinterpret_cast<std::byte*>((v + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+        }
+
+        bool is_pow2(size_t v) noexcept
+        {
+            return v != 0 && (v & (v - 1)) == 0;
+        }
+
+        // カーソルから 1 件確保する（収まらなければ nullptr）
+        void* bump(ThreadCursor& tc, size_t size, size_t alignment) noexcept
+        {
+#ifdef CUE_DEBUG
+            std::byte* header = align_up(tc.cursor, alignof(AllocHeader));
+            std::byte* payload = align_up(header + sizeof(AllocHeader), alignment);
+            std::byte* next = payload + size + k_guardSize;
+            if (next > tc.end)
+            {
+                return nullptr;
+            }
+            AllocHeader h{ static_cast<uint32_t>(payload - header), static_cast<uint32_t>(size) };
+            std::memcpy(header, &h, sizeof(h));
+            std::memset(payload + size, k_guardPattern, k_guardSize);
+#else
+            std::byte* payload = align_up(tc.cursor, alignment);
+            std::byte* next = payload + size;
+            if (next > tc.end)
+            {
+                return nullptr;
+            }
+#endif
+            tc.cursor = next;
+            tc.block->used.store(static_cast<uint32_t>(next - reinterpret_cast<std::byte*>(tc.block)), std::memory_order_relaxed);
+            return payload;
+        }
+    }
+
+    struct FrameArena::Impl
+    {
+        std::unique_ptr<std::byte[]> m_storage;
+        std::byte* m_base = nullptr;
+        size_t m_bytesPerFrame = 0;
+        size_t m_blockSize = 0;
+        size_t m_blocksPerFrame = 0;
+        uint32_t m_frameCount = 0;
+        std::pmr::memory_resource* m_upstream = nullptr;
+
+        // バッファ毎に前回使ったブロック数（デバッグ時の消去範囲を絞る）
+        std::unique_ptr<size_t[]> m_bufferUsedBlocks;
+        uint32_t m_currentBuffer = 0;
+        uint64_t m_frameIndex = 0;
+        std::atomic<uint64_t> m_epoch{ 0 };
+        alignas(k_cacheLine) std::atomic<size_t> m_nextBlock{ 0 };
+        std::atomic<size_t> m_overflowBytes{ 0 };
+
+        std::byte* buffer_begin(uint32_t buffer) const noexcept
+        {
+            return m_base + static_cast<size_t>(buffer) * m_bytesPerFrame;
+        }
+
+#ifdef CUE_DEBUG
+        // 終了したフレームの全確保について、後ろのガードが壊れていないか調べる
+        bool validate_buffer(uint32_t buffer, size_t blockCount) const noexcept
+        {
+            std::byte* begin = buffer_begin(buffer);
+            size_t index = 0;
+            while (index < blockCount)
+            {
+                BlockHeader* block = reinterpret_cast<BlockHeader*>(begin + index * m_blockSize);
+                std::byte* p = reinterpret_cast<std::byte*>(block) + sizeof(BlockHeader);
+                std::byte* end = reinterpret_cast<std::byte*>(block) + block->used.load(std::memory_order_relaxed);
+                while (p < end)
+                {
+                    std::byte* header = align_up(p, alignof(AllocHeader));
+                    AllocHeader h{};
+                    std::memcpy(&h, header, sizeof(h));
+                    const std::byte* guard = header + h.payloadOffset + h.payloadSize;
+                    for (size_t i = 0; i < k_guardSize; ++i)
+                    {
+                        if (static_cast<unsigned char>(guard[i]) != k_guardPattern)
+                        {
+                            return false;
+                        }
+                    }
+                    p = header + h.payloadOffset + h.payloadSize + k_guardSize;
+                }
+                index += (block->blockCount != 0) ? block->blockCount : 1;
+            }
+            return true;
+        }
+#endif
+    };
+
+    FrameArena::FrameArena()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    FrameArena::~FrameArena()
+    {
+    }
+    Result FrameArena::initialize(const FrameArenaDesc& desc)
+    {
+        // 1) 設定を検証する（ブロックはアドレス計算を単純にするため 2 の冪に限る）
+        if (m_impl->m_storage)
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidState,
+                Severity::Error,
+                0, "FrameArena is already initialized.");
+        }
+        if (desc.frameCount == 0 || !is_pow2(desc.blockSize) || desc.blockSize <= sizeof(BlockHeader) ||
+            desc.blockSize > UINT32_MAX || desc.bytesPerFrame < desc.blockSize)
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidArg,
+                Severity::Error,
+                0, "Invalid FrameArenaDesc.");
+        }
+
+        // 2) 全フレーム分をまとめて確保し、フレーム毎の領域をブロック境界に揃える
+        const size_t blocksPerFrame = desc.bytesPerFrame / desc.blockSize;
+        const size_t bytesPerFrame = blocksPerFrame * desc.blockSize;
+        const size_t totalBytes = bytesPerFrame * desc.frameCount + k_cacheLine;
+        m_impl->m_storage = std::make_unique_for_overwrite<std::byte[]>(totalBytes);
+        m_impl->m_base = align_up(m_impl->m_storage.get(), k_cacheLine);
+        m_impl->m_bytesPerFrame = bytesPerFrame;
+        m_impl->m_blockSize = desc.blockSize;
+        m_impl->m_blocksPerFrame = blocksPerFrame;
+        m_impl->m_frameCount = desc.frameCount;
+        m_impl->m_upstream = desc.upstream ? desc.upstream : std::pmr::get_default_resource();
+        m_impl->m_bufferUsedBlocks = std::make_unique<size_t[]>(desc.frameCount);
+
+        // 3) 最初のフレームを開始する
+        m_impl->m_currentBuffer = 0;
+        m_impl->m_frameIndex = 0;
+        m_impl->m_nextBlock.store(0, std::memory_order_relaxed);
+        m_impl->m_epoch.store(next_epoch(), std::memory_order_release);
+        return Result::ok();
+    }
+    void FrameArena::shutdown()
+    {
+        // 1) 古いカーソルが解放済み領域を指さないよう世代を進めてから解放する
+        m_impl->m_epoch.store(next_epoch(), std::memory_order_release);
+        m_impl->m_storage.reset();
+        m_impl->m_bufferUsedBlocks.reset();
+        m_impl->m_base = nullptr;
+        m_impl->m_nextBlock.store(0, std::memory_order_relaxed);
+    }
+    Result FrameArena::begin_frame()
+    {
+        if (!m_impl->m_storage)
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidState,
+                Severity::Error,
+                0, "FrameArena is not initialized.");
+        }
+
+        const size_t usedBlocks = std::min(m_impl->m_nextBlock.load(std::memory_order_acquire), m_impl->m_blocksPerFrame);
+        Result r = Result::ok();
+#ifdef CUE_DEBUG
+        // 1) 終了したフレームの境界破壊を検出する（以降の内容は信用できない）
+        if (!m_impl->validate_buffer(m_impl->m_currentBuffer, usedBlocks))
+        {
+            r = Result::fail(
+                Facility::Core,
+                Code::InvalidState,
+                Severity::Fatal,
+                0, "FrameArena guard bytes overwritten.");
+        }
+#endif
+
+        // 2) 次のバッファへ進める（frameCount フレーム前の確保がここで無効になる）
+        m_impl->m_bufferUsedBlocks[m_impl->m_currentBuffer] = usedBlocks;
+        m_impl->m_currentBuffer = (m_impl->m_currentBuffer + 1) % m_impl->m_frameCount;
+        ++m_impl->m_frameIndex;
+#ifdef CUE_DEBUG
+        // 3) 無効になった領域の誤用を見つけやすくする（使った範囲だけ塗る）
+        std::memset(m_impl->buffer_begin(m_impl->m_currentBuffer), k_clearPattern,
+            m_impl->m_bufferUsedBlocks[m_impl->m_currentBuffer] * m_impl->m_blockSize);
+#endif
+
+        // 4) 巻き戻して世代を進め、各スレッドのカーソルを無効化する
+        m_impl->m_nextBlock.store(0, std::memory_order_relaxed);
+        m_impl->m_epoch.store(next_epoch(), std::memory_order_release);
+        return r;
+    }
+    void* FrameArena::try_allocate(size_t size, size_t alignment) noexcept
+    {
+        // 1) 同じフレームで切り出したブロックがあればそこからバンプ確保する
+        ThreadCursor& tc = t_cursor;
+        if (tc.owner == this && tc.epoch == m_impl->m_epoch.load(std::memory_order_acquire))
+        {
+            if (void* p = bump(tc, size, alignment))
+            {
+                return p;
+            }
+        }
+
+        // 2) 新しいブロックを切り出す
+        return allocate_slow(size, alignment);
+    }
+    void* FrameArena::allocate_slow(size_t size, size_t alignment) noexcept
+    {
+        if (!m_impl->m_base || !is_pow2(alignment))
+        {
+            return nullptr;
+        }
+
+        // 1) 大きな要求は連続した複数ブロックをまとめて切り出す
+        size_t required = sizeof(BlockHeader) + size + alignment;
+#ifdef CUE_DEBUG
+        required += sizeof(AllocHeader) + alignof(AllocHeader) + k_guardSize;
+#endif
+        const size_t blockCount = (required + m_impl->m_blockSize - 1) / m_impl->m_blockSize;
+        const size_t first = m_impl->m_nextBlock.fetch_add(blockCount, std::memory_order_relaxed);
+        if (first + blockCount > m_impl->m_blocksPerFrame)
+        {
+            // 末尾の端数ブロックを空ブロックとして閉じ、デバッグ時の走査が未初期化領域を読まないようにする
+            if (first < m_impl->m_blocksPerFrame)
+            {
+                std::byte* tail = m_impl->buffer_begin(m_impl->m_currentBuffer) + first * m_impl->m_blockSize;
+                BlockHeader* block = ::new (static_cast<void*>(tail)) BlockHeader{ static_cast<uint32_t>(m_impl->m_blocksPerFrame - first), {} };
+                block->used.store(sizeof(BlockHeader), std::memory_order_relaxed);
+            }
+            return nullptr;
+        }
+
+        // 2) ブロックを初期化してスレッドのカーソルを付け替える
+        std::byte* blockBegin = m_impl->buffer_begin(m_impl->m_currentBuffer) + first * m_impl->m_blockSize;
+        BlockHeader* block = ::new (static_cast<void*>(blockBegin)) BlockHeader{ static_cast<uint32_t>(blockCount), {} };
+        block->used.store(sizeof(BlockHeader), std::memory_order_relaxed);
+
+        ThreadCursor& tc = t_cursor;
+        tc.owner = this;
+        tc.epoch = m_impl->m_epoch.load(std::memory_order_acquire);
+        tc.cursor = blockBegin + sizeof(BlockHeader);
+        tc.end = blockBegin + blockCount * m_impl->m_blockSize;
+        tc.block = block;
+        return bump(tc, size, alignment);
+    }
+    size_t FrameArena::get_used_bytes() const noexcept
+    {
+        const size_t blocks = std::min(m_impl->m_nextBlock.load(std::memory_order_relaxed), m_impl->m_blocksPerFrame);
+        return blocks * m_impl->m_blockSize;
+    }
+    size_t FrameArena::get_overflow_bytes() const noexcept
+    {
+        return m_impl->m_overflowBytes.load(std::memory_order_relaxed);
+    }
+    uint64_t FrameArena::get_frame_index() const noexcept
+    {
+        return m_impl->m_frameIndex;
+    }
+    void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+    {
+        // 1) 通常はアリーナから確保する
+        if (void* p = try_allocate(bytes, alignment))
+        {
+            return p;
+        }
+
+        // 2) 容量不足でもコンテナを失敗させないよう upstream に退避する
+        m_impl->m_overflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+        return m_impl->m_upstream->allocate(bytes, alignment);
+    }
+    void FrameArena::do_deallocate(void* p, size_t bytes, size_t alignment)
+    {
+        // 1) アリーナ内の領域はフレーム境界でまとめて破棄するので何もしない
+        if (owns(p))
+        {
+            return;
+        }
+        m_impl->m_upstream->deallocate(p, bytes, alignment);
+    }
+    bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+    bool FrameArena::owns(const void* p) const noexcept
+    {
+        const std::byte* b = static_cast<const std::byte*>(p);
+        return m_impl->m_base && b >= m_impl->m_base &&
+            b < m_impl->m_base + m_impl->m_bytesPerFrame * m_impl->m_frameCount;
+    }
+} // namespace Cue::Core
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Result.h"
+
+namespace Cue::Core::Detail
+{
+#if defined(_WIN32)
+    using NativeFile = void*;
+#else
+    using NativeFile = int;
+#endif
+
+    /// @brief バックエンドへ渡す 1 回分の位置指定読み込み
+    struct IoOperation
+    {
+        // 呼び出し側の要求スロット（完了時にそのまま返る）
+        uint32_t slot = 0;
+        NativeFile file{};
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        void* destination = nullptr;
+    };
+
+    struct IoOperationResult
+    {
+        uint32_t slot = 0;
+        uint32_t bytesRead = 0;
+        // 0 で成功、それ以外は errno / GetLastError
+        uint32_t error = 0;
+    };
+
+    /// @brief 読み込みを実際に行う部分（AsyncIo の I/O スレッドからだけ呼ばれる。wake は任意のスレッドから）
+    class IoBackend
+    {
+    public:
+        IoBackend() = default;
+        virtual ~IoBackend() = default;
+        IoBackend(const IoBackend&) = delete;
+        IoBackend& operator=(const IoBackend&) = delete;
+
+        /// @brief 同時に渡せる読み込みの上限
+        [[nodiscard]] virtual uint32_t get_max_queue_depth() const noexcept = 0;
+        /// @brief 読み込みを積む（次の wait でまとめて発行してよい）
+        virtual void submit(std::span<const IoOperation> operations) = 0;
+        /// @brief 積んだ読み込みを発行し、完了か wake か timeout まで待って完了を out に足す
+        /// @param timeoutNs 負なら無期限
+        virtual void wait(std::vector<IoOperationResult>& out, int64_t timeoutNs) = 0;
+        /// @brief wait を起こす
+        virtual void wake() noexcept = 0;
+    };
+
+#if defined(__linux__)
+    /// @brief io_uring のバックエンドを作る（カーネルが対応していなければ nullptr）
+    [[nodiscard]] std::unique_ptr<IoBackend> create_io_uring_backend(uint32_t queueDepth);
+#endif
+    [[nodiscard]] std::unique_ptr<IoBackend> create_thread_pool_backend(uint32_t threadCount);
+} // namespace Cue::Core::Detail
@@ -0,0 +1,284 @@
+#include "IoBackend.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__linux__) && defined(IORING_ENTER_EXT_ARG)
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Cue::Core::Detail
+{
+    namespace
+    {
+        // ユーザーデータの上位ビットで読み込み以外の完了を見分ける
+        constexpr uint64_t k_wakeTag = 0xFFFFFFFF00000000ull;
+
+        int io_uring_setup(uint32_t entries, io_uring_params* params) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int io_uring_enter(int fd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags,
+            const void* arg, size_t argSize) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+        }
+
+        uint32_t load_acquire(const uint32_t* p) noexcept
+        {
+            return std::atomic_ref<const uint32_t>(*p).load(std::memory_order_acquire);
+        }
+
+        void store_release(uint32_t* p, uint32_t value) noexcept
+        {
+            std::atomic_ref<uint32_t>(*p).store(value, std::memory_order_release);
+        }
+
+        /// @brief 生のシステムコールで組んだ io_uring（liburing には依存しない）
+        /// @details 起床用の eventfd への読み込みを常に 1 つ仕掛けておき、wake はそこへ書く。
+        ///          待機のタイムアウトは IORING_ENTER_EXT_ARG で渡すので、カーネル 5.11 以降を要する。
+        class IoUringBackend final : public IoBackend
+        {
+        public:
+            ~IoUringBackend() override
+            {
+                if (m_sqes)
+                {
+                    ::munmap(m_sqes, m_sqesSize);
+                }
+                if (m_cqRing && m_cqRing != m_sqRing)
+                {
+                    ::munmap(m_cqRing, m_cqRingSize);
+                }
+                if (m_sqRing)
+                {
+                    ::munmap(m_sqRing, m_sqRingSize);
+                }
+                if (m_ringFd >= 0)
+                {
+                    ::close(m_ringFd);
+                }
+                if (m_wakeFd >= 0)
+                {
+                    ::close(m_wakeFd);
+                }
+            }
+
+            bool initialize(uint32_t queueDepth)
+            {
+                // 1) リングを作る（起床用の読み込みの分を 1 つ足す）
+                io_uring_params params{};
+                m_ringFd = io_uring_setup(queueDepth + 1, &params);
+                if (m_ringFd < 0)
+                {
+                    return false;
+                }
+                if ((params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+                {
+                    return false;
+                }
+
+                // 2) 投入・完了リングと SQE 配列をマップする（投入と完了は同じ領域）
+                m_sqRingSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+                    params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+                m_cqRingSize = m_sqRingSize;
+                void* ring = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    m_ringFd, IORING_OFF_SQ_RING);
+                if (ring == MAP_FAILED)
+                {
+                    return false;
+                }
+                m_sqRing = static_cast<std::byte*>(ring);
+                m_cqRing = m_sqRing;
+                m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    m_ringFd, IORING_OFF_SQES);
+                if (sqes == MAP_FAILED)
+                {
+                    return false;
+                }
+                m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+                m_sqTail = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.tail);
+                m_sqMask = *reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.ring_mask);
+                m_sqArray = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.array);
+                m_cqHead = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.head);
+                m_cqTail = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.tail);
+                m_cqMask = *reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe*>(m_cqRing + params.cq_off.cqes);
+                m_maxQueueDepth = params.sq_entries - 1;
+
+                // 3) 起床用の eventfd を作り、読み込みを仕掛ける
+                m_wakeFd = ::eventfd(0, EFD_CLOEXEC);
+                if (m_wakeFd < 0)
+                {
+                    return false;
+                }
+                arm_wake();
+                return true;
+            }
+
+            uint32_t get_max_queue_depth() const noexcept override
+            {
+                return m_maxQueueDepth;
+            }
+
+            void submit(std::span<const IoOperation> operations) override
+            {
+                for (const IoOperation& operation : operations)
+                {
+                    io_uring_sqe* sqe = next_sqe();
+                    sqe->opcode = IORING_OP_READ;
+                    sqe->fd = operation.file;
+                    sqe->off = operation.offset;
+                    sqe->addr = reinterpret_cast<uint64_t>(operation.destination);
+                    sqe->len = operation.size;
+                    sqe->user_data = operation.slot;
+                }
+            }
+
+            void wait(std::vector<IoOperationResult>& out, int64_t timeoutNs) override
+            {
+                // 1) 既に完了が溜まっていれば待たずに発行だけする
+                const bool hasCompletions = load_acquire(m_cqTail) != *m_cqHead;
+                __kernel_timespec timeout{};
+                io_uring_getevents_arg arg{};
+                if (timeoutNs >= 0)
+                {
+                    timeout.tv_sec = timeoutNs / 1000000000;
+                    timeout.tv_nsec = timeoutNs % 1000000000;
+                    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+                }
+                for (;;)
+                {
+                    const int ret = io_uring_enter(m_ringFd, m_toSubmit, hasCompletions ? 0 : 1,
+                        IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+                    if (ret >= 0)
+                    {
+                        m_toSubmit -= std::min(static_cast<uint32_t>(ret), m_toSubmit);
+                        break;
+                    }
+                    // タイムアウトやシグナルは完了を刈り取って戻る（EBUSY は完了リングが詰まっている）
+                    if (errno != EINTR || m_toSubmit == 0)
+                    {
+                        break;
+                    }
+                }
+
+                // 2) 完了を刈り取る（起床用の読み込みは仕掛け直す）
+                uint32_t head = *m_cqHead;
+                const uint32_t tail = load_acquire(m_cqTail);
+                bool isWoken = false;
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                    if (cqe.user_data == k_wakeTag)
+                    {
+                        isWoken = true;
+                        continue;
+                    }
+                    IoOperationResult result{};
+                    result.slot = static_cast<uint32_t>(cqe.user_data);
+                    if (cqe.res >= 0)
+                    {
+                        result.bytesRead = static_cast<uint32_t>(cqe.res);
+                    }
+                    else
+                    {
+                        result.error = static_cast<uint32_t>(-cqe.res);
+                    }
+                    out.push_back(result);
+                }
+                store_release(m_cqHead, head);
+                if (isWoken)
+                {
+                    arm_wake();
+                }
+            }
+
+            void wake() noexcept override
+            {
+                const uint64_t one = 1;
+                [[maybe_unused]] const ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+            }
+        private:
+            io_uring_sqe* next_sqe() noexcept
+            {
+                // 深さは get_max_queue_depth で抑えているので、投入リングが溢れることはない
+                const uint32_t tail = *m_sqTail;
+                const uint32_t index = tail & m_sqMask;
+                io_uring_sqe* sqe = &m_sqes[index];
+                std::memset(sqe, 0, sizeof(*sqe));
+                m_sqArray[index] = index;
+                store_release(m_sqTail, tail + 1);
+                ++m_toSubmit;
+                return sqe;
+            }
+
+            void arm_wake() noexcept
+            {
+                io_uring_sqe* sqe = next_sqe();
+                sqe->opcode = IORING_OP_READ;
+                sqe->fd = m_wakeFd;
+                sqe->addr = reinterpret_cast<uint64_t>(&m_wakeValue);
+                sqe->len = sizeof(m_wakeValue);
+                sqe->user_data = k_wakeTag;
+            }
+
+            int m_ringFd = -1;
+            int m_wakeFd = -1;
+            uint64_t m_wakeValue = 0;
+
+            std::byte* m_sqRing = nullptr;
+            std::byte* m_cqRing = nullptr;
+            size_t m_sqRingSize = 0;
+            size_t m_cqRingSize = 0;
+            io_uring_sqe* m_sqes = nullptr;
+            size_t m_sqesSize = 0;
+
+            uint32_t* m_sqTail = nullptr;
+            uint32_t* m_sqArray = nullptr;
+            uint32_t m_sqMask = 0;
+            uint32_t* m_cqHead = nullptr;
+            uint32_t* m_cqTail = nullptr;
+            io_uring_cqe* m_cqes = nullptr;
+            uint32_t m_cqMask = 0;
+
+            // 積んだがまだカーネルへ渡していない数
+            uint32_t m_toSubmit = 0;
+            uint32_t m_maxQueueDepth = 0;
+        };
+    } // namespace
+
+    std::unique_ptr<IoBackend> create_io_uring_backend(uint32_t queueDepth)
+    {
+        auto backend = std::make_unique<IoUringBackend>();
+        if (!backend->initialize(queueDepth))
+        {
+            return nullptr;
+        }
+        return backend;
+    }
+} // namespace Cue::Core::Detail
+
+#elif defined(__linux__)
+
+namespace Cue::Core::Detail
+{
+    std::unique_ptr<IoBackend> create_io_uring_backend(uint32_t)
+    {
+        // ヘッダが古く、待機のタイムアウトを渡せない
+        return nullptr;
+    }
+} // namespace Cue::Core::Detail
+
+#endif
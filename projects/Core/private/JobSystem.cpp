@@ -0,0 +1,476 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // 呼び出しスレッドがどのジョブシステムの何番ワーカーかを保持する
+        // （複数のジョブシステムが順に作られても取り違えないよう所有者も記録する）
+        thread_local const void* t_owner = nullptr;
+        thread_local uint32_t t_workerIndex = JobSystem::k_invalidWorkerIndex;
+        thread_local uint32_t t_randomState = 0x9E3779B9u;
+
+        // 盗みに行く相手を散らすための軽量乱数
+        uint32_t next_random() noexcept
+        {
+            uint32_t x = t_randomState;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            t_randomState = x;
+            return x;
+        }
+
+        uint32_t round_up_pow2(uint32_t v) noexcept
+        {
+            uint32_t p = 1;
+            while (p < v)
+            {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        // deque 内のジョブ。盗みと上書きが競合しても未定義動作にならないよう各フィールドを atomic にする
+        // （盗みは CAS に失敗した時点で読んだ値を捨てるので relaxed で足りる）
+        struct JobSlot
+        {
+            std::atomic<JobFunction> function{ nullptr };
+            std::atomic<void*> data{ nullptr };
+            std::atomic<JobCounter*> counter{ nullptr };
+        };
+
+        struct Job
+        {
+            JobFunction function = nullptr;
+            void* data = nullptr;
+            JobCounter* counter = nullptr;
+        };
+
+        // Chase-Lev の固定長 work-stealing deque
+        // 所有スレッドは bottom 側で push/pop し、他スレッドは top 側から steal する
+        class WorkStealingDeque
+        {
+        public:
+            explicit WorkStealingDeque(uint32_t capacity)
+                : m_slots(std::make_unique<JobSlot[]>(capacity))
+                , m_mask(static_cast<int64_t>(capacity) - 1)
+            {
+            }
+
+            bool push(const Job& job) noexcept
+            {
+                // 1) 満杯なら呼び出し側でインライン実行させる
+                const int64_t b = m_bottom.load(std::memory_order_relaxed);
+                const int64_t t = m_top.load(std::memory_order_acquire);
+                if (b - t > m_mask)
+                {
+                    return false;
+                }
+
+                // 2) スロットを書いてから bottom を公開する
+                JobSlot& slot = m_slots[static_cast<size_t>(b & m_mask)];
+                slot.function.store(job.function, std::memory_order_relaxed);
+                slot.data.store(job.data, std::memory_order_relaxed);
+                slot.counter.store(job.counter, std::memory_order_relaxed);
+                m_bottom.store(b + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool pop(Job& out) noexcept
+            {
+                // 1) 先に bottom を下げて、盗みと最後の 1 個を取り合う
+                const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+                m_bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = m_top.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    // 2) 空だったので元に戻す
+                    m_bottom.store(b + 1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                read(b, out);
+                if (t != b)
+                {
+                    return true;
+                }
+
+                // 3) 最後の 1 個は盗みと CAS で決着をつける
+                const bool isWon = m_top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+                return isWon;
+            }
+
+            bool steal(Job& out) noexcept
+            {
+                int64_t t = m_top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const int64_t b = m_bottom.load(std::memory_order_acquire);
+                if (t >= b)
+                {
+                    return false;
+                }
+
+                // 1) 読んだ後に CAS が通った場合だけ、読んだ内容が有効
+                read(t, out);
+                return m_top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] bool is_empty() const noexcept
+            {
+                return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+            }
+        private:
+            void read(int64_t index, Job& out) const noexcept
+            {
+                const JobSlot& slot = m_slots[static_cast<size_t>(index & m_mask)];
+                out.function = slot.function.load(std::memory_order_relaxed);
+                out.data = slot.data.load(std::memory_order_relaxed);
+                out.counter = slot.counter.load(std::memory_order_relaxed);
+            }
+
+            // top と bottom は別スレッドが書くので偽共有を避ける
+            alignas(64) std::atomic<int64_t> m_top{ 0 };
+            alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+            std::unique_ptr<JobSlot[]> m_slots;
+            int64_t m_mask = 0;
+        };
+
+        struct alignas(64) Worker
+        {
+            explicit Worker(uint32_t capacity)
+                : deque(capacity)
+            {
+            }
+            WorkStealingDeque deque;
+            std::thread thread;
+        };
+    }
+
+    struct JobSystem::Impl
+    {
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        // ワーカー以外のスレッドから投入されたジョブの受け口（頻度が低いのでロックで守る）
+        std::mutex m_injectMutex;
+        std::vector<Job> m_injectQueue;
+        size_t m_injectHead = 0;
+        size_t m_injectCount = 0;
+        std::atomic<uint32_t> m_injectPending{ 0 };
+
+        // 待機中ワーカーの起床用
+        std::atomic<uint32_t> m_wakeSignal{ 0 };
+        std::atomic<uint32_t> m_sleepingCount{ 0 };
+        std::atomic<bool> m_isRunning{ false };
+
+        uint32_t m_workerCount = 0;
+
+        bool push_inject(const Job& job)
+        {
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            if (m_injectCount == m_injectQueue.size())
+            {
+                return false;
+            }
+            m_injectQueue[(m_injectHead + m_injectCount) % m_injectQueue.size()] = job;
+            ++m_injectCount;
+            m_injectPending.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop_inject(Job& out)
+        {
+            // 1) 空のときはロックを取らない
+            if (m_injectPending.load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            if (m_injectCount == 0)
+            {
+                return false;
+            }
+            out = m_injectQueue[m_injectHead];
+            m_injectHead = (m_injectHead + 1) % m_injectQueue.size();
+            --m_injectCount;
+            m_injectPending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool try_get_job(uint32_t workerIndex, Job& out)
+        {
+            // 1) 自分の deque（局所性が高い新しいものから）
+            if (workerIndex < m_workerCount && m_workers[workerIndex]->deque.pop(out))
+            {
+                return true;
+            }
+
+            // 2) 外部スレッドからの投入分
+            if (pop_inject(out))
+            {
+                return true;
+            }
+
+            // 3) 他のワーカーから古いものを盗む
+            const uint32_t start = next_random();
+            for (uint32_t i = 0; i < m_workerCount; ++i)
+            {
+                const uint32_t victim = (start + i) % m_workerCount;
+                if (victim == workerIndex)
+                {
+                    continue;
+                }
+                if (m_workers[victim]->deque.steal(out))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void execute(const Job& job)
+        {
+            job.function(job.data);
+            if (job.counter)
+            {
+                job.counter->m_pending.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        void wake(uint32_t jobCount)
+        {
+            // 1) 寝ているワーカーがいなければ共有変数に書き込まない
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_sleepingCount.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+            m_wakeSignal.fetch_add(1, std::memory_order_seq_cst);
+            if (jobCount == 1)
+            {
+                m_wakeSignal.notify_one();
+            }
+            else
+            {
+                m_wakeSignal.notify_all();
+            }
+        }
+
+        void worker_main(uint32_t workerIndex, const void* owner)
+        {
+            t_owner = owner;
+            t_workerIndex = workerIndex;
+            t_randomState = 0x9E3779B9u ^ (workerIndex * 0x85EBCA6Bu + 1);
+#if CUE_PROFILE_ENABLED
+            Profiler::set_thread_name("JobWorker");
+#endif
+
+            constexpr uint32_t k_spinCount = 64;
+            uint32_t idleCount = 0;
+            Job job;
+            while (m_isRunning.load(std::memory_order_acquire))
+            {
+                // 1) 仕事があれば実行する
+                if (try_get_job(workerIndex, job))
+                {
+                    execute(job);
+                    idleCount = 0;
+                    continue;
+                }
+
+                // 2) しばらくは譲りながら回って、短い空白での起床遅延を避ける
+                if (++idleCount < k_spinCount)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // 3) 寝る前に再確認し、取りこぼしを防ぐ
+                const uint32_t signal = m_wakeSignal.load(std::memory_order_seq_cst);
+                m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+                if (try_get_job(workerIndex, job))
+                {
+                    m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+                    execute(job);
+                    idleCount = 0;
+                    continue;
+                }
+                if (m_isRunning.load(std::memory_order_acquire))
+                {
+                    m_wakeSignal.wait(signal, std::memory_order_seq_cst);
+                }
+                m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+                idleCount = 0;
+            }
+
+            t_owner = nullptr;
+            t_workerIndex = k_invalidWorkerIndex;
+        }
+    };
+
+    JobSystem::JobSystem()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    JobSystem::~JobSystem()
+    {
+        shutdown();
+    }
+    Result JobSystem::initialize(const JobSystemDesc& desc)
+    {
+        // 1) 二重起動は状態が壊れるので拒否する
+        if (m_impl->m_isRunning.load(std::memory_order_acquire))
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidState,
+                Severity::Error,
+                0, "JobSystem is already initialized.");
+        }
+        if (desc.queueCapacity == 0)
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidArg,
+                Severity::Error,
+                0, "JobSystem queue capacity must be positive.");
+        }
+
+        // 2) 実行スレッド数を決める（呼び出しスレッドも 1 つに数える）
+        uint32_t workerCount = desc.workerCount;
+        if (workerCount == 0)
+        {
+            workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        const uint32_t capacity = round_up_pow2(desc.queueCapacity);
+
+        m_impl->m_workers.clear();
+        m_impl->m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_impl->m_workers.push_back(std::make_unique<Worker>(capacity));
+        }
+        m_impl->m_injectQueue.assign(capacity, Job{});
+        m_impl->m_injectHead = 0;
+        m_impl->m_injectCount = 0;
+        m_impl->m_workerCount = workerCount;
+
+        // 3) 呼び出しスレッドをワーカー 0 として登録する
+        t_owner = this;
+        t_workerIndex = 0;
+
+        // 4) 残りのワーカーを起動する
+        m_impl->m_isRunning.store(true, std::memory_order_release);
+        for (uint32_t i = 1; i < workerCount; ++i)
+        {
+            Impl* impl = m_impl.get();
+            m_impl->m_workers[i]->thread = std::thread([impl, i, this]()
+                {
+                    impl->worker_main(i, this);
+                });
+        }
+        return Result::ok();
+    }
+    void JobSystem::shutdown()
+    {
+        if (!m_impl || !m_impl->m_isRunning.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        // 1) 寝ているワーカーを起こして終了させる
+        m_impl->m_wakeSignal.fetch_add(1, std::memory_order_seq_cst);
+        m_impl->m_wakeSignal.notify_all();
+        for (auto& worker : m_impl->m_workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+
+        // 2) 呼び出しスレッドの登録を解除する
+        if (t_owner == this)
+        {
+            t_owner = nullptr;
+            t_workerIndex = k_invalidWorkerIndex;
+        }
+        // 3) 領域ごと手放す
+        std::vector<std::unique_ptr<Worker>>().swap(m_impl->m_workers);
+        std::vector<Job>().swap(m_impl->m_injectQueue);
+        m_impl->m_workerCount = 0;
+    }
+    void JobSystem::run(const JobDecl* jobs, uint32_t count, JobCounter* counter)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // 1) 完了待ちより先に加算しておく（投入直後に完了しても負にならない）
+        if (counter)
+        {
+            counter->m_pending.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        // 2) 起動前はその場で実行する（初期化順に依存するコードを壊さない）
+        if (!m_impl->m_isRunning.load(std::memory_order_acquire))
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                Impl::execute(Job{ jobs[i].function, jobs[i].data, counter });
+            }
+            return;
+        }
+
+        // 3) ワーカーなら自分の deque、それ以外は共有キューへ積む
+        const uint32_t workerIndex = get_current_worker_index();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Job job{ jobs[i].function, jobs[i].data, counter };
+            const bool isQueued = (workerIndex != k_invalidWorkerIndex)
+                ? m_impl->m_workers[workerIndex]->deque.push(job)
+                : m_impl->push_inject(job);
+
+            // 4) 溢れた分はその場で実行して、待機で詰まらないようにする
+            if (!isQueued)
+            {
+                Impl::execute(job);
+            }
+        }
+        m_impl->wake(count);
+    }
+    void JobSystem::wait(JobCounter& counter)
+    {
+        // 1) ブロックせずに他のジョブを手伝う（入れ子の fork-join でも詰まらない）
+        const uint32_t workerIndex = get_current_worker_index();
+        Job job;
+        while (!counter.is_done())
+        {
+            if (m_impl->m_isRunning.load(std::memory_order_acquire) && m_impl->try_get_job(workerIndex, job))
+            {
+                Impl::execute(job);
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    }
+    uint32_t JobSystem::get_worker_count() const noexcept
+    {
+        return m_impl->m_workerCount;
+    }
+    uint32_t JobSystem::get_current_worker_index() const noexcept
+    {
+        return (t_owner == this) ? t_workerIndex : k_invalidWorkerIndex;
+    }
+} // namespace Cue::Core
@@ -0,0 +1,537 @@
+#include "Logger.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // 呼び出し側が積む固定長レコード（文字列は複製せずポインタだけ持つ）
+        struct LogRecord
+        {
+            int64_t timestamp;
+            const char* message;
+            const char* file;
+            const char* function;
+            uint32_t messageLength;
+            uint32_t native;
+            uint32_t line;
+            uint32_t threadIndex;
+            Facility facility;
+            Code code;
+            Severity severity;
+        };
+
+        // リングの状態
+        enum class RingState : uint8_t
+        {
+            // 生産者のスレッドが使っている
+            Active,
+            // 生産者のスレッドが終わった（残りを掃き出したら Free にする）
+            Released,
+            // 掃き出し終えて、次に登録するスレッドが使い回せる
+            Free,
+        };
+
+        struct ThreadRingCache;
+
+        // 1 スレッド（生産者）と書き出しスレッド（消費者）の間の SPSC リング
+        struct alignas(64) LogRing
+        {
+            explicit LogRing(uint32_t capacity, uint32_t index)
+                : records(std::make_unique_for_overwrite<LogRecord[]>(capacity))
+                , mask(capacity - 1)
+                , threadIndex(index)
+            {
+            }
+
+            std::unique_ptr<LogRecord[]> records;
+            uint32_t mask;
+            uint32_t threadIndex;
+            std::atomic<RingState> state{ RingState::Active };
+            // 使っているスレッドのキャッシュ（g_ringOwnerMutex の下で読み書きする）
+            ThreadRingCache* cache = nullptr;
+
+            // 生産者と消費者が別々に書くので偽共有を避ける
+            alignas(64) std::atomic<uint64_t> tail{ 0 };
+            uint64_t cachedHead = 0;
+            std::atomic<uint64_t> dropped{ 0 };
+            alignas(64) std::atomic<uint64_t> head{ 0 };
+        };
+
+        // リングとスレッドの結び付きを切る時の排他（ロガーの停止とスレッドの終了のどちらが先でもよいよう大域に置く）
+        std::mutex g_ringOwnerMutex;
+
+        // スレッド毎にどのロガーのどのリングを使うかを覚えておく
+        struct ThreadRingCache
+        {
+            const void* owner = nullptr;
+            uint64_t generation = 0;
+            LogRing* ring = nullptr;
+
+            ~ThreadRingCache()
+            {
+                release();
+            }
+
+            /// @brief 使っていたリングを手放す（ロガーが先に止まっていればリングは既に外されている）
+            void release() noexcept
+            {
+                std::lock_guard<std::mutex> lock(g_ringOwnerMutex);
+                if (ring)
+                {
+                    ring->cache = nullptr;
+                    ring->state.store(RingState::Released, std::memory_order_release);
+                }
+                owner = nullptr;
+                ring = nullptr;
+            }
+        };
+        thread_local ThreadRingCache t_ringCache;
+
+        // ロガーの作り直しで古いリングを使わないよう世代はプロセス内で一意にする
+        uint64_t next_generation() noexcept
+        {
+            static std::atomic<uint64_t> s_generation{ 0 };
+            return s_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        uint32_t round_up_pow2(uint32_t v) noexcept
+        {
+            uint32_t p = 1;
+            while (p < v)
+            {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        const char* to_string(Severity s) noexcept
+        {
+            switch (s)
+            {
+            case Severity::Info: return "Info";
+            case Severity::Warning: return "Warning";
+            case Severity::Error: return "Error";
+            case Severity::Fatal: return "Fatal";
+            }
+            return "Unknown";
+        }
+
+        const char* to_string(Facility f) noexcept
+        {
+            switch (f)
+            {
+            case Facility::Core: return "Core";
+            case Facility::Platform: return "Platform";
+            case Facility::IO: return "IO";
+            case Facility::Graphics: return "Graphics";
+            case Facility::D3D12: return "D3D12";
+            }
+            return "Unknown";
+        }
+
+        const char* to_string(Code c) noexcept
+        {
+            switch (c)
+            {
+            case Code::Ok: return "Ok";
+            case Code::InvalidArg: return "InvalidArg";
+            case Code::InvalidState: return "InvalidState";
+            case Code::NotFound: return "NotFound";
+            case Code::AccessDenied: return "AccessDenied";
+            case Code::IoError: return "IoError";
+            case Code::OutOfMemory: return "OutOfMemory";
+            case Code::Unsupported: return "Unsupported";
+            case Code::CreationFailed: return "CreationFailed";
+            case Code::GettingInfoFailed: return "GettingInfoFailed";
+            case Code::Cancelled: return "Cancelled";
+            case Code::Unknown: return "Unknown";
+            }
+            return "Unknown";
+        }
+    }
+
+    struct Logger::Impl
+    {
+        using Clock = std::chrono::steady_clock;
+
+        LoggerDesc m_desc{};
+        uint32_t m_ringCapacity = 0;
+        uint64_t m_generation = 0;
+        Clock::time_point m_startTime{};
+        std::FILE* m_file = nullptr;
+
+        // リングは登録後に動かさないよう固定長の表に置く（消費者はロック無しで走査する）
+        std::unique_ptr<LogRing> m_rings[k_maxThreads];
+        std::atomic<uint32_t> m_ringCount{ 0 };
+        std::mutex m_registerMutex;
+
+        std::thread m_thread;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic<bool> m_isRunning{ false };
+        std::atomic<uint64_t> m_droppedCount{ 0 };
+        std::atomic<uint64_t> m_writtenCount{ 0 };
+
+        // 書き出しスレッド専用の作業領域
+        std::vector<LogRecord> m_batch;
+        uint64_t m_drainedTails[k_maxThreads] = {};
+        RingState m_drainedStates[k_maxThreads] = {};
+        std::string m_text;
+
+        LogRing* acquire_ring() noexcept
+        {
+            // 1) 登録済みなら thread_local のキャッシュを使う
+            ThreadRingCache& cache = t_ringCache;
+            if (cache.owner == this && cache.generation == m_generation)
+            {
+                return cache.ring;
+            }
+
+            // 2) 別のロガーのリングを持っていれば手放す
+            if (cache.ring)
+            {
+                cache.release();
+            }
+
+            // 3) 終わったスレッドのリングが掃き出し済みなら使い回し、無ければ作って登録する
+            std::lock_guard<std::mutex> lock(m_registerMutex);
+            const uint32_t ringCount = m_ringCount.load(std::memory_order_relaxed);
+            LogRing* ring = nullptr;
+            for (uint32_t i = 0; i < ringCount && !ring; ++i)
+            {
+                if (m_rings[i]->state.load(std::memory_order_acquire) == RingState::Free)
+                {
+                    ring = m_rings[i].get();
+                    ring->cachedHead = ring->head.load(std::memory_order_acquire);
+                    ring->state.store(RingState::Active, std::memory_order_relaxed);
+                }
+            }
+            if (!ring)
+            {
+                if (ringCount >= k_maxThreads)
+                {
+                    return nullptr;
+                }
+                m_rings[ringCount] = std::make_unique<LogRing>(m_ringCapacity, ringCount);
+                ring = m_rings[ringCount].get();
+                m_ringCount.store(ringCount + 1, std::memory_order_release);
+            }
+
+            std::lock_guard<std::mutex> ownerLock(g_ringOwnerMutex);
+            ring->cache = &cache;
+            cache.owner = this;
+            cache.generation = m_generation;
+            cache.ring = ring;
+            return ring;
+        }
+
+        void wake() noexcept
+        {
+            m_wakeCondition.notify_one();
+        }
+
+        // 全リングから取り出して時刻順に並べ、まとめて書き出す
+        size_t drain()
+        {
+            // 1) 各リングの公開済み分を取り出す
+            m_batch.clear();
+            const uint32_t ringCount = m_ringCount.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < ringCount; ++i)
+            {
+                LogRing& ring = *m_rings[i];
+                // 生産者のスレッドが終わっていれば、この後に読む tail で最後まで積まれている
+                m_drainedStates[i] = ring.state.load(std::memory_order_acquire);
+                const uint64_t head = ring.head.load(std::memory_order_relaxed);
+                const uint64_t tail = ring.tail.load(std::memory_order_acquire);
+                for (uint64_t p = head; p != tail; ++p)
+                {
+                    m_batch.push_back(ring.records[p & ring.mask]);
+                }
+                m_drainedTails[i] = tail;
+
+                const uint64_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+                m_droppedCount.fetch_add(dropped, std::memory_order_relaxed);
+            }
+            if (m_batch.empty())
+            {
+                release_drained_rings(ringCount);
+                return 0;
+            }
+            const size_t count = m_batch.size();
+
+            // 2) スレッドを跨いでも発生順に読めるよう時刻で並べる
+            std::stable_sort(m_batch.begin(), m_batch.end(),
+                [](const LogRecord& a, const LogRecord& b) { return a.timestamp < b.timestamp; });
+
+            // 3) 整形してまとめて書き出す（書き込み回数を減らす）
+            m_text.clear();
+            char line[512];
+            for (const LogRecord& rec : m_batch)
+            {
+                const double seconds = static_cast<double>(rec.timestamp) * 1e-9;
+                const int n = std::snprintf(line, sizeof(line),
+                    "[%12.6f][T%03u][%s][%s] %s (native=0x%08X): %.*s (%s:%u %s)\n",
+                    seconds, rec.threadIndex,
+                    to_string(rec.severity), to_string(rec.facility), to_string(rec.code),
+                    rec.native,
+                    static_cast<int>(rec.messageLength), rec.message ? rec.message : "",
+                    rec.file ? rec.file : "", rec.line, rec.function ? rec.function : "");
+                if (n > 0)
+                {
+                    m_text.append(line, std::min(static_cast<size_t>(n), sizeof(line) - 1));
+                }
+            }
+            if (m_file)
+            {
+                std::fwrite(m_text.data(), 1, m_text.size(), m_file);
+                std::fflush(m_file);
+            }
+            if (m_desc.isStderrEnabled)
+            {
+                std::fwrite(m_text.data(), 1, m_text.size(), stderr);
+            }
+            m_writtenCount.fetch_add(count, std::memory_order_relaxed);
+
+            // 4) 書き出し後に消費位置を進める（flush が書き込み完了まで待てるように）
+            for (uint32_t i = 0; i < ringCount; ++i)
+            {
+                m_rings[i]->head.store(m_drainedTails[i], std::memory_order_release);
+            }
+            release_drained_rings(ringCount);
+            return count;
+        }
+
+        /// @brief 生産者のスレッドが終わって最後まで掃き出したリングを、次のスレッドが使えるよう空きに戻す
+        void release_drained_rings(uint32_t ringCount) noexcept
+        {
+            for (uint32_t i = 0; i < ringCount; ++i)
+            {
+                LogRing& ring = *m_rings[i];
+                if (m_drainedStates[i] == RingState::Released && ring.head.load(std::memory_order_relaxed) == m_drainedTails[i])
+                {
+                    ring.state.store(RingState::Free, std::memory_order_release);
+                }
+            }
+        }
+
+        void writer_main()
+        {
+            set_thread_memory_tag(Facility::Core);
+            const auto interval = std::chrono::milliseconds(std::max(m_desc.flushIntervalMs, 1u));
+            while (m_isRunning.load(std::memory_order_acquire))
+            {
+                // 1) 溜まっていれば続けて掃き出し、無ければ一定時間待つ
+                if (drain() != 0)
+                {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCondition.wait_for(lock, interval);
+            }
+
+            // 2) 停止前に残りを書き出す
+            while (drain() != 0)
+            {
+            }
+        }
+    };
+
+    Logger::Logger()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    Logger::~Logger()
+    {
+        shutdown();
+    }
+    Result Logger::initialize(const LoggerDesc& desc)
+    {
+        // 1) 二重起動は状態が壊れるので拒否する
+        if (m_impl->m_isRunning.load(std::memory_order_acquire))
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidState,
+                Severity::Error,
+                0, "Logger is already initialized.");
+        }
+        if (desc.ringCapacity == 0)
+        {
+            return Result::fail(
+                Facility::Core,
+                Code::InvalidArg,
+                Severity::Error,
+                0, "Logger ring capacity must be positive.");
+        }
+
+        // 2) 出力先を開く
+        std::FILE* file = nullptr;
+        if (desc.filePath)
+        {
+            file = std::fopen(desc.filePath, "ab");
+            if (!file)
+            {
+                return Result::fail(
+                    Facility::IO,
+                    Code::IoError,
+                    Severity::Error,
+                    0, "Failed to open log file.");
+            }
+        }
+
+        // 3) 世代を進めて古いキャッシュを無効化する（前回のリングは shutdown で手放してある）
+        m_impl->m_desc = desc;
+        m_impl->m_ringCapacity = round_up_pow2(desc.ringCapacity);
+        m_impl->m_generation = next_generation();
+        m_impl->m_startTime = Impl::Clock::now();
+        m_impl->m_file = file;
+        m_impl->m_batch.reserve(static_cast<size_t>(m_impl->m_ringCapacity) * 4);
+
+        // 4) 書き出しスレッドを起動する
+        m_impl->m_isRunning.store(true, std::memory_order_release);
+        Impl* impl = m_impl.get();
+        m_impl->m_thread = std::thread([impl]() { impl->writer_main(); });
+        return Result::ok();
+    }
+    void Logger::shutdown()
+    {
+        if (!m_impl || !m_impl->m_isRunning.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        // 1) 書き出しスレッドに残りを掃き出させてから止める
+        m_impl->wake();
+        if (m_impl->m_thread.joinable())
+        {
+            m_impl->m_thread.join();
+        }
+        if (m_impl->m_file)
+        {
+            std::fclose(m_impl->m_file);
+            m_impl->m_file = nullptr;
+        }
+
+        // 2) 各スレッドのキャッシュから外してからリングを手放す（停止後の log は積まずに返る）
+        std::lock_guard<std::mutex> lock(g_ringOwnerMutex);
+        const uint32_t ringCount = m_impl->m_ringCount.exchange(0, std::memory_order_acq_rel);
+        for (uint32_t i = 0; i < ringCount; ++i)
+        {
+            LogRing& ring = *m_impl->m_rings[i];
+            if (ring.cache)
+            {
+                ring.cache->owner = nullptr;
+                ring.cache->ring = nullptr;
+            }
+            m_impl->m_droppedCount.fetch_add(ring.dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_impl->m_rings[i].reset();
+        }
+        std::vector<LogRecord>().swap(m_impl->m_batch);
+        std::string().swap(m_impl->m_text);
+    }
+    bool Logger::log(const Result& r) noexcept
+    {
+        // 1) 記録対象かを判定する
+        const Severity severity = r.get_severity();
+        if (severity < m_impl->m_desc.minSeverity || !m_impl->m_isRunning.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        LogRing* ring = m_impl->acquire_ring();
+        if (!ring)
+        {
+            m_impl->m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // 2) 空きを確認する（消費者の位置は満杯に見えたときだけ読み直す）
+        const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        if (tail - ring->cachedHead > ring->mask)
+        {
+            ring->cachedHead = ring->head.load(std::memory_order_acquire);
+            while (tail - ring->cachedHead > ring->mask)
+            {
+                if (m_impl->m_desc.overflowPolicy == LogOverflowPolicy::Drop ||
+                    !m_impl->m_isRunning.load(std::memory_order_relaxed))
+                {
+                    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                m_impl->wake();
+                std::this_thread::yield();
+                ring->cachedHead = ring->head.load(std::memory_order_acquire);
+            }
+        }
+
+        // 3) レコードを書いて公開する
+        const ResultDiagnostic diagnostic = r.get_diagnostic();
+        LogRecord& rec = ring->records[tail & ring->mask];
+        rec.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Impl::Clock::now() - m_impl->m_startTime).count();
+        rec.message = diagnostic.message.data();
+        rec.messageLength = static_cast<uint32_t>(diagnostic.message.size());
+        rec.file = diagnostic.file;
+        rec.function = diagnostic.function;
+        rec.native = r.get_native();
+        rec.line = diagnostic.line;
+        rec.threadIndex = ring->threadIndex;
+        rec.facility = r.get_facility();
+        rec.code = r.get_code();
+        rec.severity = severity;
+        ring->tail.store(tail + 1, std::memory_order_release);
+
+        // 4) 致命的なものは落ちる前に書き出したいので即座に起こす
+        if (severity == Severity::Fatal)
+        {
+            m_impl->wake();
+        }
+        return true;
+    }
+    void Logger::flush()
+    {
+        if (!m_impl->m_isRunning.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // 1) 呼び出し時点の各リングの末尾まで消費されるのを待つ
+        const uint32_t ringCount = m_impl->m_ringCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < ringCount; ++i)
+        {
+            LogRing& ring = *m_impl->m_rings[i];
+            const uint64_t tail = ring.tail.load(std::memory_order_acquire);
+            while (ring.head.load(std::memory_order_acquire) < tail &&
+                m_impl->m_isRunning.load(std::memory_order_acquire))
+            {
+                m_impl->wake();
+                std::this_thread::yield();
+            }
+        }
+    }
+    uint64_t Logger::get_dropped_count() const noexcept
+    {
+        // 1) リング側でまだ集計されていない分も含める
+        uint64_t dropped = m_impl->m_droppedCount.load(std::memory_order_relaxed);
+        const uint32_t ringCount = m_impl->m_ringCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < ringCount; ++i)
+        {
+            dropped += m_impl->m_rings[i]->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+    uint64_t Logger::get_written_count() const noexcept
+    {
+        return m_impl->m_writtenCount.load(std::memory_order_relaxed);
+    }
+} // namespace Cue::Core
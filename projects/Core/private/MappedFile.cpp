@@ -0,0 +1,168 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // パスを終端付きで写すための上限（動的確保を避ける）
+        constexpr size_t k_maxPath = 1024;
+    } // namespace
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_isEmpty = std::exchange(other.m_isEmpty, false);
+#if defined(_WIN32)
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    Result MappedFile::open(std::string_view path)
+    {
+        close();
+        if (path.empty() || path.size() >= k_maxPath)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "MappedFile path is invalid.");
+        }
+
+#if defined(_WIN32)
+        // 1) UTF-8 のパスを UTF-16 へ変換して開く
+        wchar_t widePath[k_maxPath];
+        const int length = ::MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()),
+            widePath, static_cast<int>(k_maxPath - 1));
+        if (length <= 0)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, ::GetLastError(),
+                "MappedFile path is not valid UTF-8.");
+        }
+        widePath[length] = L'\0';
+        HANDLE file = ::CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            const DWORD error = ::GetLastError();
+            return Result::fail(Facility::IO,
+                error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND ? Code::NotFound : Code::IoError,
+                Severity::Error, error, "MappedFile failed to open the file.");
+        }
+
+        // 2) 大きさを確かめてマップする（マップ後はハンドルを閉じてよい）
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size))
+        {
+            const DWORD error = ::GetLastError();
+            ::CloseHandle(file);
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, error, "MappedFile failed to get the size.");
+        }
+        if (size.QuadPart == 0)
+        {
+            ::CloseHandle(file);
+            m_isEmpty = true;
+            return Result::ok();
+        }
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (!mapping)
+        {
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, ::GetLastError(),
+                "MappedFile failed to create the mapping.");
+        }
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            const DWORD error = ::GetLastError();
+            ::CloseHandle(mapping);
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, error, "MappedFile failed to map the view.");
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const std::byte*>(view);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        // 1) 終端付きのパスを作って開く
+        char terminated[k_maxPath];
+        path.copy(terminated, path.size());
+        terminated[path.size()] = '\0';
+        const int fd = ::open(terminated, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            const int error = errno;
+            return Result::fail(Facility::IO, error == ENOENT ? Code::NotFound : Code::IoError, Severity::Error,
+                static_cast<uint32_t>(error), "MappedFile failed to open the file.");
+        }
+
+        // 2) 大きさを確かめてマップする（マップ後は記述子を閉じてよい）
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, static_cast<uint32_t>(error),
+                "MappedFile failed to get the size.");
+        }
+        if (st.st_size == 0)
+        {
+            ::close(fd);
+            m_isEmpty = true;
+            return Result::ok();
+        }
+        void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, static_cast<uint32_t>(errno),
+                "MappedFile failed to map the file.");
+        }
+        m_data = static_cast<const std::byte*>(view);
+        m_size = static_cast<size_t>(st.st_size);
+#endif
+        return Result::ok();
+    }
+
+    void MappedFile::close() noexcept
+    {
+        if (m_data)
+        {
+#if defined(_WIN32)
+            ::UnmapViewOfFile(m_data);
+            ::CloseHandle(m_mapping);
+            m_mapping = nullptr;
+#else
+            ::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_isEmpty = false;
+    }
+} // namespace Cue::Core
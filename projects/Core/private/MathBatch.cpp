@@ -0,0 +1,153 @@
+#include "MathBatch.h"
+
+namespace Cue::Math
+{
+    namespace
+    {
+        // 端数や SIMD 非対応環境用の 1 要素分の処理
+        inline void transform_one(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t i, float w) noexcept
+        {
+            const float x = in.x[i];
+            const float y = in.y[i];
+            const float z = in.z[i];
+            out.x[i] = x * m.r[0].x + y * m.r[1].x + z * m.r[2].x + w * m.r[3].x;
+            out.y[i] = x * m.r[0].y + y * m.r[1].y + z * m.r[2].y + w * m.r[3].y;
+            out.z[i] = x * m.r[0].z + y * m.r[1].z + z * m.r[2].z + w * m.r[3].z;
+        }
+
+#if CUE_MATH_AVX2
+        inline __m256 madd8(__m256 a, __m256 b, __m256 c) noexcept
+        {
+            return _mm256_fmadd_ps(a, b, c);
+        }
+#endif
+#if CUE_MATH_SSE41
+        inline __m128 madd4(__m128 a, __m128 b, __m128 c) noexcept
+        {
+            return Detail::madd(a, b, c);
+        }
+#endif
+
+        // SoA なので要素をまたいだシャッフルが不要で、行列の各成分を splat して積和するだけで済む
+        void transform_streams(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count, float w) noexcept
+        {
+            size_t i = 0;
+#if CUE_MATH_AVX2
+            {
+                const __m256 m00 = _mm256_set1_ps(m.r[0].x), m01 = _mm256_set1_ps(m.r[0].y), m02 = _mm256_set1_ps(m.r[0].z);
+                const __m256 m10 = _mm256_set1_ps(m.r[1].x), m11 = _mm256_set1_ps(m.r[1].y), m12 = _mm256_set1_ps(m.r[1].z);
+                const __m256 m20 = _mm256_set1_ps(m.r[2].x), m21 = _mm256_set1_ps(m.r[2].y), m22 = _mm256_set1_ps(m.r[2].z);
+                const __m256 t0 = _mm256_set1_ps(m.r[3].x * w), t1 = _mm256_set1_ps(m.r[3].y * w), t2 = _mm256_set1_ps(m.r[3].z * w);
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256 x = _mm256_loadu_ps(in.x + i);
+                    const __m256 y = _mm256_loadu_ps(in.y + i);
+                    const __m256 z = _mm256_loadu_ps(in.z + i);
+                    _mm256_storeu_ps(out.x + i, madd8(x, m00, madd8(y, m10, madd8(z, m20, t0))));
+                    _mm256_storeu_ps(out.y + i, madd8(x, m01, madd8(y, m11, madd8(z, m21, t1))));
+                    _mm256_storeu_ps(out.z + i, madd8(x, m02, madd8(y, m12, madd8(z, m22, t2))));
+                }
+            }
+#endif
+#if CUE_MATH_SSE41
+            {
+                const __m128 m00 = _mm_set1_ps(m.r[0].x), m01 = _mm_set1_ps(m.r[0].y), m02 = _mm_set1_ps(m.r[0].z);
+                const __m128 m10 = _mm_set1_ps(m.r[1].x), m11 = _mm_set1_ps(m.r[1].y), m12 = _mm_set1_ps(m.r[1].z);
+                const __m128 m20 = _mm_set1_ps(m.r[2].x), m21 = _mm_set1_ps(m.r[2].y), m22 = _mm_set1_ps(m.r[2].z);
+                const __m128 t0 = _mm_set1_ps(m.r[3].x * w), t1 = _mm_set1_ps(m.r[3].y * w), t2 = _mm_set1_ps(m.r[3].z * w);
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128 x = _mm_loadu_ps(in.x + i);
+                    const __m128 y = _mm_loadu_ps(in.y + i);
+                    const __m128 z = _mm_loadu_ps(in.z + i);
+                    _mm_storeu_ps(out.x + i, madd4(x, m00, madd4(y, m10, madd4(z, m20, t0))));
+                    _mm_storeu_ps(out.y + i, madd4(x, m01, madd4(y, m11, madd4(z, m21, t1))));
+                    _mm_storeu_ps(out.z + i, madd4(x, m02, madd4(y, m12, madd4(z, m22, t2))));
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                transform_one(m, in, out, i, w);
+            }
+        }
+    }
+
+    void transform_points(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept
+    {
+        transform_streams(m, in, out, count, 1.0f);
+    }
+    void transform_vectors(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept
+    {
+        transform_streams(m, in, out, count, 0.0f);
+    }
+    void transform_matrices(const float4x4* in, const float4x4& m, float4x4* out, size_t count) noexcept
+    {
+        size_t i = 0;
+#if CUE_MATH_AVX2
+        // 1) 右辺が共通なので b の各行を 256bit に 2 回複製して保持し、2 行ずつ計算する
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.r[0].x));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.r[1].x));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.r[2].x));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.r[3].x));
+        for (; i < count; ++i)
+        {
+            const float* a = &in[i].r[0].x;
+            float* o = &out[i].r[0].x;
+            for (int row = 0; row < 4; row += 2)
+            {
+                const __m256 rows = _mm256_loadu_ps(a + row * 4);
+                __m256 v = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+                v = madd8(_mm256_permute_ps(rows, 0x55), b1, v);
+                v = madd8(_mm256_permute_ps(rows, 0xAA), b2, v);
+                v = madd8(_mm256_permute_ps(rows, 0xFF), b3, v);
+                _mm256_storeu_ps(o + row * 4, v);
+            }
+        }
+#else
+        for (; i < count; ++i)
+        {
+            out[i] = multiply(in[i], m);
+        }
+#endif
+    }
+    void multiply_matrices(const float4x4* a, const float4x4* b, float4x4* out, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = multiply(a[i], b[i]);
+        }
+    }
+
+    namespace Scalar
+    {
+        void transform_points(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                transform_one(m, in, out, i, 1.0f);
+            }
+        }
+        void transform_vectors(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                transform_one(m, in, out, i, 0.0f);
+            }
+        }
+        void transform_matrices(const float4x4* in, const float4x4& m, float4x4* out, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = Scalar::multiply(in[i], m);
+            }
+        }
+        void multiply_matrices(const float4x4* a, const float4x4* b, float4x4* out, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = Scalar::multiply(a[i], b[i]);
+            }
+        }
+    }
+} // namespace Cue::Math
@@ -0,0 +1,408 @@
+#include "MemoryTracker.h"
+
+#if CUE_MEMORY_TRACKING_ENABLED
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace Cue::Core
+{
+#if CUE_MEMORY_TRACKING_ENABLED
+    namespace
+    {
+        // 予算の状態（超えた時点で Pending、check_memory_budgets で返したら Reported、下回ったら Under に戻す）
+        constexpr uint8_t k_budgetUnder = 0;
+        constexpr uint8_t k_budgetPending = 1;
+        constexpr uint8_t k_budgetReported = 2;
+
+        /// @brief タグ毎のカウンタ（タグ同士の偽共有を避ける）
+        /// @details 確保・解放の度に書くのは liveBytes と確保数か解放数の 2 つだけにし、
+        ///          生存数とフレーム毎の確保数は読む側で差から求める。
+        struct alignas(64) TagCounters
+        {
+            std::atomic<uint64_t> liveBytes{ 0 };
+            std::atomic<uint64_t> peakBytes{ 0 };
+            std::atomic<uint64_t> allocCount{ 0 };
+            std::atomic<uint64_t> freeCount{ 0 };
+            // 直前の begin_memory_frame 時点の allocCount と、その前のフレームの確保数
+            std::atomic<uint64_t> frameStartCount{ 0 };
+            std::atomic<uint64_t> lastFrameCount{ 0 };
+            std::atomic<uint64_t> budgetBytes{ 0 };
+            std::atomic<uint64_t> overBudgetBytes{ 0 };
+            std::atomic<uint8_t> budgetState{ k_budgetUnder };
+        };
+
+        /// @brief ユーザー領域の直前に置くヘッダ（解放時にタグと大きさを引く）
+        struct AllocationHeader
+        {
+            uint64_t size;
+            // malloc の戻り値からユーザー領域までの距離
+            uint32_t offset;
+            uint16_t tag;
+            uint16_t magic;
+        };
+        static_assert(sizeof(AllocationHeader) == 16, "AllocationHeader must keep 16-byte alignment.");
+
+        constexpr uint16_t k_headerMagic = 0xC0E1;
+        constexpr size_t k_defaultAlignment = 16;
+
+        // operator new から触るので、どちらも動的初期化の無い定数初期化にしておく
+        TagCounters g_counters[k_memoryTagCount];
+        thread_local uint16_t t_tag = 0;
+
+        void record_allocate(uint16_t tag, uint64_t size) noexcept
+        {
+            TagCounters& counters = g_counters[tag];
+            counters.allocCount.fetch_add(1, std::memory_order_relaxed);
+            const uint64_t live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+            // 1) 最大値は上回った時だけ書く
+            uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+            while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+
+            // 2) 予算を超えた瞬間だけ記録する（確保は止めない）
+            const uint64_t budget = counters.budgetBytes.load(std::memory_order_relaxed);
+            if (budget != 0 && live > budget && counters.budgetState.load(std::memory_order_relaxed) == k_budgetUnder)
+            {
+                uint8_t expected = k_budgetUnder;
+                if (counters.budgetState.compare_exchange_strong(expected, k_budgetPending, std::memory_order_relaxed))
+                {
+                    counters.overBudgetBytes.store(live, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void record_free(uint16_t tag, uint64_t size) noexcept
+        {
+            TagCounters& counters = g_counters[tag];
+            counters.freeCount.fetch_add(1, std::memory_order_relaxed);
+            const uint64_t live = counters.liveBytes.fetch_sub(size, std::memory_order_relaxed) - size;
+
+            // 予算を下回ったら次の超過をまた報告できるようにする
+            if (counters.budgetState.load(std::memory_order_relaxed) != k_budgetUnder
+                && live <= counters.budgetBytes.load(std::memory_order_relaxed))
+            {
+                counters.budgetState.store(k_budgetUnder, std::memory_order_relaxed);
+            }
+        }
+
+        void* tracked_allocate(size_t size, size_t alignment) noexcept
+        {
+            // 1) ヘッダと整列の余白を足して確保する（malloc は 16 バイト境界を返す）
+            const size_t padding = alignment > k_defaultAlignment ? alignment : 0;
+            if (size > SIZE_MAX - sizeof(AllocationHeader) - padding)
+            {
+                return nullptr;
+            }
+            std::byte* base = static_cast<std::byte*>(std::malloc(size + sizeof(AllocationHeader) + padding));
+            if (!base)
+            {
+                return nullptr;
+            }
+
+            // 2) ヘッダの直後を要求された境界に揃え、ヘッダはその直前に置く
+            const uintptr_t first = reinterpret_cast<uintptr_t>(base) + sizeof(AllocationHeader);
+            const size_t align = std::max(alignment, k_defaultAlignment);
+            std::byte* user = reinterpret_cast<std::byte*>((first + align - 1) & ~static_cast<uintptr_t>(align - 1));
+            AllocationHeader* header = reinterpret_cast<AllocationHeader*>(user) - 1;
+            header->size = size;
+            header->offset = static_cast<uint32_t>(user - base);
+            header->tag = t_tag;
+            header->magic = k_headerMagic;
+
+            record_allocate(header->tag, size);
+            return user;
+        }
+
+        void tracked_free(void* p) noexcept
+        {
+            if (!p)
+            {
+                return;
+            }
+            const AllocationHeader* header = static_cast<const AllocationHeader*>(p) - 1;
+            assert(header->magic == k_headerMagic && "Freed block was not allocated by the tracking operator new");
+            record_free(header->tag, header->size);
+            std::free(static_cast<std::byte*>(p) - header->offset);
+        }
+
+        void* allocate_or_throw(size_t size, size_t alignment)
+        {
+            // operator new の規約どおり、new_handler が無くなるまで呼び直す
+            for (;;)
+            {
+                void* p = tracked_allocate(size, alignment);
+                if (p)
+                {
+                    return p;
+                }
+                std::new_handler handler = std::get_new_handler();
+                if (!handler)
+                {
+                    throw std::bad_alloc();
+                }
+                handler();
+            }
+        }
+
+        void* allocate_or_null(size_t size, size_t alignment) noexcept
+        {
+            void* p = tracked_allocate(size, alignment);
+            if (!p)
+            {
+                std::new_handler handler = std::get_new_handler();
+                if (handler)
+                {
+                    handler();
+                    p = tracked_allocate(size, alignment);
+                }
+            }
+            return p;
+        }
+
+        uint32_t to_index(Facility tag) noexcept
+        {
+            return static_cast<uint32_t>(tag) & (k_memoryTagCount - 1);
+        }
+
+        const char* to_string(uint32_t tag) noexcept
+        {
+            switch (static_cast<Facility>(tag))
+            {
+            case Facility::Core: return "Core";
+            case Facility::Platform: return "Platform";
+            case Facility::IO: return "IO";
+            case Facility::Graphics: return "Graphics";
+            case Facility::D3D12: return "D3D12";
+            default: break;
+            }
+            return tag == 0 ? "Untagged" : "Unknown";
+        }
+
+        uint64_t get_live_count(const TagCounters& counters) noexcept
+        {
+            // 解放数を先に読む（確保数を先に読むと、間に入った確保と解放で一時的に負になり得る）
+            const uint64_t freed = counters.freeCount.load(std::memory_order_relaxed);
+            return counters.allocCount.load(std::memory_order_relaxed) - freed;
+        }
+    } // namespace
+
+    Facility set_thread_memory_tag(Facility tag) noexcept
+    {
+        const Facility previous = static_cast<Facility>(t_tag);
+        t_tag = static_cast<uint16_t>(to_index(tag));
+        return previous;
+    }
+    Facility get_thread_memory_tag() noexcept
+    {
+        return static_cast<Facility>(t_tag);
+    }
+    MemoryTagStats get_memory_stats(Facility tag) noexcept
+    {
+        const TagCounters& counters = g_counters[to_index(tag)];
+        MemoryTagStats stats{};
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.liveCount = get_live_count(counters);
+        stats.totalCount = counters.allocCount.load(std::memory_order_relaxed);
+        stats.frameCount = counters.lastFrameCount.load(std::memory_order_relaxed);
+        stats.budgetBytes = counters.budgetBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+    MemorySnapshot take_memory_snapshot() noexcept
+    {
+        MemorySnapshot snapshot{};
+        for (uint32_t i = 0; i < k_memoryTagCount; ++i)
+        {
+            snapshot.liveBytes[i] = g_counters[i].liveBytes.load(std::memory_order_relaxed);
+            snapshot.liveCount[i] = get_live_count(g_counters[i]);
+        }
+        return snapshot;
+    }
+    void set_memory_budget(Facility tag, uint64_t bytes) noexcept
+    {
+        TagCounters& counters = g_counters[to_index(tag)];
+        counters.budgetBytes.store(bytes, std::memory_order_relaxed);
+        counters.budgetState.store(k_budgetUnder, std::memory_order_relaxed);
+    }
+    Result check_memory_budgets() noexcept
+    {
+        for (uint32_t i = 0; i < k_memoryTagCount; ++i)
+        {
+            uint8_t expected = k_budgetPending;
+            if (g_counters[i].budgetState.compare_exchange_strong(expected, k_budgetReported, std::memory_order_relaxed))
+            {
+                const uint64_t overKiB = g_counters[i].overBudgetBytes.load(std::memory_order_relaxed) / 1024;
+                return Result::fail(static_cast<Facility>(i), Code::OutOfMemory, Severity::Warning,
+                    static_cast<uint32_t>(std::min<uint64_t>(overKiB, UINT32_MAX)), "Memory budget exceeded.");
+            }
+        }
+        return Result::ok();
+    }
+    void begin_memory_frame() noexcept
+    {
+        // フレームの切り替えは 1 スレッドから呼ぶ前提（カウンタ自体は確保と競合しても壊れない）
+        for (TagCounters& counters : g_counters)
+        {
+            const uint64_t allocated = counters.allocCount.load(std::memory_order_relaxed);
+            counters.lastFrameCount.store(allocated - counters.frameStartCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            counters.frameStartCount.store(allocated, std::memory_order_relaxed);
+        }
+    }
+    uint32_t write_memory_report(std::FILE* file, const MemorySnapshot& baseline) noexcept
+    {
+        // 1) 基準より生存量が増えたタグだけを並べる（減った分で増えた分が隠れることはある）
+        uint32_t leakCount = 0;
+        for (uint32_t i = 0; i < k_memoryTagCount; ++i)
+        {
+            // 2) プロセスの寿命で持つ確保はリークではない
+            if (i == to_index(k_processLifetimeFacility))
+            {
+                continue;
+            }
+            const TagCounters& counters = g_counters[i];
+            const uint64_t liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+            const uint64_t liveCount = get_live_count(counters);
+            if (liveBytes <= baseline.liveBytes[i] && liveCount <= baseline.liveCount[i])
+            {
+                continue;
+            }
+            if (leakCount++ == 0 && file)
+            {
+                std::fprintf(file, "[MemoryTracker] outstanding allocations since baseline:\n");
+            }
+            if (file)
+            {
+                std::fprintf(file, "  %-10s %+lld bytes (%+lld allocations), live %llu bytes, peak %llu bytes\n",
+                    to_string(i),
+                    static_cast<long long>(liveBytes - baseline.liveBytes[i]),
+                    static_cast<long long>(liveCount - baseline.liveCount[i]),
+                    static_cast<unsigned long long>(liveBytes),
+                    static_cast<unsigned long long>(counters.peakBytes.load(std::memory_order_relaxed)));
+            }
+        }
+        return leakCount;
+    }
+#else
+    Facility set_thread_memory_tag(Facility) noexcept
+    {
+        return k_untaggedFacility;
+    }
+    Facility get_thread_memory_tag() noexcept
+    {
+        return k_untaggedFacility;
+    }
+    MemoryTagStats get_memory_stats(Facility) noexcept
+    {
+        return {};
+    }
+    MemorySnapshot take_memory_snapshot() noexcept
+    {
+        return {};
+    }
+    void set_memory_budget(Facility, uint64_t) noexcept
+    {
+    }
+    Result check_memory_budgets() noexcept
+    {
+        return Result::ok();
+    }
+    void begin_memory_frame() noexcept
+    {
+    }
+    uint32_t write_memory_report(std::FILE*, const MemorySnapshot&) noexcept
+    {
+        return 0;
+    }
+#endif
+} // namespace Cue::Core
+
+#if CUE_MEMORY_TRACKING_ENABLED
+// 置き換え可能なグローバル確保関数（この翻訳単位がリンクされると全ての new/delete がここを通る）
+void* operator new(std::size_t size)
+{
+    return Cue::Core::allocate_or_throw(size, Cue::Core::k_defaultAlignment);
+}
+void* operator new[](std::size_t size)
+{
+    return Cue::Core::allocate_or_throw(size, Cue::Core::k_defaultAlignment);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Cue::Core::allocate_or_null(size, Cue::Core::k_defaultAlignment);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Cue::Core::allocate_or_null(size, Cue::Core::k_defaultAlignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Cue::Core::allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Cue::Core::allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Cue::Core::allocate_or_null(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Cue::Core::allocate_or_null(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    Cue::Core::tracked_free(p);
+}
+#endif
@@ -0,0 +1,356 @@
+#include "NameId.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        // 最初の表の大きさ（2 の冪）。7/8 まで埋まったら倍の大きさの表へ移す
+        constexpr uint32_t k_initialCapacity = 1u << 16;
+        // 文字列を詰めるブロックの大きさ
+        constexpr size_t k_textChunkSize = 64u * 1024u;
+        // 文字列を写す領域が取れなかった時に公開する空文字列（[u32 長さ = 0][NUL]）
+        alignas(uint32_t) constexpr char k_emptyText[sizeof(uint32_t) + 1] = {};
+
+        struct TextChunk
+        {
+            // 1 つ前に作ったブロック（先頭のブロックから順に所有する）
+            std::unique_ptr<TextChunk> next;
+            size_t capacity = 0;
+            std::atomic<size_t> used{ 0 };
+            std::unique_ptr<char[]> data;
+        };
+
+        struct Slot
+        {
+            // 0 は空き
+            std::atomic<uint64_t> hash{ 0 };
+            // [u32 長さ][文字列][NUL] の文字列部分。hash を書いた者が後から公開する
+            std::atomic<const char*> text{ nullptr };
+        };
+
+        /// @brief 線形探索のオープンアドレス表 1 枚。枠の確保は hash の CAS で、消すことはない
+        struct SlotBlock
+        {
+            SlotBlock(std::unique_ptr<Slot[]> slots, uint32_t capacity) noexcept
+                : slots(std::move(slots))
+                , mask(capacity - 1)
+                , limit(capacity / 8 * 7)
+            {
+            }
+
+            std::unique_ptr<Slot[]> slots;
+            uint32_t mask;
+            uint32_t limit;
+            std::atomic<uint32_t> entryCount{ 0 };
+            // 次の表へ写し始めたら立てる（以降にここへ入れた者は次の表にも入れ直す）
+            std::atomic<bool> isSealed{ false };
+            // 古い表は読み手がまだ見ているかもしれないので終了まで残す
+            std::unique_ptr<SlotBlock> previous;
+        };
+
+        /// @brief 表を 1 枚作る（intern から例外を出さないよう、確保できなければ nullptr）
+        std::unique_ptr<SlotBlock> make_block(uint32_t capacity) noexcept
+        {
+            std::unique_ptr<Slot[]> slots(new (std::nothrow) Slot[capacity]);
+            if (!slots)
+            {
+                return nullptr;
+            }
+            return std::unique_ptr<SlotBlock>(new (std::nothrow) SlotBlock(std::move(slots), capacity));
+        }
+
+        enum class InsertResult : uint8_t
+        {
+            Inserted,
+            Found,
+            Full,
+        };
+
+        /// @brief 埋まると倍の大きさの表へ写して差し替える名前の表
+        /// @details 登録と検索はロックを取らない。表を広げる時だけロックを取り、古い表に封をしてから写す。
+        ///          封の前に入った分は写す側が拾い、封の後に入った分は入れた者が新しい表にも入れ直す。
+        ///          確保には例外を投げない経路を使い、表を広げられなければ登録を諦める（ID は使えるが文字列は引けない）。
+        class NameTable final
+        {
+        public:
+            NameTable()
+            {
+                // 表と文字列はプロセスの終わりまで残すので、リークの報告から外す
+                const MemoryTagScope tag(k_processLifetimeFacility);
+                m_block = make_block(k_initialCapacity);
+                m_current.store(m_block.get(), std::memory_order_release);
+            }
+            ~NameTable()
+            {
+                // 長い鎖でも再帰しないよう、先頭から 1 つずつ外して破棄する
+                std::unique_ptr<TextChunk> chunk(m_chunk.load(std::memory_order_acquire));
+                while (chunk)
+                {
+                    chunk = std::move(chunk->next);
+                }
+            }
+
+            void intern(uint64_t hash, std::string_view text) noexcept
+            {
+                SlotBlock* block = m_current.load(std::memory_order_acquire);
+                // 写した文字列（表を移って入れ直す時は写し直さずに同じものを指す）
+                const char* stored = nullptr;
+                while (block)
+                {
+                    // 1) 封をした表には入れず、写し終えた新しい表で探す
+                    if (block->isSealed.load(std::memory_order_seq_cst))
+                    {
+                        block = grow(block);
+                        continue;
+                    }
+
+                    // 2) 埋まっていれば広げてからやり直す
+                    const InsertResult result = insert(*block, hash, text, stored);
+                    if (result == InsertResult::Full)
+                    {
+                        block = grow(block);
+                        continue;
+                    }
+
+                    // 3) 入れた後に封をされたら見落とされたかもしれないので、新しい表でも確かめる
+                    if (!block->isSealed.load(std::memory_order_seq_cst))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            std::string_view find(uint64_t hash) const noexcept
+            {
+                const SlotBlock* block = m_current.load(std::memory_order_acquire);
+                if (!block)
+                {
+                    return {};
+                }
+                for (uint32_t i = 0; i <= block->mask; ++i)
+                {
+                    const Slot& slot = block->slots[(hash + i) & block->mask];
+                    const uint64_t current = slot.hash.load(std::memory_order_acquire);
+                    if (current == hash)
+                    {
+                        return wait_text(slot);
+                    }
+                    if (current == 0)
+                    {
+                        break;
+                    }
+                }
+                return {};
+            }
+
+            NameTableStats get_stats() const noexcept
+            {
+                const SlotBlock* block = m_current.load(std::memory_order_acquire);
+                NameTableStats stats{};
+                if (block)
+                {
+                    stats.entryCount = block->entryCount.load(std::memory_order_relaxed);
+                    stats.capacity = block->mask + 1;
+                }
+                stats.growCount = m_growCount.load(std::memory_order_relaxed);
+                stats.textBytes = m_textBytes.load(std::memory_order_relaxed);
+                stats.collisionCount = m_collisionCount.load(std::memory_order_relaxed);
+                return stats;
+            }
+        private:
+            /// @brief 枠を取ったスレッドが文字列を公開するまで待つ（写す間だけなので短い）
+            static std::string_view wait_text(const Slot& slot) noexcept
+            {
+                const char* text = slot.text.load(std::memory_order_acquire);
+                while (!text)
+                {
+                    std::this_thread::yield();
+                    text = slot.text.load(std::memory_order_acquire);
+                }
+                uint32_t length;
+                std::memcpy(&length, text - sizeof(length), sizeof(length));
+                return std::string_view(text, length);
+            }
+
+            InsertResult insert(SlotBlock& block, uint64_t hash, std::string_view text, const char*& stored) noexcept
+            {
+                for (uint32_t i = 0; i <= block.mask; ++i)
+                {
+                    Slot& slot = block.slots[(hash + i) & block.mask];
+                    uint64_t current = slot.hash.load(std::memory_order_acquire);
+                    if (current == 0)
+                    {
+                        // 1) 空きなら枠を取り、文字列を写してから公開する（封との前後を決めるため seq_cst）
+                        if (block.entryCount.load(std::memory_order_relaxed) >= block.limit)
+                        {
+                            return InsertResult::Full;
+                        }
+                        if (slot.hash.compare_exchange_strong(current, hash, std::memory_order_seq_cst))
+                        {
+                            block.entryCount.fetch_add(1, std::memory_order_relaxed);
+                            if (!stored)
+                            {
+                                stored = store_text(text);
+                            }
+                            slot.text.store(stored, std::memory_order_release);
+                            return InsertResult::Inserted;
+                        }
+                        // 他のスレッドが先に取った（current に取った値が入る）
+                    }
+                    if (current == hash)
+                    {
+                        // 2) 登録済み。非リリースビルドでは文字列が同じかを確かめる
+#ifndef CUE_RELEASE
+                        if (wait_text(slot) != text)
+                        {
+                            m_collisionCount.fetch_add(1, std::memory_order_relaxed);
+                            assert(false && "NameId hash collision");
+                        }
+#endif
+                        return InsertResult::Found;
+                    }
+                }
+                return InsertResult::Full;
+            }
+
+            /// @brief full が今の表なら倍の大きさの表へ写して差し替え、今の表を返す（確保できなければ nullptr）
+            SlotBlock* grow(SlotBlock* full) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_growMutex);
+                SlotBlock* current = m_current.load(std::memory_order_acquire);
+                if (current != full)
+                {
+                    return current;
+                }
+
+                // 1) 先に確保する。取れなければ封をせずに諦める（今の表はそのまま使える）
+                const MemoryTagScope tag(k_processLifetimeFacility);
+                std::unique_ptr<SlotBlock> next = make_block((full->mask + 1) * 2);
+                if (!next)
+                {
+                    return nullptr;
+                }
+
+                // 2) 封をしてから写す（文字列は写さずに同じものを指す）
+                full->isSealed.store(true, std::memory_order_seq_cst);
+                for (uint32_t i = 0; i <= full->mask; ++i)
+                {
+                    const Slot& source = full->slots[i];
+                    const uint64_t hash = source.hash.load(std::memory_order_seq_cst);
+                    if (hash == 0)
+                    {
+                        continue;
+                    }
+                    const char* text = wait_text(source).data();
+                    uint32_t index = static_cast<uint32_t>(hash) & next->mask;
+                    while (next->slots[index].hash.load(std::memory_order_relaxed) != 0)
+                    {
+                        index = (index + 1) & next->mask;
+                    }
+                    next->slots[index].hash.store(hash, std::memory_order_relaxed);
+                    next->slots[index].text.store(text, std::memory_order_relaxed);
+                    next->entryCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // 3) 古い表を新しい表に持たせてから公開する
+                next->previous = std::move(m_block);
+                m_block = std::move(next);
+                m_current.store(m_block.get(), std::memory_order_release);
+                m_growCount.fetch_add(1, std::memory_order_relaxed);
+                return m_block.get();
+            }
+
+            /// @brief 文字列をブロックへ写す（ブロック内は fetch_add で切り出し、足りなければ CAS で差し替える）
+            /// @details 枠は取った後なので、ブロックを確保できなければ空文字列を公開して待っている読み手を止めない
+            const char* store_text(std::string_view text) noexcept
+            {
+                const uint32_t length = static_cast<uint32_t>(std::min<size_t>(text.size(), UINT32_MAX - 8));
+                const size_t size = (sizeof(uint32_t) + length + 1 + alignof(uint32_t) - 1) & ~(alignof(uint32_t) - 1);
+                for (;;)
+                {
+                    TextChunk* chunk = m_chunk.load(std::memory_order_acquire);
+                    char* p = nullptr;
+                    if (chunk)
+                    {
+                        const size_t offset = chunk->used.fetch_add(size, std::memory_order_relaxed);
+                        if (offset + size <= chunk->capacity)
+                        {
+                            p = chunk->data.get() + offset;
+                        }
+                    }
+                    if (!p)
+                    {
+                        // 新しいブロックの先頭を自分の分として差し替える（負けたら前のブロックを手放さずに捨ててやり直す）
+                        const MemoryTagScope tag(k_processLifetimeFacility);
+                        std::unique_ptr<TextChunk> fresh(new (std::nothrow) TextChunk());
+                        if (fresh)
+                        {
+                            fresh->capacity = std::max(k_textChunkSize, size);
+                            fresh->data.reset(new (std::nothrow) char[fresh->capacity]);
+                        }
+                        if (!fresh || !fresh->data)
+                        {
+                            return k_emptyText + sizeof(uint32_t);
+                        }
+                        fresh->used.store(size, std::memory_order_relaxed);
+                        fresh->next.reset(chunk);
+                        if (!m_chunk.compare_exchange_strong(chunk, fresh.get(), std::memory_order_acq_rel))
+                        {
+                            (void)fresh->next.release();
+                            continue;
+                        }
+                        p = fresh.release()->data.get();
+                    }
+                    std::memcpy(p, &length, sizeof(length));
+                    std::memcpy(p + sizeof(length), text.data(), length);
+                    p[sizeof(length) + length] = '\0';
+                    m_textBytes.fetch_add(length, std::memory_order_relaxed);
+                    return p + sizeof(length);
+                }
+            }
+
+            // 今の表（古い表は m_block から previous を辿って所有する）
+            std::atomic<SlotBlock*> m_current{ nullptr };
+            std::unique_ptr<SlotBlock> m_block;
+            std::mutex m_growMutex;
+            // 最後に作った文字列ブロック（所有は破棄時に引き取る）
+            std::atomic<TextChunk*> m_chunk{ nullptr };
+            std::atomic<uint32_t> m_growCount{ 0 };
+            std::atomic<uint64_t> m_textBytes{ 0 };
+            std::atomic<uint64_t> m_collisionCount{ 0 };
+        };
+
+        NameTable& get_table() noexcept
+        {
+            static NameTable table;
+            return table;
+        }
+    } // namespace
+
+    NameId NameId::intern(std::string_view text) noexcept
+    {
+        const NameId id = from_string(text);
+        get_table().intern(id.m_hash, text);
+        return id;
+    }
+
+    std::string_view NameId::get_text() const noexcept
+    {
+        return m_hash != 0 ? get_table().find(m_hash) : std::string_view{};
+    }
+
+    NameTableStats get_name_table_stats() noexcept
+    {
+        return get_table().get_stats();
+    }
+} // namespace Cue::Core
@@ -0,0 +1,317 @@
+#include "Pak.h"
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        constexpr uint64_t align_up(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // これより小さな項目は圧縮しない（開くたびに確保して展開するほどの得がない）
+        constexpr uint64_t k_minCompressedEntrySize = 4 * 1024;
+
+        bool write_zeros(std::FILE* file, uint64_t count) noexcept
+        {
+            static constexpr std::byte k_zeros[4096]{};
+            while (count != 0)
+            {
+                const size_t chunk = static_cast<size_t>(std::min<uint64_t>(count, sizeof(k_zeros)));
+                if (std::fwrite(k_zeros, 1, chunk, file) != chunk)
+                {
+                    return false;
+                }
+                count -= chunk;
+            }
+            return true;
+        }
+    } // namespace
+
+    Result PakArchive::open(std::string_view path)
+    {
+        close();
+
+        // 1) マップしてヘッダを検証する
+        Result r = m_file.open(path);
+        if (!r)
+        {
+            return r;
+        }
+        const std::span<const std::byte> data = m_file.get_data();
+        PakHeader header{};
+        if (data.size() < sizeof(header))
+        {
+            close();
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Pak file is too small.");
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != k_pakMagic || header.version != k_pakVersion || header.fileSize != data.size())
+        {
+            close();
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, header.version,
+                "Pak header is invalid or from an unsupported version.");
+        }
+        if (header.tocOffset % alignof(PakTocEntry) != 0 || header.tocOffset > data.size()
+            || (data.size() - header.tocOffset) / sizeof(PakTocEntry) < header.entryCount)
+        {
+            close();
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "Pak table of contents is out of range.");
+        }
+
+        // 2) 目次の並びと範囲を検証する（以後の参照で境界を確かめずに済むように）
+        m_entries = std::span<const PakTocEntry>(
+            reinterpret_cast<const PakTocEntry*>(data.data() + header.tocOffset), header.entryCount);
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const PakTocEntry& entry = m_entries[i];
+            const bool isSorted = i == 0 || m_entries[i - 1].pathHash < entry.pathHash;
+            if (!isSorted || entry.offset > data.size() || entry.size > data.size() - entry.offset)
+            {
+                close();
+                return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, static_cast<uint32_t>(i),
+                    "Pak entry is unsorted or out of range.");
+            }
+        }
+        return Result::ok();
+    }
+
+    void PakArchive::close() noexcept
+    {
+        m_entries = {};
+        m_file.close();
+    }
+
+    const PakTocEntry* PakArchive::find(uint64_t pathHash) const noexcept
+    {
+        // 1) ハッシュの昇順に並んでいるので二分探索する
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pathHash,
+            [](const PakTocEntry& entry, uint64_t hash)
+        {
+            return entry.pathHash < hash;
+        });
+        if (it == m_entries.end() || it->pathHash != pathHash)
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    std::span<const std::byte> PakArchive::get_data(const PakTocEntry& entry) const noexcept
+    {
+        return m_file.get_data().subspan(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.size));
+    }
+
+    struct PakWriter::Impl
+    {
+        struct Entry
+        {
+            uint64_t pathHash = 0;
+            std::string virtualPath;
+            std::string sourcePath;
+            std::vector<std::byte> data;
+            bool isFromFile = false;
+            uint64_t size = 0;
+            uint32_t flags = 0;
+        };
+
+        std::vector<Entry> entries;
+        uint32_t compressionBlockSize = 0;
+        JobSystem* jobSystem = nullptr;
+        PakWriteStats stats{};
+
+        /// @brief 縮む場合だけ圧縮した内容に置き換える
+        Result compress(Entry& entry)
+        {
+            MappedFile source;
+            std::span<const std::byte> data = entry.data;
+            if (entry.isFromFile)
+            {
+                Result r = source.open(entry.sourcePath);
+                if (!r)
+                {
+                    return r;
+                }
+                data = source.get_data();
+            }
+            if (data.size() < k_minCompressedEntrySize)
+            {
+                return Result::ok();
+            }
+            std::vector<std::byte> compressed;
+            Result r = compress_blocks(data, compressionBlockSize, compressed, jobSystem);
+            if (!r)
+            {
+                return r;
+            }
+            // 1/16 も縮まないものは展開の手間に見合わない
+            if (compressed.size() > data.size() - data.size() / 16)
+            {
+                return Result::ok();
+            }
+            entry.data = std::move(compressed);
+            entry.size = entry.data.size();
+            entry.isFromFile = false;
+            entry.flags |= k_pakEntryCompressed;
+            ++stats.compressedCount;
+            return Result::ok();
+        }
+    };
+
+    PakWriter::PakWriter()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    PakWriter::~PakWriter()
+    {
+    }
+
+    void PakWriter::add_file(std::string_view virtualPath, std::string_view sourcePath)
+    {
+        Impl::Entry entry{};
+        entry.pathHash = hash_path(virtualPath);
+        entry.virtualPath.assign(virtualPath);
+        entry.sourcePath.assign(sourcePath);
+        entry.isFromFile = true;
+        m_impl->entries.push_back(std::move(entry));
+    }
+
+    void PakWriter::add_data(std::string_view virtualPath, std::span<const std::byte> data)
+    {
+        Impl::Entry entry{};
+        entry.pathHash = hash_path(virtualPath);
+        entry.virtualPath.assign(virtualPath);
+        entry.data.assign(data.begin(), data.end());
+        entry.size = data.size();
+        m_impl->entries.push_back(std::move(entry));
+    }
+
+    void PakWriter::set_compression(uint32_t blockSize, JobSystem* jobSystem) noexcept
+    {
+        m_impl->compressionBlockSize = blockSize;
+        m_impl->jobSystem = jobSystem;
+    }
+
+    size_t PakWriter::get_entry_count() const noexcept
+    {
+        return m_impl->entries.size();
+    }
+
+    const PakWriteStats& PakWriter::get_stats() const noexcept
+    {
+        return m_impl->stats;
+    }
+
+    Result PakWriter::write(std::string_view outputPath)
+    {
+        std::vector<Impl::Entry>& entries = m_impl->entries;
+
+        // 1) ハッシュで並べ、同じハッシュが二つあれば（重複か衝突）書き出さない
+        std::sort(entries.begin(), entries.end(), [](const Impl::Entry& a, const Impl::Entry& b)
+        {
+            return a.pathHash < b.pathHash;
+        });
+        for (size_t i = 1; i < entries.size(); ++i)
+        {
+            if (entries[i - 1].pathHash == entries[i].pathHash)
+            {
+                return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, static_cast<uint32_t>(i),
+                    "Pak paths are duplicated or their hashes collide.");
+            }
+        }
+
+        // 2) 大きさを確かめ、必要なら圧縮して配置を決める（目次はヘッダの直後、内容は目次の後の 64KB 境界から）
+        m_impl->stats = PakWriteStats{};
+        for (Impl::Entry& entry : entries)
+        {
+            if (entry.isFromFile)
+            {
+                MappedFile source;
+                Result r = source.open(entry.sourcePath);
+                if (!r)
+                {
+                    return r;
+                }
+                entry.size = source.get_data().size();
+            }
+            m_impl->stats.sourceBytes += entry.size;
+            if (m_impl->compressionBlockSize != 0 && (entry.flags & k_pakEntryCompressed) == 0)
+            {
+                Result r = m_impl->compress(entry);
+                if (!r)
+                {
+                    return r;
+                }
+            }
+            m_impl->stats.storedBytes += entry.size;
+        }
+        m_impl->stats.storedBytes += sizeof(PakHeader) + sizeof(PakTocEntry) * entries.size();
+        std::vector<PakTocEntry> toc(entries.size());
+        uint64_t offset = align_up(sizeof(PakHeader) + sizeof(PakTocEntry) * entries.size(), k_pakEntryAlignment);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            // 大きいものは 64KB 境界へ、小さいものは 64KB の区間をまたがない位置へ詰める
+            const uint64_t size = entries[i].size;
+            if (size >= k_pakEntryAlignment)
+            {
+                offset = align_up(offset, k_pakEntryAlignment);
+            }
+            else
+            {
+                offset = align_up(offset, k_pakSmallEntryAlignment);
+                if (offset / k_pakEntryAlignment != (offset + size - (size != 0 ? 1 : 0)) / k_pakEntryAlignment)
+                {
+                    offset = align_up(offset, k_pakEntryAlignment);
+                }
+            }
+            toc[i] = PakTocEntry{ entries[i].pathHash, offset, size, entries[i].flags, 0 };
+            offset += size;
+        }
+        const uint64_t fileSize = entries.empty() ? sizeof(PakHeader)
+                                                  : toc.back().offset + toc.back().size;
+
+        // 3) ヘッダ・目次・内容の順に書く
+        const std::string output(outputPath);
+        std::FILE* file = std::fopen(output.c_str(), "wb");
+        if (!file)
+        {
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, 0, "Pak output could not be opened.");
+        }
+        const PakHeader header{ k_pakMagic, k_pakVersion, static_cast<uint32_t>(entries.size()), 0,
+            sizeof(PakHeader), fileSize };
+        bool isWritten = std::fwrite(&header, sizeof(header), 1, file) == 1
+            && (toc.empty() || std::fwrite(toc.data(), sizeof(PakTocEntry), toc.size(), file) == toc.size());
+        uint64_t written = sizeof(PakHeader) + sizeof(PakTocEntry) * toc.size();
+        for (size_t i = 0; i < entries.size() && isWritten; ++i)
+        {
+            isWritten = write_zeros(file, toc[i].offset - written);
+            const Impl::Entry& entry = entries[i];
+            if (entry.isFromFile)
+            {
+                // 大きさを測った後に変わっていれば目次と食い違うので失敗にする
+                MappedFile source;
+                isWritten = isWritten && source.open(entry.sourcePath) && source.get_data().size() == entry.size
+                    && std::fwrite(source.get_data().data(), 1, source.get_data().size(), file) == entry.size;
+            }
+            else
+            {
+                isWritten = isWritten && std::fwrite(entry.data.data(), 1, entry.data.size(), file) == entry.data.size();
+            }
+            written = toc[i].offset + toc[i].size;
+        }
+        isWritten = (std::fclose(file) == 0) && isWritten;
+        if (!isWritten)
+        {
+            return Result::fail(Facility::IO, Code::IoError, Severity::Error, 0, "Pak output could not be written.");
+        }
+        return Result::ok();
+    }
+} // namespace Cue::Core
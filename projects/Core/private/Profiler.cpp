@@ -0,0 +1,303 @@
+#include "Profiler.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        struct Zone
+        {
+            const char* name;
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        // 1 スレッド分のリング（書き込みは所有スレッドのみ）
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(uint32_t id)
+                : zones(std::make_unique_for_overwrite<Zone[]>(Profiler::k_zonesPerThread))
+                , threadId(id)
+            {
+            }
+            std::unique_ptr<Zone[]> zones;
+            std::atomic<uint64_t> head{ 0 };
+            // 使い回した時に、前のスレッドの分を書き出さないための先頭
+            std::atomic<uint64_t> first{ 0 };
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<uint32_t> threadId;
+            // 所有スレッドが終わった（次に登録するスレッドが使い回せる。それまでは中身を書き出せる）
+            std::atomic<bool> isFree{ false };
+        };
+
+        struct ProfilerState
+        {
+            ProfilerState()
+                : calibrationTick(Profiler::now())
+                , calibrationTime(std::chrono::steady_clock::now())
+            {
+            }
+
+            // スレッドのリングは登録後に動かさないよう固定長の表に置く
+            std::unique_ptr<ThreadBuffer> buffers[Profiler::k_maxThreads];
+            std::atomic<uint32_t> bufferCount{ 0 };
+            std::mutex registerMutex;
+            // 使い回したリングにも別のスレッドとして見えるよう、スレッド ID は登録毎に振る
+            uint32_t nextThreadId = 1;
+
+            uint64_t frames[Profiler::k_maxFrames] = {};
+            std::atomic<uint64_t> frameCount{ 0 };
+
+            std::atomic<bool> isEnabled{ true };
+
+            // TSC をマイクロ秒に直すための基準点
+            uint64_t calibrationTick;
+            std::chrono::steady_clock::time_point calibrationTime;
+        };
+
+        // マクロから直接呼ばれるため、状態はここに閉じ込めて初回使用時に構築する
+        ProfilerState& state() noexcept
+        {
+            static ProfilerState s_state;
+            return s_state;
+        }
+
+        /// @brief スレッドが使っているリング（スレッドの終了で空きに戻す）
+        struct ThreadBufferOwner
+        {
+            ThreadBuffer* buffer = nullptr;
+
+            ~ThreadBufferOwner()
+            {
+                if (buffer)
+                {
+                    buffer->isFree.store(true, std::memory_order_release);
+                }
+            }
+        };
+        thread_local ThreadBufferOwner t_owner;
+
+        ThreadBuffer* acquire_buffer() noexcept
+        {
+            // 1) 登録済みならそのまま使う
+            if (t_owner.buffer)
+            {
+                return t_owner.buffer;
+            }
+
+            // 2) 終わったスレッドのリングがあれば使い回す（前のスレッドの分は書き出さなくなる）
+            ProfilerState& s = state();
+            std::lock_guard<std::mutex> lock(s.registerMutex);
+            const uint32_t count = s.bufferCount.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                ThreadBuffer& buffer = *s.buffers[i];
+                if (buffer.isFree.load(std::memory_order_acquire))
+                {
+                    buffer.first.store(buffer.head.load(std::memory_order_relaxed), std::memory_order_release);
+                    buffer.name.store(nullptr, std::memory_order_release);
+                    buffer.threadId.store(s.nextThreadId++, std::memory_order_release);
+                    buffer.isFree.store(false, std::memory_order_relaxed);
+                    t_owner.buffer = &buffer;
+                    return t_owner.buffer;
+                }
+            }
+
+            // 3) 無ければ登録する（確保は同時に動くスレッドの数まで）
+            if (count >= Profiler::k_maxThreads)
+            {
+                return nullptr;
+            }
+            // リングは終了まで手放さないので、リークの報告に出ないタグで確保する
+            const MemoryTagScope tag(k_processLifetimeFacility);
+            s.buffers[count] = std::make_unique<ThreadBuffer>(s.nextThreadId++);
+            s.bufferCount.store(count + 1, std::memory_order_release);
+            t_owner.buffer = s.buffers[count].get();
+            return t_owner.buffer;
+        }
+
+        // 静的文字列でも JSON として壊れないよう最低限エスケープする
+        void append_json_string(std::string& out, const char* text)
+        {
+            out.push_back('"');
+            for (const char* p = text ? text : ""; *p; ++p)
+            {
+                const char c = *p;
+                if (c == '"' || c == '\\')
+                {
+                    out.push_back('\\');
+                    out.push_back(c);
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out.push_back(' ');
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+            }
+            out.push_back('"');
+        }
+    }
+
+    void Profiler::record_zone(const char* name, uint64_t begin, uint64_t end) noexcept
+    {
+        ProfilerState& s = state();
+        if (!s.isEnabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        ThreadBuffer* buffer = acquire_buffer();
+        if (!buffer)
+        {
+            return;
+        }
+
+        // 1) 古いゾーンを上書きして書き込み、位置を公開する
+        const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        buffer->zones[head & (k_zonesPerThread - 1)] = Zone{ name, begin, end };
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+    void Profiler::mark_frame() noexcept
+    {
+        ProfilerState& s = state();
+        const uint64_t index = s.frameCount.load(std::memory_order_relaxed);
+        s.frames[index & (k_maxFrames - 1)] = now();
+        s.frameCount.store(index + 1, std::memory_order_release);
+    }
+    void Profiler::set_thread_name(const char* name) noexcept
+    {
+        if (ThreadBuffer* buffer = acquire_buffer())
+        {
+            buffer->name.store(name, std::memory_order_release);
+        }
+    }
+    void Profiler::set_enabled(bool isEnabled) noexcept
+    {
+        state().isEnabled.store(isEnabled, std::memory_order_relaxed);
+    }
+    Result Profiler::export_chrome_trace(const char* path, uint32_t frameCount)
+    {
+        ProfilerState& s = state();
+
+        // 1) TSC とマイクロ秒の比を、起動時からの経過で求める
+        const uint64_t nowTick = now();
+        const auto nowTime = std::chrono::steady_clock::now();
+        const double elapsedUs = std::chrono::duration<double, std::micro>(nowTime - s.calibrationTime).count();
+        const double elapsedTicks = static_cast<double>(nowTick - s.calibrationTick);
+        const double usPerTick = (elapsedTicks > 0.0 && elapsedUs > 0.0) ? elapsedUs / elapsedTicks : 1e-3;
+        auto to_us = [&](uint64_t tick)
+            {
+                return static_cast<double>(static_cast<int64_t>(tick - s.calibrationTick)) * usPerTick;
+            };
+
+        // 2) 書き出す範囲の先頭（直近 frameCount フレームの最初のマーカー）を決める
+        const uint64_t totalFrames = s.frameCount.load(std::memory_order_acquire);
+        const uint64_t keptFrames = std::min<uint64_t>({ totalFrames, static_cast<uint64_t>(frameCount), k_maxFrames });
+        const uint64_t firstFrame = totalFrames - keptFrames;
+        const uint64_t cutoff = (keptFrames != 0) ? s.frames[firstFrame & (k_maxFrames - 1)] : 0;
+
+        std::string json;
+        json.reserve(1u << 20);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool isFirst = true;
+        char number[128];
+        auto begin_event = [&]()
+            {
+                if (!isFirst)
+                {
+                    json += ",\n";
+                }
+                isFirst = false;
+            };
+
+        // 3) フレームマーカーをグローバルな instant event として出す
+        for (uint64_t f = firstFrame; f < totalFrames; ++f)
+        {
+            begin_event();
+            std::snprintf(number, sizeof(number),
+                "{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}",
+                static_cast<unsigned long long>(f), to_us(s.frames[f & (k_maxFrames - 1)]));
+            json += number;
+        }
+
+        // 4) 各スレッドのリングを読み、書き込み中に上書きされた分は捨てる
+        std::vector<Zone> zones;
+        zones.reserve(k_zonesPerThread);
+        const uint32_t bufferCount = s.bufferCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < bufferCount; ++i)
+        {
+            const ThreadBuffer& buffer = *s.buffers[i];
+            const uint32_t threadId = buffer.threadId.load(std::memory_order_acquire);
+            if (const char* name = buffer.name.load(std::memory_order_acquire))
+            {
+                begin_event();
+                std::snprintf(number, sizeof(number),
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", threadId);
+                json += number;
+                append_json_string(json, name);
+                json += "}}";
+            }
+
+            const uint64_t head = buffer.head.load(std::memory_order_acquire);
+            const uint64_t first = std::max((head > k_zonesPerThread) ? head - k_zonesPerThread : 0,
+                std::min(buffer.first.load(std::memory_order_acquire), head));
+            zones.clear();
+            for (uint64_t z = first; z < head; ++z)
+            {
+                zones.push_back(buffer.zones[z & (k_zonesPerThread - 1)]);
+            }
+            const uint64_t headAfter = buffer.head.load(std::memory_order_acquire);
+            const uint64_t validFirst = (headAfter > k_zonesPerThread) ? headAfter - k_zonesPerThread : 0;
+
+            for (uint64_t z = first; z < head; ++z)
+            {
+                const Zone& zone = zones[static_cast<size_t>(z - first)];
+                if (z < validFirst || zone.begin < cutoff || zone.end < zone.begin)
+                {
+                    continue;
+                }
+                begin_event();
+                json += "{\"name\":";
+                append_json_string(json, zone.name);
+                std::snprintf(number, sizeof(number),
+                    ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    threadId, to_us(zone.begin),
+                    static_cast<double>(zone.end - zone.begin) * usPerTick);
+                json += number;
+            }
+        }
+        json += "\n]}\n";
+
+        // 5) まとめて書き出す
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file)
+        {
+            return Result::fail(
+                Facility::IO,
+                Code::IoError,
+                Severity::Error,
+                0, "Failed to open profiler trace file.");
+        }
+        const size_t written = std::fwrite(json.data(), 1, json.size(), file);
+        std::fclose(file);
+        if (written != json.size())
+        {
+            return Result::fail(
+                Facility::IO,
+                Code::IoError,
+                Severity::Error,
+                0, "Failed to write profiler trace file.");
+        }
+        return Result::ok();
+    }
+} // namespace Cue::Core
@@ -0,0 +1,177 @@
+#include "Result.h"
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Cue::Core::Detail
+{
+    namespace
+    {
+        // 診断表の数（票の上位 6bit、0 は「記録なし」）と 1 つの表の件数（票の下位 10bit）
+        constexpr uint32_t k_maxDiagnosticTables = 63;
+        constexpr uint32_t k_diagnosticCapacity = 1024;
+        constexpr uint32_t k_slotBits = 10;
+
+        /// @brief 1 件分。stamp を 0 にしてから書き、最後に Result のビット列を入れる（読み手は前後の stamp で確かめる）
+        struct DiagnosticEntry
+        {
+            std::atomic<uint64_t> stamp{ 0 };
+            std::atomic<const char*> message{ nullptr };
+            std::atomic<const char*> file{ nullptr };
+            std::atomic<const char*> function{ nullptr };
+            std::atomic<uint32_t> messageLength{ 0 };
+            std::atomic<uint32_t> line{ 0 };
+        };
+
+        /// @brief スレッド毎の環状バッファ。スレッドの終了で手放し、次のスレッドが使い回す（解放はしない）
+        struct DiagnosticTable
+        {
+            std::atomic<bool> isUsed{ false };
+            uint32_t next = 0;
+            DiagnosticEntry entries[k_diagnosticCapacity];
+        };
+
+        std::atomic<DiagnosticTable*> g_tables[k_maxDiagnosticTables] = {};
+
+        /// @brief スレッドが最初に失敗した時に表を借りる
+        /// @details 返した後に他の thread_local の破棄から失敗しても読めるよう、デストラクタを持たせない。
+        ///          （デストラクタ内の書き込みは寿命の終わりとして最適化で消されうる）
+        struct ThreadDiagnostics
+        {
+            // 1 始まり（0 は未取得）
+            uint32_t index = 0;
+            bool isExhausted = false;
+
+            DiagnosticTable* acquire() noexcept;
+
+            void release() noexcept
+            {
+                if (index != 0)
+                {
+                    g_tables[index - 1].load(std::memory_order_relaxed)->isUsed.store(false, std::memory_order_release);
+                }
+                // 返した後の失敗は記録しない（他のスレッドが借りた表に書かない）
+                index = 0;
+                isExhausted = true;
+            }
+        };
+
+        thread_local ThreadDiagnostics t_diagnostics;
+
+        /// @brief スレッドの終了時に表を返す
+        struct ThreadDiagnosticsRelease
+        {
+            bool isArmed = false;
+
+            ~ThreadDiagnosticsRelease()
+            {
+                if (isArmed)
+                {
+                    t_diagnostics.release();
+                }
+            }
+        };
+
+        thread_local ThreadDiagnosticsRelease t_diagnosticsRelease;
+
+        DiagnosticTable* ThreadDiagnostics::acquire() noexcept
+        {
+            if (index != 0)
+            {
+                return g_tables[index - 1].load(std::memory_order_relaxed);
+            }
+            if (isExhausted)
+            {
+                return nullptr;
+            }
+            for (uint32_t i = 0; i < k_maxDiagnosticTables; ++i)
+            {
+                DiagnosticTable* table = g_tables[i].load(std::memory_order_acquire);
+                if (!table)
+                {
+                    // 1) まだ無ければ作って置く（競争に負けたら相手のものを使う）。表は解放しないのでリークの報告から外す
+                    const MemoryTagScope tag(k_processLifetimeFacility);
+                    auto fresh = std::make_unique<DiagnosticTable>();
+                    if (g_tables[i].compare_exchange_strong(table, fresh.get(), std::memory_order_acq_rel))
+                    {
+                        table = fresh.release();
+                    }
+                }
+                bool expected = false;
+                if (table->isUsed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                {
+                    // 2) 借りたらスレッドの終了で返すよう登録する
+                    index = i + 1;
+                    t_diagnosticsRelease.isArmed = true;
+                    return table;
+                }
+            }
+            // スレッドが多すぎる時は診断情報を残さない（Result のコードは変わらない）
+            isExhausted = true;
+            return nullptr;
+        }
+    } // namespace
+
+    uint16_t record_diagnostic(uint64_t bits, std::string_view message, const std::source_location& location) noexcept
+    {
+        DiagnosticTable* table = t_diagnostics.acquire();
+        if (!table)
+        {
+            return 0;
+        }
+
+        // 1) 票を決め、読み手から見えるビット列を作る
+        const uint32_t slot = table->next;
+        table->next = (slot + 1) & (k_diagnosticCapacity - 1);
+        const uint16_t ticket = static_cast<uint16_t>((t_diagnostics.index << k_slotBits) | slot);
+        const uint64_t stamp = bits | static_cast<uint64_t>(ticket) << k_resultTicketShift;
+
+        // 2) 書いている間は stamp を 0 にしておく
+        DiagnosticEntry& entry = table->entries[slot];
+        entry.stamp.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.message.store(message.data(), std::memory_order_relaxed);
+        entry.messageLength.store(static_cast<uint32_t>(message.size()), std::memory_order_relaxed);
+        entry.file.store(location.file_name(), std::memory_order_relaxed);
+        entry.function.store(location.function_name(), std::memory_order_relaxed);
+        entry.line.store(static_cast<uint32_t>(location.line()), std::memory_order_relaxed);
+        entry.stamp.store(stamp, std::memory_order_release);
+        return ticket;
+    }
+
+    ResultDiagnostic find_diagnostic(uint64_t bits) noexcept
+    {
+        const uint32_t ticket = static_cast<uint32_t>(bits >> k_resultTicketShift);
+        const uint32_t tableIndex = ticket >> k_slotBits;
+        if (tableIndex == 0 || tableIndex > k_maxDiagnosticTables)
+        {
+            return {};
+        }
+        const DiagnosticTable* table = g_tables[tableIndex - 1].load(std::memory_order_acquire);
+        if (!table)
+        {
+            return {};
+        }
+
+        // 1) 書き換えの前後で stamp が同じなら、読んだ値はこの Result のもの
+        const DiagnosticEntry& entry = table->entries[ticket & (k_diagnosticCapacity - 1)];
+        if (entry.stamp.load(std::memory_order_acquire) != bits)
+        {
+            return {};
+        }
+        ResultDiagnostic diagnostic{};
+        const char* message = entry.message.load(std::memory_order_relaxed);
+        const uint32_t messageLength = entry.messageLength.load(std::memory_order_relaxed);
+        diagnostic.file = entry.file.load(std::memory_order_relaxed);
+        diagnostic.function = entry.function.load(std::memory_order_relaxed);
+        diagnostic.line = entry.line.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.stamp.load(std::memory_order_relaxed) != bits)
+        {
+            return {};
+        }
+        diagnostic.message = std::string_view(message ? message : "", message ? messageLength : 0);
+        return diagnostic;
+    }
+} // namespace Cue::Core::Detail
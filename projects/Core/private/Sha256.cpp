@@ -0,0 +1,160 @@
+#include "Sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Cue::Core
+{
+    namespace
+    {
+        constexpr uint32_t k_roundConstants[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        constexpr uint32_t rotr(uint32_t x, uint32_t n) noexcept
+        {
+            return (x >> n) | (x << (32 - n));
+        }
+    } // namespace
+
+    Sha256::Sha256() noexcept
+        : m_state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 }
+        , m_buffer{}
+    {
+    }
+
+    void Sha256::update(std::span<const std::byte> data) noexcept
+    {
+        // 空の入力は data() が nullptr になりうるので、memcpy に渡す前に抜ける
+        if (data.empty())
+        {
+            return;
+        }
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data());
+        size_t size = data.size();
+        m_length += size;
+
+        // 1) 端数が溜まっていれば先に 64 バイトまで埋める
+        if (m_bufferSize != 0)
+        {
+            const size_t fill = std::min(size, sizeof(m_buffer) - m_bufferSize);
+            std::memcpy(m_buffer + m_bufferSize, p, fill);
+            m_bufferSize += fill;
+            p += fill;
+            size -= fill;
+            if (m_bufferSize < sizeof(m_buffer))
+            {
+                return;
+            }
+            process_block(m_buffer);
+            m_bufferSize = 0;
+        }
+
+        // 2) 残りはブロック単位で直接処理し、端数だけを溜める
+        for (; size >= 64; p += 64, size -= 64)
+        {
+            process_block(p);
+        }
+        std::memcpy(m_buffer, p, size);
+        m_bufferSize = size;
+    }
+
+    void Sha256::update_field(std::string_view text) noexcept
+    {
+        uint8_t length[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            length[i] = static_cast<uint8_t>(static_cast<uint64_t>(text.size()) >> (i * 8));
+        }
+        update(std::as_bytes(std::span<const uint8_t>(length)));
+        update(text);
+    }
+
+    Sha256Digest Sha256::finalize() noexcept
+    {
+        // 1) 0x80 と 0 で埋め、最後の 8 バイトにビット長（ビッグエンディアン）を置く
+        const uint64_t bitLength = m_length * 8;
+        m_buffer[m_bufferSize++] = 0x80;
+        if (m_bufferSize > 56)
+        {
+            std::memset(m_buffer + m_bufferSize, 0, sizeof(m_buffer) - m_bufferSize);
+            process_block(m_buffer);
+            m_bufferSize = 0;
+        }
+        std::memset(m_buffer + m_bufferSize, 0, 56 - m_bufferSize);
+        for (size_t i = 0; i < 8; ++i)
+        {
+            m_buffer[56 + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+        }
+        process_block(m_buffer);
+
+        // 2) 状態をビッグエンディアンで書き出す
+        Sha256Digest digest{};
+        for (size_t i = 0; i < 8; ++i)
+        {
+            digest.bytes[i * 4 + 0] = static_cast<uint8_t>(m_state[i] >> 24);
+            digest.bytes[i * 4 + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+            digest.bytes[i * 4 + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+            digest.bytes[i * 4 + 3] = static_cast<uint8_t>(m_state[i]);
+        }
+        return digest;
+    }
+
+    void Sha256::process_block(const uint8_t* block) noexcept
+    {
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; ++i)
+        {
+            w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16)
+                | (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+        }
+        for (size_t i = 16; i < 64; ++i)
+        {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+        for (size_t i = 0; i < 64; ++i)
+        {
+            const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const uint32_t choose = (e & f) ^ (~e & g);
+            const uint32_t t1 = h + s1 + choose + k_roundConstants[i] + w[i];
+            const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t t2 = s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+        m_state[5] += f;
+        m_state[6] += g;
+        m_state[7] += h;
+    }
+
+    Sha256Digest sha256(std::span<const std::byte> data) noexcept
+    {
+        Sha256 hasher;
+        hasher.update(data);
+        return hasher.finalize();
+    }
+} // namespace Cue::Core
@@ -0,0 +1,200 @@
+#include "IoBackend.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace Cue::Core::Detail
+{
+    namespace
+    {
+        // ワーカー 1 つが同時に抱えるのは 1 件なので、深さの上限は事実上ワーカー数で決まる
+        constexpr uint32_t k_maxThreadPoolQueueDepth = 1024;
+
+        IoOperationResult read_at(const IoOperation& operation) noexcept
+        {
+            IoOperationResult result{};
+            result.slot = operation.slot;
+#if defined(_WIN32)
+            // 同期ハンドルでも OVERLAPPED にオフセットを渡せば位置指定で読める
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(operation.offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(operation.offset >> 32);
+            DWORD bytesRead = 0;
+            if (::ReadFile(operation.file, operation.destination, operation.size, &bytesRead, &overlapped))
+            {
+                result.bytesRead = bytesRead;
+            }
+            else
+            {
+                const DWORD error = ::GetLastError();
+                // 末尾以降の読み込みは 0 バイトの成功として扱う
+                result.error = error == ERROR_HANDLE_EOF ? 0 : error;
+            }
+#else
+            for (;;)
+            {
+                const ssize_t bytesRead = ::pread(operation.file, operation.destination, operation.size,
+                    static_cast<off_t>(operation.offset));
+                if (bytesRead >= 0)
+                {
+                    result.bytesRead = static_cast<uint32_t>(bytesRead);
+                    break;
+                }
+                if (errno != EINTR)
+                {
+                    result.error = static_cast<uint32_t>(errno);
+                    break;
+                }
+            }
+#endif
+            return result;
+        }
+
+        /// @brief ワーカースレッドが位置指定読み込みをするバックエンド（io_uring が無い環境向け）
+        class ThreadPoolIoBackend final : public IoBackend
+        {
+        public:
+            explicit ThreadPoolIoBackend(uint32_t threadCount)
+            {
+                m_threads.reserve(threadCount);
+                for (uint32_t i = 0; i < threadCount; ++i)
+                {
+                    m_threads.emplace_back([this]()
+                    {
+                        worker_main();
+                    });
+                }
+            }
+
+            ~ThreadPoolIoBackend() override
+            {
+                {
+                    std::lock_guard lock(m_operationMutex);
+                    m_isStopping = true;
+                }
+                m_operationCv.notify_all();
+                for (std::thread& thread : m_threads)
+                {
+                    thread.join();
+                }
+            }
+
+            uint32_t get_max_queue_depth() const noexcept override
+            {
+                return k_maxThreadPoolQueueDepth;
+            }
+
+            void submit(std::span<const IoOperation> operations) override
+            {
+                if (operations.empty())
+                {
+                    return;
+                }
+                {
+                    std::lock_guard lock(m_operationMutex);
+                    m_operations.insert(m_operations.end(), operations.begin(), operations.end());
+                }
+                if (operations.size() == 1)
+                {
+                    m_operationCv.notify_one();
+                }
+                else
+                {
+                    m_operationCv.notify_all();
+                }
+            }
+
+            void wait(std::vector<IoOperationResult>& out, int64_t timeoutNs) override
+            {
+                std::unique_lock lock(m_resultMutex);
+                const auto isReady = [this]()
+                {
+                    return !m_results.empty() || m_isWoken;
+                };
+                if (timeoutNs < 0)
+                {
+                    m_resultCv.wait(lock, isReady);
+                }
+                else
+                {
+                    m_resultCv.wait_for(lock, std::chrono::nanoseconds(timeoutNs), isReady);
+                }
+                out.insert(out.end(), m_results.begin(), m_results.end());
+                m_results.clear();
+                m_isWoken = false;
+            }
+
+            void wake() noexcept override
+            {
+                {
+                    std::lock_guard lock(m_resultMutex);
+                    m_isWoken = true;
+                }
+                m_resultCv.notify_one();
+            }
+        private:
+            void worker_main()
+            {
+                set_thread_memory_tag(Facility::IO);
+                for (;;)
+                {
+                    // 1) 読み込みを 1 件取る
+                    IoOperation operation{};
+                    {
+                        std::unique_lock lock(m_operationMutex);
+                        m_operationCv.wait(lock, [this]()
+                        {
+                            return m_isStopping || !m_operations.empty();
+                        });
+                        if (m_operations.empty())
+                        {
+                            return;
+                        }
+                        operation = m_operations.front();
+                        m_operations.pop_front();
+                    }
+
+                    // 2) 読んで結果を渡す
+                    const IoOperationResult result = read_at(operation);
+                    {
+                        std::lock_guard lock(m_resultMutex);
+                        m_results.push_back(result);
+                    }
+                    m_resultCv.notify_one();
+                }
+            }
+
+            std::vector<std::thread> m_threads;
+
+            std::mutex m_operationMutex;
+            std::condition_variable m_operationCv;
+            std::deque<IoOperation> m_operations;
+            bool m_isStopping = false;
+
+            std::mutex m_resultMutex;
+            std::condition_variable m_resultCv;
+            std::vector<IoOperationResult> m_results;
+            bool m_isWoken = false;
+        };
+    } // namespace
+
+    std::unique_ptr<IoBackend> create_thread_pool_backend(uint32_t threadCount)
+    {
+        return std::make_unique<ThreadPoolIoBackend>(std::max(threadCount, 1u));
+    }
+} // namespace Cue::Core::Detail
@@ -0,0 +1,403 @@
+#include "Utf.h"
+
+#include <bit>
+#include <cstdint>
+
+// SIMD 実装はビルド時に選択する（CMake の CUE_SIMD で CUE_SIMD_AVX2 / CUE_SIMD_SSE41 が定義される）
+#if defined(CUE_SIMD_AVX2)
+#include <immintrin.h>
+#define CUE_UTF_SSE41 1
+#define CUE_UTF_AVX2 1
+#elif defined(CUE_SIMD_SSE41)
+#include <smmintrin.h>
+#define CUE_UTF_SSE41 1
+#define CUE_UTF_AVX2 0
+#else
+#define CUE_UTF_SSE41 0
+#define CUE_UTF_AVX2 0
+#endif
+
+namespace Cue::Core
+{
+    namespace
+    {
+        Result fail_malformed(std::string_view message) noexcept
+        {
+            return Result::fail(Facility::Core, Code::InvalidArg, Severity::Error, 0, message);
+        }
+
+        Result fail_no_space() noexcept
+        {
+            return Result::fail(Facility::Core, Code::InvalidArg, Severity::Error, 0, "UTF destination buffer is too small.");
+        }
+
+        /// @brief 1 文字分を復号する（不正な並びなら false）
+        inline bool decode_utf8(const uint8_t* s, size_t remaining, uint32_t& outCodePoint, size_t& outLength) noexcept
+        {
+            const uint32_t lead = s[0];
+            uint32_t codePoint;
+            size_t length;
+            if (lead < 0xC2)
+            {
+                // 0x80-0xBF は継続バイト、0xC0/0xC1 は必ず冗長な表現になる
+                return false;
+            }
+            else if (lead < 0xE0)
+            {
+                codePoint = lead & 0x1F;
+                length = 2;
+            }
+            else if (lead < 0xF0)
+            {
+                codePoint = lead & 0x0F;
+                length = 3;
+            }
+            else if (lead < 0xF5)
+            {
+                codePoint = lead & 0x07;
+                length = 4;
+            }
+            else
+            {
+                return false;
+            }
+            if (remaining < length)
+            {
+                return false;
+            }
+            for (size_t k = 1; k < length; ++k)
+            {
+                const uint32_t b = s[k];
+                if ((b & 0xC0) != 0x80)
+                {
+                    return false;
+                }
+                codePoint = (codePoint << 6) | (b & 0x3F);
+            }
+            if (length == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)))
+            {
+                return false;
+            }
+            if (length == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF))
+            {
+                return false;
+            }
+            outCodePoint = codePoint;
+            outLength = length;
+            return true;
+        }
+
+#if CUE_UTF_SSE41
+        constexpr char to_char(unsigned value) noexcept
+        {
+            return static_cast<char>(value);
+        }
+
+        // pshufb でそのレーンを 0 にする添字
+        constexpr char k_zero = to_char(0x80);
+
+        /// @brief 先頭から続く 3 バイト文字（かな・漢字）を最大 5 つ UTF-16 にして、変換した文字数を返す
+        /// @details d には 8 単位分を書く。
+        inline size_t convert_utf8_3byte_x5(__m128i v, char16_t* d) noexcept
+        {
+            // 1) 先頭バイトと継続バイトの並びを 1 回の比較で確かめる
+            const __m128i pattern = _mm_setr_epi8(
+                to_char(0xF0), to_char(0xC0), to_char(0xC0), to_char(0xF0), to_char(0xC0), to_char(0xC0),
+                to_char(0xF0), to_char(0xC0), to_char(0xC0), to_char(0xF0), to_char(0xC0), to_char(0xC0),
+                to_char(0xF0), to_char(0xC0), to_char(0xC0), 0);
+            const __m128i expected = _mm_setr_epi8(
+                to_char(0xE0), to_char(0x80), to_char(0x80), to_char(0xE0), to_char(0x80), to_char(0x80),
+                to_char(0xE0), to_char(0x80), to_char(0x80), to_char(0xE0), to_char(0x80), to_char(0x80),
+                to_char(0xE0), to_char(0x80), to_char(0x80), 0);
+            const uint32_t matched = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, pattern), expected)));
+            if ((matched & 7) != 7)
+            {
+                return 0;
+            }
+
+            // 2) 各文字の 3 バイトを 16 ビットのレーンへ並べ替えて組み立てる
+            const __m128i lead = _mm_shuffle_epi8(v, _mm_setr_epi8(0, k_zero, 3, k_zero, 6, k_zero, 9, k_zero,
+                12, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero));
+            const __m128i middle = _mm_shuffle_epi8(v, _mm_setr_epi8(1, k_zero, 4, k_zero, 7, k_zero, 10, k_zero,
+                13, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero));
+            const __m128i last = _mm_shuffle_epi8(v, _mm_setr_epi8(2, k_zero, 5, k_zero, 8, k_zero, 11, k_zero,
+                14, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero));
+            const __m128i low6 = _mm_set1_epi16(0x3F);
+            const __m128i code = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi16(_mm_and_si128(lead, _mm_set1_epi16(0x0F)), 12),
+                    _mm_slli_epi16(_mm_and_si128(middle, low6), 6)),
+                _mm_and_si128(last, low6));
+
+            // 3) 冗長な表現（0x800 未満）とサロゲートを弾き、先頭から正しい文字数を数える
+            const __m128i high = _mm_and_si128(code, _mm_set1_epi16(static_cast<short>(0xF800)));
+            const __m128i bad = _mm_or_si128(_mm_cmpeq_epi16(high, _mm_setzero_si128()),
+                _mm_cmpeq_epi16(high, _mm_set1_epi16(static_cast<short>(0xD800))));
+            const uint32_t badLanes = static_cast<uint32_t>(_mm_movemask_epi8(bad));
+            size_t count = 0;
+            while (count < 5 && ((matched >> (count * 3)) & 7) == 7 && ((badLanes >> (count * 2)) & 1) == 0)
+            {
+                ++count;
+            }
+            if (count != 0)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), code);
+            }
+            return count;
+        }
+
+        /// @brief 先頭から続く 3 バイトになる文字を最大 8 つ UTF-8 にして、変換した文字数を返す
+        /// @details d には 24 バイト分を書く。
+        inline size_t convert_utf16_3byte_x8(__m128i code, char* d) noexcept
+        {
+            // 1) 0x800 未満とサロゲートの手前までを数える
+            const __m128i high = _mm_and_si128(code, _mm_set1_epi16(static_cast<short>(0xF800)));
+            const __m128i bad = _mm_or_si128(_mm_cmpeq_epi16(high, _mm_setzero_si128()),
+                _mm_cmpeq_epi16(high, _mm_set1_epi16(static_cast<short>(0xD800))));
+            const uint32_t badLanes = static_cast<uint32_t>(_mm_movemask_epi8(bad));
+            const size_t count = badLanes == 0 ? 8 : static_cast<size_t>(std::countr_zero(badLanes)) / 2;
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            // 2) 各文字の 3 バイトをレーン毎に作ってバイトへ詰める
+            const __m128i low6 = _mm_set1_epi16(0x3F);
+            const __m128i lead = _mm_or_si128(_mm_srli_epi16(code, 12), _mm_set1_epi16(0xE0));
+            const __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(code, 6), low6), _mm_set1_epi16(0x80));
+            const __m128i last = _mm_or_si128(_mm_and_si128(code, low6), _mm_set1_epi16(0x80));
+            // x = [lead0..7, middle0..7], y = [last0..7, 0...]
+            const __m128i x = _mm_packus_epi16(lead, middle);
+            const __m128i y = _mm_packus_epi16(last, _mm_setzero_si128());
+
+            // 3) 文字毎に (lead, middle, last) の順へ並べて 16 + 8 バイトを書く
+            const __m128i first = _mm_or_si128(
+                _mm_shuffle_epi8(x, _mm_setr_epi8(0, 8, k_zero, 1, 9, k_zero, 2, 10, k_zero, 3, 11, k_zero, 4, 12, k_zero, 5)),
+                _mm_shuffle_epi8(y, _mm_setr_epi8(k_zero, k_zero, 0, k_zero, k_zero, 1, k_zero, k_zero, 2, k_zero, k_zero, 3,
+                    k_zero, k_zero, 4, k_zero)));
+            const __m128i second = _mm_or_si128(
+                _mm_shuffle_epi8(x, _mm_setr_epi8(13, k_zero, 6, 14, k_zero, 7, 15, k_zero,
+                    k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero)),
+                _mm_shuffle_epi8(y, _mm_setr_epi8(k_zero, 5, k_zero, k_zero, 6, k_zero, k_zero, 7,
+                    k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero, k_zero)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), first);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d + 16), second);
+            return count;
+        }
+#endif
+    } // namespace
+
+    Result utf8_to_utf16(std::string_view src, std::span<char16_t> dst, size_t& outWritten) noexcept
+    {
+        const uint8_t* s = reinterpret_cast<const uint8_t*>(src.data());
+        const size_t size = src.size();
+        char16_t* d = dst.data();
+        const size_t capacity = dst.size();
+        size_t i = 0;
+        size_t o = 0;
+        while (i < size)
+        {
+#if CUE_UTF_AVX2
+            // 1) ASCII だけの 32 バイトはそのまま広げる（先頭が ASCII でなければ試さない）
+            if (s[i] < 0x80 && size - i >= 32 && capacity - o >= 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                if (_mm256_movemask_epi8(v) == 0)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + o), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + o + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+                    i += 32;
+                    o += 32;
+                    continue;
+                }
+            }
+#endif
+#if CUE_UTF_SSE41
+            // 2) 16 バイト単位で、先頭の ASCII をまとめて広げるか、先頭の 3 バイト文字をまとめて変換する
+            if (size - i >= 16 && capacity - o >= 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                const uint32_t nonAscii = static_cast<uint32_t>(_mm_movemask_epi8(v));
+                const size_t asciiCount = nonAscii == 0 ? 16 : static_cast<size_t>(std::countr_zero(nonAscii));
+                if (asciiCount != 0)
+                {
+                    // 16 単位分書くが、進めるのは ASCII の分だけ（残りは次で上書きされる）
+                    const __m128i zero = _mm_setzero_si128();
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + o), _mm_unpacklo_epi8(v, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + o + 8), _mm_unpackhi_epi8(v, zero));
+                    i += asciiCount;
+                    o += asciiCount;
+                    continue;
+                }
+                const size_t count = convert_utf8_3byte_x5(v, d + o);
+                if (count != 0)
+                {
+                    i += count * 3;
+                    o += count;
+                    continue;
+                }
+            }
+#endif
+            // 3) 残りは 1 文字ずつ
+            if (s[i] < 0x80)
+            {
+                if (o == capacity)
+                {
+                    outWritten = o;
+                    return fail_no_space();
+                }
+                d[o++] = static_cast<char16_t>(s[i++]);
+                continue;
+            }
+            uint32_t codePoint = 0;
+            size_t length = 0;
+            if (!decode_utf8(s + i, size - i, codePoint, length))
+            {
+                outWritten = o;
+                return fail_malformed("UTF-8 input is malformed.");
+            }
+            const size_t units = codePoint < 0x10000 ? 1 : 2;
+            if (capacity - o < units)
+            {
+                outWritten = o;
+                return fail_no_space();
+            }
+            if (units == 1)
+            {
+                d[o++] = static_cast<char16_t>(codePoint);
+            }
+            else
+            {
+                codePoint -= 0x10000;
+                d[o++] = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+                d[o++] = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
+            }
+            i += length;
+        }
+        outWritten = o;
+        return Result::ok();
+    }
+
+    Result utf16_to_utf8(std::u16string_view src, std::span<char> dst, size_t& outWritten) noexcept
+    {
+        const char16_t* s = src.data();
+        const size_t size = src.size();
+        char* d = dst.data();
+        const size_t capacity = dst.size();
+        size_t i = 0;
+        size_t o = 0;
+        while (i < size)
+        {
+#if CUE_UTF_AVX2
+            // 1) ASCII だけの 32 単位はそのまま詰める（先頭が ASCII でなければ試さない）
+            if (s[i] < 0x80 && size - i >= 32 && capacity - o >= 32)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 16));
+                if (_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_set1_epi16(static_cast<short>(0xFF80))))
+                {
+                    // packus は 128 ビット毎に詰めるので、並びを戻す
+                    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + o), packed);
+                    i += 32;
+                    o += 32;
+                    continue;
+                }
+            }
+#endif
+#if CUE_UTF_SSE41
+            // 2) 先頭の ASCII をまとめて詰めるか、先頭の 3 バイトになる文字をまとめて変換する
+            if (size - i >= 16 && capacity - o >= 16)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8));
+                const __m128i highBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i isAscii = _mm_packs_epi16(_mm_cmpeq_epi16(_mm_and_si128(a, highBits), zero),
+                    _mm_cmpeq_epi16(_mm_and_si128(b, highBits), zero));
+                const uint32_t asciiMask = static_cast<uint32_t>(_mm_movemask_epi8(isAscii));
+                const size_t asciiCount = static_cast<size_t>(std::countr_one(asciiMask));
+                if (asciiCount != 0)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + o), _mm_packus_epi16(a, b));
+                    i += asciiCount;
+                    o += asciiCount;
+                    continue;
+                }
+            }
+            if (size - i >= 8 && capacity - o >= 24)
+            {
+                const size_t count = convert_utf16_3byte_x8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), d + o);
+                if (count != 0)
+                {
+                    i += count;
+                    o += count * 3;
+                    continue;
+                }
+            }
+#endif
+            // 3) 残りは 1 文字ずつ
+            uint32_t codePoint = s[i];
+            size_t units = 1;
+            if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            {
+                // 上位サロゲートの直後に下位サロゲートが続く場合だけ正しい
+                if (codePoint >= 0xDC00 || size - i < 2 || s[i + 1] < 0xDC00 || s[i + 1] > 0xDFFF)
+                {
+                    outWritten = o;
+                    return fail_malformed("UTF-16 input is malformed.");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (static_cast<uint32_t>(s[i + 1]) - 0xDC00);
+                units = 2;
+            }
+            const size_t length = codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+            if (capacity - o < length)
+            {
+                outWritten = o;
+                return fail_no_space();
+            }
+            switch (length)
+            {
+            case 1:
+                d[o] = static_cast<char>(codePoint);
+                break;
+            case 2:
+                d[o] = static_cast<char>(0xC0 | (codePoint >> 6));
+                d[o + 1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            case 3:
+                d[o] = static_cast<char>(0xE0 | (codePoint >> 12));
+                d[o + 1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                d[o + 2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            default:
+                d[o] = static_cast<char>(0xF0 | (codePoint >> 18));
+                d[o + 1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                d[o + 2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                d[o + 3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            }
+            i += units;
+            o += length;
+        }
+        outWritten = o;
+        return Result::ok();
+    }
+
+    Result utf8_to_utf16(std::string_view src, std::pmr::u16string& out)
+    {
+        out.resize(get_utf16_capacity(src.size()));
+        size_t written = 0;
+        const Result r = utf8_to_utf16(src, std::span<char16_t>(out.data(), out.size()), written);
+        out.resize(r ? written : 0);
+        return r;
+    }
+
+    Result utf16_to_utf8(std::u16string_view src, std::pmr::string& out)
+    {
+        out.resize(get_utf8_capacity(src.size()));
+        size_t written = 0;
+        const Result r = utf16_to_utf8(src, std::span<char>(out.data(), out.size()), written);
+        out.resize(r ? written : 0);
+        return r;
+    }
+} // namespace Cue::Core
@@ -0,0 +1,234 @@
+#include "Vfs.h"
+#include "Compression.h"
+
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace Cue::Core
+{
+    namespace
+    {
+        bool is_escaping(std::string_view path) noexcept
+        {
+            // 1) ".." の区間があればマウント先の外を指しうる
+            size_t begin = 0;
+            while (begin <= path.size())
+            {
+                size_t end = path.find_first_of("/\\", begin);
+                if (end == std::string_view::npos)
+                {
+                    end = path.size();
+                }
+                if (path.substr(begin, end - begin) == "..")
+                {
+                    return true;
+                }
+                begin = end + 1;
+            }
+            return false;
+        }
+
+        // ルートと仮想パスを繋いで終端付きの実パスを作る（確保しない）
+        bool build_path(std::string_view root, std::string_view path, char (&out)[VirtualFileSystem::k_maxPath]) noexcept
+        {
+            while (!path.empty() && (path.front() == '/' || path.front() == '\\'))
+            {
+                path.remove_prefix(1);
+            }
+            if (root.size() + 1 + path.size() >= VirtualFileSystem::k_maxPath)
+            {
+                return false;
+            }
+            size_t length = root.copy(out, root.size());
+            out[length++] = '/';
+            for (char c : path)
+            {
+                out[length++] = (c == '\\') ? '/' : c;
+            }
+            out[length] = '\0';
+            return true;
+        }
+
+        bool is_regular_file(const char* path) noexcept
+        {
+#if defined(_WIN32)
+            wchar_t widePath[VirtualFileSystem::k_maxPath];
+            if (::MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, static_cast<int>(VirtualFileSystem::k_maxPath)) <= 0)
+            {
+                return false;
+            }
+            const DWORD attributes = ::GetFileAttributesW(widePath);
+            return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+#else
+            struct stat st{};
+            return ::stat(path, &st) == 0 && S_ISREG(st.st_mode);
+#endif
+        }
+    } // namespace
+
+    struct VirtualFileSystem::Impl
+    {
+        struct Mount
+        {
+            std::string root;
+            std::unique_ptr<PakArchive> pak;
+        };
+
+        // 後ろほど優先
+        std::vector<Mount> mounts;
+        JobSystem* jobSystem = nullptr;
+    };
+
+    VirtualFileSystem::VirtualFileSystem()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    VirtualFileSystem::~VirtualFileSystem()
+    {
+    }
+
+    void VirtualFileSystem::set_job_system(JobSystem* jobSystem) noexcept
+    {
+        m_impl->jobSystem = jobSystem;
+    }
+
+    Result VirtualFileSystem::mount_directory(std::string_view root)
+    {
+        // 1) 末尾の区切りを落として保存する
+        while (root.size() > 1 && (root.back() == '/' || root.back() == '\\'))
+        {
+            root.remove_suffix(1);
+        }
+        if (root.empty() || root.size() >= k_maxPath)
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "VFS directory root is invalid.");
+        }
+        Impl::Mount mount{};
+        mount.root.assign(root);
+        m_impl->mounts.push_back(std::move(mount));
+        return Result::ok();
+    }
+
+    Result VirtualFileSystem::mount_pak(std::string_view pakPath)
+    {
+        auto pak = std::make_unique<PakArchive>();
+        Result r = pak->open(pakPath);
+        if (!r)
+        {
+            return r;
+        }
+        Impl::Mount mount{};
+        mount.pak = std::move(pak);
+        m_impl->mounts.push_back(std::move(mount));
+        return Result::ok();
+    }
+
+    void VirtualFileSystem::unmount_all() noexcept
+    {
+        m_impl->mounts.clear();
+    }
+
+    Result VirtualFileSystem::open(std::string_view path, VfsFile& outFile) const
+    {
+        outFile.close();
+        if (path.empty() || is_escaping(path))
+        {
+            return Result::fail(Facility::IO, Code::InvalidArg, Severity::Error, 0, "VFS path is invalid.");
+        }
+
+        // 1) 優先度の高いマウントから順に探す（ハッシュは一度だけ計算する）
+        const uint64_t hash = hash_path(path);
+        for (auto it = m_impl->mounts.rbegin(); it != m_impl->mounts.rend(); ++it)
+        {
+            if (it->pak)
+            {
+                if (const PakTocEntry* entry = it->pak->find(hash))
+                {
+                    if (!PakArchive::is_compressed(*entry))
+                    {
+                        outFile.m_data = it->pak->get_data(*entry);
+                        return Result::ok();
+                    }
+
+                    // 圧縮された項目は展開先を確保し、ブロックを並列に展開する
+                    CompressedBlockReader reader;
+                    Result r = reader.open(it->pak->get_data(*entry));
+                    if (!r)
+                    {
+                        return r;
+                    }
+                    const size_t size = static_cast<size_t>(reader.get_uncompressed_size());
+                    outFile.m_buffer.reset(new (std::nothrow) std::byte[size]);
+                    if (!outFile.m_buffer && size != 0)
+                    {
+                        return Result::fail(Facility::IO, Code::OutOfMemory, Severity::Error, 0,
+                            "VFS failed to allocate the decompression buffer.");
+                    }
+                    r = reader.decompress(std::span<std::byte>(outFile.m_buffer.get(), size), m_impl->jobSystem);
+                    if (!r)
+                    {
+                        outFile.close();
+                        return r;
+                    }
+                    outFile.m_data = std::span<const std::byte>(outFile.m_buffer.get(), size);
+                    return Result::ok();
+                }
+                continue;
+            }
+
+            char fullPath[k_maxPath];
+            if (!build_path(it->root, path, fullPath))
+            {
+                continue;
+            }
+            Result r = outFile.m_mapping.open(fullPath);
+            if (r)
+            {
+                outFile.m_data = outFile.m_mapping.get_data();
+                return Result::ok();
+            }
+            if (r.get_code() != Code::NotFound)
+            {
+                return r;
+            }
+        }
+        return Result::fail(Facility::IO, Code::NotFound, Severity::Warning, 0, "VFS file was not found.");
+    }
+
+    bool VirtualFileSystem::exists(std::string_view path) const
+    {
+        if (path.empty() || is_escaping(path))
+        {
+            return false;
+        }
+        const uint64_t hash = hash_path(path);
+        for (auto it = m_impl->mounts.rbegin(); it != m_impl->mounts.rend(); ++it)
+        {
+            if (it->pak)
+            {
+                if (it->pak->find(hash))
+                {
+                    return true;
+                }
+                continue;
+            }
+            char fullPath[k_maxPath];
+            if (build_path(it->root, path, fullPath) && is_regular_file(fullPath))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace Cue::Core
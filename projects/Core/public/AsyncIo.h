@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief 読み込み要求の優先度（値が小さいほど先に発行する）
+    enum class IoPriority : uint8_t
+    {
+        Critical,
+        High,
+        Normal,
+        Low,
+        Count,
+    };
+
+    /// @brief 完了通知を呼ぶスレッド
+    enum class IoDelivery : uint8_t
+    {
+        // poll_completions を呼んだスレッド（メインループ等）
+        Polled,
+        // I/O スレッド上で直ちに（コールバックは短く保つこと）
+        IoThread,
+    };
+
+    enum class IoBackendType : uint8_t
+    {
+        // 使える中で最速のもの（Linux では io_uring、それ以外はスレッドプール）
+        Auto,
+        IoUring,
+        ThreadPool,
+    };
+
+    /// @brief AsyncIo で開いたファイル
+    struct IoFile
+    {
+        static constexpr uint32_t k_invalidIndex = 0xFFFFFFFFu;
+        uint32_t index = k_invalidIndex;
+        uint32_t generation = 0;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept { return index != k_invalidIndex; }
+    };
+
+    /// @brief 要求の識別子（0 は無効）
+    using IoRequestId = uint64_t;
+    inline constexpr IoRequestId k_invalidIoRequestId = 0;
+
+    struct IoCompletion
+    {
+        IoRequestId id = k_invalidIoRequestId;
+        // 取り消された場合は Code::Cancelled
+        Result result{};
+        // ファイル末尾に達した場合は要求より小さくなる
+        uint64_t bytesRead = 0;
+        void* userData = nullptr;
+    };
+
+    using IoCallback = void (*)(const IoCompletion& completion);
+
+    /// @brief 読み込み要求
+    /// @details destination は完了通知を受け取るまで呼び出し側が寿命を保証する。
+    struct IoReadRequest
+    {
+        IoFile file{};
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        void* destination = nullptr;
+        IoPriority priority = IoPriority::Normal;
+        IoDelivery delivery = IoDelivery::Polled;
+        IoCallback callback = nullptr;
+        void* userData = nullptr;
+    };
+
+    struct AsyncIoDesc
+    {
+        IoBackendType backend = IoBackendType::Auto;
+        // 同時にカーネル（またはワーカー）へ渡す読み込みの上限
+        uint32_t maxQueueDepth = 32;
+        // 読み込み帯域の上限（0 で無制限）
+        uint64_t maxBytesPerSecond = 0;
+        // スレッドプールのワーカー数
+        uint32_t threadCount = 4;
+    };
+
+    struct AsyncIoStats
+    {
+        uint64_t submittedCount = 0;
+        uint64_t completedCount = 0;
+        uint64_t failedCount = 0;
+        uint64_t cancelledCount = 0;
+        uint64_t bytesRead = 0;
+        uint32_t pendingCount = 0;
+        uint32_t inFlightCount = 0;
+    };
+
+    /// @brief 優先度付きの非同期読み込みサービス
+    /// @details 要求は優先度毎の待ち行列に積まれ、専用の I/O スレッドが深さと帯域の上限内で発行する。
+    ///          Linux では io_uring にまとめて渡し、それ以外（または io_uring が使えない環境）では
+    ///          ワーカースレッドの位置指定読み込みで処理する。
+    class AsyncIo final
+    {
+    public:
+        AsyncIo();
+        ~AsyncIo();
+        AsyncIo(const AsyncIo&) = delete;
+        AsyncIo& operator=(const AsyncIo&) = delete;
+
+        [[nodiscard]] Result initialize(const AsyncIoDesc& desc = {});
+        /// @brief 未発行の要求を取り消し、発行済みの完了を待って止める
+        /// @details 取り消した要求の IoThread の通知は止める前に I/O スレッドで呼び、
+        ///          受け取られていない Polled の完了通知は呼び出しスレッドで呼ぶ。
+        void shutdown();
+
+        /// @brief 読み込み用にファイルを開く（パスは UTF-8）
+        [[nodiscard]] Result open_file(std::string_view path, IoFile& outFile);
+        /// @brief ファイルを閉じる（そのファイルへの要求がすべて完了してから呼ぶ）
+        void close_file(IoFile file);
+        [[nodiscard]] uint64_t get_file_size(IoFile file) const noexcept;
+
+        /// @brief 読み込みを要求する（完了は callback へ delivery で指定したスレッドから通知される）
+        [[nodiscard]] Result read(const IoReadRequest& request, IoRequestId& outId);
+        /// @brief 未発行の要求を取り消す（取り消せた場合は Cancelled で完了が通知される）
+        /// @details 発行済みの要求は取り消せず false を返す（通常ファイルの読み込みはカーネルでも中断できない）。
+        ///          Cancelled の通知も delivery に従い、呼び出しスレッドでは呼ばない。
+        bool cancel(IoRequestId id);
+        /// @brief IoDelivery::Polled の完了通知を呼び出しスレッドで呼ぶ（複数のスレッドから同時に呼んでもよい）
+        /// @return 呼んだ数
+        uint32_t poll_completions(uint32_t maxCount = 0xFFFFFFFFu);
+
+        /// @brief 深さと帯域の上限を変える（深さはバックエンドの上限に丸める）
+        void set_limits(uint32_t maxQueueDepth, uint64_t maxBytesPerSecond);
+        [[nodiscard]] AsyncIoStats get_stats() const noexcept;
+        /// @brief 実際に使っているバックエンド
+        [[nodiscard]] IoBackendType get_backend_type() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Result.h"
+#include "Sha256.h"
+
+namespace Cue::Core
+{
+    struct BlobCacheDesc
+    {
+        // キャッシュ本体のパス（UTF-8）。隣に "<path>.lock" を作る
+        std::string_view path{};
+        // ファイルがこの大きさを超えたら、最近のものから 3/4 に収まる分だけ残して詰め直す
+        uint64_t sizeBudget = 256ull * 1024 * 1024;
+    };
+
+    struct BlobCacheStats
+    {
+        uint64_t hitCount = 0;
+        uint64_t missCount = 0;
+        uint64_t storeCount = 0;
+        // 内容の検査に失敗して捨てた数
+        uint64_t corruptCount = 0;
+        uint32_t compactionCount = 0;
+        uint32_t entryCount = 0;
+        uint64_t fileBytes = 0;
+    };
+
+    /// @brief 内容のハッシュで引く永続キャッシュ（コンパイル済みシェーダ等）
+    /// @details 1 つのファイルに追記するだけのログで、開く時に走査して索引をメモリ上に作り、読み込みはマップした領域から写す。
+    ///          追記は別ファイルのロックで複数プロセス間でも直列化し、書きかけの末尾は次の書き手が切り詰める。
+    ///          読み手はロックを取らず、記録の検査値で書きかけや壊れた内容を弾く。
+    ///          同じインスタンスは複数スレッドから使える。
+    class BlobCache final
+    {
+    public:
+        BlobCache();
+        ~BlobCache();
+        BlobCache(const BlobCache&) = delete;
+        BlobCache& operator=(const BlobCache&) = delete;
+
+        /// @brief 開いて索引を作る（無ければ作り、形式が違えば空にする）
+        [[nodiscard]] Result open(const BlobCacheDesc& desc);
+        void close() noexcept;
+
+        /// @brief 鍵の内容を写す（無ければ Code::NotFound。他のプロセスが足したものも拾う）
+        [[nodiscard]] Result find(const Sha256Digest& key, std::vector<std::byte>& outPayload);
+        /// @brief 鍵と内容を追記する（既にあれば何もしない）
+        [[nodiscard]] Result store(const Sha256Digest& key, std::span<const std::byte> payload);
+        /// @brief 予算に関わらず詰め直す
+        [[nodiscard]] Result compact();
+
+        [[nodiscard]] BlobCacheStats get_stats() const;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
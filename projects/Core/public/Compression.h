@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    class JobSystem;
+
+    /// @brief lz_compress の出力に必要な大きさの上限
+    [[nodiscard]] constexpr size_t lz_compress_bound(size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    /// @brief 1 ブロックを LZ 系の形式で圧縮する
+    /// @details トークン（リテラル長 4bit + 一致長 4bit）、リテラル、16bit の距離を並べる LZ4 と同系統の形式。
+    ///          距離は 64KB までなので、ブロックはそれ以下の窓でしか参照しない。
+    /// @param destination lz_compress_bound(source.size()) 以上の大きさ
+    /// @return 書いた大きさ（destination が足りなければ 0）
+    [[nodiscard]] size_t lz_compress(std::span<const std::byte> source, std::span<std::byte> destination) noexcept;
+
+    /// @brief lz_compress の出力を展開する（壊れた入力でも範囲外には書かない）
+    /// @param destination 展開後の大きさちょうど
+    [[nodiscard]] bool lz_decompress(std::span<const std::byte> source, std::span<std::byte> destination) noexcept;
+
+    // "CBLK"
+    constexpr uint32_t k_compressedMagic = 0x4B4C4243u;
+    constexpr uint32_t k_compressedVersion = 1;
+    // ブロックは独立に展開できる単位（小さいほど並列に割りやすく、大きいほど圧縮率が上がる）
+    constexpr uint32_t k_minCompressedBlockSize = 64 * 1024;
+    constexpr uint32_t k_maxCompressedBlockSize = 256 * 1024;
+    constexpr uint32_t k_defaultCompressedBlockSize = 128 * 1024;
+
+    /// @brief ブロック圧縮したデータの先頭
+    struct CompressedHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t blockSize;
+        uint32_t blockCount;
+        uint64_t uncompressedSize;
+        uint64_t reserved;
+    };
+
+    // 圧縮しても縮まなかったブロックはそのまま置く
+    constexpr uint32_t k_compressedBlockStored = 1u << 0;
+
+    /// @brief ブロックの索引（ヘッダ直後に blockCount 個並ぶ）
+    struct CompressedBlockEntry
+    {
+        // ヘッダの先頭からの位置
+        uint64_t offset;
+        uint32_t compressedSize;
+        uint32_t flags;
+    };
+
+    static_assert(sizeof(CompressedHeader) == 32 && sizeof(CompressedBlockEntry) == 16,
+        "compressed layout must not change silently.");
+
+    /// @brief source をブロックに分けて圧縮し、ヘッダと索引を付けて out に書く
+    /// @param jobSystem 渡せばブロックを並列に圧縮する
+    [[nodiscard]] Result compress_blocks(std::span<const std::byte> source, uint32_t blockSize,
+        std::vector<std::byte>& out, JobSystem* jobSystem = nullptr);
+
+    /// @brief ブロック圧縮したデータを検証して展開する
+    /// @details 参照するだけで複製しないので、data は読み終えるまで呼び出し側が保持する。
+    class CompressedBlockReader final
+    {
+    public:
+        /// @brief 先頭がブロック圧縮の形式か（検証はしない）
+        [[nodiscard]] static bool is_compressed(std::span<const std::byte> data) noexcept;
+
+        /// @brief ヘッダと索引を検証する
+        [[nodiscard]] Result open(std::span<const std::byte> data);
+
+        [[nodiscard]] uint64_t get_uncompressed_size() const noexcept { return m_header.uncompressedSize; }
+        [[nodiscard]] uint32_t get_block_size() const noexcept { return m_header.blockSize; }
+        [[nodiscard]] uint32_t get_block_count() const noexcept { return m_header.blockCount; }
+        [[nodiscard]] uint32_t get_block_uncompressed_size(uint32_t index) const noexcept;
+
+        /// @brief 1 ブロックを展開する（destination はそのブロックの展開後の大きさ以上）
+        [[nodiscard]] Result decompress_block(uint32_t index, std::span<std::byte> destination) const noexcept;
+        /// @brief 全体を呼び出し側の領域へ直接展開する
+        /// @param destination get_uncompressed_size 以上の大きさ
+        /// @param jobSystem 渡せばブロックをワーカーに分けて展開する
+        [[nodiscard]] Result decompress(std::span<std::byte> destination, JobSystem* jobSystem = nullptr) const;
+    private:
+        std::span<const std::byte> m_data;
+        std::span<const CompressedBlockEntry> m_blocks;
+        CompressedHeader m_header{};
+    };
+} // namespace Cue::Core
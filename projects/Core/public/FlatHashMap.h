@@ -0,0 +1,529 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// グループの照合は SSE2 で 16 バイトずつ行う（CUE_SIMD が SCALAR の時は 64 ビット整数 2 つで行う）
+#if defined(CUE_SIMD_AVX2) || defined(CUE_SIMD_SSE41)
+#include <emmintrin.h>
+#define CUE_FLAT_HASH_SSE2 1
+#else
+#define CUE_FLAT_HASH_SSE2 0
+#endif
+
+namespace Cue::Core
+{
+    namespace Detail
+    {
+        // 制御バイト：使用中はハッシュの下位 7 ビット（0..127）、空きと削除済みは負の値
+        inline constexpr int8_t k_ctrlEmpty = -128;
+        inline constexpr int8_t k_ctrlDeleted = -2;
+        inline constexpr size_t k_groupWidth = 16;
+
+        /// @brief グループ内で条件に合った位置のビット列（下位ビットから順に取り出す）
+        struct GroupBits
+        {
+            uint32_t bits = 0;
+
+            explicit operator bool() const noexcept { return bits != 0; }
+            [[nodiscard]] uint32_t get_lowest() const noexcept { return static_cast<uint32_t>(std::countr_zero(bits)); }
+            void clear_lowest() noexcept { bits &= bits - 1; }
+        };
+
+        /// @brief 16 個の制御バイトをまとめて照合する
+        struct Group
+        {
+#if CUE_FLAT_HASH_SSE2
+            __m128i ctrl;
+
+            explicit Group(const int8_t* position) noexcept
+                : ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(position)))
+            {
+            }
+            [[nodiscard]] GroupBits match(int8_t h2) const noexcept
+            {
+                return { static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))) };
+            }
+            [[nodiscard]] GroupBits match_empty() const noexcept
+            {
+                return match(k_ctrlEmpty);
+            }
+            [[nodiscard]] GroupBits match_empty_or_deleted() const noexcept
+            {
+                // 空きと削除済みだけが -1 より小さい
+                return { static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))) };
+            }
+#else
+            // SIMD が無い時は 8 バイトずつ 64 ビット整数として照合する（リトルエンディアン前提）
+            static constexpr uint64_t k_lsbs = 0x0101010101010101ull;
+            static constexpr uint64_t k_msbs = 0x8080808080808080ull;
+
+            uint64_t low;
+            uint64_t high;
+
+            explicit Group(const int8_t* position) noexcept
+            {
+                std::memcpy(&low, position, sizeof(low));
+                std::memcpy(&high, position + sizeof(low), sizeof(high));
+            }
+            [[nodiscard]] GroupBits match(int8_t h2) const noexcept
+            {
+                // 繰り下がりで一致の上のバイトを誤って拾うことがあるが、そのバイトは h2 ^ 1（使用中）なのでキー比較で落ちる
+                const uint64_t pattern = k_lsbs * static_cast<uint8_t>(h2);
+                const uint64_t x = low ^ pattern;
+                const uint64_t y = high ^ pattern;
+                return to_bits((x - k_lsbs) & ~x & k_msbs, (y - k_lsbs) & ~y & k_msbs);
+            }
+            [[nodiscard]] GroupBits match_empty() const noexcept
+            {
+                // 最上位ビットが立ち、ビット 1 が落ちているのは空き（0x80）だけ
+                return to_bits(low & ~(low << 6) & k_msbs, high & ~(high << 6) & k_msbs);
+            }
+            [[nodiscard]] GroupBits match_empty_or_deleted() const noexcept
+            {
+                return to_bits(low & k_msbs, high & k_msbs);
+            }
+        private:
+            /// @brief 各バイトの最上位ビットを 1 バイトあたり 1 ビットに詰める
+            [[nodiscard]] static GroupBits to_bits(uint64_t lowMsbs, uint64_t highMsbs) noexcept
+            {
+                constexpr uint64_t k_gather = 0x0102040810204080ull;
+                const uint32_t lowBits = static_cast<uint32_t>(((lowMsbs >> 7) * k_gather) >> 56);
+                const uint32_t highBits = static_cast<uint32_t>(((highMsbs >> 7) * k_gather) >> 56);
+                return { lowBits | (highBits << 8) };
+            }
+#endif
+        };
+
+        /// @brief std::hash の弱い値（整数では恒等写像）を上位ビットまで混ぜる
+        [[nodiscard]] inline uint64_t mix_hash(uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            return h;
+        }
+    } // namespace Detail
+
+    /// @brief オープンアドレス法のハッシュマップ（SwissTable 方式）
+    /// @details キーと値を 1 本の配列に直に並べ、別に持つ 1 バイトの制御バイトを 16 個ずつまとめて照合する。
+    ///          探索は制御バイトの一致で候補を絞ってからキーを比べるので、外れのキー比較がほとんど起きない。
+    ///          制御バイトと要素は upstream からの 1 回の確保にまとめる。
+    ///          std::unordered_map と違い、再ハッシュ（挿入で容量が増える時）で要素のアドレスは変わる。
+    template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    class FlatHashMap final
+    {
+    public:
+        /// @brief 1 要素（key は書き換えないこと）
+        struct Entry
+        {
+            K key;
+            V value;
+        };
+
+        template<bool IsConst>
+        class IteratorBase final
+        {
+        public:
+            using MapType = std::conditional_t<IsConst, const FlatHashMap, FlatHashMap>;
+            using EntryType = std::conditional_t<IsConst, const Entry, Entry>;
+
+            IteratorBase() noexcept = default;
+            IteratorBase(MapType* map, size_t index) noexcept
+                : m_map(map)
+                , m_index(index)
+            {
+                skip_free();
+            }
+            // 非 const から const への変換
+            template<bool IsOtherConst, typename = std::enable_if_t<IsConst && !IsOtherConst>>
+            IteratorBase(const IteratorBase<IsOtherConst>& other) noexcept
+                : m_map(other.m_map)
+                , m_index(other.m_index)
+            {
+            }
+
+            [[nodiscard]] EntryType& operator*() const noexcept { return m_map->m_slots[m_index]; }
+            [[nodiscard]] EntryType* operator->() const noexcept { return &m_map->m_slots[m_index]; }
+            IteratorBase& operator++() noexcept
+            {
+                ++m_index;
+                skip_free();
+                return *this;
+            }
+            [[nodiscard]] bool operator==(const IteratorBase& other) const noexcept { return m_index == other.m_index; }
+            [[nodiscard]] bool operator!=(const IteratorBase& other) const noexcept { return m_index != other.m_index; }
+        private:
+            friend class FlatHashMap;
+            template<bool>
+            friend class IteratorBase;
+
+            void skip_free() noexcept
+            {
+                while (m_index < m_map->m_capacity && m_map->m_ctrl[m_index] < 0)
+                {
+                    ++m_index;
+                }
+            }
+
+            MapType* m_map = nullptr;
+            size_t m_index = 0;
+        };
+        using iterator = IteratorBase<false>;
+        using const_iterator = IteratorBase<true>;
+
+        /// @param upstream 制御バイトと要素の確保先（nullptr で std::pmr::get_default_resource()）
+        explicit FlatHashMap(std::pmr::memory_resource* upstream = nullptr) noexcept
+            : m_upstream(upstream ? upstream : std::pmr::get_default_resource())
+        {
+        }
+        FlatHashMap(const FlatHashMap& other)
+            : FlatHashMap(other.m_upstream)
+        {
+            copy_from(other);
+        }
+        FlatHashMap(FlatHashMap&& other) noexcept
+            : FlatHashMap(other.m_upstream)
+        {
+            steal_from(other);
+        }
+        ~FlatHashMap()
+        {
+            release();
+        }
+
+        FlatHashMap& operator=(const FlatHashMap& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_from(other);
+            }
+            return *this;
+        }
+        FlatHashMap& operator=(FlatHashMap&& other)
+        {
+            if (this != &other)
+            {
+                if (other.m_upstream->is_equal(*m_upstream))
+                {
+                    release();
+                    steal_from(other);
+                }
+                else
+                {
+                    // 確保先が違う時は領域を引き取れないので、1 つずつ移す
+                    clear();
+                    reserve(other.m_size);
+                    for (Entry& entry : other)
+                    {
+                        try_emplace(std::move(entry.key), std::move(entry.value));
+                    }
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        /// @brief キーが無ければ args で値を作って挿入する
+        /// @return 値へのポインタと、挿入したか（既にあれば false で既存の値を返す）
+        template<typename KeyArg, typename... Args>
+        std::pair<V*, bool> try_emplace(KeyArg&& key, Args&&... args)
+        {
+            // 1) 既にあればそれを返す
+            const uint64_t hash = get_hash(key);
+            const size_t found = find_index(key, hash);
+            if (found != k_notFound)
+            {
+                return { &m_slots[found].value, false };
+            }
+
+            // 2) 削除済みも含めて 7/8 を超えるなら、広げるか詰め直す
+            if ((m_size + m_deletedCount + 1) * 8 > m_capacity * 7)
+            {
+                grow();
+            }
+
+            // 3) 探索列の最初の空きか削除済みに置く
+            const size_t index = find_insert_index(hash);
+            if (m_ctrl[index] == Detail::k_ctrlDeleted)
+            {
+                --m_deletedCount;
+            }
+            m_ctrl[index] = get_h2(hash);
+            ::new (static_cast<void*>(m_slots + index)) Entry{ K(std::forward<KeyArg>(key)), V(std::forward<Args>(args)...) };
+            ++m_size;
+            return { &m_slots[index].value, true };
+        }
+        /// @brief キーが無ければ既定値で挿入し、値を返す
+        V& operator[](const K& key)
+        {
+            return *try_emplace(key).first;
+        }
+
+        /// @return 値へのポインタ（無ければ nullptr）
+        [[nodiscard]] V* find(const K& key) noexcept
+        {
+            const size_t index = find_index(key, get_hash(key));
+            return index != k_notFound ? &m_slots[index].value : nullptr;
+        }
+        [[nodiscard]] const V* find(const K& key) const noexcept
+        {
+            const size_t index = find_index(key, get_hash(key));
+            return index != k_notFound ? &m_slots[index].value : nullptr;
+        }
+        [[nodiscard]] bool contains(const K& key) const noexcept
+        {
+            return find_index(key, get_hash(key)) != k_notFound;
+        }
+
+        /// @return 取り除いたら true
+        bool erase(const K& key)
+        {
+            const size_t index = find_index(key, get_hash(key));
+            if (index == k_notFound)
+            {
+                return false;
+            }
+            erase_at(index);
+            return true;
+        }
+        /// @return 次の要素（要素は動かないので、走査しながら消せる）
+        iterator erase(const_iterator position)
+        {
+            erase_at(position.m_index);
+            return iterator(this, position.m_index + 1);
+        }
+
+        /// @brief 全要素を破棄する（領域は残す）
+        void clear() noexcept
+        {
+            if (m_capacity == 0)
+            {
+                return;
+            }
+            destroy_entries();
+            std::memset(m_ctrl, Detail::k_ctrlEmpty, m_capacity);
+            m_size = 0;
+            m_deletedCount = 0;
+        }
+
+        /// @brief count 個まで再ハッシュせずに入るようにする
+        void reserve(size_t count)
+        {
+            const size_t capacity = get_capacity_for(count);
+            if (capacity > m_capacity)
+            {
+                rehash(capacity);
+            }
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return iterator(this, 0); }
+        [[nodiscard]] iterator end() noexcept { return iterator(this, m_capacity); }
+        [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, m_capacity); }
+
+        [[nodiscard]] size_t size() const noexcept { return m_size; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] size_t get_capacity() const noexcept { return m_capacity; }
+    private:
+        static constexpr size_t k_notFound = ~size_t(0);
+
+        [[nodiscard]] static uint64_t get_hash(const K& key) noexcept
+        {
+            return Detail::mix_hash(static_cast<uint64_t>(Hash{}(key)));
+        }
+        [[nodiscard]] static int8_t get_h2(uint64_t hash) noexcept
+        {
+            return static_cast<int8_t>(hash & 0x7F);
+        }
+        [[nodiscard]] static size_t get_capacity_for(size_t count) noexcept
+        {
+            const size_t needed = count + count / 7 + 1;
+            return std::bit_ceil(needed < Detail::k_groupWidth ? Detail::k_groupWidth : needed);
+        }
+
+        [[nodiscard]] size_t find_index(const K& key, uint64_t hash) const noexcept
+        {
+            if (m_capacity == 0)
+            {
+                return k_notFound;
+            }
+            // グループ単位の三角数列の探索（グループ数が 2 の冪なので全グループを 1 度ずつ巡る）
+            const size_t groupMask = m_capacity / Detail::k_groupWidth - 1;
+            const int8_t h2 = get_h2(hash);
+            size_t group = static_cast<size_t>(hash >> 7) & groupMask;
+            for (size_t step = 1;; ++step)
+            {
+                const size_t base = group * Detail::k_groupWidth;
+                const Detail::Group g(m_ctrl + base);
+                for (Detail::GroupBits bits = g.match(h2); bits; bits.clear_lowest())
+                {
+                    const size_t index = base + bits.get_lowest();
+                    if (Eq{}(m_slots[index].key, key)) [[likely]]
+                    {
+                        return index;
+                    }
+                }
+                // 空きのあるグループより先には置かれていない
+                if (g.match_empty() || step > groupMask)
+                {
+                    return k_notFound;
+                }
+                group = (group + step) & groupMask;
+            }
+        }
+
+        [[nodiscard]] size_t find_insert_index(uint64_t hash) const noexcept
+        {
+            const size_t groupMask = m_capacity / Detail::k_groupWidth - 1;
+            size_t group = static_cast<size_t>(hash >> 7) & groupMask;
+            for (size_t step = 1;; ++step)
+            {
+                const size_t base = group * Detail::k_groupWidth;
+                const Detail::GroupBits bits = Detail::Group(m_ctrl + base).match_empty_or_deleted();
+                if (bits)
+                {
+                    return base + bits.get_lowest();
+                }
+                group = (group + step) & groupMask;
+            }
+        }
+
+        void erase_at(size_t index) noexcept
+        {
+            // グループに空きが残っていれば探索はそこで止まるので、空きに戻してよい
+            m_slots[index].~Entry();
+            const size_t base = index & ~(Detail::k_groupWidth - 1);
+            if (Detail::Group(m_ctrl + base).match_empty())
+            {
+                m_ctrl[index] = Detail::k_ctrlEmpty;
+            }
+            else
+            {
+                m_ctrl[index] = Detail::k_ctrlDeleted;
+                ++m_deletedCount;
+            }
+            --m_size;
+        }
+
+        void grow()
+        {
+            // 削除済みが半分以上を占めるなら、同じ容量で詰め直すだけで足りる
+            if (m_capacity != 0 && m_deletedCount * 2 >= m_size)
+            {
+                rehash(m_capacity);
+            }
+            else
+            {
+                rehash(m_capacity == 0 ? Detail::k_groupWidth : m_capacity * 2);
+            }
+        }
+
+        [[nodiscard]] static size_t get_slot_offset(size_t capacity) noexcept
+        {
+            return (capacity + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+        }
+        [[nodiscard]] static size_t get_allocation_size(size_t capacity) noexcept
+        {
+            return get_slot_offset(capacity) + capacity * sizeof(Entry);
+        }
+        [[nodiscard]] static size_t get_allocation_alignment() noexcept
+        {
+            return alignof(Entry) > Detail::k_groupWidth ? alignof(Entry) : Detail::k_groupWidth;
+        }
+
+        void rehash(size_t newCapacity)
+        {
+            // 1) 新しい領域を確保して全て空きにする
+            void* memory = m_upstream->allocate(get_allocation_size(newCapacity), get_allocation_alignment());
+            int8_t* oldCtrl = m_ctrl;
+            Entry* oldSlots = m_slots;
+            const size_t oldCapacity = m_capacity;
+            m_ctrl = static_cast<int8_t*>(memory);
+            m_slots = reinterpret_cast<Entry*>(static_cast<unsigned char*>(memory) + get_slot_offset(newCapacity));
+            m_capacity = newCapacity;
+            m_deletedCount = 0;
+            std::memset(m_ctrl, Detail::k_ctrlEmpty, newCapacity);
+
+            // 2) 使用中の要素を移す（新しい表に同じキーは無いので、空きを探すだけでよい）
+            for (size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] >= 0)
+                {
+                    const uint64_t hash = get_hash(oldSlots[i].key);
+                    const size_t index = find_insert_index(hash);
+                    m_ctrl[index] = get_h2(hash);
+                    ::new (static_cast<void*>(m_slots + index)) Entry(std::move(oldSlots[i]));
+                    oldSlots[i].~Entry();
+                }
+            }
+
+            // 3) 古い領域を返す
+            if (oldCapacity != 0)
+            {
+                m_upstream->deallocate(oldCtrl, get_allocation_size(oldCapacity), get_allocation_alignment());
+            }
+        }
+
+        void destroy_entries() noexcept
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] >= 0)
+                {
+                    m_slots[i].~Entry();
+                }
+            }
+        }
+
+        void release() noexcept
+        {
+            if (m_capacity == 0)
+            {
+                return;
+            }
+            destroy_entries();
+            m_upstream->deallocate(m_ctrl, get_allocation_size(m_capacity), get_allocation_alignment());
+            m_ctrl = nullptr;
+            m_slots = nullptr;
+            m_capacity = 0;
+            m_size = 0;
+            m_deletedCount = 0;
+        }
+
+        void copy_from(const FlatHashMap& other)
+        {
+            reserve(other.m_size);
+            for (const Entry& entry : other)
+            {
+                try_emplace(entry.key, entry.value);
+            }
+        }
+
+        void steal_from(FlatHashMap& other) noexcept
+        {
+            m_upstream = other.m_upstream;
+            m_ctrl = std::exchange(other.m_ctrl, nullptr);
+            m_slots = std::exchange(other.m_slots, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_size = std::exchange(other.m_size, 0);
+            m_deletedCount = std::exchange(other.m_deletedCount, 0);
+        }
+
+        std::pmr::memory_resource* m_upstream = nullptr;
+        int8_t* m_ctrl = nullptr;
+        Entry* m_slots = nullptr;
+        size_t m_capacity = 0;
+        size_t m_size = 0;
+        size_t m_deletedCount = 0;
+    };
+} // namespace Cue::Core
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief FrameArena の初期化情報
+    struct FrameArenaDesc
+    {
+        // 1 フレーム分のバッファサイズ
+        size_t bytesPerFrame = 16u * 1024u * 1024u;
+        // バッファ数（2: ダブルバッファ, 3: トリプルバッファ）
+        uint32_t frameCount = 2;
+        // スレッド毎に切り出すブロックの大きさ（2 の冪）
+        size_t blockSize = 64u * 1024u;
+        // 容量不足時の退避先（nullptr で std::pmr::get_default_resource()）
+        std::pmr::memory_resource* upstream = nullptr;
+    };
+
+    /// @brief フレーム単位で巻き戻すバンプアロケータ
+    /// @details 各スレッドは共有バッファから blockSize 単位のブロックを atomic に切り出し、
+    ///          以降はそのブロック内でロック無しにバンプ確保する（ワーカー同士が競合しない）。
+    ///          確保したメモリは frameCount 回 begin_frame を呼ぶまで有効で、個別解放はできない。
+    ///          begin_frame は他スレッドの確保と並行して呼んではならない（フレーム境界で呼ぶこと）。
+    ///          std::pmr::memory_resource として使う場合、容量不足分は upstream から確保する。
+    class FrameArena final : public std::pmr::memory_resource
+    {
+    public:
+        FrameArena();
+        ~FrameArena() override;
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /// @brief バッファを確保する
+        [[nodiscard]] Result initialize(const FrameArenaDesc& desc = {});
+        /// @brief バッファを解放する
+        void shutdown();
+
+        /// @brief 次のバッファへ切り替えて巻き戻す
+        /// @return デバッグビルドで終了したフレームの境界チェックに失敗した場合はエラー
+        [[nodiscard]] Result begin_frame();
+
+        /// @brief バッファから確保する
+        /// @return 容量不足なら nullptr（upstream へは退避しない）
+        [[nodiscard]] void* try_allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+        /// @brief 型付きで count 個分の領域を確保する（コンストラクタは呼ばない）
+        template<typename T>
+        [[nodiscard]] T* try_allocate_array(size_t count) noexcept
+        {
+            return static_cast<T*>(try_allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /// @brief 現在のフレームで切り出し済みのバイト数（ブロック単位）
+        [[nodiscard]] size_t get_used_bytes() const noexcept;
+        /// @brief pmr 経由で upstream に退避した累計バイト数
+        [[nodiscard]] size_t get_overflow_bytes() const noexcept;
+        /// @brief 現在のフレーム番号（begin_frame 毎に増える）
+        [[nodiscard]] uint64_t get_frame_index() const noexcept;
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    private:
+        void* allocate_slow(size_t size, size_t alignment) noexcept;
+        [[nodiscard]] bool owns(const void* p) const noexcept;
+
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief ジョブ本体。data はジョブ完了まで呼び出し側が寿命を保証する
+    using JobFunction = void (*)(void* data);
+
+    /// @brief ジョブの宣言
+    struct JobDecl
+    {
+        JobFunction function = nullptr;
+        void* data = nullptr;
+    };
+
+    /// @brief fork-join 用の完了カウンタ
+    /// @details run で投入したジョブ数だけ加算され、完了ごとに減算される。
+    ///          0 になった時点で、紐づくジョブがすべて完了したことを表す。
+    class JobCounter final
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        /// @brief 紐づくジョブがすべて完了しているか
+        [[nodiscard]] bool is_done() const noexcept
+        {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        }
+    private:
+        friend class JobSystem;
+        std::atomic<uint32_t> m_pending{ 0 };
+    };
+
+    /// @brief ジョブシステムの初期化情報
+    struct JobSystemDesc
+    {
+        // 呼び出しスレッドを含む実行スレッド数（0 でハードウェアのコア数）
+        uint32_t workerCount = 0;
+        // ワーカー毎の deque 容量（2 の冪に切り上げる）
+        uint32_t queueCapacity = 4096;
+    };
+
+    /// @brief ワークスティーリング方式のジョブスケジューラ
+    /// @details initialize を呼んだスレッドをワーカー 0 とし、残りを専用スレッドとして起動する。
+    ///          各ワーカーは Chase-Lev deque を持ち、自分の deque が空になると他から盗む。
+    ///          wait はブロックせず、カウンタが 0 になるまで他のジョブを実行して待つ。
+    class JobSystem final
+    {
+    public:
+        static constexpr uint32_t k_invalidWorkerIndex = 0xFFFFFFFFu;
+        static constexpr uint32_t k_maxParallelForJobs = 64;
+
+        JobSystem();
+        ~JobSystem();
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /// @brief ワーカースレッドを起動する
+        [[nodiscard]] Result initialize(const JobSystemDesc& desc = {});
+        /// @brief 全ワーカーを停止する（未実行のジョブは破棄される）
+        void shutdown();
+
+        /// @brief ジョブを投入する
+        /// @param jobs ジョブ配列（内容はコピーされる）
+        /// @param count ジョブ数
+        /// @param counter 完了通知先（不要なら nullptr）
+        void run(const JobDecl* jobs, uint32_t count, JobCounter* counter);
+        /// @brief ジョブを 1 つ投入する
+        void run(const JobDecl& job, JobCounter* counter)
+        {
+            run(&job, 1, counter);
+        }
+        /// @brief counter が 0 になるまで、他のジョブを実行しながら待つ
+        void wait(JobCounter& counter);
+
+        /// @brief [0, count) を grainSize 毎に分割して並列実行し、完了まで待つ
+        /// @param body void(uint32_t begin, uint32_t end) 形式の処理
+        template<typename F>
+        void parallel_for(uint32_t count, uint32_t grainSize, F&& body);
+
+        /// @brief 呼び出しスレッドを含む実行スレッド数
+        [[nodiscard]] uint32_t get_worker_count() const noexcept;
+        /// @brief 呼び出しスレッドのワーカー番号（このシステムのワーカーでなければ k_invalidWorkerIndex）
+        [[nodiscard]] uint32_t get_current_worker_index() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    template<typename F>
+    void JobSystem::parallel_for(uint32_t count, uint32_t grainSize, F&& body)
+    {
+        // 1) 分割単位を決める（小さすぎる分割は投入コストが勝つ）
+        if (count == 0)
+        {
+            return;
+        }
+        const uint32_t grain = std::max(grainSize, 1u);
+        const uint32_t chunkCount = (count + grain - 1) / grain;
+        if (chunkCount == 1)
+        {
+            body(0u, count);
+            return;
+        }
+
+        // 2) ジョブはチャンクを動的に取り合うので、ワーカー数分だけ投入すれば足りる
+        //    （コンテキストはスタック上に置き、確保を発生させない）
+        struct Context
+        {
+            std::remove_reference_t<F>* body;
+            std::atomic<uint32_t> next;
+            uint32_t count;
+            uint32_t grain;
+        };
+        Context context{ &body, { 0 }, count, grain };
+
+        JobFunction function = [](void* data)
+            {
+                Context* c = static_cast<Context*>(data);
+                for (;;)
+                {
+                    const uint32_t begin = c->next.fetch_add(c->grain, std::memory_order_relaxed);
+                    if (begin >= c->count)
+                    {
+                        break;
+                    }
+                    (*c->body)(begin, std::min(begin + c->grain, c->count));
+                }
+            };
+
+        const uint32_t jobCount = std::min({ chunkCount, std::max(get_worker_count(), 1u), k_maxParallelForJobs });
+        JobDecl decls[k_maxParallelForJobs];
+        for (uint32_t i = 0; i < jobCount; ++i)
+        {
+            decls[i] = JobDecl{ function, &context };
+        }
+
+        // 3) 呼び出しスレッドも wait の中で処理に参加する
+        JobCounter counter;
+        run(decls, jobCount, &counter);
+        wait(counter);
+    }
+} // namespace Cue::Core
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief スレッド毎のリングが満杯のときの振る舞い
+    enum class LogOverflowPolicy : uint8_t
+    {
+        // 記録を捨てて呼び出し側を止めない（捨てた件数は数える）
+        Drop = 0,
+        // 空きができるまで呼び出し側を待たせる（記録は失わない）
+        Block = 1,
+    };
+
+    /// @brief Logger の初期化情報
+    struct LoggerDesc
+    {
+        // 出力ファイル（nullptr でファイル出力しない）
+        const char* filePath = nullptr;
+        // 標準エラーへも出力するか
+        bool isStderrEnabled = true;
+        // スレッド毎のリング容量（レコード数、2 の冪に切り上げる）
+        uint32_t ringCapacity = 1024;
+        // リング満杯時の振る舞い
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop;
+        // これ未満の重大度は記録しない
+        Severity minSeverity = Severity::Info;
+        // 書き出しスレッドが溜まった記録を掃き出す間隔
+        uint32_t flushIntervalMs = 2;
+    };
+
+    /// @brief Result を非同期に書き出すロガー
+    /// @details 呼び出し側は Result のフィールドと文字列ポインタだけを固定長レコードとして
+    ///          スレッド毎のロックフリーリング（SPSC）に積み、整形と書き出しは専用スレッドがまとめて行う。
+    ///          そのため message/file/function は静的な寿命を持つ文字列でなければならない。
+    ///          各スレッドの初回の log でリングを登録する（確保はこの 1 回だけ）。スレッドが終わると
+    ///          書き出しスレッドが残りを掃き出した後にリングを空きに戻し、次に登録するスレッドが使い回す。
+    class Logger final
+    {
+    public:
+        // 同時に登録できるスレッド数の上限（超えたスレッドの記録は捨てる）
+        static constexpr uint32_t k_maxThreads = 256;
+
+        Logger();
+        ~Logger();
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        /// @brief 書き出しスレッドを起動する
+        [[nodiscard]] Result initialize(const LoggerDesc& desc = {});
+        /// @brief 溜まった記録を書き出してから停止し、リングを手放す（他のスレッドが log を呼び終えてから呼ぶこと）
+        void shutdown();
+
+        /// @brief Result を記録する
+        /// @return 記録できなかった（捨てた・未初期化・重大度が低い）場合は false
+        bool log(const Result& r) noexcept;
+        /// @brief 呼び出し時点までに積まれた記録が書き出されるまで待つ
+        void flush();
+
+        /// @brief リング満杯などで捨てた記録数
+        [[nodiscard]] uint64_t get_dropped_count() const noexcept;
+        /// @brief 書き出した記録数
+        [[nodiscard]] uint64_t get_written_count() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief 読み取り専用でメモリマップしたファイル
+    /// @details 内容はページ単位で必要な時に読み込まれ、get_data の範囲はコピー無しで参照できる。
+    class MappedFile final
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /// @brief ファイルを開いてマップする（パスは UTF-8）
+        [[nodiscard]] Result open(std::string_view path);
+        void close() noexcept;
+
+        [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr || m_isEmpty; }
+        [[nodiscard]] std::span<const std::byte> get_data() const noexcept
+        {
+            return std::span<const std::byte>(m_data, m_size);
+        }
+    private:
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+        // 空のファイルはマップできないので、開けたことだけを覚える
+        bool m_isEmpty = false;
+#if defined(_WIN32)
+        void* m_mapping = nullptr;
+#endif
+    };
+} // namespace Cue::Core
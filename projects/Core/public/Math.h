@@ -0,0 +1,542 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// SIMD 実装はビルド時に選択する（CMake の CUE_SIMD で CUE_SIMD_AVX2 / CUE_SIMD_SSE41 が定義される）
+#if defined(CUE_SIMD_AVX2)
+#include <immintrin.h>
+#define CUE_MATH_SSE41 1
+#define CUE_MATH_AVX2 1
+#elif defined(CUE_SIMD_SSE41)
+#include <smmintrin.h>
+#define CUE_MATH_SSE41 1
+#define CUE_MATH_AVX2 0
+#else
+#define CUE_MATH_SSE41 0
+#define CUE_MATH_AVX2 0
+#endif
+
+namespace Cue::Math
+{
+    constexpr float k_pi = 3.14159265358979323846f;
+
+    /// @brief 3 要素ベクトル（格納用、SIMD 化しない）
+    struct Float3
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    /// @brief 4 要素ベクトル
+    struct alignas(16) Float4
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 0.0f;
+    };
+
+    /// @brief 回転を表す単位クォータニオン（w が実部）
+    struct alignas(16) Quaternion
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 1.0f;
+    };
+
+    /// @brief 行優先の 4x4 行列
+    /// @details D3D と同じく行ベクトル規約（p' = p * M）で、r[3] が平行移動になる。
+    struct alignas(16) Float4x4
+    {
+        Float4 r[4] = {
+            { 1.0f, 0.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+            { 0.0f, 0.0f, 0.0f, 1.0f },
+        };
+    };
+
+    using float3 = Float3;
+    using float4 = Float4;
+    using float4x4 = Float4x4;
+    using quaternion = Quaternion;
+
+    // ---------------------------------------------------------------------
+    // Float3
+    // ---------------------------------------------------------------------
+    [[nodiscard]] constexpr float3 operator+(const float3& a, const float3& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    [[nodiscard]] constexpr float3 operator-(const float3& a, const float3& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    [[nodiscard]] constexpr float3 operator*(const float3& a, float s) noexcept { return { a.x * s, a.y * s, a.z * s }; }
+    [[nodiscard]] constexpr float3 operator-(const float3& a) noexcept { return { -a.x, -a.y, -a.z }; }
+
+    [[nodiscard]] constexpr float dot(const float3& a, const float3& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+    [[nodiscard]] constexpr float3 cross(const float3& a, const float3& b) noexcept
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    [[nodiscard]] inline float length(const float3& a) noexcept
+    {
+        return std::sqrt(dot(a, a));
+    }
+    [[nodiscard]] inline float3 normalize(const float3& a) noexcept
+    {
+        const float len = length(a);
+        return (len > 0.0f) ? a * (1.0f / len) : float3{};
+    }
+
+    // ---------------------------------------------------------------------
+    // Float4
+    // ---------------------------------------------------------------------
+#if CUE_MATH_SSE41
+    namespace Detail
+    {
+        [[nodiscard]] inline __m128 load(const Float4& v) noexcept { return _mm_load_ps(&v.x); }
+        [[nodiscard]] inline __m128 load(const Quaternion& q) noexcept { return _mm_load_ps(&q.x); }
+        [[nodiscard]] inline Float4 store4(__m128 v) noexcept
+        {
+            Float4 r;
+            _mm_store_ps(&r.x, v);
+            return r;
+        }
+        [[nodiscard]] inline Quaternion store_quat(__m128 v) noexcept
+        {
+            Quaternion r;
+            _mm_store_ps(&r.x, v);
+            return r;
+        }
+        // a * b + c（AVX2 ビルドでは FMA を使う）
+        [[nodiscard]] inline __m128 madd(__m128 a, __m128 b, __m128 c) noexcept
+        {
+#if CUE_MATH_AVX2
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+        template<int i>
+        [[nodiscard]] inline __m128 splat(__m128 v) noexcept
+        {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i));
+        }
+    }
+
+    [[nodiscard]] inline float4 operator+(const float4& a, const float4& b) noexcept { return Detail::store4(_mm_add_ps(Detail::load(a), Detail::load(b))); }
+    [[nodiscard]] inline float4 operator-(const float4& a, const float4& b) noexcept { return Detail::store4(_mm_sub_ps(Detail::load(a), Detail::load(b))); }
+    [[nodiscard]] inline float4 operator*(const float4& a, float s) noexcept { return Detail::store4(_mm_mul_ps(Detail::load(a), _mm_set1_ps(s))); }
+    [[nodiscard]] inline float dot(const float4& a, const float4& b) noexcept
+    {
+        return _mm_cvtss_f32(_mm_dp_ps(Detail::load(a), Detail::load(b), 0xF1));
+    }
+#else
+    [[nodiscard]] inline float4 operator+(const float4& a, const float4& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; }
+    [[nodiscard]] inline float4 operator-(const float4& a, const float4& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; }
+    [[nodiscard]] inline float4 operator*(const float4& a, float s) noexcept { return { a.x * s, a.y * s, a.z * s, a.w * s }; }
+    [[nodiscard]] inline float dot(const float4& a, const float4& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+#endif
+
+    // ---------------------------------------------------------------------
+    // スカラー参照実装（SIMD 版の検証と、SIMD 非対応環境での実装を兼ねる）
+    // ---------------------------------------------------------------------
+    namespace Scalar
+    {
+        [[nodiscard]] inline float4x4 multiply(const float4x4& a, const float4x4& b) noexcept
+        {
+            float4x4 r;
+            for (int i = 0; i < 4; ++i)
+            {
+                const Float4& row = a.r[i];
+                r.r[i].x = row.x * b.r[0].x + row.y * b.r[1].x + row.z * b.r[2].x + row.w * b.r[3].x;
+                r.r[i].y = row.x * b.r[0].y + row.y * b.r[1].y + row.z * b.r[2].y + row.w * b.r[3].y;
+                r.r[i].z = row.x * b.r[0].z + row.y * b.r[1].z + row.z * b.r[2].z + row.w * b.r[3].z;
+                r.r[i].w = row.x * b.r[0].w + row.y * b.r[1].w + row.z * b.r[2].w + row.w * b.r[3].w;
+            }
+            return r;
+        }
+
+        [[nodiscard]] inline float4x4 transpose(const float4x4& m) noexcept
+        {
+            float4x4 r;
+            r.r[0] = { m.r[0].x, m.r[1].x, m.r[2].x, m.r[3].x };
+            r.r[1] = { m.r[0].y, m.r[1].y, m.r[2].y, m.r[3].y };
+            r.r[2] = { m.r[0].z, m.r[1].z, m.r[2].z, m.r[3].z };
+            r.r[3] = { m.r[0].w, m.r[1].w, m.r[2].w, m.r[3].w };
+            return r;
+        }
+
+        // 余因子展開による一般逆行列（特異な場合は determinant が 0 になる）
+        [[nodiscard]] inline float4x4 inverse(const float4x4& m, float* determinant = nullptr) noexcept
+        {
+            const float* a = &m.r[0].x;
+            float inv[16];
+            inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+            inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+            inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+            inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+            inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+            inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+            inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+            inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+            inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+            inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+            inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+            inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+            inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+            inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+            inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+            inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+            const float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+            if (determinant)
+            {
+                *determinant = det;
+            }
+            const float invDet = (det != 0.0f) ? 1.0f / det : 0.0f;
+            float4x4 r;
+            float* o = &r.r[0].x;
+            for (int i = 0; i < 16; ++i)
+            {
+                o[i] = inv[i] * invDet;
+            }
+            return r;
+        }
+
+        [[nodiscard]] inline float3 transform_point(const float3& p, const float4x4& m) noexcept
+        {
+            return {
+                p.x * m.r[0].x + p.y * m.r[1].x + p.z * m.r[2].x + m.r[3].x,
+                p.x * m.r[0].y + p.y * m.r[1].y + p.z * m.r[2].y + m.r[3].y,
+                p.x * m.r[0].z + p.y * m.r[1].z + p.z * m.r[2].z + m.r[3].z,
+            };
+        }
+
+        [[nodiscard]] inline Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) noexcept
+        {
+            // 1) 最短経路を通るよう符号を揃える
+            float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            const float sign = (cosTheta < 0.0f) ? -1.0f : 1.0f;
+            cosTheta *= sign;
+
+            // 2) ほぼ同じ向きなら sin が 0 に近づき不安定なので線形補間で代える
+            float wa = 1.0f - t;
+            float wb = t;
+            if (cosTheta < 0.9995f)
+            {
+                const float theta = std::acos(cosTheta);
+                const float invSin = 1.0f / std::sin(theta);
+                wa = std::sin((1.0f - t) * theta) * invSin;
+                wb = std::sin(t * theta) * invSin;
+            }
+            wb *= sign;
+
+            Quaternion r{ a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb };
+            const float len = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+            const float invLen = (len > 0.0f) ? 1.0f / len : 0.0f;
+            return { r.x * invLen, r.y * invLen, r.z * invLen, r.w * invLen };
+        }
+    } // namespace Scalar
+
+    // ---------------------------------------------------------------------
+    // Float4x4
+    // ---------------------------------------------------------------------
+    [[nodiscard]] constexpr float4x4 identity() noexcept
+    {
+        return float4x4{};
+    }
+
+    [[nodiscard]] inline float4x4 translation(const float3& t) noexcept
+    {
+        float4x4 m;
+        m.r[3] = { t.x, t.y, t.z, 1.0f };
+        return m;
+    }
+
+    [[nodiscard]] inline float4x4 scaling(const float3& s) noexcept
+    {
+        float4x4 m;
+        m.r[0].x = s.x;
+        m.r[1].y = s.y;
+        m.r[2].z = s.z;
+        return m;
+    }
+
+    /// @brief eye から target を向くビュー行列（左手系、up はおおよその上方向）
+    [[nodiscard]] inline float4x4 look_at(const float3& eye, const float3& target, const float3& up) noexcept
+    {
+        const float3 zAxis = normalize(target - eye);
+        const float3 xAxis = normalize(cross(up, zAxis));
+        const float3 yAxis = cross(zAxis, xAxis);
+        float4x4 m;
+        m.r[0] = { xAxis.x, yAxis.x, zAxis.x, 0.0f };
+        m.r[1] = { xAxis.y, yAxis.y, zAxis.y, 0.0f };
+        m.r[2] = { xAxis.z, yAxis.z, zAxis.z, 0.0f };
+        m.r[3] = { -dot(xAxis, eye), -dot(yAxis, eye), -dot(zAxis, eye), 1.0f };
+        return m;
+    }
+
+    /// @brief 透視投影（左手系、深度は D3D と同じ 0..1）
+    [[nodiscard]] inline float4x4 perspective(float fovY, float aspect, float nearZ, float farZ) noexcept
+    {
+        const float yScale = 1.0f / std::tan(fovY * 0.5f);
+        const float range = farZ / (farZ - nearZ);
+        float4x4 m;
+        m.r[0] = { yScale / aspect, 0.0f, 0.0f, 0.0f };
+        m.r[1] = { 0.0f, yScale, 0.0f, 0.0f };
+        m.r[2] = { 0.0f, 0.0f, range, 1.0f };
+        m.r[3] = { 0.0f, 0.0f, -nearZ * range, 0.0f };
+        return m;
+    }
+
+    /// @brief 平行投影（左手系、原点中心で幅 width・高さ height、深度は 0..1）
+    [[nodiscard]] inline float4x4 orthographic(float width, float height, float nearZ, float farZ) noexcept
+    {
+        const float range = 1.0f / (farZ - nearZ);
+        float4x4 m;
+        m.r[0] = { 2.0f / width, 0.0f, 0.0f, 0.0f };
+        m.r[1] = { 0.0f, 2.0f / height, 0.0f, 0.0f };
+        m.r[2] = { 0.0f, 0.0f, range, 0.0f };
+        m.r[3] = { 0.0f, 0.0f, -nearZ * range, 1.0f };
+        return m;
+    }
+
+#if CUE_MATH_SSE41
+    [[nodiscard]] inline float4x4 multiply(const float4x4& a, const float4x4& b) noexcept
+    {
+        // 1) 行ベクトル規約なので、a の各行を b の行の線形結合として求める
+        const __m128 b0 = Detail::load(b.r[0]);
+        const __m128 b1 = Detail::load(b.r[1]);
+        const __m128 b2 = Detail::load(b.r[2]);
+        const __m128 b3 = Detail::load(b.r[3]);
+        float4x4 r;
+        for (int i = 0; i < 4; ++i)
+        {
+            const __m128 row = Detail::load(a.r[i]);
+            __m128 v = _mm_mul_ps(Detail::splat<0>(row), b0);
+            v = Detail::madd(Detail::splat<1>(row), b1, v);
+            v = Detail::madd(Detail::splat<2>(row), b2, v);
+            v = Detail::madd(Detail::splat<3>(row), b3, v);
+            _mm_store_ps(&r.r[i].x, v);
+        }
+        return r;
+    }
+
+    [[nodiscard]] inline float4x4 transpose(const float4x4& m) noexcept
+    {
+        __m128 r0 = Detail::load(m.r[0]);
+        __m128 r1 = Detail::load(m.r[1]);
+        __m128 r2 = Detail::load(m.r[2]);
+        __m128 r3 = Detail::load(m.r[3]);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        float4x4 r;
+        _mm_store_ps(&r.r[0].x, r0);
+        _mm_store_ps(&r.r[1].x, r1);
+        _mm_store_ps(&r.r[2].x, r2);
+        _mm_store_ps(&r.r[3].x, r3);
+        return r;
+    }
+
+    namespace Detail
+    {
+        // 2x2 行列を __m128 に (m00, m01, m10, m11) で詰めた演算群（ブロック逆行列用）
+        template<int x, int y, int z, int w>
+        [[nodiscard]] inline __m128 swizzle(__m128 v) noexcept
+        {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
+        }
+        template<int x, int y, int z, int w>
+        [[nodiscard]] inline __m128 shuffle(__m128 a, __m128 b) noexcept
+        {
+            return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+        }
+        // A * B
+        [[nodiscard]] inline __m128 mat2_mul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+                _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+        }
+        // adj(A) * B
+        [[nodiscard]] inline __m128 mat2_adj_mul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+                _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+        }
+        // A * adj(B)
+        [[nodiscard]] inline __m128 mat2_mul_adj(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+                _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+        }
+    }
+
+    /// @brief 一般の 4x4 逆行列
+    /// @param determinant 行列式の出力先（特異判定に使う、不要なら nullptr）
+    [[nodiscard]] inline float4x4 inverse(const float4x4& m, float* determinant = nullptr) noexcept
+    {
+        const __m128 r0 = Detail::load(m.r[0]);
+        const __m128 r1 = Detail::load(m.r[1]);
+        const __m128 r2 = Detail::load(m.r[2]);
+        const __m128 r3 = Detail::load(m.r[3]);
+
+        // 1) 2x2 のブロック A B / C D に分ける
+        const __m128 a = _mm_movelh_ps(r0, r1);
+        const __m128 b = _mm_movehl_ps(r1, r0);
+        const __m128 c = _mm_movelh_ps(r2, r3);
+        const __m128 d = _mm_movehl_ps(r3, r2);
+
+        // 2) 各ブロックの行列式をまとめて求める
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(Detail::shuffle<0, 2, 0, 2>(r0, r2), Detail::shuffle<1, 3, 1, 3>(r1, r3)),
+            _mm_mul_ps(Detail::shuffle<1, 3, 1, 3>(r0, r2), Detail::shuffle<0, 2, 0, 2>(r1, r3)));
+        const __m128 detA = Detail::swizzle<0, 0, 0, 0>(detSub);
+        const __m128 detB = Detail::swizzle<1, 1, 1, 1>(detSub);
+        const __m128 detC = Detail::swizzle<2, 2, 2, 2>(detSub);
+        const __m128 detD = Detail::swizzle<3, 3, 3, 3>(detSub);
+
+        // 3) 余因子ブロックを組み立てる
+        const __m128 dc = Detail::mat2_adj_mul(d, c);
+        const __m128 ab = Detail::mat2_adj_mul(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Detail::mat2_mul(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Detail::mat2_mul(c, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Detail::mat2_mul_adj(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Detail::mat2_mul_adj(a, dc));
+
+        // 4) 全体の行列式
+        __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+        __m128 tr = _mm_mul_ps(ab, Detail::swizzle<0, 2, 1, 3>(dc));
+        tr = _mm_hadd_ps(tr, tr);
+        tr = _mm_hadd_ps(tr, tr);
+        detM = _mm_sub_ps(detM, tr);
+        if (determinant)
+        {
+            *determinant = _mm_cvtss_f32(detM);
+        }
+
+        // 5) 符号を付けて割り、転置しながら並べ直す
+        const __m128 zeroMask = _mm_cmpneq_ps(detM, _mm_setzero_ps());
+        const __m128 rcpDet = _mm_and_ps(_mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM), zeroMask);
+        x = _mm_mul_ps(x, rcpDet);
+        y = _mm_mul_ps(y, rcpDet);
+        z = _mm_mul_ps(z, rcpDet);
+        w = _mm_mul_ps(w, rcpDet);
+
+        float4x4 r;
+        _mm_store_ps(&r.r[0].x, Detail::shuffle<3, 1, 3, 1>(x, y));
+        _mm_store_ps(&r.r[1].x, Detail::shuffle<2, 0, 2, 0>(x, y));
+        _mm_store_ps(&r.r[2].x, Detail::shuffle<3, 1, 3, 1>(z, w));
+        _mm_store_ps(&r.r[3].x, Detail::shuffle<2, 0, 2, 0>(z, w));
+        return r;
+    }
+
+    [[nodiscard]] inline float3 transform_point(const float3& p, const float4x4& m) noexcept
+    {
+        __m128 v = Detail::madd(_mm_set1_ps(p.x), Detail::load(m.r[0]), Detail::load(m.r[3]));
+        v = Detail::madd(_mm_set1_ps(p.y), Detail::load(m.r[1]), v);
+        v = Detail::madd(_mm_set1_ps(p.z), Detail::load(m.r[2]), v);
+        const Float4 r = Detail::store4(v);
+        return { r.x, r.y, r.z };
+    }
+#else
+    [[nodiscard]] inline float4x4 multiply(const float4x4& a, const float4x4& b) noexcept { return Scalar::multiply(a, b); }
+    [[nodiscard]] inline float4x4 transpose(const float4x4& m) noexcept { return Scalar::transpose(m); }
+    [[nodiscard]] inline float4x4 inverse(const float4x4& m, float* determinant = nullptr) noexcept { return Scalar::inverse(m, determinant); }
+    [[nodiscard]] inline float3 transform_point(const float3& p, const float4x4& m) noexcept { return Scalar::transform_point(p, m); }
+#endif
+
+    [[nodiscard]] inline float4x4 operator*(const float4x4& a, const float4x4& b) noexcept
+    {
+        return multiply(a, b);
+    }
+
+    // ---------------------------------------------------------------------
+    // Quaternion
+    // ---------------------------------------------------------------------
+    [[nodiscard]] inline quaternion from_axis_angle(const float3& axis, float radians) noexcept
+    {
+        const float3 n = normalize(axis);
+        const float s = std::sin(radians * 0.5f);
+        return { n.x * s, n.y * s, n.z * s, std::cos(radians * 0.5f) };
+    }
+
+    /// @brief a の回転の後に b の回転を適用するクォータニオン
+    [[nodiscard]] inline quaternion multiply(const quaternion& a, const quaternion& b) noexcept
+    {
+        return {
+            b.w * a.x + b.x * a.w + b.y * a.z - b.z * a.y,
+            b.w * a.y - b.x * a.z + b.y * a.w + b.z * a.x,
+            b.w * a.z + b.x * a.y - b.y * a.x + b.z * a.w,
+            b.w * a.w - b.x * a.x - b.y * a.y - b.z * a.z,
+        };
+    }
+
+    [[nodiscard]] inline quaternion normalize(const quaternion& q) noexcept
+    {
+        const float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        const float inv = (len > 0.0f) ? 1.0f / len : 0.0f;
+        return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+    }
+
+#if CUE_MATH_SSE41
+    /// @brief 球面線形補間（最短経路、t は [0, 1]）
+    [[nodiscard]] inline quaternion slerp(const quaternion& a, const quaternion& b, float t) noexcept
+    {
+        const __m128 va = Detail::load(a);
+        __m128 vb = Detail::load(b);
+
+        // 1) 最短経路を通るよう符号を揃える
+        float cosTheta = _mm_cvtss_f32(_mm_dp_ps(va, vb, 0xF1));
+        const float sign = (cosTheta < 0.0f) ? -1.0f : 1.0f;
+        cosTheta *= sign;
+
+        // 2) ほぼ同じ向きなら線形補間で代える
+        float wa = 1.0f - t;
+        float wb = t;
+        if (cosTheta < 0.9995f)
+        {
+            const float theta = std::acos(cosTheta);
+            const float invSin = 1.0f / std::sin(theta);
+            wa = std::sin((1.0f - t) * theta) * invSin;
+            wb = std::sin(t * theta) * invSin;
+        }
+        vb = _mm_mul_ps(vb, _mm_set1_ps(wb * sign));
+
+        // 3) 重み付き和を正規化する
+        const __m128 r = Detail::madd(va, _mm_set1_ps(wa), vb);
+        const __m128 lenSq = _mm_dp_ps(r, r, 0xFF);
+        const __m128 mask = _mm_cmpgt_ps(lenSq, _mm_setzero_ps());
+        return Detail::store_quat(_mm_and_ps(_mm_div_ps(r, _mm_sqrt_ps(lenSq)), mask));
+    }
+#else
+    [[nodiscard]] inline quaternion slerp(const quaternion& a, const quaternion& b, float t) noexcept
+    {
+        return Scalar::slerp(a, b, t);
+    }
+#endif
+
+    /// @brief 回転行列に変換する（行ベクトル規約）
+    [[nodiscard]] inline float4x4 to_matrix(const quaternion& q) noexcept
+    {
+        const float xx = q.x * q.x;
+        const float yy = q.y * q.y;
+        const float zz = q.z * q.z;
+        const float xy = q.x * q.y;
+        const float xz = q.x * q.z;
+        const float yz = q.y * q.z;
+        const float wx = q.w * q.x;
+        const float wy = q.w * q.y;
+        const float wz = q.w * q.z;
+        float4x4 m;
+        m.r[0] = { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f };
+        m.r[1] = { 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f };
+        m.r[2] = { 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f };
+        return m;
+    }
+} // namespace Cue::Math
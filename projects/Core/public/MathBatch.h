@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Math.h"
+
+namespace Cue::Math
+{
+    /// @brief SoA 形式の点列（読み取り専用）
+    struct ConstFloat3Streams
+    {
+        const float* x = nullptr;
+        const float* y = nullptr;
+        const float* z = nullptr;
+    };
+
+    /// @brief SoA 形式の点列（書き込み先）
+    struct Float3Streams
+    {
+        float* x = nullptr;
+        float* y = nullptr;
+        float* z = nullptr;
+    };
+
+    /// @brief SoA の点列に行列を適用する（平行移動を含む）
+    /// @details 入力と出力は同じ配列でもよい。アラインメントは要求しない。
+    void transform_points(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept;
+    /// @brief SoA の方向ベクトル列に行列を適用する（平行移動を含まない）
+    void transform_vectors(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept;
+    /// @brief out[i] = in[i] * m をまとめて計算する（ローカル→ワールドの一括変換など）
+    void transform_matrices(const float4x4* in, const float4x4& m, float4x4* out, size_t count) noexcept;
+    /// @brief out[i] = a[i] * b[i] をまとめて計算する
+    void multiply_matrices(const float4x4* a, const float4x4* b, float4x4* out, size_t count) noexcept;
+
+    namespace Scalar
+    {
+        /// @brief transform_points のスカラー参照実装
+        void transform_points(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept;
+        /// @brief transform_vectors のスカラー参照実装
+        void transform_vectors(const float4x4& m, ConstFloat3Streams in, Float3Streams out, size_t count) noexcept;
+        /// @brief transform_matrices のスカラー参照実装
+        void transform_matrices(const float4x4* in, const float4x4& m, float4x4* out, size_t count) noexcept;
+        /// @brief multiply_matrices のスカラー参照実装
+        void multiply_matrices(const float4x4* a, const float4x4* b, float4x4* out, size_t count) noexcept;
+    }
+} // namespace Cue::Math
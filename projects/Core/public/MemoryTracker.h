@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include "Result.h"
+
+// Release では追跡を組み込まない（CUE_ENABLE_MEMORY_TRACKING で明示的に有効化できる）
+#if !defined(CUE_MEMORY_TRACKING_ENABLED)
+#if !defined(CUE_RELEASE) || defined(CUE_ENABLE_MEMORY_TRACKING)
+#define CUE_MEMORY_TRACKING_ENABLED 1
+#else
+#define CUE_MEMORY_TRACKING_ENABLED 0
+#endif
+#endif
+
+namespace Cue::Core
+{
+    // タグの数（Facility は Result の中で 6bit なので 64 で足りる）
+    constexpr uint32_t k_memoryTagCount = 64;
+    // どの Facility のスコープにも入っていない確保
+    constexpr Facility k_untaggedFacility = static_cast<Facility>(0);
+    // プロセスの終わりまで持ち続ける確保（プロファイラのスレッド毎のリングなど）。リークの報告からは外す
+    constexpr Facility k_processLifetimeFacility = static_cast<Facility>(k_memoryTagCount - 1);
+
+    /// @brief 1 つのタグの集計
+    struct MemoryTagStats
+    {
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t liveCount = 0;
+        uint64_t totalCount = 0;
+        // 直前のフレーム（begin_memory_frame の間）の確保回数
+        uint64_t frameCount = 0;
+        // 0 なら予算なし
+        uint64_t budgetBytes = 0;
+    };
+
+    /// @brief リーク判定の基準にする、ある時点の生存量
+    struct MemorySnapshot
+    {
+        uint64_t liveBytes[k_memoryTagCount] = {};
+        uint64_t liveCount[k_memoryTagCount] = {};
+    };
+
+    /// @brief 確保をタグ付けして数える（グローバルの operator new/delete を置き換える）
+    /// @details 呼び出したスレッドの現在のタグで確保を数え、解放時は確保時のタグから引く
+    ///          （タグはブロックの前に置いた 16 バイトのヘッダに残す）。カウンタはタグ毎の atomic だけで、
+    ///          ロックは取らない。CUE_MEMORY_TRACKING_ENABLED が 0 のビルドでは置き換えず、
+    ///          以下の関数は何もしない（集計は全て 0）。
+    [[nodiscard]] constexpr bool is_memory_tracking_enabled() noexcept
+    {
+        return CUE_MEMORY_TRACKING_ENABLED != 0;
+    }
+
+    /// @brief このスレッドの現在のタグを差し替え、元のタグを返す
+    Facility set_thread_memory_tag(Facility tag) noexcept;
+    /// @brief このスレッドの現在のタグ
+    [[nodiscard]] Facility get_thread_memory_tag() noexcept;
+
+    [[nodiscard]] MemoryTagStats get_memory_stats(Facility tag) noexcept;
+    [[nodiscard]] MemorySnapshot take_memory_snapshot() noexcept;
+
+    /// @brief 緩い予算を設定する（超えても確保は失敗させず、check_memory_budgets で警告を返す）
+    /// @param bytes 0 で予算なし
+    void set_memory_budget(Facility tag, uint64_t bytes) noexcept;
+    /// @brief 前回の呼び出し以降に予算を超えたタグがあれば、その 1 つを Warning の Result で返す
+    /// @details native には超えた時点の生存量（KiB）を入れる。同じ超過は一度しか返さない。
+    [[nodiscard]] Result check_memory_budgets() noexcept;
+
+    /// @brief フレームの区切り（フレーム毎の確保回数を締める）
+    void begin_memory_frame() noexcept;
+
+    /// @brief 基準の時点より生存量が増えたタグを書き出す（k_processLifetimeFacility は除く）
+    /// @return 増えていたタグの数（タグ無しも 1 つと数える）
+    uint32_t write_memory_report(std::FILE* file, const MemorySnapshot& baseline) noexcept;
+
+    /// @brief スコープの間だけスレッドのタグを差し替える（入れ子にでき、抜けると元に戻る）
+    class MemoryTagScope final
+    {
+    public:
+        explicit MemoryTagScope(Facility tag) noexcept
+            : m_previous(set_thread_memory_tag(tag))
+        {
+        }
+        ~MemoryTagScope()
+        {
+            set_thread_memory_tag(m_previous);
+        }
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+    private:
+        Facility m_previous;
+    };
+} // namespace Cue::Core
+
+#if CUE_MEMORY_TRACKING_ENABLED
+#define CUE_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define CUE_MEMORY_TAG_CONCAT(a, b) CUE_MEMORY_TAG_CONCAT_INNER(a, b)
+// スコープの終わりまでの確保を指定した Facility に付ける
+#define CUE_MEMORY_TAG(facility) const ::Cue::Core::MemoryTagScope CUE_MEMORY_TAG_CONCAT(cueMemoryTag, __LINE__)(facility)
+#else
+#define CUE_MEMORY_TAG(facility) static_cast<void>(0)
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace Cue::Core
+{
+    /// @brief 名前の 64bit ハッシュ（FNV-1a、0 は無効値のため 1 に寄せる）
+    [[nodiscard]] constexpr uint64_t hash_name(std::string_view text) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char c : text)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash != 0 ? hash : 1;
+    }
+
+    /// @brief 文字列をキーにする代わりに使う名前の ID（比較とハッシュは整数 1 つ）
+    /// @details 文字列リテラルからはコンパイル時にハッシュを求める（consteval なので実行時の文字列は渡せない）。
+    ///          実行時の文字列は intern で大域の表に登録し、元の文字列を get_text で引けるようにする
+    ///          （表は埋まると広げるので登録数に上限は無い）。
+    ///          リテラルから作った ID も、同じ文字列がどこかで intern されていれば文字列を引ける。
+    ///          非リリースビルドでは、異なる文字列が同じハッシュで登録されるとアサートし、衝突数を数える。
+    class NameId final
+    {
+    public:
+        constexpr NameId() noexcept = default;
+
+        template<size_t N>
+        consteval NameId(const char (&literal)[N]) noexcept
+            : m_hash(hash_name(std::string_view(literal, N - 1)))
+        {
+        }
+
+        /// @brief 表に登録せずにハッシュだけ求める
+        [[nodiscard]] static constexpr NameId from_string(std::string_view text) noexcept
+        {
+            NameId id;
+            id.m_hash = hash_name(text);
+            return id;
+        }
+
+        /// @brief 表に登録して ID を得る（複数スレッドから呼べる。ロックを取るのは表を広げる時だけ）
+        /// @details 例外は投げない。表や文字列の領域を確保できなければ登録を諦め、ID は返すが get_text は空になる
+        [[nodiscard]] static NameId intern(std::string_view text) noexcept;
+
+        /// @brief 登録された元の文字列（NUL 終端。登録されていなければ空）
+        [[nodiscard]] std::string_view get_text() const noexcept;
+
+        [[nodiscard]] constexpr uint64_t get_hash() const noexcept { return m_hash; }
+        [[nodiscard]] constexpr bool is_valid() const noexcept { return m_hash != 0; }
+
+        [[nodiscard]] constexpr bool operator==(const NameId&) const noexcept = default;
+        [[nodiscard]] constexpr auto operator<=>(const NameId&) const noexcept = default;
+    private:
+        uint64_t m_hash = 0;
+    };
+
+    struct NameTableStats
+    {
+        uint32_t entryCount = 0;
+        uint32_t capacity = 0;
+        // 表が埋まって倍の大きさへ広げた回数
+        uint32_t growCount = 0;
+        uint64_t textBytes = 0;
+        // 異なる文字列が同じハッシュになった数（非リリースビルドでのみ数える）
+        uint64_t collisionCount = 0;
+    };
+
+    [[nodiscard]] NameTableStats get_name_table_stats() noexcept;
+} // namespace Cue::Core
+
+template<>
+struct std::hash<Cue::Core::NameId>
+{
+    size_t operator()(const Cue::Core::NameId& id) const noexcept
+    {
+        return static_cast<size_t>(id.get_hash());
+    }
+};
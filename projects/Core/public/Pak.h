@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "Result.h"
+
+namespace Cue::Core
+{
+    class JobSystem;
+
+    /// @brief 正規化したパスの 64bit ハッシュ（FNV-1a）
+    /// @details 区切りは '/' に揃え、ASCII は小文字に、先頭の "./" と "/" は除いてから混ぜる。
+    ///          文字列を作らずに 1 文字ずつ変換するので確保しない。
+    [[nodiscard]] constexpr uint64_t hash_path(std::string_view path) noexcept
+    {
+        // 1) 先頭の "./" と "/" を読み飛ばす
+        size_t begin = 0;
+        for (;;)
+        {
+            if (begin + 1 < path.size() && path[begin] == '.' && (path[begin + 1] == '/' || path[begin + 1] == '\\'))
+            {
+                begin += 2;
+            }
+            else if (begin < path.size() && (path[begin] == '/' || path[begin] == '\\'))
+            {
+                begin += 1;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        // 2) 正規化しながら混ぜる
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = begin; i < path.size(); ++i)
+        {
+            char c = path[i];
+            if (c == '\\')
+            {
+                c = '/';
+            }
+            else if (c >= 'A' && c <= 'Z')
+            {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // "CPAK"
+    constexpr uint32_t k_pakMagic = 0x4B415043u;
+    constexpr uint32_t k_pakVersion = 1;
+    // 大きなエントリの先頭アライメント（マップしたまま GPU アップロードや非同期読み込みの単位に揃える）
+    constexpr uint64_t k_pakEntryAlignment = 64ull * 1024ull;
+    // 64KB 未満のエントリは詰めて置く（境界をまたがないので 1 ブロックの読み込みで済む）
+    constexpr uint64_t k_pakSmallEntryAlignment = 256;
+
+    // 内容は compress_blocks の形式（size は圧縮後の大きさ）
+    constexpr uint32_t k_pakEntryCompressed = 1u << 0;
+
+    /// @brief pak の先頭
+    struct PakHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        // ヘッダ直後に置かれる目次の位置
+        uint64_t tocOffset;
+        uint64_t fileSize;
+    };
+
+    /// @brief 目次の 1 項目（pathHash の昇順に並ぶ）
+    struct PakTocEntry
+    {
+        uint64_t pathHash;
+        uint64_t offset;
+        uint64_t size;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(PakHeader) == 32 && sizeof(PakTocEntry) == 32, "pak layout must not change silently.");
+
+    /// @brief メモリマップした pak
+    /// @details 目次を二分探索し、内容はマップした領域をそのまま返す（コピーしない）。
+    class PakArchive final
+    {
+    public:
+        PakArchive() = default;
+        ~PakArchive() = default;
+        PakArchive(const PakArchive&) = delete;
+        PakArchive& operator=(const PakArchive&) = delete;
+        PakArchive(PakArchive&&) noexcept = default;
+        PakArchive& operator=(PakArchive&&) noexcept = default;
+
+        /// @brief 開いて目次を検証する
+        [[nodiscard]] Result open(std::string_view path);
+        void close() noexcept;
+
+        /// @brief 目次の項目を引く（無ければ nullptr）
+        [[nodiscard]] const PakTocEntry* find(uint64_t pathHash) const noexcept;
+        [[nodiscard]] const PakTocEntry* find(std::string_view path) const noexcept { return find(hash_path(path)); }
+        /// @brief 項目の内容（アーカイブを閉じるまで有効。圧縮された項目は圧縮後のまま返す）
+        [[nodiscard]] std::span<const std::byte> get_data(const PakTocEntry& entry) const noexcept;
+        [[nodiscard]] static bool is_compressed(const PakTocEntry& entry) noexcept
+        {
+            return (entry.flags & k_pakEntryCompressed) != 0;
+        }
+
+        [[nodiscard]] std::span<const PakTocEntry> get_entries() const noexcept { return m_entries; }
+    private:
+        MappedFile m_file;
+        std::span<const PakTocEntry> m_entries;
+    };
+
+    struct PakWriteStats
+    {
+        uint64_t sourceBytes = 0;
+        // 目次と内容の合計（配置の隙間は含まない）
+        uint64_t storedBytes = 0;
+        uint32_t compressedCount = 0;
+    };
+
+    /// @brief pak を書き出す（ツール用）
+    class PakWriter final
+    {
+    public:
+        PakWriter();
+        ~PakWriter();
+        PakWriter(const PakWriter&) = delete;
+        PakWriter& operator=(const PakWriter&) = delete;
+
+        /// @brief ディスク上のファイルを仮想パスで登録する（内容は write の時に読む）
+        void add_file(std::string_view virtualPath, std::string_view sourcePath);
+        /// @brief メモリ上の内容を仮想パスで登録する（内容は複製して持つ）
+        void add_data(std::string_view virtualPath, std::span<const std::byte> data);
+
+        /// @brief 以降の write でブロック圧縮する（0 で圧縮しない。縮まない項目はそのまま置く）
+        /// @param jobSystem 渡せばブロックを並列に圧縮する
+        void set_compression(uint32_t blockSize, JobSystem* jobSystem = nullptr) noexcept;
+
+        /// @brief 目次を並べて書き出す（パスのハッシュが衝突していれば失敗）
+        [[nodiscard]] Result write(std::string_view outputPath);
+        [[nodiscard]] size_t get_entry_count() const noexcept;
+        /// @brief 直前の write の集計
+        [[nodiscard]] const PakWriteStats& get_stats() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief 固定サイズオブジェクト用のフリーリストアロケータ
+    /// @details ページ単位で upstream から確保し、解放されたスロットはフリーリストで再利用する。
+    ///          確保・解放は O(1) だがスレッドセーフではない（スレッド毎かシステム毎に持つこと）。
+    ///          std::pmr::memory_resource としては sizeof(T) 以下の要求だけをプールで賄い、
+    ///          それより大きい要求は upstream へ回す。
+    template<typename T>
+    class PoolAllocator final : public std::pmr::memory_resource
+    {
+    public:
+        /// @param objectsPerPage 1 ページに入るオブジェクト数
+        /// @param upstream ページの確保先（nullptr で std::pmr::get_default_resource()）
+        explicit PoolAllocator(uint32_t objectsPerPage = 256, std::pmr::memory_resource* upstream = nullptr)
+            : m_upstream(upstream ? upstream : std::pmr::get_default_resource())
+            , m_objectsPerPage(objectsPerPage != 0 ? objectsPerPage : 1)
+        {
+        }
+        ~PoolAllocator() override
+        {
+            release();
+        }
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        /// @brief 1 オブジェクト分の未初期化領域を確保する
+        [[nodiscard]] T* allocate_object()
+        {
+            // 1) フリーリストが空ならページを足す
+            if (!m_freeList)
+            {
+                add_page();
+            }
+
+            // 2) 先頭スロットを取り出す
+            Slot* slot = m_freeList;
+            m_freeList = slot->next;
+            ++m_liveCount;
+#ifdef CUE_DEBUG
+            std::memset(slot->guard, k_guardPattern, sizeof(slot->guard));
+#endif
+            return reinterpret_cast<T*>(slot->storage);
+        }
+
+        /// @brief allocate_object で確保した領域を返す
+        void deallocate_object(T* p) noexcept
+        {
+            if (!p)
+            {
+                return;
+            }
+            Slot* slot = reinterpret_cast<Slot*>(p);
+            --m_liveCount;
+#ifdef CUE_DEBUG
+            // 1) 境界を越えた書き込みを数える（check_guards で報告する）。壊れたスロットは再利用しない
+            for (unsigned char b : slot->guard)
+            {
+                if (b != k_guardPattern)
+                {
+                    ++m_corruptedCount;
+                    return;
+                }
+            }
+            std::memset(slot->storage, k_freedPattern, sizeof(slot->storage));
+#endif
+            // 2) フリーリストの先頭へ戻す
+            slot->next = m_freeList;
+            m_freeList = slot;
+        }
+
+        /// @brief 構築済みのオブジェクトを生成する
+        template<typename... Args>
+        [[nodiscard]] T* create(Args&&... args)
+        {
+            return ::new (static_cast<void*>(allocate_object())) T(std::forward<Args>(args)...);
+        }
+
+        /// @brief create で生成したオブジェクトを破棄する
+        void destroy(T* p) noexcept
+        {
+            if (!p)
+            {
+                return;
+            }
+            p->~T();
+            deallocate_object(p);
+        }
+
+        /// @brief 全ページを upstream に返す（生存中のオブジェクトは破棄されない）
+        void release() noexcept
+        {
+            for (void* page : m_pages)
+            {
+                m_upstream->deallocate(page, page_bytes(), alignof(Slot));
+            }
+            m_pages.clear();
+            m_freeList = nullptr;
+            m_liveCount = 0;
+        }
+
+        /// @brief 生存中のオブジェクト数
+        [[nodiscard]] size_t get_live_count() const noexcept { return m_liveCount; }
+        /// @brief 確保済みのページ数
+        [[nodiscard]] size_t get_page_count() const noexcept { return m_pages.size(); }
+        /// @brief 解放時にガードの破壊が見つかっていないか調べる
+        /// @details ガードは CUE_DEBUG のときだけ置く。見つかった場合は以降の内容を信用できないので Fatal を返す
+        [[nodiscard]] Result check_guards() const noexcept
+        {
+            if (m_corruptedCount != 0)
+            {
+                return Result::fail(
+                    Facility::Core,
+                    Code::InvalidState,
+                    Severity::Fatal,
+                    m_corruptedCount, "PoolAllocator guard bytes overwritten.");
+            }
+            return Result::ok();
+        }
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (bytes <= sizeof(T) && alignment <= alignof(T))
+            {
+                return allocate_object();
+            }
+            return m_upstream->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            if (bytes <= sizeof(T) && alignment <= alignof(T))
+            {
+                deallocate_object(static_cast<T*>(p));
+                return;
+            }
+            m_upstream->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    private:
+        static constexpr unsigned char k_guardPattern = 0xFD;
+        static constexpr unsigned char k_freedPattern = 0xDD;
+
+        // 空きスロットは次へのリンクとして、使用中は T の格納領域として使う
+        union Slot
+        {
+            Slot* next;
+            struct
+            {
+                alignas(T) unsigned char storage[sizeof(T)];
+#ifdef CUE_DEBUG
+                unsigned char guard[alignof(T) < 8 ? 8 : alignof(T)];
+#endif
+            };
+        };
+
+        size_t page_bytes() const noexcept
+        {
+            return sizeof(Slot) * m_objectsPerPage;
+        }
+
+        void add_page()
+        {
+            // 1) ページを確保して、先頭から順に払い出されるようにリンクする
+            Slot* page = static_cast<Slot*>(m_upstream->allocate(page_bytes(), alignof(Slot)));
+            m_pages.push_back(page);
+            for (uint32_t i = 0; i < m_objectsPerPage; ++i)
+            {
+                page[i].next = (i + 1 < m_objectsPerPage) ? &page[i + 1] : m_freeList;
+            }
+            m_freeList = page;
+        }
+
+        std::pmr::memory_resource* m_upstream = nullptr;
+        std::vector<void*> m_pages;
+        Slot* m_freeList = nullptr;
+        size_t m_liveCount = 0;
+        uint32_t m_objectsPerPage = 0;
+        uint32_t m_corruptedCount = 0;
+    };
+} // namespace Cue::Core
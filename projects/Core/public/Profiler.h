@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Result.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CUE_PROFILE_HAS_TSC 1
+#elif (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CUE_PROFILE_HAS_TSC 1
+#else
+#define CUE_PROFILE_HAS_TSC 0
+#endif
+
+// Release では計測コードを残さない（CUE_ENABLE_PROFILER で明示的に有効化できる）
+#if !defined(CUE_PROFILE_ENABLED)
+#if !defined(CUE_RELEASE) || defined(CUE_ENABLE_PROFILER)
+#define CUE_PROFILE_ENABLED 1
+#else
+#define CUE_PROFILE_ENABLED 0
+#endif
+#endif
+
+namespace Cue::Core
+{
+    /// @brief スコープ単位で CPU 時間を記録するプロファイラ
+    /// @details 各スレッドは自分専用のリングバッファにゾーン（名前・開始・終了の TSC）を書き込む。
+    ///          リングは古いものから上書きされるので、常に直近の区間だけが残る。
+    ///          スレッドが終わってもリングは次のスレッドが使い回すまで残り、その間は書き出せる。
+    ///          名前は静的な寿命を持つ文字列でなければならない（ポインタのみ保持する）。
+    class Profiler final
+    {
+    public:
+        // スレッド毎に保持するゾーン数（2 の冪）
+        static constexpr uint32_t k_zonesPerThread = 1u << 16;
+        // 保持するフレームマーカー数（2 の冪）
+        static constexpr uint32_t k_maxFrames = 1024;
+        // 同時に登録できるスレッド数の上限（終わったスレッドのリングは次のスレッドが使い回す）
+        static constexpr uint32_t k_maxThreads = 256;
+
+        Profiler() = delete;
+
+        /// @brief 現在のタイムスタンプ（x86 では TSC、それ以外はナノ秒）
+        [[nodiscard]] static uint64_t now() noexcept
+        {
+#if CUE_PROFILE_HAS_TSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /// @brief 呼び出しスレッドのリングにゾーンを書き込む
+        static void record_zone(const char* name, uint64_t begin, uint64_t end) noexcept;
+        /// @brief フレームの開始を記録する
+        static void mark_frame() noexcept;
+        /// @brief 呼び出しスレッドの表示名を設定する（静的文字列）
+        static void set_thread_name(const char* name) noexcept;
+        /// @brief 記録を止める・再開する（停止中の record_zone は何もしない）
+        static void set_enabled(bool isEnabled) noexcept;
+
+        /// @brief 直近 frameCount フレーム分を Chrome trace event 形式の JSON で書き出す
+        /// @details Perfetto（ui.perfetto.dev）や chrome://tracing で開ける。
+        [[nodiscard]] static Result export_chrome_trace(const char* path, uint32_t frameCount);
+    };
+
+    /// @brief 生成から破棄までをゾーンとして記録する
+    class ProfileScope final
+    {
+    public:
+        explicit ProfileScope(const char* name) noexcept
+            : m_name(name)
+            , m_begin(Profiler::now())
+        {
+        }
+        ~ProfileScope()
+        {
+            Profiler::record_zone(m_name, m_begin, Profiler::now());
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    private:
+        const char* m_name;
+        uint64_t m_begin;
+    };
+} // namespace Cue::Core
+
+#if CUE_PROFILE_ENABLED
+#define CUE_PROFILE_CONCAT_INNER(a, b) a##b
+#define CUE_PROFILE_CONCAT(a, b) CUE_PROFILE_CONCAT_INNER(a, b)
+// スコープの終わりまでをゾーンとして記録する
+#define CUE_PROFILE_SCOPE(name) const ::Cue::Core::ProfileScope CUE_PROFILE_CONCAT(cueProfileScope, __LINE__)(name)
+// フレームの開始を記録する
+#define CUE_PROFILE_FRAME() ::Cue::Core::Profiler::mark_frame()
+#else
+#define CUE_PROFILE_SCOPE(name) static_cast<void>(0)
+#define CUE_PROFILE_FRAME() static_cast<void>(0)
+#endif
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cassert>
 #include <cstdint>
+#include <new>
 #include <string_view>
 #include <source_location>
+#include <type_traits>
+#include <utility>
 
 namespace Cue::Core
 {
@@ -27,6 +31,8 @@ namespace Cue::Core
         Unsupported,
         CreationFailed,
         GettingInfoFailed,
+        // 要求が完了前に取り消された
+        Cancelled,
         Unknown,
     };
 
@@ -38,24 +44,41 @@ namespace Cue::Core
         Fatal = 3,
     };
 
-    struct Result final
+    /// @brief 失敗時だけ記録する診断情報（メッセージと発生箇所）
+    struct ResultDiagnostic
     {
-        Facility facility = Facility::Core;
-        Code code = Code::Ok;
-        Severity severity = Severity::Info;
-
-        // OS/SDKの生コード：GetLastError や HRESULT をそのまま入れる用途
-        uint32_t native = 0;
-
         // 動的確保を避けるため、基本は静的文字列だけ（必要ならログ側で整形）
         std::string_view message{};
-
-        // 任意：発生箇所（ログで使う）
         const char* file = "";
         const char* function = "";
         uint32_t line = 0;
+    };
+
+    namespace Detail
+    {
+        // Result のビット配置: [0, 32) native, [32, 40) code, [40, 46) facility, [46, 48) severity, [48, 64) 診断票
+        constexpr uint32_t k_resultCodeShift = 32;
+        constexpr uint32_t k_resultFacilityShift = 40;
+        constexpr uint32_t k_resultSeverityShift = 46;
+        constexpr uint32_t k_resultTicketShift = 48;
+
+        /// @brief 呼び出したスレッドの診断表に記録し、引くための票を返す（失敗の経路でだけ呼ぶ）
+        [[nodiscard]] uint16_t record_diagnostic(uint64_t bits, std::string_view message,
+            const std::source_location& location) noexcept;
+        /// @brief 票から診断情報を引く（古くて上書きされていれば空）
+        [[nodiscard]] ResultDiagnostic find_diagnostic(uint64_t bits) noexcept;
+    } // namespace Detail
 
-        static Result ok() noexcept
+    /// @brief 失敗し得る関数の戻り値（64bit 1 つに収まり、成功時はレジスタで返る）
+    /// @details 機能・コード・重大度・OS/SDK の生コードを詰め、メッセージと発生箇所は失敗時にだけ
+    ///          スレッド毎の診断表（直近 1024 件の環状バッファ）へ記録して、その票だけを持つ。
+    ///          診断情報は他のスレッドからも引けるが、記録したスレッドがその後 1024 回失敗すると引けなくなる。
+    class Result final
+    {
+    public:
+        constexpr Result() noexcept = default;
+
+        static constexpr Result ok() noexcept
         {
             // 1) 成功のデフォルト値を返す
             return {};
@@ -66,26 +89,173 @@ namespace Cue::Core
             std::string_view msg,
             const std::source_location& loc = std::source_location::current()) noexcept
         {
-            // 1) 結果を組み立てる（動的確保はしない）
-            Result r{};
-            r.facility = f;
-            r.code = c;
-            r.severity = s;
-            r.native = nativeCode;
-            r.message = msg;
-
-            // 2) 呼び出し位置を保存
-            r.file = loc.file_name();
-            r.function = loc.function_name();
-            r.line = static_cast<uint32_t>(loc.line());
+            // 1) 値を詰める（動的確保はしない）
+            Result r;
+            r.m_bits = static_cast<uint64_t>(nativeCode)
+                | (static_cast<uint64_t>(c) & 0xFF) << Detail::k_resultCodeShift
+                | (static_cast<uint64_t>(f) & 0x3F) << Detail::k_resultFacilityShift
+                | (static_cast<uint64_t>(s) & 0x3) << Detail::k_resultSeverityShift;
 
+            // 2) メッセージと呼び出し位置は診断表へ
+            r.m_bits |= static_cast<uint64_t>(Detail::record_diagnostic(r.m_bits, msg, loc)) << Detail::k_resultTicketShift;
             return r;
         }
 
-        explicit operator bool() const noexcept
+        [[nodiscard]] constexpr Facility get_facility() const noexcept
+        {
+            return static_cast<Facility>((m_bits >> Detail::k_resultFacilityShift) & 0x3F);
+        }
+        [[nodiscard]] constexpr Code get_code() const noexcept
+        {
+            return static_cast<Code>((m_bits >> Detail::k_resultCodeShift) & 0xFF);
+        }
+        [[nodiscard]] constexpr Severity get_severity() const noexcept
+        {
+            return static_cast<Severity>((m_bits >> Detail::k_resultSeverityShift) & 0x3);
+        }
+        // OS/SDKの生コード：GetLastError や HRESULT をそのまま入れる用途
+        [[nodiscard]] constexpr uint32_t get_native() const noexcept
+        {
+            return static_cast<uint32_t>(m_bits);
+        }
+        /// @brief メッセージと発生箇所（成功時や、診断表から消えていれば空）
+        [[nodiscard]] ResultDiagnostic get_diagnostic() const noexcept
+        {
+            return (m_bits >> Detail::k_resultTicketShift) != 0 ? Detail::find_diagnostic(m_bits) : ResultDiagnostic{};
+        }
+
+        explicit constexpr operator bool() const noexcept
         {
             // 1) 成功判定
-            return code == Code::Ok;
+            return get_code() == Code::Ok;
+        }
+    private:
+        uint64_t m_bits = 0;
+    };
+
+    static_assert(sizeof(Result) == 8 && std::is_trivially_copyable_v<Result>, "Result must fit in a register.");
+
+    /// @brief 値か失敗の Result のどちらかを持つ戻り値
+    /// @details T が自明にコピー・破棄できる型なら Expected<T> もそうなる（小さな T ならレジスタで返る）。
+    template<typename T>
+    class Expected final
+    {
+    public:
+        Expected(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+            : m_value(value)
+        {
         }
+        Expected(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_value(std::move(value))
+        {
+        }
+        /// @brief 失敗から作る（成功の Result は渡さないこと）
+        Expected(Result error) noexcept
+            : m_result(error)
+            , m_empty()
+        {
+            assert(!error && "Expected requires a failed Result or a value");
+        }
+
+        Expected(const Expected&) requires std::is_trivially_copy_constructible_v<T> = default;
+        Expected(const Expected& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+            : m_result(other.m_result)
+            , m_empty()
+        {
+            if (other.m_result)
+            {
+                ::new (static_cast<void*>(&m_value)) T(other.m_value);
+            }
+        }
+        Expected(Expected&&) requires std::is_trivially_move_constructible_v<T> = default;
+        Expected(Expected&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_result(other.m_result)
+            , m_empty()
+        {
+            if (other.m_result)
+            {
+                ::new (static_cast<void*>(&m_value)) T(std::move(other.m_value));
+            }
+        }
+        Expected& operator=(const Expected&) requires std::is_trivially_copy_assignable_v<T> && std::is_trivially_destructible_v<T> = default;
+        Expected& operator=(const Expected& other)
+        {
+            if (this != &other)
+            {
+                reset();
+                m_result = other.m_result;
+                if (other.m_result)
+                {
+                    ::new (static_cast<void*>(&m_value)) T(other.m_value);
+                }
+            }
+            return *this;
+        }
+        Expected& operator=(Expected&&) requires std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T> = default;
+        Expected& operator=(Expected&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                reset();
+                m_result = other.m_result;
+                if (other.m_result)
+                {
+                    ::new (static_cast<void*>(&m_value)) T(std::move(other.m_value));
+                }
+            }
+            return *this;
+        }
+        ~Expected() requires std::is_trivially_destructible_v<T> = default;
+        ~Expected()
+        {
+            reset();
+        }
+
+        [[nodiscard]] bool has_value() const noexcept { return static_cast<bool>(m_result); }
+        explicit operator bool() const noexcept { return has_value(); }
+        /// @brief 成功なら Result::ok()、失敗ならその Result
+        [[nodiscard]] Result get_result() const noexcept { return m_result; }
+
+        [[nodiscard]] T& value() & noexcept
+        {
+            assert(has_value());
+            return m_value;
+        }
+        [[nodiscard]] const T& value() const& noexcept
+        {
+            assert(has_value());
+            return m_value;
+        }
+        [[nodiscard]] T&& value() && noexcept
+        {
+            assert(has_value());
+            return std::move(m_value);
+        }
+        [[nodiscard]] T value_or(T fallback) const
+        {
+            return has_value() ? m_value : fallback;
+        }
+        [[nodiscard]] T* operator->() noexcept { return &value(); }
+        [[nodiscard]] const T* operator->() const noexcept { return &value(); }
+        [[nodiscard]] T& operator*() & noexcept { return value(); }
+        [[nodiscard]] const T& operator*() const& noexcept { return value(); }
+    private:
+        void reset() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                if (m_result)
+                {
+                    m_value.~T();
+                }
+            }
+        }
+
+        Result m_result{};
+        union
+        {
+            char m_empty;
+            T m_value;
+        };
     };
 } // namespace Cue::Core
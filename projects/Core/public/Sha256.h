@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Cue::Core
+{
+    /// @brief SHA-256 の値
+    struct Sha256Digest
+    {
+        std::array<uint8_t, 32> bytes{};
+
+        [[nodiscard]] bool operator==(const Sha256Digest&) const noexcept = default;
+        /// @brief 表引き用に先頭 8 バイトを取り出す（暗号学的ハッシュなので偏らない）
+        [[nodiscard]] uint64_t get_prefix() const noexcept
+        {
+            uint64_t v = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                v |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+            }
+            return v;
+        }
+    };
+
+    /// @brief 逐次的に SHA-256 を計算する（キャッシュの鍵など、衝突を許せない用途向け）
+    class Sha256 final
+    {
+    public:
+        Sha256() noexcept;
+
+        void update(std::span<const std::byte> data) noexcept;
+        void update(std::string_view text) noexcept
+        {
+            update(std::as_bytes(std::span<const char>(text.data(), text.size())));
+        }
+        /// @brief 長さを前置して混ぜる（複数の可変長の値を連結しても境界が曖昧にならない）
+        void update_field(std::string_view text) noexcept;
+        [[nodiscard]] Sha256Digest finalize() noexcept;
+    private:
+        void process_block(const uint8_t* block) noexcept;
+
+        uint32_t m_state[8];
+        uint8_t m_buffer[64];
+        uint64_t m_length = 0;
+        size_t m_bufferSize = 0;
+    };
+
+    [[nodiscard]] Sha256Digest sha256(std::span<const std::byte> data) noexcept;
+} // namespace Cue::Core
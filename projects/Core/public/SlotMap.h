@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace Cue::Core
+{
+    /// @brief SlotMap の要素を指すハンドル
+    /// @details 要素を消すとスロットの世代が進むので、古いハンドルは別の要素を指さずに無効になる。
+    struct SlotHandle
+    {
+        static constexpr uint32_t k_invalidIndex = 0xFFFFFFFFu;
+
+        uint32_t index = k_invalidIndex;
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != k_invalidIndex; }
+        bool operator==(const SlotHandle&) const = default;
+    };
+
+    /// @brief 世代付きハンドルで引ける、要素を詰めて持つ配列
+    /// @details 要素は常に先頭から隙間なく並ぶので、begin/end の走査は配列と同じ速さになる。
+    ///          消す時は末尾の要素を穴に移す（要素のアドレスと並び順は変わるが、ハンドルは変わらない）。
+    ///          スロットの世代は奇数が使用中、偶数が空きで、既定のハンドル（世代 0）はどの要素も指さない。
+    template<typename T>
+    class SlotMap final
+    {
+    public:
+        using iterator = typename std::pmr::vector<T>::iterator;
+        using const_iterator = typename std::pmr::vector<T>::const_iterator;
+
+        /// @param upstream 要素とスロット表の確保先（nullptr で std::pmr::get_default_resource()）
+        explicit SlotMap(std::pmr::memory_resource* upstream = nullptr)
+            : m_values(upstream ? upstream : std::pmr::get_default_resource())
+            , m_denseToSlot(m_values.get_allocator())
+            , m_slots(m_values.get_allocator())
+        {
+        }
+
+        template<typename... Args>
+        SlotHandle emplace(Args&&... args)
+        {
+            // 1) 空きスロットがあれば使い回し、無ければ末尾に足す
+            uint32_t slotIndex = m_freeHead;
+            if (slotIndex == SlotHandle::k_invalidIndex)
+            {
+                slotIndex = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back({});
+            }
+            else
+            {
+                m_freeHead = m_slots[slotIndex].denseOrNextFree;
+            }
+
+            // 2) 要素は末尾に置き、スロットと相互に指し合う
+            Slot& slot = m_slots[slotIndex];
+            slot.denseOrNextFree = static_cast<uint32_t>(m_values.size());
+            ++slot.generation;
+            m_values.emplace_back(std::forward<Args>(args)...);
+            m_denseToSlot.push_back(slotIndex);
+            return { slotIndex, slot.generation };
+        }
+        SlotHandle insert(const T& value) { return emplace(value); }
+        SlotHandle insert(T&& value) { return emplace(std::move(value)); }
+
+        /// @return 取り除いたら true（無効なハンドルなら false）
+        bool erase(SlotHandle handle)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+            // 1) 末尾の要素を穴に移し、その要素のスロットを付け替える
+            Slot& slot = m_slots[handle.index];
+            const uint32_t dense = slot.denseOrNextFree;
+            const uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+            if (dense != last)
+            {
+                m_values[dense] = std::move(m_values[last]);
+                m_denseToSlot[dense] = m_denseToSlot[last];
+                m_slots[m_denseToSlot[dense]].denseOrNextFree = dense;
+            }
+            m_values.pop_back();
+            m_denseToSlot.pop_back();
+
+            // 2) 世代を進めて古いハンドルを無効にし、空きリストに繋ぐ
+            ++slot.generation;
+            slot.denseOrNextFree = m_freeHead;
+            m_freeHead = handle.index;
+            return true;
+        }
+
+        /// @return 要素へのポインタ（無効なハンドルなら nullptr）
+        [[nodiscard]] T* get(SlotHandle handle) noexcept
+        {
+            return contains(handle) ? &m_values[m_slots[handle.index].denseOrNextFree] : nullptr;
+        }
+        [[nodiscard]] const T* get(SlotHandle handle) const noexcept
+        {
+            return contains(handle) ? &m_values[m_slots[handle.index].denseOrNextFree] : nullptr;
+        }
+        [[nodiscard]] bool contains(SlotHandle handle) const noexcept
+        {
+            return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+                && (handle.generation & 1) != 0;
+        }
+
+        /// @brief 詰めた並びの index 番目の要素を指すハンドル（走査しながら消す時に使う）
+        [[nodiscard]] SlotHandle get_handle(size_t denseIndex) const noexcept
+        {
+            assert(denseIndex < m_values.size() && "SlotMap::get_handle index out of range.");
+            const uint32_t slotIndex = m_denseToSlot[denseIndex];
+            return { slotIndex, m_slots[slotIndex].generation };
+        }
+
+        /// @brief 全要素を破棄する（世代は進めるので、それまでのハンドルは全て無効になる）
+        void clear()
+        {
+            for (const uint32_t slotIndex : m_denseToSlot)
+            {
+                Slot& slot = m_slots[slotIndex];
+                ++slot.generation;
+                slot.denseOrNextFree = m_freeHead;
+                m_freeHead = slotIndex;
+            }
+            m_values.clear();
+            m_denseToSlot.clear();
+        }
+        void reserve(size_t count)
+        {
+            m_values.reserve(count);
+            m_denseToSlot.reserve(count);
+            m_slots.reserve(count);
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return m_values.begin(); }
+        [[nodiscard]] iterator end() noexcept { return m_values.end(); }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_values.begin(); }
+        [[nodiscard]] const_iterator end() const noexcept { return m_values.end(); }
+        [[nodiscard]] T* data() noexcept { return m_values.data(); }
+        [[nodiscard]] const T* data() const noexcept { return m_values.data(); }
+
+        [[nodiscard]] size_t size() const noexcept { return m_values.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_values.empty(); }
+    private:
+        struct Slot
+        {
+            // 使用中なら m_values の位置、空きなら次の空きスロット
+            uint32_t denseOrNextFree = SlotHandle::k_invalidIndex;
+            uint32_t generation = 0;
+        };
+
+        std::pmr::vector<T> m_values;
+        std::pmr::vector<uint32_t> m_denseToSlot;
+        std::pmr::vector<Slot> m_slots;
+        uint32_t m_freeHead = SlotHandle::k_invalidIndex;
+    };
+} // namespace Cue::Core
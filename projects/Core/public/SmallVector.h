@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cue::Core
+{
+    /// @brief N 要素までをオブジェクト内に持つ可変長配列
+    /// @details 要素数が N 以下の間はヒープを使わない（一時的な小さなリストや、要素の中に入れ子にする配列向け）。
+    ///          N を超えると upstream から 2 倍ずつ確保し直し、以降は縮めない。
+    ///          ムーブはヒープ上にあれば領域ごと引き取るが、インラインの間は要素を 1 つずつムーブする。
+    template<typename T, size_t N>
+    class SmallVector final
+    {
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        /// @param upstream N を超えた時の確保先（nullptr で std::pmr::get_default_resource()）
+        explicit SmallVector(std::pmr::memory_resource* upstream = nullptr) noexcept
+            : m_upstream(upstream ? upstream : std::pmr::get_default_resource())
+        {
+        }
+        SmallVector(std::initializer_list<T> values, std::pmr::memory_resource* upstream = nullptr)
+            : SmallVector(upstream)
+        {
+            reserve(values.size());
+            for (const T& value : values)
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T(value);
+                ++m_size;
+            }
+        }
+        SmallVector(const SmallVector& other)
+            : SmallVector(other.m_upstream)
+        {
+            copy_from(other);
+        }
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : SmallVector(other.m_upstream)
+        {
+            take_from(other);
+        }
+        ~SmallVector()
+        {
+            clear();
+            release_heap();
+        }
+
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_from(other);
+            }
+            return *this;
+        }
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                clear();
+                take_from(other);
+            }
+            return *this;
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_size == m_capacity)
+            {
+                // 引数が自身の要素を指していても壊さないよう、新しい領域に先に構築してから移す
+                const size_t newCapacity = std::max<size_t>(m_capacity * 2, 4);
+                T* newData = allocate(newCapacity);
+                ::new (static_cast<void*>(newData + m_size)) T(std::forward<Args>(args)...);
+                relocate(newData, newCapacity);
+            }
+            else
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+            }
+            return m_data[m_size++];
+        }
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            assert(m_size != 0 && "SmallVector::pop_back on an empty vector.");
+            m_data[--m_size].~T();
+        }
+
+        /// @brief 要素を取り除き、後ろを詰める（順序を保つ）
+        iterator erase(const_iterator position)
+        {
+            T* p = m_data + (position - m_data);
+            std::move(p + 1, m_data + m_size, p);
+            pop_back();
+            return p;
+        }
+        /// @brief 末尾の要素で穴を埋めて取り除く（順序を保たない代わりに O(1)）
+        void swap_erase(size_t index)
+        {
+            assert(index < m_size && "SmallVector::swap_erase index out of range.");
+            if (index + 1 != m_size)
+            {
+                m_data[index] = std::move(m_data[m_size - 1]);
+            }
+            pop_back();
+        }
+
+        void clear() noexcept
+        {
+            std::destroy(m_data, m_data + m_size);
+            m_size = 0;
+        }
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > m_capacity)
+            {
+                relocate(allocate(capacity), capacity);
+            }
+        }
+        void resize(size_t size)
+        {
+            reserve(size);
+            while (m_size < size)
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T();
+                ++m_size;
+            }
+            while (m_size > size)
+            {
+                pop_back();
+            }
+        }
+        void resize(size_t size, const T& value)
+        {
+            reserve(size);
+            while (m_size < size)
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T(value);
+                ++m_size;
+            }
+            while (m_size > size)
+            {
+                pop_back();
+            }
+        }
+
+        [[nodiscard]] T& operator[](size_t index) noexcept
+        {
+            assert(index < m_size && "SmallVector index out of range.");
+            return m_data[index];
+        }
+        [[nodiscard]] const T& operator[](size_t index) const noexcept
+        {
+            assert(index < m_size && "SmallVector index out of range.");
+            return m_data[index];
+        }
+        [[nodiscard]] T& front() noexcept { return (*this)[0]; }
+        [[nodiscard]] const T& front() const noexcept { return (*this)[0]; }
+        [[nodiscard]] T& back() noexcept { return (*this)[m_size - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return (*this)[m_size - 1]; }
+
+        [[nodiscard]] T* data() noexcept { return m_data; }
+        [[nodiscard]] const T* data() const noexcept { return m_data; }
+        [[nodiscard]] iterator begin() noexcept { return m_data; }
+        [[nodiscard]] iterator end() noexcept { return m_data + m_size; }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+        [[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+
+        [[nodiscard]] size_t size() const noexcept { return m_size; }
+        [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+        /// @brief 要素がオブジェクト内の領域にあるか
+        [[nodiscard]] bool is_inline() const noexcept { return m_data == get_inline_data(); }
+    private:
+        T* get_inline_data() noexcept { return reinterpret_cast<T*>(m_inline); }
+        const T* get_inline_data() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+        T* allocate(size_t capacity)
+        {
+            return static_cast<T*>(m_upstream->allocate(capacity * sizeof(T), alignof(T)));
+        }
+
+        void release_heap() noexcept
+        {
+            if (!is_inline())
+            {
+                m_upstream->deallocate(m_data, m_capacity * sizeof(T), alignof(T));
+            }
+            m_data = get_inline_data();
+            m_capacity = N;
+        }
+
+        /// @brief 既存の要素を新しい領域へムーブし、古い領域を返す
+        void relocate(T* newData, size_t newCapacity)
+        {
+            std::uninitialized_move(m_data, m_data + m_size, newData);
+            std::destroy(m_data, m_data + m_size);
+            release_heap();
+            m_data = newData;
+            m_capacity = newCapacity;
+        }
+
+        void copy_from(const SmallVector& other)
+        {
+            reserve(other.m_size);
+            std::uninitialized_copy(other.m_data, other.m_data + other.m_size, m_data);
+            m_size = other.m_size;
+        }
+
+        void take_from(SmallVector& other)
+        {
+            // 1) 相手がヒープにあり確保先も同じなら、領域ごと引き取る
+            if (!other.is_inline() && other.m_upstream->is_equal(*m_upstream))
+            {
+                release_heap();
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.get_inline_data();
+                other.m_size = 0;
+                other.m_capacity = N;
+                return;
+            }
+
+            // 2) それ以外は要素を 1 つずつムーブする
+            reserve(other.m_size);
+            std::uninitialized_move(other.m_data, other.m_data + other.m_size, m_data);
+            m_size = other.m_size;
+            other.clear();
+        }
+
+        std::pmr::memory_resource* m_upstream = nullptr;
+        T* m_data = get_inline_data();
+        size_t m_size = 0;
+        size_t m_capacity = N;
+        alignas(T) unsigned char m_inline[sizeof(T) * (N != 0 ? N : 1)];
+    };
+} // namespace Cue::Core
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Result.h"
+
+namespace Cue::Core
+{
+    /// @brief UTF-8 を UTF-16 にする時に必要な最大の長さ（UTF-16 の単位数）
+    [[nodiscard]] constexpr size_t get_utf16_capacity(size_t utf8Length) noexcept
+    {
+        return utf8Length;
+    }
+
+    /// @brief UTF-16 を UTF-8 にする時に必要な最大の長さ（バイト数）
+    [[nodiscard]] constexpr size_t get_utf8_capacity(size_t utf16Length) noexcept
+    {
+        return utf16Length * 3;
+    }
+
+    /// @brief UTF-8 を 1 回の走査で UTF-16 に変換する
+    /// @details ASCII の連続と 3 バイト文字（かな・漢字）の連続は SIMD でまとめて処理する。
+    ///          途切れた並び・冗長な表現・サロゲート・範囲外の値は不正な入力として失敗する。
+    ///          dst が足りなくても失敗し、いずれの場合も outWritten にはそこまでに書いた長さを返す。
+    ///          dst を get_utf16_capacity の長さで用意すれば足りなくなることはない。
+    [[nodiscard]] Result utf8_to_utf16(std::string_view src, std::span<char16_t> dst, size_t& outWritten) noexcept;
+
+    /// @brief UTF-16 を 1 回の走査で UTF-8 に変換する（対になっていないサロゲートは不正な入力）
+    [[nodiscard]] Result utf16_to_utf8(std::u16string_view src, std::span<char> dst, size_t& outWritten) noexcept;
+
+    /// @brief pmr 文字列に変換する（FrameArena を渡せばフレーム内の一時文字列にできる。失敗時は空）
+    [[nodiscard]] Result utf8_to_utf16(std::string_view src, std::pmr::u16string& out);
+    [[nodiscard]] Result utf16_to_utf8(std::u16string_view src, std::pmr::string& out);
+} // namespace Cue::Core
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "Pak.h"
+#include "Result.h"
+
+namespace Cue::Core
+{
+    class JobSystem;
+
+    /// @brief VFS から開いたファイルの内容
+    /// @details pak の中身ならアーカイブのマップ領域を、ばらのファイルならそのファイルのマップ領域を指す。
+    ///          圧縮された pak の項目だけは、開いた時に展開した自前の領域を指す。
+    class VfsFile final
+    {
+    public:
+        VfsFile() = default;
+        VfsFile(VfsFile&&) noexcept = default;
+        VfsFile& operator=(VfsFile&&) noexcept = default;
+
+        [[nodiscard]] std::span<const std::byte> get_data() const noexcept { return m_data; }
+        void close() noexcept
+        {
+            m_data = {};
+            m_mapping.close();
+            m_buffer.reset();
+        }
+    private:
+        friend class VirtualFileSystem;
+
+        MappedFile m_mapping;
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::span<const std::byte> m_data;
+    };
+
+    /// @brief ディレクトリと pak を重ねてマウントする仮想ファイルシステム
+    /// @details 後からマウントしたものが優先される。マウントは起動時に済ませ、open は複数スレッドから呼べる。
+    ///          pak は 64bit のパスハッシュで引くため、検索で文字列を作らない。
+    class VirtualFileSystem final
+    {
+    public:
+        // ディレクトリのマウントで組み立てるパスの上限
+        static constexpr size_t k_maxPath = 1024;
+
+        VirtualFileSystem();
+        ~VirtualFileSystem();
+        VirtualFileSystem(const VirtualFileSystem&) = delete;
+        VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+        /// @brief 圧縮された項目の展開に使うジョブシステム（設定しなければ open を呼んだスレッドだけで展開する）
+        void set_job_system(JobSystem* jobSystem) noexcept;
+
+        [[nodiscard]] Result mount_directory(std::string_view root);
+        [[nodiscard]] Result mount_pak(std::string_view pakPath);
+        void unmount_all() noexcept;
+
+        /// @brief 仮想パスのファイルを開く（".." を含むパスは受け付けない）
+        [[nodiscard]] Result open(std::string_view path, VfsFile& outFile) const;
+        [[nodiscard]] bool exists(std::string_view path) const;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Core
@@ -5,6 +5,7 @@
 #include <Windows.h>
 #include <win_platform.h>
 #endif
+#include <FramePacer.h>
 
 // Graphics
 #include <d3d12_backend.h>
@@ -23,11 +24,26 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
     Cue::Engine engine;
     Cue::EngineInitInfo initInfo;
     initInfo.platform = platform.get();
-    engine.initialize(initInfo);
+    if (!engine.initialize(initInfo))
+    {
+        return -1;
+    }
+
+    // 空回りで CPU を使い切らないよう、フレームの開始間隔を揃える
+    Cue::Platform::FramePacer pacer;
+    if (!pacer.initialize(Cue::Platform::FramePacerDesc{}))
+    {
+        engine.shutdown();
+        return -1;
+    }
     while (isRunning)
     {
         isRunning = platform->poll_message();
-        engine.tick();
+        if (!engine.tick())
+        {
+            isRunning = false;
+        }
+        pacer.wait_for_next_frame();
     }
 
     engine.shutdown();
@@ -0,0 +1,171 @@
+#include "Archetype.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+namespace Cue::Ecs
+{
+    namespace
+    {
+        // 列の先頭は SIMD でそのまま読めるよう 16 バイトに揃える
+        constexpr uint32_t k_columnAlignment = 16;
+
+        struct ComponentRegistry
+        {
+            std::mutex mutex;
+            ComponentInfo infos[k_maxComponents];
+            uint32_t count = 0;
+        };
+
+        ComponentRegistry& registry() noexcept
+        {
+            static ComponentRegistry s_registry;
+            return s_registry;
+        }
+
+        constexpr uint32_t align_up(uint32_t value, uint32_t alignment) noexcept
+        {
+            return (value + alignment - 1u) & ~(alignment - 1u);
+        }
+    } // namespace
+
+    namespace Detail
+    {
+        ComponentId register_component(uint32_t size, uint32_t alignment) noexcept
+        {
+            ComponentRegistry& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            // 上限を超える型の数はマスクで表せない（設計上の誤り）
+            assert(reg.count < k_maxComponents && "too many ECS component types");
+            if (reg.count >= k_maxComponents)
+            {
+                return k_invalidComponent;
+            }
+            reg.infos[reg.count] = ComponentInfo{ size, alignment };
+            return reg.count++;
+        }
+    } // namespace Detail
+
+    const ComponentInfo& get_component_info(ComponentId id) noexcept
+    {
+        // 登録済みの要素は以後書き換わらないため、読み取りにロックは要らない
+        return registry().infos[id];
+    }
+
+    Archetype::Archetype(const ComponentMask& mask)
+        : m_mask(mask)
+    {
+        std::fill(std::begin(m_addEdges), std::end(m_addEdges), k_invalidArchetype);
+        std::fill(std::begin(m_removeEdges), std::end(m_removeEdges), k_invalidArchetype);
+        std::fill(std::begin(m_columnOf), std::end(m_columnOf), static_cast<int16_t>(-1));
+
+        // 1) ID 順に列を並べる（同じマスクなら常に同じレイアウトになる）
+        uint32_t rowSize = static_cast<uint32_t>(sizeof(Entity));
+        for (ComponentId id = 0; id < k_maxComponents; ++id)
+        {
+            if (!mask.test(id))
+            {
+                continue;
+            }
+            const ComponentInfo& info = get_component_info(id);
+            assert(info.alignment <= k_columnAlignment && "over-aligned ECS component");
+            m_columnOf[id] = static_cast<int16_t>(m_components.size());
+            m_components.push_back(id);
+            m_sizes.push_back(info.size);
+            rowSize += info.size;
+        }
+        m_offsets.resize(m_components.size());
+
+        // 2) 列毎のアライメント詰め物を見込んで、チャンクに収まる最大の行数を探す
+        uint32_t capacity = static_cast<uint32_t>(k_chunkSize) / rowSize;
+        for (; capacity > 0; --capacity)
+        {
+            uint32_t offset = align_up(capacity * static_cast<uint32_t>(sizeof(Entity)), k_columnAlignment);
+            for (size_t i = 0; i < m_components.size(); ++i)
+            {
+                m_offsets[i] = offset;
+                offset = align_up(offset + capacity * m_sizes[i], k_columnAlignment);
+            }
+            if (offset <= k_chunkSize)
+            {
+                break;
+            }
+        }
+        assert(capacity > 0 && "ECS archetype row does not fit in a chunk");
+        m_capacity = capacity;
+    }
+
+    void Archetype::push_row(Entity entity, uint32_t& outChunk, uint32_t& outRow)
+    {
+        // 1) 末尾のチャンクが満杯なら新しいチャンクを足す
+        if (m_chunks.empty() || m_chunks.back().count == m_capacity)
+        {
+            Chunk chunk{};
+            chunk.memory = m_spareChunk ? std::move(m_spareChunk) : std::make_unique_for_overwrite<ChunkMemory>();
+            m_chunks.push_back(std::move(chunk));
+        }
+
+        // 2) 末尾に行を足す
+        Chunk& chunk = m_chunks.back();
+        outChunk = static_cast<uint32_t>(m_chunks.size() - 1);
+        outRow = chunk.count;
+        get_entities(chunk)[chunk.count] = entity;
+        ++chunk.count;
+        ++m_entityCount;
+    }
+
+    Entity Archetype::remove_row(uint32_t chunkIndex, uint32_t row) noexcept
+    {
+        Chunk& last = m_chunks.back();
+        const uint32_t lastRow = last.count - 1;
+        Chunk& chunk = m_chunks[chunkIndex];
+
+        // 1) 末尾の行を穴へ移してチャンクを前詰めに保つ
+        Entity moved{};
+        if (&chunk != &last || row != lastRow)
+        {
+            moved = get_entities(last)[lastRow];
+            get_entities(chunk)[row] = moved;
+            for (size_t i = 0; i < m_components.size(); ++i)
+            {
+                std::byte* dst = chunk.memory->bytes + m_offsets[i] + static_cast<size_t>(row) * m_sizes[i];
+                const std::byte* src = last.memory->bytes + m_offsets[i] + static_cast<size_t>(lastRow) * m_sizes[i];
+                std::memcpy(dst, src, m_sizes[i]);
+            }
+        }
+
+        // 2) 空になった末尾チャンクは予備として 1 つだけ残す
+        --last.count;
+        --m_entityCount;
+        if (last.count == 0)
+        {
+            if (!m_spareChunk)
+            {
+                m_spareChunk = std::move(last.memory);
+            }
+            m_chunks.pop_back();
+        }
+        return moved;
+    }
+
+    void Archetype::copy_shared_components(const Archetype& src, uint32_t srcChunk, uint32_t srcRow,
+        uint32_t dstChunk, uint32_t dstRow) noexcept
+    {
+        const Chunk& from = src.m_chunks[srcChunk];
+        Chunk& to = m_chunks[dstChunk];
+        for (size_t i = 0; i < m_components.size(); ++i)
+        {
+            const ComponentId id = m_components[i];
+            if (!src.has_component(id))
+            {
+                continue;
+            }
+            const size_t srcColumn = static_cast<size_t>(src.m_columnOf[id]);
+            std::memcpy(to.memory->bytes + m_offsets[i] + static_cast<size_t>(dstRow) * m_sizes[i],
+                from.memory->bytes + src.m_offsets[srcColumn] + static_cast<size_t>(srcRow) * m_sizes[i],
+                m_sizes[i]);
+        }
+    }
+} // namespace Cue::Ecs
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+namespace Cue::Ecs
+{
+    // チャンクの大きさ（L1/L2 に収まり、ページを跨ぎにくい大きさ）
+    constexpr size_t k_chunkSize = 16u * 1024u;
+
+    /// @brief 1 チャンク分のメモリ
+    struct alignas(64) ChunkMemory
+    {
+        std::byte bytes[k_chunkSize];
+    };
+
+    /// @brief アーキタイプ内の 1 チャンク
+    /// @details 先頭にエンティティ配列、その後ろにコンポーネント毎の配列（SoA）が並ぶ。
+    struct Chunk
+    {
+        std::unique_ptr<ChunkMemory> memory;
+        uint32_t count = 0;
+    };
+
+    /// @brief 同じコンポーネント構成を持つエンティティの集合
+    /// @details チャンクは常に前詰めで、最後のチャンク以外は満杯に保つ（走査を線形にするため）。
+    class World;
+
+    class Archetype final
+    {
+    public:
+        static constexpr uint32_t k_invalidArchetype = 0xFFFFFFFFu;
+
+        explicit Archetype(const ComponentMask& mask);
+
+        [[nodiscard]] const ComponentMask& get_mask() const noexcept { return m_mask; }
+        [[nodiscard]] const std::vector<ComponentId>& get_components() const noexcept { return m_components; }
+        [[nodiscard]] uint32_t get_capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] size_t get_chunk_count() const noexcept { return m_chunks.size(); }
+        [[nodiscard]] size_t get_entity_count() const noexcept { return m_entityCount; }
+        [[nodiscard]] Chunk& get_chunk(size_t index) noexcept { return m_chunks[index]; }
+        [[nodiscard]] const Chunk& get_chunk(size_t index) const noexcept { return m_chunks[index]; }
+
+        [[nodiscard]] bool has_component(ComponentId id) const noexcept
+        {
+            return id < k_maxComponents && m_mask.test(id);
+        }
+        [[nodiscard]] Entity* get_entities(const Chunk& chunk) const noexcept
+        {
+            return reinterpret_cast<Entity*>(chunk.memory->bytes);
+        }
+        /// @brief チャンク内のコンポーネント配列（持っていなければ nullptr）
+        [[nodiscard]] void* get_column(const Chunk& chunk, ComponentId id) const noexcept
+        {
+            if (!has_component(id))
+            {
+                return nullptr;
+            }
+            return chunk.memory->bytes + m_offsets[static_cast<size_t>(m_columnOf[id])];
+        }
+        template<typename T>
+        [[nodiscard]] T* get_column(const Chunk& chunk) const noexcept
+        {
+            return static_cast<T*>(get_column(chunk, component_id<std::remove_const_t<T>>()));
+        }
+
+        /// @brief 末尾に行を確保する（コンポーネントは未初期化）
+        void push_row(Entity entity, uint32_t& outChunk, uint32_t& outRow);
+        /// @brief 行を取り除き、穴を末尾の行で埋める
+        /// @return 穴に移動してきたエンティティ（移動が無ければ無効 ID）
+        Entity remove_row(uint32_t chunkIndex, uint32_t row) noexcept;
+        /// @brief 同じ ID のコンポーネントを別アーキタイプの行からコピーする
+        void copy_shared_components(const Archetype& src, uint32_t srcChunk, uint32_t srcRow,
+            uint32_t dstChunk, uint32_t dstRow) noexcept;
+    private:
+        friend class World;
+
+        // コンポーネントの追加・削除で遷移する先のキャッシュ（World が埋める）
+        uint32_t m_addEdges[k_maxComponents];
+        uint32_t m_removeEdges[k_maxComponents];
+        ComponentMask m_mask;
+        std::vector<ComponentId> m_components;
+        std::vector<uint32_t> m_offsets;
+        std::vector<uint32_t> m_sizes;
+        int16_t m_columnOf[k_maxComponents];
+        uint32_t m_capacity = 0;
+        size_t m_entityCount = 0;
+        std::vector<Chunk> m_chunks;
+        // 空になったチャンクを 1 つだけ残して確保の往復を避ける
+        std::unique_ptr<ChunkMemory> m_spareChunk;
+    };
+} // namespace Cue::Ecs
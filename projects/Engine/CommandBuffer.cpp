@@ -0,0 +1,46 @@
+#include "CommandBuffer.h"
+
+namespace Cue::Ecs
+{
+    Entity CommandBuffer::create_entity()
+    {
+        const Entity pending{ m_pendingCount++, k_pendingGeneration };
+        push(CommandType::CreateEntity, pending, k_invalidComponent, 0);
+        return pending;
+    }
+
+    void CommandBuffer::destroy_entity(Entity entity)
+    {
+        push(CommandType::DestroyEntity, entity, k_invalidComponent, 0);
+    }
+
+    void CommandBuffer::add_component(Entity entity, ComponentId id, const void* data)
+    {
+        const uint32_t size = get_component_info(id).size;
+        void* payload = push(CommandType::AddComponent, entity, id, (size + 7u) & ~7u);
+        std::memcpy(payload, data, size);
+    }
+
+    void CommandBuffer::remove_component(Entity entity, ComponentId id)
+    {
+        push(CommandType::RemoveComponent, entity, id, 0);
+    }
+
+    void CommandBuffer::clear() noexcept
+    {
+        m_data.clear();
+        m_pendingCount = 0;
+    }
+
+    void* CommandBuffer::push(CommandType type, Entity entity, ComponentId component, uint32_t payloadSize)
+    {
+        // 1) ヘッダとデータを連続した領域へ追記する（ヘッダは 8 バイトの倍数なので整列が崩れない）
+        const size_t offset = m_data.size();
+        m_data.resize(offset + sizeof(CommandHeader) + payloadSize);
+
+        // 2) ヘッダを書き込む
+        const CommandHeader header{ type, component, entity, payloadSize, 0 };
+        std::memcpy(m_data.data() + offset, &header, sizeof(header));
+        return m_data.data() + offset + sizeof(CommandHeader);
+    }
+} // namespace Cue::Ecs
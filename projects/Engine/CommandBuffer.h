@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+namespace Cue::Ecs
+{
+    /// @brief 構造変更（生成・破棄・コンポーネント増減）を遅延させるためのコマンド列
+    /// @details 走査中やシステムの並列実行中は World を直接変更できないため、ここに記録して
+    ///          フレーム末に World::execute でまとめて適用する。1 つのバッファは 1 スレッドから使う。
+    class CommandBuffer final
+    {
+    public:
+        // create_entity が返す仮 ID の世代（このバッファ内でだけ有効）
+        static constexpr uint32_t k_pendingGeneration = 0xFFFFFFFFu;
+
+        /// @brief エンティティの生成を記録する
+        /// @return 同じバッファへの後続コマンドでだけ使える仮 ID
+        [[nodiscard]] Entity create_entity();
+        /// @brief エンティティの破棄を記録する
+        void destroy_entity(Entity entity);
+        /// @brief コンポーネントの追加（既にあれば上書き）を記録する
+        void add_component(Entity entity, ComponentId id, const void* data);
+        template<typename T>
+        void add_component(Entity entity, const T& value)
+        {
+            add_component(entity, component_id<T>(), &value);
+        }
+        /// @brief コンポーネントの削除を記録する
+        void remove_component(Entity entity, ComponentId id);
+        template<typename T>
+        void remove_component(Entity entity)
+        {
+            remove_component(entity, component_id<T>());
+        }
+
+        [[nodiscard]] bool is_empty() const noexcept { return m_data.empty(); }
+        /// @brief 記録を捨てる（確保済みの領域は次フレームに再利用する）
+        void clear() noexcept;
+    private:
+        friend class World;
+
+        enum class CommandType : uint32_t
+        {
+            CreateEntity,
+            DestroyEntity,
+            AddComponent,
+            RemoveComponent,
+        };
+
+        struct CommandHeader
+        {
+            CommandType type;
+            ComponentId component;
+            Entity entity;
+            // ヘッダの後ろに続くデータの大きさ（8 バイト単位に切り上げ済み）
+            uint32_t payloadSize;
+            uint32_t reserved;
+        };
+
+        void* push(CommandType type, Entity entity, ComponentId component, uint32_t payloadSize);
+
+        std::vector<std::byte> m_data;
+        uint32_t m_pendingCount = 0;
+    };
+} // namespace Cue::Ecs
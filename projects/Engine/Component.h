@@ -0,0 +1,52 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <type_traits>
+
+namespace Cue::Ecs
+{
+    // 登録できるコンポーネント型の上限（マスクのビット数）
+    constexpr uint32_t k_maxComponents = 128;
+
+    using ComponentId = uint32_t;
+    using ComponentMask = std::bitset<k_maxComponents>;
+
+    constexpr ComponentId k_invalidComponent = 0xFFFFFFFFu;
+
+    /// @brief 型消去されたコンポーネント情報
+    struct ComponentInfo
+    {
+        uint32_t size = 0;
+        uint32_t alignment = 0;
+    };
+
+    namespace Detail
+    {
+        // 型毎に一度だけ呼ばれ、プロセス内で一意な ID を振る
+        ComponentId register_component(uint32_t size, uint32_t alignment) noexcept;
+    }
+
+    /// @brief 登録済みコンポーネントの情報
+    [[nodiscard]] const ComponentInfo& get_component_info(ComponentId id) noexcept;
+
+    /// @brief コンポーネント型の ID
+    /// @details チャンク間の移動を memcpy だけで済ませるため、トリビアルにコピー・破棄できる型に限る。
+    template<typename T>
+    [[nodiscard]] ComponentId component_id() noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+            "ECS components must be trivially copyable and destructible.");
+        static const ComponentId s_id = Detail::register_component(
+            static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)));
+        return s_id;
+    }
+
+    /// @brief 型の並びからマスクを作る
+    template<typename... Ts>
+    [[nodiscard]] ComponentMask make_mask() noexcept
+    {
+        ComponentMask mask;
+        (mask.set(component_id<std::remove_const_t<Ts>>()), ...);
+        return mask;
+    }
+} // namespace Cue::Ecs
@@ -0,0 +1,571 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+namespace Cue
+{
+    namespace
+    {
+        constexpr uint32_t k_width = 4;
+        constexpr uint32_t k_noParent = 0xFFFFFFFFu;
+        // 空いた子の箱（どの平面でも外側になる）
+        constexpr float k_huge = 1.0e30f;
+        // cull がカメラ毎に並列に回す部分木の数の目安
+        constexpr uint32_t k_targetSubtreeCount = 64;
+        constexpr uint32_t k_maxStackSize = 256;
+        constexpr uint32_t k_allPlanes = 0x3Fu;
+
+        /// @brief 4 つの子の箱を SoA で持つ節点（2 キャッシュライン）
+        struct alignas(64) Node
+        {
+            // [0..2] が min の xyz、[3..5] が max の xyz
+            float bounds[6][k_width];
+            // 0 以上は節点、負は ~（並べ替えた物体列の位置）
+            int32_t children[k_width];
+            uint32_t childCount;
+            // この節点の下の物体が並べ替えた物体列のどこにあるか
+            uint32_t first;
+            uint32_t count;
+            // 親の節点 * 4 + 親の中での子の位置（根は k_noParent）
+            uint32_t parentSlot;
+        };
+        static_assert(sizeof(Node) == 128);
+
+        /// @brief 1 平面分の判定に使う値（箱の最も内側・最も外側の角を選ぶ添字を先に決めておく）
+        struct PlaneTest
+        {
+            float normal[3];
+            float distance;
+            // 法線方向に最も遠い角（これが外なら箱は外）と、最も近い角（これが内なら箱は内）
+            uint32_t farIndex[3];
+            uint32_t nearIndex[3];
+        };
+
+        struct FrustumTest
+        {
+            PlaneTest planes[6];
+        };
+
+        FrustumTest make_frustum_test(const Frustum& frustum) noexcept
+        {
+            FrustumTest test{};
+            for (uint32_t p = 0; p < 6; ++p)
+            {
+                const Math::Float4& plane = frustum.planes[p];
+                const float normal[3] = { plane.x, plane.y, plane.z };
+                PlaneTest& out = test.planes[p];
+                out.distance = plane.w;
+                for (uint32_t axis = 0; axis < 3; ++axis)
+                {
+                    out.normal[axis] = normal[axis];
+                    out.farIndex[axis] = normal[axis] >= 0.0f ? axis + 3 : axis;
+                    out.nearIndex[axis] = normal[axis] >= 0.0f ? axis : axis + 3;
+                }
+            }
+            return test;
+        }
+
+        /// @brief 1 平面に対して 4 つの子を判定する
+        /// @param outOutside 平面の外側にある子のビット
+        /// @param outInside 平面の内側に丸ごと入る子のビット
+        inline void test_plane(const Node& node, const PlaneTest& plane, uint32_t& outOutside, uint32_t& outInside) noexcept
+        {
+#if CUE_MATH_SSE41
+            const __m128 nx = _mm_set1_ps(plane.normal[0]);
+            const __m128 ny = _mm_set1_ps(plane.normal[1]);
+            const __m128 nz = _mm_set1_ps(plane.normal[2]);
+            const __m128 d = _mm_set1_ps(plane.distance);
+            __m128 farDistance = Math::Detail::madd(nx, _mm_load_ps(node.bounds[plane.farIndex[0]]), d);
+            farDistance = Math::Detail::madd(ny, _mm_load_ps(node.bounds[plane.farIndex[1]]), farDistance);
+            farDistance = Math::Detail::madd(nz, _mm_load_ps(node.bounds[plane.farIndex[2]]), farDistance);
+            __m128 nearDistance = Math::Detail::madd(nx, _mm_load_ps(node.bounds[plane.nearIndex[0]]), d);
+            nearDistance = Math::Detail::madd(ny, _mm_load_ps(node.bounds[plane.nearIndex[1]]), nearDistance);
+            nearDistance = Math::Detail::madd(nz, _mm_load_ps(node.bounds[plane.nearIndex[2]]), nearDistance);
+            const __m128 zero = _mm_setzero_ps();
+            outOutside = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(farDistance, zero)));
+            outInside = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(nearDistance, zero)));
+#else
+            outOutside = 0;
+            outInside = 0;
+            for (uint32_t lane = 0; lane < k_width; ++lane)
+            {
+                float farDistance = plane.distance;
+                float nearDistance = plane.distance;
+                for (uint32_t axis = 0; axis < 3; ++axis)
+                {
+                    farDistance += plane.normal[axis] * node.bounds[plane.farIndex[axis]][lane];
+                    nearDistance += plane.normal[axis] * node.bounds[plane.nearIndex[axis]][lane];
+                }
+                outOutside |= static_cast<uint32_t>(farDistance < 0.0f) << lane;
+                outInside |= static_cast<uint32_t>(nearDistance >= 0.0f) << lane;
+            }
+#endif
+        }
+
+        void set_slot_bounds(Node& node, uint32_t slot, const Aabb& bounds) noexcept
+        {
+            node.bounds[0][slot] = bounds.min.x;
+            node.bounds[1][slot] = bounds.min.y;
+            node.bounds[2][slot] = bounds.min.z;
+            node.bounds[3][slot] = bounds.max.x;
+            node.bounds[4][slot] = bounds.max.y;
+            node.bounds[5][slot] = bounds.max.z;
+        }
+
+        /// @brief 節点の子の箱を全て含む箱
+        Aabb get_node_bounds(const Node& node) noexcept
+        {
+            Aabb result{ { k_huge, k_huge, k_huge }, { -k_huge, -k_huge, -k_huge } };
+            for (uint32_t slot = 0; slot < node.childCount; ++slot)
+            {
+                result.min.x = std::min(result.min.x, node.bounds[0][slot]);
+                result.min.y = std::min(result.min.y, node.bounds[1][slot]);
+                result.min.z = std::min(result.min.z, node.bounds[2][slot]);
+                result.max.x = std::max(result.max.x, node.bounds[3][slot]);
+                result.max.y = std::max(result.max.y, node.bounds[4][slot]);
+                result.max.z = std::max(result.max.z, node.bounds[5][slot]);
+            }
+            return result;
+        }
+
+        float get_axis(const Math::Float3& v, uint32_t axis) noexcept
+        {
+            return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+        }
+    }
+
+    Frustum make_frustum(const Math::Float4x4& viewProjection) noexcept
+    {
+        // 行ベクトル規約なので、クリップ座標の各成分は行列の列との内積になる
+        const Math::Float4x4& m = viewProjection;
+        const Math::Float4 column[4] = {
+            { m.r[0].x, m.r[1].x, m.r[2].x, m.r[3].x },
+            { m.r[0].y, m.r[1].y, m.r[2].y, m.r[3].y },
+            { m.r[0].z, m.r[1].z, m.r[2].z, m.r[3].z },
+            { m.r[0].w, m.r[1].w, m.r[2].w, m.r[3].w },
+        };
+        Frustum frustum{};
+        frustum.planes[0] = column[3] + column[0];  // 左
+        frustum.planes[1] = column[3] - column[0];  // 右
+        frustum.planes[2] = column[3] + column[1];  // 下
+        frustum.planes[3] = column[3] - column[1];  // 上
+        frustum.planes[4] = column[2];              // 手前（深度 0）
+        frustum.planes[5] = column[3] - column[2];  // 奥
+        for (Math::Float4& plane : frustum.planes)
+        {
+            const float length = Math::length(Math::Float3{ plane.x, plane.y, plane.z });
+            if (length > 0.0f)
+            {
+                plane = plane * (1.0f / length);
+            }
+        }
+        return frustum;
+    }
+
+    bool is_visible(const Frustum& frustum, const Aabb& bounds) noexcept
+    {
+        for (const Math::Float4& plane : frustum.planes)
+        {
+            const float x = plane.x >= 0.0f ? bounds.max.x : bounds.min.x;
+            const float y = plane.y >= 0.0f ? bounds.max.y : bounds.min.y;
+            const float z = plane.z >= 0.0f ? bounds.max.z : bounds.min.z;
+            if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct CullingBvh::Impl
+    {
+        std::vector<Aabb> bounds;
+        // 並べ替えた物体列（位置 → 物体の番号）と、物体の入っている節点の子の位置（節点 * 4 + 位置）
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> location;
+        std::vector<Node> nodes;
+        std::vector<uint8_t> dirty;
+        bool isDirty = false;
+        uint32_t depth = 0;
+
+        // cull の並列の単位になる部分木の根と、それより上の節点に直に付いた物体（並べ替えた列の位置）
+        std::vector<uint32_t> subtreeRoots;
+        std::vector<uint32_t> looseObjects;
+        // 部分木 * カメラ毎の出力（容量を使い回す）
+        std::vector<std::vector<uint32_t>> taskOutputs;
+        std::vector<FrustumTest> frustumTests;
+
+        // build の作業領域
+        std::vector<Math::Float3> centroids;
+
+        /// @brief [first, first + count) を重心の最も広い軸の中央で 2 つに分ける
+        uint32_t split_median(uint32_t first, uint32_t count)
+        {
+            Math::Float3 low{ k_huge, k_huge, k_huge };
+            Math::Float3 high{ -k_huge, -k_huge, -k_huge };
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const Math::Float3& c = centroids[order[i]];
+                low = { std::min(low.x, c.x), std::min(low.y, c.y), std::min(low.z, c.z) };
+                high = { std::max(high.x, c.x), std::max(high.y, c.y), std::max(high.z, c.z) };
+            }
+            const Math::Float3 extent = high - low;
+            const uint32_t axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+            const uint32_t half = count / 2;
+            std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                [this, axis](uint32_t a, uint32_t b)
+                {
+                    return get_axis(centroids[a], axis) < get_axis(centroids[b], axis);
+                });
+            return half;
+        }
+
+        uint32_t build_node(uint32_t first, uint32_t count, uint32_t parentSlot, uint32_t nodeDepth)
+        {
+            // 1) 親より先に番号を取る（refit は番号の大きい方から親へ向かって回す）
+            const uint32_t index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            depth = std::max(depth, nodeDepth);
+
+            // 2) 4 つ以下なら物体を直に子にし、それより多ければ中央で 2 回割って 4 つに分ける
+            uint32_t groupFirst[k_width] = {};
+            uint32_t groupCount[k_width] = {};
+            uint32_t groupTotal = 0;
+            if (count <= k_width)
+            {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    groupFirst[i] = first + i;
+                    groupCount[i] = 1;
+                }
+                groupTotal = count;
+            }
+            else
+            {
+                const uint32_t left = split_median(first, count);
+                const uint32_t leftLeft = split_median(first, left);
+                const uint32_t rightLeft = split_median(first + left, count - left);
+                groupFirst[0] = first;
+                groupCount[0] = leftLeft;
+                groupFirst[1] = first + leftLeft;
+                groupCount[1] = left - leftLeft;
+                groupFirst[2] = first + left;
+                groupCount[2] = rightLeft;
+                groupFirst[3] = first + left + rightLeft;
+                groupCount[3] = count - left - rightLeft;
+                groupTotal = k_width;
+            }
+
+            // 3) 子を作ってから箱を埋める（子の節点を作ると nodes が伸びるので参照は後で取る）
+            int32_t children[k_width] = {};
+            Aabb childBounds[k_width] = {};
+            for (uint32_t slot = 0; slot < groupTotal; ++slot)
+            {
+                if (groupCount[slot] == 1)
+                {
+                    const uint32_t position = groupFirst[slot];
+                    children[slot] = ~static_cast<int32_t>(position);
+                    childBounds[slot] = bounds[order[position]];
+                    location[order[position]] = index * k_width + slot;
+                }
+                else
+                {
+                    const uint32_t child = build_node(groupFirst[slot], groupCount[slot], index * k_width + slot, nodeDepth + 1);
+                    children[slot] = static_cast<int32_t>(child);
+                    childBounds[slot] = get_node_bounds(nodes[child]);
+                }
+            }
+
+            Node& node = nodes[index];
+            for (uint32_t slot = 0; slot < k_width; ++slot)
+            {
+                node.children[slot] = children[slot];
+                set_slot_bounds(node, slot, slot < groupTotal ? childBounds[slot]
+                    : Aabb{ { k_huge, k_huge, k_huge }, { -k_huge, -k_huge, -k_huge } });
+            }
+            node.childCount = groupTotal;
+            node.first = first;
+            node.count = count;
+            node.parentSlot = parentSlot;
+            return index;
+        }
+
+        /// @brief 根から幅優先に開いて、並列に回す部分木を選ぶ
+        void choose_subtrees()
+        {
+            subtreeRoots.clear();
+            looseObjects.clear();
+            if (nodes.empty())
+            {
+                return;
+            }
+            std::vector<uint32_t> frontier{ 0 };
+            std::vector<uint32_t> next;
+            while (!frontier.empty() && frontier.size() * k_width <= k_targetSubtreeCount)
+            {
+                next.clear();
+                for (const uint32_t index : frontier)
+                {
+                    const Node& node = nodes[index];
+                    for (uint32_t slot = 0; slot < node.childCount; ++slot)
+                    {
+                        if (node.children[slot] >= 0)
+                        {
+                            next.push_back(static_cast<uint32_t>(node.children[slot]));
+                        }
+                        else
+                        {
+                            looseObjects.push_back(static_cast<uint32_t>(~node.children[slot]));
+                        }
+                    }
+                }
+                frontier.swap(next);
+            }
+            subtreeRoots = frontier;
+        }
+
+        /// @brief 部分木を辿り、可視な物体の番号を out に足す
+        void cull_subtree(const FrustumTest& test, uint32_t root, std::vector<uint32_t>& out) const
+        {
+            // 節点と、まだ判定の要る平面のビット（親で丸ごと内側と分かった平面は子で調べない）
+            uint32_t stackNodes[k_maxStackSize];
+            uint32_t stackPlanes[k_maxStackSize];
+            uint32_t stackSize = 0;
+            stackNodes[stackSize] = root;
+            stackPlanes[stackSize] = k_allPlanes;
+            ++stackSize;
+
+            while (stackSize != 0)
+            {
+                --stackSize;
+                const Node& node = nodes[stackNodes[stackSize]];
+                const uint32_t planeMask = stackPlanes[stackSize];
+
+                // 1) 残っている平面毎に 4 つの子をまとめて判定する
+                uint32_t outside = 0;
+                uint32_t childPlanes[k_width] = { planeMask, planeMask, planeMask, planeMask };
+                for (uint32_t p = 0; p < 6; ++p)
+                {
+                    if ((planeMask & (1u << p)) == 0)
+                    {
+                        continue;
+                    }
+                    uint32_t planeOutside = 0;
+                    uint32_t planeInside = 0;
+                    test_plane(node, test.planes[p], planeOutside, planeInside);
+                    outside |= planeOutside;
+                    for (uint32_t lane = 0; lane < k_width; ++lane)
+                    {
+                        childPlanes[lane] &= ~(((planeInside >> lane) & 1u) << p);
+                    }
+                }
+
+                // 2) 外に出なかった子を、物体なら出力へ、節点なら丸ごと内側か辿るかで分ける
+                const uint32_t visible = ((1u << node.childCount) - 1) & ~outside;
+                for (uint32_t lane = 0; lane < node.childCount; ++lane)
+                {
+                    if ((visible & (1u << lane)) == 0)
+                    {
+                        continue;
+                    }
+                    const int32_t child = node.children[lane];
+                    if (child < 0)
+                    {
+                        out.push_back(order[static_cast<uint32_t>(~child)]);
+                    }
+                    else if (childPlanes[lane] == 0)
+                    {
+                        const Node& inside = nodes[static_cast<uint32_t>(child)];
+                        out.insert(out.end(), order.begin() + inside.first, order.begin() + inside.first + inside.count);
+                    }
+                    else
+                    {
+                        assert(stackSize < k_maxStackSize && "CullingBvh traversal stack overflow.");
+                        stackNodes[stackSize] = static_cast<uint32_t>(child);
+                        stackPlanes[stackSize] = childPlanes[lane];
+                        ++stackSize;
+                    }
+                }
+            }
+        }
+    };
+
+    CullingBvh::CullingBvh()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    CullingBvh::~CullingBvh()
+    {
+    }
+
+    Core::Result CullingBvh::build(std::span<const Aabb> bounds)
+    {
+        if (bounds.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "CullingBvh object count is out of range.");
+        }
+
+        // 1) 箱を写し、重心で分けるための作業領域を用意する
+        Impl& impl = *m_impl;
+        const uint32_t count = static_cast<uint32_t>(bounds.size());
+        impl.bounds.assign(bounds.begin(), bounds.end());
+        impl.order.resize(count);
+        std::iota(impl.order.begin(), impl.order.end(), 0u);
+        impl.location.assign(count, 0);
+        impl.centroids.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            impl.centroids[i] = (bounds[i].min + bounds[i].max) * 0.5f;
+        }
+
+        // 2) 上から中央で割りながら組む（節点数は物体数の 1/3 程度）
+        impl.nodes.clear();
+        impl.nodes.reserve(count / 3 + 1);
+        impl.depth = 0;
+        if (count != 0)
+        {
+            (void)impl.build_node(0, count, k_noParent, 1);
+        }
+        assert(impl.depth * (k_width - 1) + 1 <= k_maxStackSize && "CullingBvh is too deep for the traversal stack.");
+        impl.dirty.assign(impl.nodes.size(), 0);
+        impl.isDirty = false;
+
+        // 3) 並列に回す部分木を選んでおく
+        impl.choose_subtrees();
+        return Core::Result::ok();
+    }
+
+    void CullingBvh::update(uint32_t objectIndex, const Aabb& bounds) noexcept
+    {
+        // 1) 物体の入っている子の箱はその場で書き換える
+        Impl& impl = *m_impl;
+        assert(objectIndex < impl.bounds.size() && "CullingBvh::update object index out of range.");
+        impl.bounds[objectIndex] = bounds;
+        const uint32_t slot = impl.location[objectIndex];
+        set_slot_bounds(impl.nodes[slot / k_width], slot % k_width, bounds);
+
+        // 2) その節点から根まで印を付ける（既に付いていればその先も付いている）
+        for (uint32_t index = slot / k_width; index != k_noParent && impl.dirty[index] == 0;)
+        {
+            impl.dirty[index] = 1;
+            const uint32_t parentSlot = impl.nodes[index].parentSlot;
+            index = parentSlot == k_noParent ? k_noParent : parentSlot / k_width;
+        }
+        impl.isDirty = true;
+    }
+
+    void CullingBvh::refit() noexcept
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isDirty)
+        {
+            return;
+        }
+        // 子は親より大きい番号なので、後ろから回せば子の箱は親へ写す前に直っている
+        for (size_t i = impl.nodes.size(); i-- > 0;)
+        {
+            if (impl.dirty[i] == 0)
+            {
+                continue;
+            }
+            impl.dirty[i] = 0;
+            const Node& node = impl.nodes[i];
+            if (node.parentSlot != k_noParent)
+            {
+                set_slot_bounds(impl.nodes[node.parentSlot / k_width], node.parentSlot % k_width, get_node_bounds(node));
+            }
+        }
+        impl.isDirty = false;
+    }
+
+    Core::Result CullingBvh::cull(std::span<const Frustum> frustums, std::span<std::vector<uint32_t>> outVisible,
+        Core::JobSystem* jobSystem)
+    {
+        Impl& impl = *m_impl;
+        if (frustums.size() != outVisible.size())
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidArg, Core::Severity::Error,
+                static_cast<uint32_t>(outVisible.size()), "CullingBvh::cull needs one output list per frustum.");
+        }
+        if (impl.isDirty)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "CullingBvh::cull was called with updates that have not been refit.");
+        }
+
+        // 1) 平面毎に角の選び方を決めておき、上の方の節点に直に付いた物体はここで調べる
+        const uint32_t cameraCount = static_cast<uint32_t>(frustums.size());
+        impl.frustumTests.resize(cameraCount);
+        for (uint32_t c = 0; c < cameraCount; ++c)
+        {
+            impl.frustumTests[c] = make_frustum_test(frustums[c]);
+            std::vector<uint32_t>& visible = outVisible[c];
+            visible.clear();
+            for (const uint32_t position : impl.looseObjects)
+            {
+                const uint32_t object = impl.order[position];
+                if (is_visible(frustums[c], impl.bounds[object]))
+                {
+                    visible.push_back(object);
+                }
+            }
+        }
+
+        // 2) カメラ * 部分木を 1 つの仕事として並列に回す（出力は仕事毎に分け、ロックを取らない）
+        const uint32_t subtreeCount = static_cast<uint32_t>(impl.subtreeRoots.size());
+        const uint32_t taskCount = cameraCount * subtreeCount;
+        if (impl.taskOutputs.size() < taskCount)
+        {
+            impl.taskOutputs.resize(taskCount);
+        }
+        auto body = [&impl, subtreeCount](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t task = begin; task < end; ++task)
+                {
+                    std::vector<uint32_t>& out = impl.taskOutputs[task];
+                    out.clear();
+                    impl.cull_subtree(impl.frustumTests[task / subtreeCount], impl.subtreeRoots[task % subtreeCount], out);
+                }
+            };
+        if (jobSystem)
+        {
+            jobSystem->parallel_for(taskCount, 1, body);
+        }
+        else
+        {
+            body(0, taskCount);
+        }
+
+        // 3) 部分木の順に繋ぐ（並列でも結果の並びは変わらない）
+        for (uint32_t c = 0; c < cameraCount; ++c)
+        {
+            std::vector<uint32_t>& visible = outVisible[c];
+            for (uint32_t s = 0; s < subtreeCount; ++s)
+            {
+                const std::vector<uint32_t>& part = impl.taskOutputs[c * subtreeCount + s];
+                visible.insert(visible.end(), part.begin(), part.end());
+            }
+        }
+        return Core::Result::ok();
+    }
+
+    const Aabb& CullingBvh::get_bounds(uint32_t objectIndex) const noexcept
+    {
+        assert(objectIndex < m_impl->bounds.size() && "CullingBvh::get_bounds object index out of range.");
+        return m_impl->bounds[objectIndex];
+    }
+
+    CullingBvhStats CullingBvh::get_stats() const noexcept
+    {
+        CullingBvhStats stats{};
+        stats.objectCount = static_cast<uint32_t>(m_impl->bounds.size());
+        stats.nodeCount = static_cast<uint32_t>(m_impl->nodes.size());
+        stats.depth = m_impl->depth;
+        stats.subtreeCount = static_cast<uint32_t>(m_impl->subtreeRoots.size());
+        return stats;
+    }
+} // namespace Cue
@@ -0,0 +1,75 @@
+#pragma once
+#include <JobSystem.h>
+#include <Math.h>
+#include <Result.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Cue
+{
+    /// @brief 軸に沿った境界箱（ワールド空間）
+    struct Aabb
+    {
+        Math::Float3 min{};
+        Math::Float3 max{};
+    };
+
+    /// @brief 視錐台の 6 平面（xyz が内向きの単位法線、w が距離。dot(n, p) + w >= 0 が内側）
+    struct Frustum
+    {
+        Math::Float4 planes[6]{};
+    };
+
+    /// @brief ビュー射影行列（行ベクトル規約、深度 0..1）から視錐台を取り出す
+    [[nodiscard]] Frustum make_frustum(const Math::Float4x4& viewProjection) noexcept;
+    /// @brief 1 つの箱が視錐台に掛かるか（BVH を通さない参照実装。平面毎の判定なので角の外側は残る）
+    [[nodiscard]] bool is_visible(const Frustum& frustum, const Aabb& bounds) noexcept;
+
+    /// @brief CullingBvh の形の集計
+    struct CullingBvhStats
+    {
+        uint32_t objectCount = 0;
+        uint32_t nodeCount = 0;
+        // 根を 1 とした最も深い節点の深さ
+        uint32_t depth = 0;
+        // cull が並列に回す部分木の数（カメラ毎）
+        uint32_t subtreeCount = 0;
+    };
+
+    /// @brief 視錐台カリング用の 4 分木 BVH
+    /// @details 節点は 4 つの子の箱を SoA で持ち、平面 1 枚につき 4 つの箱を SIMD でまとめて判定する。
+    ///          子は節点か物体のどちらかで、各節点の下の物体は並べ替えた物体列の連続した範囲になるので、
+    ///          視錐台に丸ごと入った部分木は判定せずに範囲ごと可視リストへ写す。
+    ///          動く物体は update で箱を差し替え、refit で親へ向かって箱を広げ直す（木の形は変えない）。
+    ///          refit を重ねて木の質が落ちたら build し直す。
+    class CullingBvh final
+    {
+    public:
+        CullingBvh();
+        ~CullingBvh();
+        CullingBvh(const CullingBvh&) = delete;
+        CullingBvh& operator=(const CullingBvh&) = delete;
+
+        /// @brief 物体の箱から木を組み直す（物体の番号は bounds の添字）
+        [[nodiscard]] Core::Result build(std::span<const Aabb> bounds);
+        /// @brief 物体の箱を差し替える（親の箱は refit を呼ぶまで直さない）
+        void update(uint32_t objectIndex, const Aabb& bounds) noexcept;
+        /// @brief update された物体から根までの箱を合わせ直す
+        void refit() noexcept;
+
+        /// @brief カメラ毎に可視な物体の番号を集める（update の後は refit してから呼ぶこと）
+        /// @param frustums カメラ毎の視錐台
+        /// @param outVisible frustums と同じ数のリスト（中身は置き換える。容量は使い回す）
+        /// @param jobSystem 部分木を並列に回す先（nullptr なら呼び出しスレッドで回す）
+        [[nodiscard]] Core::Result cull(std::span<const Frustum> frustums, std::span<std::vector<uint32_t>> outVisible,
+            Core::JobSystem* jobSystem);
+
+        [[nodiscard]] const Aabb& get_bounds(uint32_t objectIndex) const noexcept;
+        [[nodiscard]] CullingBvhStats get_stats() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue
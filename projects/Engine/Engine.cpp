@@ -1,5 +1,9 @@
 #include "Engine.h"
 
+#include <Profiler.h>
+
+#include <algorithm>
+
 namespace Cue
 {
     Engine::Engine()
@@ -9,17 +13,300 @@ namespace Cue
     Engine::~Engine()
     {
     }
-    void Engine::initialize(EngineInitInfo& initInfo)
+    Core::Result Engine::initialize(EngineInitInfo& initInfo)
     {
+        // 入力キューとフレームの区切りをプラットフォームに頼るので、無しでは始められない
+        if (!initInfo.platform)
+        {
+            return Core::Result::fail(
+                Core::Facility::Core,
+                Core::Code::InvalidState,
+                Core::Severity::Error,
+                0, "EngineInitInfo::platform is null.");
+        }
+
+        // エンジン自身の確保は Core に付ける（以降に増えた分が shutdown のリーク判定の対象）
+        m_memoryBaseline = Core::take_memory_snapshot();
+        m_isMemoryReportEnabled = initInfo.isMemoryReportEnabled;
+        CUE_MEMORY_TAG(Core::Facility::Core);
         m_platform = initInfo.platform;
+        m_graphicsBackend = initInfo.graphicsBackend;
+
+#if CUE_PROFILE_ENABLED
+        Core::Profiler::set_thread_name("Main");
+#endif
+
+        // 1) 以降の失敗を記録できるよう、ロガーを最初に起動する
+        Core::Result r = m_logger.initialize(initInfo.logger);
+        if (!r)
+        {
+            return r;
+        }
+
+        // 2) フレーム処理を分割できるよう、呼び出しスレッドをワーカー 0 としてジョブシステムを起動する
+        Core::JobSystemDesc jobDesc{};
+        jobDesc.workerCount = initInfo.workerCount;
+        r = m_jobSystem.initialize(jobDesc);
+        if (!r)
+        {
+            m_logger.log(r);
+            m_logger.shutdown();
+            return r;
+        }
+
+        // 3) フレーム内の一時確保をヒープから切り離す
+        r = m_frameArena.initialize(initInfo.frameArena);
+        if (!r)
+        {
+            m_logger.log(r);
+            m_jobSystem.shutdown();
+            m_logger.shutdown();
+            return r;
+        }
+
+        // 4) 入力はリングの容量分を 1 フレームで受け取れるようにしておく
+        m_frameInput.resize(m_platform->get_input_queue().get_capacity());
+        m_frameInputCount = 0;
+        m_inputLatencyBuckets.assign(k_latencyBucketCount, 0);
+        reset_input_latency_stats();
+
+        // 5) フレームパケットのリングを用意し、並走させるなら描画スレッドを起こす
+        r = m_framePipeline.initialize(initInfo.framePipeline);
+        if (!r)
+        {
+            m_logger.log(r);
+            m_frameArena.shutdown();
+            m_jobSystem.shutdown();
+            m_logger.shutdown();
+            return r;
+        }
+        m_extractFrame = initInfo.extractFrame;
+        m_renderFrame = initInfo.renderFrame;
+        m_renderResult.store(Core::Result::ok(), std::memory_order_relaxed);
+        m_frameIndex = 0;
+        m_startTime = std::chrono::steady_clock::now();
+        m_lastFrameTime = m_startTime;
+        if (m_framePipeline.get_depth() > 1)
+        {
+            m_renderThread = std::thread([this]() { run_render_thread(); });
+        }
+        return Core::Result::ok();
+    }
+    Core::Result Engine::tick()
+    {
+        CUE_PROFILE_FRAME();
+        CUE_PROFILE_SCOPE("Engine::tick");
+        Core::begin_memory_frame();
+
+        // 描画スレッドが失敗していたらフレームを進めない
+        Core::Result r = m_renderResult.load(std::memory_order_acquire);
+        if (!r)
+        {
+            return r;
+        }
+        {
+            CUE_PROFILE_SCOPE("Platform::begin_frame");
+            CUE_MEMORY_TAG(Core::Facility::Platform);
+            m_platform->begin_frame();
+        }
+        {
+            CUE_PROFILE_SCOPE("Engine::drain_input");
+            drain_input();
+        }
+
+        // 1) 前フレームの一時確保を巻き戻す（壊れていたらフレームを進めない）
+        r = m_frameArena.begin_frame();
+        if (!r)
+        {
+            m_logger.log(r);
+            m_platform->end_frame();
+            return r;
+        }
+
+        // 2) ECS のシステムを実行し、フレーム中に溜まった構造変更をまとめて適用する
+        m_systemScheduler.run(m_world, m_jobSystem);
+        {
+            CUE_PROFILE_SCOPE("World::flush_commands");
+            m_world.flush_commands();
+        }
+
+        // 3) 描画に渡すパケットを作る（描画が遅れていればここで待つ）
+        r = submit_frame();
+        if (!r)
+        {
+            m_logger.log(r);
+            m_platform->end_frame();
+            return r;
+        }
+
+        {
+            CUE_PROFILE_SCOPE("Platform::end_frame");
+            CUE_MEMORY_TAG(Core::Facility::Platform);
+            m_platform->end_frame();
+        }
+
+        // 4) 予算超過は警告として記録するだけで、フレームは止めない
+        const Core::Result budget = Core::check_memory_budgets();
+        if (!budget)
+        {
+            m_logger.log(budget);
+        }
+        return Core::Result::ok();
+    }
+    InputLatencyStats Engine::get_input_latency_stats() const noexcept
+    {
+        InputLatencyStats stats{};
+        stats.eventCount = m_inputEventCount;
+        stats.droppedCount = m_platform ? m_platform->get_input_queue().get_dropped_count() : 0;
+        if (m_inputEventCount == 0)
+        {
+            return stats;
+        }
+        stats.minUs = static_cast<double>(m_inputLatencyMinNs) / 1000.0;
+        stats.maxUs = static_cast<double>(m_inputLatencyMaxNs) / 1000.0;
+        stats.avgUs = static_cast<double>(m_inputLatencyTotalNs) / 1000.0 / static_cast<double>(m_inputEventCount);
+
+        // 1) 分位点はヒストグラムの区間の中央で近似する
+        auto percentile = [this](double p) noexcept
+            {
+                const uint64_t target = static_cast<uint64_t>(p * static_cast<double>(m_inputEventCount - 1)) + 1;
+                uint64_t accumulated = 0;
+                for (uint32_t i = 0; i < k_latencyBucketCount; ++i)
+                {
+                    accumulated += m_inputLatencyBuckets[i];
+                    if (accumulated >= target)
+                    {
+                        return (static_cast<double>(i) + 0.5) * k_latencyBucketWidthUs;
+                    }
+                }
+                return static_cast<double>(k_latencyBucketCount) * k_latencyBucketWidthUs;
+            };
+        stats.p50Us = std::clamp(percentile(0.50), stats.minUs, stats.maxUs);
+        stats.p99Us = std::clamp(percentile(0.99), stats.minUs, stats.maxUs);
+        return stats;
+    }
+    void Engine::reset_input_latency_stats() noexcept
+    {
+        std::fill(m_inputLatencyBuckets.begin(), m_inputLatencyBuckets.end(), 0u);
+        m_inputEventCount = 0;
+        m_inputLatencyTotalNs = 0;
+        m_inputLatencyMinNs = UINT64_MAX;
+        m_inputLatencyMaxNs = 0;
     }
-    void Engine::tick()
+    void Engine::drain_input() noexcept
     {
-        m_platform->begin_frame();
+        // 1) 1 度だけ取り出す（この後に届いた分は次のフレームに回る）。取り出し終えた時点をフレームの受け取り時刻とする
+        m_frameInputCount = m_platform->get_input_queue().pop(m_frameInput);
+        const uint64_t frameStart = Platform::get_input_timestamp();
 
-        m_platform->end_frame();
+        // 2) 各イベントの遅延を積む
+        for (uint32_t i = 0; i < m_frameInputCount; ++i)
+        {
+            const uint64_t timestamp = m_frameInput[i].timestampNs;
+            const uint64_t latency = frameStart > timestamp ? frameStart - timestamp : 0;
+            const uint64_t bucket = std::min<uint64_t>(latency / (k_latencyBucketWidthUs * 1000ull), k_latencyBucketCount - 1);
+            ++m_inputLatencyBuckets[bucket];
+            m_inputLatencyTotalNs += latency;
+            m_inputLatencyMinNs = std::min(m_inputLatencyMinNs, latency);
+            m_inputLatencyMaxNs = std::max(m_inputLatencyMaxNs, latency);
+        }
+        m_inputEventCount += m_frameInputCount;
+    }
+    Core::Result Engine::submit_frame()
+    {
+        // 1) 空きパケットを取る（並走時に描画が depth - 1 フレーム遅れていれば返るまで待つ）
+        FramePacket* packet = nullptr;
+        {
+            CUE_PROFILE_SCOPE("FramePipeline::begin_write");
+            packet = m_framePipeline.begin_write();
+        }
+        if (!packet)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "FramePipeline is stopped.");
+        }
+
+        // 2) フレーム定数を入れ、残りは呼び出し側に詰めてもらう
+        const auto now = std::chrono::steady_clock::now();
+        packet->constants.frameIndex = m_frameIndex++;
+        packet->constants.timeSeconds = std::chrono::duration<double>(now - m_startTime).count();
+        packet->constants.deltaSeconds = std::chrono::duration<float>(now - m_lastFrameTime).count();
+        m_lastFrameTime = now;
+        packet->camera = CameraData{};
+        packet->objects.clear();
+        if (m_extractFrame)
+        {
+            CUE_PROFILE_SCOPE("Engine::extract_frame");
+            m_extractFrame(m_world, *packet);
+        }
+        packet->publishedNs = Platform::get_input_timestamp();
+        m_framePipeline.end_write();
+
+        // 3) 直列ならこのスレッドで描画まで済ませる
+        if (m_framePipeline.get_depth() > 1)
+        {
+            return Core::Result::ok();
+        }
+        const FramePacket* frame = m_framePipeline.begin_read();
+        Core::Result r = Core::Result::ok();
+        if (m_renderFrame)
+        {
+            CUE_PROFILE_SCOPE("Engine::render_frame");
+            CUE_MEMORY_TAG(Core::Facility::Graphics);
+            r = m_renderFrame(*frame);
+        }
+        m_framePipeline.end_read();
+        return r;
+    }
+    void Engine::run_render_thread()
+    {
+#if CUE_PROFILE_ENABLED
+        Core::Profiler::set_thread_name("Render");
+#endif
+        Core::set_thread_memory_tag(Core::Facility::Graphics);
+        // 1) 停止を頼まれても公開済みの分は描き切る（begin_read が nullptr を返すまで）
+        while (const FramePacket* packet = m_framePipeline.begin_read())
+        {
+            if (m_renderFrame && m_renderResult.load(std::memory_order_relaxed))
+            {
+                CUE_PROFILE_SCOPE("Engine::render_frame");
+                const Core::Result r = m_renderFrame(*packet);
+                if (!r)
+                {
+                    // 2) 失敗は記録して次の tick で返す（背圧で生産者を止めないよう受け取りは続ける）
+                    m_logger.log(r);
+                    m_renderResult.store(r, std::memory_order_release);
+                }
+            }
+            m_framePipeline.end_read();
+        }
     }
     void Engine::shutdown()
     {
+        // 1) 描画スレッドに残りを描かせてから止め、システムが捕捉しているエンジンの参照を手放す
+        m_framePipeline.request_stop();
+        if (m_renderThread.joinable())
+        {
+            m_renderThread.join();
+        }
+        m_framePipeline.shutdown();
+        m_systemScheduler.clear();
+        m_world.reset();
+        m_extractFrame = nullptr;
+        m_renderFrame = nullptr;
+        m_jobSystem.shutdown();
+        m_frameArena.shutdown();
+        std::vector<Platform::InputEvent>().swap(m_frameInput);
+        std::vector<uint32_t>().swap(m_inputLatencyBuckets);
+        m_frameInputCount = 0;
+
+        // 2) 終了処理中の記録も残すため、ロガーは最後に止める
+        m_logger.shutdown();
+
+        // 3) エンジンが持つものを全て手放した後に、残っている分をリークとして書き出す
+        if (m_isMemoryReportEnabled)
+        {
+            (void)Core::write_memory_report(stderr, m_memoryBaseline);
+        }
     }
 } // namespace Cue
@@ -1,15 +1,59 @@
 #pragma once
 #include <Platform.h>
+#include <FrameArena.h>
 #include <GraphicsCore.h>
+#include <JobSystem.h>
+#include <Logger.h>
+#include <MemoryTracker.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "FramePipeline.h"
+#include "SystemScheduler.h"
+#include "World.h"
 
 namespace Cue
 {
+    /// @brief シミュレーションの後にワールドからフレームパケットを詰める（tick のスレッドで呼ぶ）
+    using FrameExtractFunction = std::function<void(Ecs::World&, FramePacket&)>;
+    /// @brief フレームパケットだけを見て描画を発行する（並走時は描画スレッドで呼ぶ）
+    using FrameRenderFunction = std::function<Core::Result(const FramePacket&)>;
+
     struct EngineInitInfo
     {
         // 初期化情報をここに追加
         Platform::IPlatform* platform = nullptr;
         Graphics::Backend* graphicsBackend = nullptr;
+        // ジョブシステムの実行スレッド数（0 でコア数）
+        uint32_t workerCount = 0;
+        // フレーム毎の一時確保に使うアリーナの設定
+        Core::FrameArenaDesc frameArena{};
+        // ログの出力設定
+        Core::LoggerDesc logger{};
+        // フレームパケットのリング（depth 1 で tick 内に直列、2〜3 で描画スレッドを立てて並走させる）
+        FramePipelineDesc framePipeline{ .depth = 1 };
+        FrameExtractFunction extractFrame;
+        FrameRenderFunction renderFrame;
+        // shutdown で initialize 以降に増えた確保をタグ毎に標準エラーへ書き出す（追跡が有効なビルドのみ）
+        bool isMemoryReportEnabled = true;
+    };
+
+    /// @brief 入力イベントが OS から届いてから、それを取り込むフレームが始まるまでの時間の集計
+    struct InputLatencyStats
+    {
+        uint64_t eventCount = 0;
+        // 入力リングが満杯で捨てられたイベント数
+        uint64_t droppedCount = 0;
+        double minUs = 0.0;
+        double avgUs = 0.0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
     };
 
     class Engine
@@ -17,11 +61,73 @@ namespace Cue
     public:
         Engine();
         ~Engine();
-        void initialize(EngineInitInfo& initInfo);
-        void tick();
+        [[nodiscard]] Core::Result initialize(EngineInitInfo& initInfo);
+        [[nodiscard]] Core::Result tick();
         void shutdown();
+
+        /// @brief フレーム処理を複数コアに分割するためのジョブシステム
+        [[nodiscard]] Core::JobSystem& get_job_system() noexcept { return m_jobSystem; }
+        /// @brief フレーム内だけ有効な一時確保用アリーナ（tick の先頭で巻き戻る）
+        [[nodiscard]] Core::FrameArena& get_frame_arena() noexcept { return m_frameArena; }
+        /// @brief Result を非同期に書き出すロガー
+        [[nodiscard]] Core::Logger& get_logger() noexcept { return m_logger; }
+        /// @brief エンティティとコンポーネントを保持する ECS のワールド
+        [[nodiscard]] Ecs::World& get_world() noexcept { return m_world; }
+        /// @brief tick 毎に実行される ECS システムの登録先
+        [[nodiscard]] Ecs::SystemScheduler& get_system_scheduler() noexcept { return m_systemScheduler; }
+        /// @brief このフレームの先頭で入力リングから取り出したイベント（古い順、次の tick まで有効）
+        [[nodiscard]] std::span<const Platform::InputEvent> get_frame_input() const noexcept
+        {
+            return { m_frameInput.data(), m_frameInputCount };
+        }
+
+        /// @brief 入力からフレーム開始までの遅延の集計
+        [[nodiscard]] InputLatencyStats get_input_latency_stats() const noexcept;
+        void reset_input_latency_stats() noexcept;
+
+        /// @brief シミュレーションと描画の受け渡しの集計（背圧で待った時間など）
+        [[nodiscard]] FramePipelineStats get_frame_pipeline_stats() const noexcept { return m_framePipeline.get_stats(); }
     private:
+        // 遅延ヒストグラムの 1 区間の幅と区間数（これを超える遅延は最後の区間に入る）
+        static constexpr uint32_t k_latencyBucketWidthUs = 10;
+        static constexpr uint32_t k_latencyBucketCount = 4096;
+
+        /// @brief 入力リングを 1 度だけ掃き出し、各イベントの遅延を積む
+        void drain_input() noexcept;
+        /// @brief パケットを詰めて公開する（直列なら続けて描画まで行う）
+        [[nodiscard]] Core::Result submit_frame();
+        /// @brief 描画スレッド本体：公開順にパケットを受け取って描画する
+        void run_render_thread();
+
         Platform::IPlatform* m_platform = nullptr;
         Graphics::Backend* m_graphicsBackend = nullptr;
+        Core::Logger m_logger;
+        Core::JobSystem m_jobSystem;
+        Core::FrameArena m_frameArena;
+        Ecs::World m_world;
+        Ecs::SystemScheduler m_systemScheduler;
+
+        FramePipeline m_framePipeline;
+        FrameExtractFunction m_extractFrame;
+        FrameRenderFunction m_renderFrame;
+        std::thread m_renderThread;
+        // 描画スレッドで最初に起きた失敗（次の tick で返す）
+        std::atomic<Core::Result> m_renderResult{};
+        uint64_t m_frameIndex = 0;
+        std::chrono::steady_clock::time_point m_startTime{};
+        std::chrono::steady_clock::time_point m_lastFrameTime{};
+
+        // 入力リングと同じ容量を initialize で確保する（毎フレームの確保は無い）
+        std::vector<Platform::InputEvent> m_frameInput;
+        uint32_t m_frameInputCount = 0;
+        std::vector<uint32_t> m_inputLatencyBuckets;
+        uint64_t m_inputEventCount = 0;
+        uint64_t m_inputLatencyTotalNs = 0;
+        uint64_t m_inputLatencyMinNs = UINT64_MAX;
+        uint64_t m_inputLatencyMaxNs = 0;
+
+        // リーク判定の基準（initialize の先頭の生存量）
+        Core::MemorySnapshot m_memoryBaseline{};
+        bool m_isMemoryReportEnabled = true;
     };
 } // namespace Cue
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+namespace Cue::Ecs
+{
+    /// @brief 世代付きエンティティ ID
+    /// @details 破棄されたスロットは再利用されるが、世代が変わるため古い ID は無効と判定できる。
+    struct Entity
+    {
+        static constexpr uint32_t k_invalidIndex = 0xFFFFFFFFu;
+
+        uint32_t index = k_invalidIndex;
+        uint32_t generation = 0;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept { return index != k_invalidIndex; }
+        [[nodiscard]] constexpr bool operator==(const Entity& other) const noexcept = default;
+    };
+} // namespace Cue::Ecs
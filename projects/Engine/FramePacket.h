@@ -0,0 +1,44 @@
+#pragma once
+#include <Math.h>
+#include <cstdint>
+#include <vector>
+
+namespace Cue
+{
+    /// @brief 描画対象 1 つ分
+    struct RenderObject
+    {
+        Math::Float4x4 world{};
+        uint32_t meshId = 0;
+        uint32_t materialId = 0;
+    };
+
+    /// @brief フレームのカメラ
+    struct CameraData
+    {
+        Math::Float4x4 view{};
+        Math::Float4x4 projection{};
+        Math::Float3 position{};
+    };
+
+    /// @brief フレーム毎の定数
+    struct FrameConstants
+    {
+        uint64_t frameIndex = 0;
+        // initialize からの経過時間と前フレームからの経過時間
+        double timeSeconds = 0.0;
+        float deltaSeconds = 0.0f;
+    };
+
+    /// @brief シミュレーションが書き、描画が読むだけのフレームの写し
+    /// @details 描画側はワールドに触れず、このパケットだけで 1 フレームを描けるようにする。
+    ///          パケットはリングで使い回すので、objects は容量を保ったまま毎フレーム詰め直す。
+    struct FramePacket
+    {
+        FrameConstants constants{};
+        CameraData camera{};
+        std::vector<RenderObject> objects;
+        // シミュレーションが書き終えた時刻（get_input_timestamp と同じ時計）
+        uint64_t publishedNs = 0;
+    };
+} // namespace Cue
@@ -0,0 +1,194 @@
+#include "FramePipeline.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace Cue
+{
+    struct FramePipeline::Impl
+    {
+        using Clock = std::chrono::steady_clock;
+
+        FramePacket packets[k_maxDepth];
+        uint32_t depth = 0;
+
+        // 書いた数・読み始めた数・返した数（パケットは番号 % depth）
+        uint64_t writeCount = 0;
+        uint64_t readCount = 0;
+        uint64_t releaseCount = 0;
+        bool isWriting = false;
+        bool isReading = false;
+        bool isStopping = false;
+
+        mutable std::mutex mutex;
+        std::condition_variable writable;
+        std::condition_variable readable;
+
+        uint64_t stallCount = 0;
+        Clock::duration stallTime{};
+        Clock::duration renderIdleTime{};
+    };
+
+    FramePipeline::FramePipeline()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    FramePipeline::~FramePipeline()
+    {
+    }
+    Core::Result FramePipeline::initialize(const FramePipelineDesc& desc)
+    {
+        if (m_impl->depth != 0)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "FramePipeline is already initialized.");
+        }
+        if (desc.depth == 0 || desc.depth > k_maxDepth)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidArg, Core::Severity::Error, desc.depth,
+                "FramePipeline depth must be 1 to 3.");
+        }
+
+        // 1) 描画対象の領域はここで確保し、以降は使い回す
+        for (uint32_t i = 0; i < desc.depth; ++i)
+        {
+            m_impl->packets[i] = FramePacket{};
+            m_impl->packets[i].objects.reserve(desc.objectCapacity);
+        }
+        m_impl->depth = desc.depth;
+        m_impl->writeCount = 0;
+        m_impl->readCount = 0;
+        m_impl->releaseCount = 0;
+        m_impl->isWriting = false;
+        m_impl->isReading = false;
+        m_impl->isStopping = false;
+        m_impl->stallCount = 0;
+        m_impl->stallTime = {};
+        m_impl->renderIdleTime = {};
+        return Core::Result::ok();
+    }
+    void FramePipeline::shutdown()
+    {
+        request_stop();
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        for (FramePacket& packet : m_impl->packets)
+        {
+            packet = FramePacket{};
+        }
+        m_impl->depth = 0;
+    }
+    FramePacket* FramePipeline::begin_write()
+    {
+        Impl& impl = *m_impl;
+        std::unique_lock<std::mutex> lock(impl.mutex);
+        if (impl.depth == 0)
+        {
+            return nullptr;
+        }
+
+        // 1) 全パケットが描画側にあれば 1 つ返るまで待つ（背圧）
+        if (impl.writeCount - impl.releaseCount >= impl.depth && !impl.isStopping)
+        {
+            const Impl::Clock::time_point begin = Impl::Clock::now();
+            impl.writable.wait(lock, [&impl]()
+                {
+                    return impl.writeCount - impl.releaseCount < impl.depth || impl.isStopping;
+                });
+            ++impl.stallCount;
+            impl.stallTime += Impl::Clock::now() - begin;
+        }
+        if (impl.isStopping)
+        {
+            return nullptr;
+        }
+        impl.isWriting = true;
+        return &impl.packets[impl.writeCount % impl.depth];
+    }
+    void FramePipeline::end_write()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_impl->mutex);
+            if (!m_impl->isWriting)
+            {
+                return;
+            }
+            m_impl->isWriting = false;
+            ++m_impl->writeCount;
+        }
+        m_impl->readable.notify_one();
+    }
+    const FramePacket* FramePipeline::begin_read()
+    {
+        Impl& impl = *m_impl;
+        std::unique_lock<std::mutex> lock(impl.mutex);
+        if (impl.depth == 0)
+        {
+            return nullptr;
+        }
+
+        // 1) 公開済みのパケットが無ければ届くまで待つ
+        if (impl.readCount == impl.writeCount && !impl.isStopping)
+        {
+            const Impl::Clock::time_point begin = Impl::Clock::now();
+            impl.readable.wait(lock, [&impl]()
+                {
+                    return impl.readCount != impl.writeCount || impl.isStopping;
+                });
+            impl.renderIdleTime += Impl::Clock::now() - begin;
+        }
+        if (impl.readCount == impl.writeCount)
+        {
+            return nullptr;
+        }
+        impl.isReading = true;
+        return &impl.packets[impl.readCount++ % impl.depth];
+    }
+    void FramePipeline::end_read()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_impl->mutex);
+            if (!m_impl->isReading)
+            {
+                return;
+            }
+            m_impl->isReading = false;
+            ++m_impl->releaseCount;
+        }
+        // 背圧で待つ生産者と wait_idle の両方を起こす
+        m_impl->writable.notify_all();
+    }
+    void FramePipeline::wait_idle()
+    {
+        Impl& impl = *m_impl;
+        std::unique_lock<std::mutex> lock(impl.mutex);
+        impl.writable.wait(lock, [&impl]()
+            {
+                return impl.releaseCount == impl.writeCount || impl.isStopping;
+            });
+    }
+    void FramePipeline::request_stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_impl->mutex);
+            m_impl->isStopping = true;
+        }
+        m_impl->writable.notify_all();
+        m_impl->readable.notify_all();
+    }
+    uint32_t FramePipeline::get_depth() const noexcept
+    {
+        return m_impl->depth;
+    }
+    FramePipelineStats FramePipeline::get_stats() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        FramePipelineStats stats{};
+        stats.producedCount = m_impl->writeCount;
+        stats.consumedCount = m_impl->releaseCount;
+        stats.stallCount = m_impl->stallCount;
+        stats.stallMs = std::chrono::duration<double, std::milli>(m_impl->stallTime).count();
+        stats.renderIdleMs = std::chrono::duration<double, std::milli>(m_impl->renderIdleTime).count();
+        return stats;
+    }
+} // namespace Cue
@@ -0,0 +1,67 @@
+#pragma once
+#include <Result.h>
+#include <cstdint>
+#include <memory>
+
+#include "FramePacket.h"
+
+namespace Cue
+{
+    /// @brief FramePipeline の初期化情報
+    struct FramePipelineDesc
+    {
+        // パケット数（1 で直列、2〜3 で描画が 1〜2 フレーム遅れて並走する）
+        uint32_t depth = 2;
+        // パケット毎に先に確保しておく描画対象の数
+        uint32_t objectCapacity = 1024;
+    };
+
+    /// @brief パイプラインの集計
+    struct FramePipelineStats
+    {
+        uint64_t producedCount = 0;
+        uint64_t consumedCount = 0;
+        // 描画が追いつかず、シミュレーションが空きを待ったフレーム数と合計時間
+        uint64_t stallCount = 0;
+        double stallMs = 0.0;
+        // 描画がパケットの到着を待った合計時間
+        double renderIdleMs = 0.0;
+    };
+
+    /// @brief シミュレーション（生産者 1 つ）から描画（消費者 1 つ）へフレームパケットを渡すリング
+    /// @details 生産者は begin_write で空きパケットを取り、end_write で公開する。空きが無ければ
+    ///          描画が 1 つ返すまで待つ（背圧）ので、シミュレーションが depth - 1 フレームより先へは進まない。
+    ///          消費者は公開順に begin_read で受け取り、end_read で返す。
+    class FramePipeline final
+    {
+    public:
+        static constexpr uint32_t k_maxDepth = 3;
+
+        FramePipeline();
+        ~FramePipeline();
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+
+        [[nodiscard]] Core::Result initialize(const FramePipelineDesc& desc);
+        void shutdown();
+
+        /// @brief 生産者側：空きパケットを取る（空くまで待つ。停止後は nullptr）
+        [[nodiscard]] FramePacket* begin_write();
+        /// @brief 生産者側：begin_write で取ったパケットを公開する
+        void end_write();
+        /// @brief 消費者側：次に公開されたパケットを取る（届くまで待つ。停止後で残りが無ければ nullptr）
+        [[nodiscard]] const FramePacket* begin_read();
+        /// @brief 消費者側：begin_read で取ったパケットを返す
+        void end_read();
+        /// @brief 公開済みのパケットを全て描画が返すまで待つ
+        void wait_idle();
+        /// @brief 待っている生産者・消費者を起こして終わらせる（公開済みの分は読める）
+        void request_stop();
+
+        [[nodiscard]] uint32_t get_depth() const noexcept;
+        [[nodiscard]] FramePipelineStats get_stats() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue
@@ -0,0 +1,156 @@
+#pragma once
+#include <JobSystem.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Component.h"
+#include "World.h"
+
+namespace Cue::Ecs
+{
+    /// @brief 指定したコンポーネントを全て持つエンティティを走査するクエリ
+    /// @details 該当するアーキタイプの一覧をキャッシュし、World にアーキタイプが増えた分だけ調べ直す。
+    ///          const 修飾した型は読み取り専用として渡される。
+    template<typename... Ts>
+    class Query final
+    {
+    public:
+        Query()
+            : m_all(make_mask<Ts...>())
+        {
+        }
+
+        /// @brief 指定したコンポーネントを持つエンティティを除外する
+        template<typename... Us>
+        Query& exclude()
+        {
+            m_none |= make_mask<Us...>();
+            m_archetypes.clear();
+            m_seenArchetypes = 0;
+            return *this;
+        }
+
+        /// @brief チャンク単位で走査する（body(count, const Entity*, Ts*...)）
+        template<typename F>
+        void for_each_chunk(World& world, F&& body)
+        {
+            update(world);
+            for (uint32_t archetypeIndex : m_archetypes)
+            {
+                Archetype& archetype = world.get_archetype(archetypeIndex);
+                for (size_t c = 0; c < archetype.get_chunk_count(); ++c)
+                {
+                    const Chunk& chunk = archetype.get_chunk(c);
+                    body(static_cast<size_t>(chunk.count), archetype.get_entities(chunk),
+                        archetype.template get_column<Ts>(chunk)...);
+                }
+            }
+        }
+
+        /// @brief エンティティ単位で走査する（body(Ts&...)）
+        template<typename F>
+        void for_each(World& world, F&& body)
+        {
+            for_each_chunk(world, [&body](size_t count, const Entity*, Ts*... columns)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    body(columns[i]...);
+                }
+            });
+        }
+
+        /// @brief チャンクをジョブに分配して並列に走査する（body は複数スレッドから同時に呼ばれる）
+        template<typename F>
+        void parallel_for_each_chunk(World& world, Core::JobSystem& jobSystem, F&& body)
+        {
+            // 1) 走査対象のチャンクを平らな一覧にする（一覧の領域は次回に再利用する）
+            update(world);
+            m_chunks.clear();
+            for (uint32_t archetypeIndex : m_archetypes)
+            {
+                Archetype& archetype = world.get_archetype(archetypeIndex);
+                for (size_t c = 0; c < archetype.get_chunk_count(); ++c)
+                {
+                    m_chunks.push_back(ChunkRef{ &archetype, &archetype.get_chunk(c) });
+                }
+            }
+
+            // 2) チャンク 1 つを分割単位としてジョブに流す
+            jobSystem.parallel_for(static_cast<uint32_t>(m_chunks.size()), 1,
+                [this, &body](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    const Archetype& archetype = *m_chunks[i].archetype;
+                    const Chunk& chunk = *m_chunks[i].chunk;
+                    body(static_cast<size_t>(chunk.count), archetype.get_entities(chunk),
+                        archetype.template get_column<Ts>(chunk)...);
+                }
+            });
+        }
+
+        /// @brief 並列にエンティティ単位で走査する（body(Ts&...)）
+        template<typename F>
+        void parallel_for_each(World& world, Core::JobSystem& jobSystem, F&& body)
+        {
+            parallel_for_each_chunk(world, jobSystem, [&body](size_t count, const Entity*, Ts*... columns)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    body(columns[i]...);
+                }
+            });
+        }
+
+        /// @brief 該当するエンティティ数
+        [[nodiscard]] size_t count(World& world)
+        {
+            update(world);
+            size_t total = 0;
+            for (uint32_t archetypeIndex : m_archetypes)
+            {
+                total += world.get_archetype(archetypeIndex).get_entity_count();
+            }
+            return total;
+        }
+
+        /// @brief 読み取るコンポーネント（SystemDesc の宣言に使う）
+        [[nodiscard]] static ComponentMask get_read_mask() noexcept { return make_mask<Ts...>(); }
+        /// @brief 書き込むコンポーネント（const でない型）
+        [[nodiscard]] static ComponentMask get_write_mask() noexcept
+        {
+            ComponentMask mask;
+            ((std::is_const_v<Ts> ? void() : void(mask.set(component_id<std::remove_const_t<Ts>>()))), ...);
+            return mask;
+        }
+    private:
+        struct ChunkRef
+        {
+            const Archetype* archetype;
+            const Chunk* chunk;
+        };
+
+        void update(World& world)
+        {
+            // 1) 前回以降に作られたアーキタイプだけを調べる
+            const size_t archetypeCount = world.get_archetype_count();
+            for (; m_seenArchetypes < archetypeCount; ++m_seenArchetypes)
+            {
+                const ComponentMask& mask = world.get_archetype(m_seenArchetypes).get_mask();
+                if ((mask & m_all) == m_all && (mask & m_none).none())
+                {
+                    m_archetypes.push_back(static_cast<uint32_t>(m_seenArchetypes));
+                }
+            }
+        }
+
+        ComponentMask m_all;
+        ComponentMask m_none;
+        std::vector<uint32_t> m_archetypes;
+        size_t m_seenArchetypes = 0;
+        std::vector<ChunkRef> m_chunks;
+    };
+} // namespace Cue::Ecs
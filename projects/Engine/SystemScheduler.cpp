@@ -0,0 +1,127 @@
+#include "SystemScheduler.h"
+
+#include <Profiler.h>
+#include <algorithm>
+#include <utility>
+
+namespace Cue::Ecs
+{
+    namespace
+    {
+        // どちらかが書くコンポーネントを、もう一方が読むか書くなら同時に走らせられない
+        bool is_conflicting(const SystemDesc& a, const SystemDesc& b) noexcept
+        {
+            return (a.writes & (b.reads | b.writes)).any() || (b.writes & (a.reads | a.writes)).any();
+        }
+    } // namespace
+
+    SystemScheduler::SystemScheduler()
+    {
+    }
+
+    SystemScheduler::~SystemScheduler()
+    {
+    }
+
+    void SystemScheduler::add_system(SystemDesc desc)
+    {
+        SystemEntry entry{};
+        entry.desc = std::move(desc);
+        m_systems.push_back(std::move(entry));
+        m_isDirty = true;
+    }
+
+    void SystemScheduler::clear() noexcept
+    {
+        // 1) 領域ごと手放す（エンジン停止後のリーク判定に残さない）
+        std::vector<SystemEntry>().swap(m_systems);
+        std::vector<std::vector<uint32_t>>().swap(m_phases);
+        std::vector<SystemJob>().swap(m_jobs);
+        std::vector<Core::JobDecl>().swap(m_decls);
+        m_isDirty = false;
+    }
+
+    size_t SystemScheduler::get_phase_count()
+    {
+        if (m_isDirty)
+        {
+            build_phases();
+        }
+        return m_phases.size();
+    }
+
+    void SystemScheduler::run(World& world, Core::JobSystem& jobSystem)
+    {
+        CUE_PROFILE_SCOPE("SystemScheduler::run");
+        if (m_isDirty)
+        {
+            build_phases();
+        }
+
+        // 1) フェーズ毎に、含まれるシステムを全てジョブとして流して待つ
+        for (const std::vector<uint32_t>& phase : m_phases)
+        {
+            m_jobs.clear();
+            m_decls.clear();
+            for (uint32_t index : phase)
+            {
+                m_jobs.push_back(SystemJob{ &m_systems[index], &world, &jobSystem });
+            }
+            if (m_jobs.size() == 1)
+            {
+                // 1 つだけなら投入せずにこのスレッドで実行する
+                execute_system(&m_jobs[0]);
+                continue;
+            }
+            for (SystemJob& job : m_jobs)
+            {
+                m_decls.push_back(Core::JobDecl{ &SystemScheduler::execute_system, &job });
+            }
+            Core::JobCounter counter;
+            jobSystem.run(m_decls.data(), static_cast<uint32_t>(m_decls.size()), &counter);
+            jobSystem.wait(counter);
+        }
+
+        // 2) 構造変更は全システムの後で登録順に適用する（実行スレッドに依らず結果が決まる）
+        CUE_PROFILE_SCOPE("SystemScheduler::apply_commands");
+        for (SystemEntry& entry : m_systems)
+        {
+            if (!entry.commands.is_empty())
+            {
+                world.execute(entry.commands);
+            }
+        }
+    }
+
+    void SystemScheduler::execute_system(void* data)
+    {
+        SystemJob& job = *static_cast<SystemJob*>(data);
+        CUE_PROFILE_SCOPE(job.entry->desc.name);
+        SystemContext context{ *job.world, job.entry->commands, *job.jobSystem };
+        job.entry->desc.function(context);
+    }
+
+    void SystemScheduler::build_phases()
+    {
+        // 1) 自分より前に登録された衝突相手の、最も遅いフェーズの次に置く
+        m_phases.clear();
+        for (size_t i = 0; i < m_systems.size(); ++i)
+        {
+            uint32_t phase = 0;
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (is_conflicting(m_systems[i].desc, m_systems[j].desc))
+                {
+                    phase = std::max(phase, m_systems[j].phase + 1);
+                }
+            }
+            m_systems[i].phase = phase;
+            if (m_phases.size() <= phase)
+            {
+                m_phases.resize(phase + 1);
+            }
+            m_phases[phase].push_back(static_cast<uint32_t>(i));
+        }
+        m_isDirty = false;
+    }
+} // namespace Cue::Ecs
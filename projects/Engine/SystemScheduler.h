@@ -0,0 +1,78 @@
+#pragma once
+#include <JobSystem.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "Component.h"
+#include "World.h"
+
+namespace Cue::Ecs
+{
+    /// @brief システムの実行時に渡される情報
+    struct SystemContext
+    {
+        World& world;
+        // 構造変更はここへ記録する（全フェーズの後で登録順に適用される）
+        CommandBuffer& commands;
+        Core::JobSystem& jobSystem;
+    };
+
+    using SystemFunction = std::function<void(SystemContext&)>;
+
+    /// @brief システムの登録情報
+    /// @details reads / writes の宣言が実行順を決める。宣言に無いコンポーネントへ触れてはならない。
+    struct SystemDesc
+    {
+        const char* name = "";
+        ComponentMask reads;
+        ComponentMask writes;
+        SystemFunction function;
+    };
+
+    /// @brief 読み書きが衝突しないシステムを同じフェーズにまとめ、ジョブシステムで並列に実行する
+    /// @details 衝突するシステム同士は登録順を保つ。システムの中でワールドを構造変更してはならない。
+    class SystemScheduler final
+    {
+    public:
+        SystemScheduler();
+        ~SystemScheduler();
+
+        void add_system(SystemDesc desc);
+        /// @brief 登録を全て外し、領域も手放す
+        void clear() noexcept;
+
+        /// @brief 全システムを実行し、記録されたコマンドを登録順に適用する
+        void run(World& world, Core::JobSystem& jobSystem);
+
+        [[nodiscard]] size_t get_system_count() const noexcept { return m_systems.size(); }
+        /// @brief フェーズ数（次の run で組み直す場合は組み直し後の値）
+        [[nodiscard]] size_t get_phase_count();
+    private:
+        struct SystemEntry
+        {
+            SystemDesc desc;
+            CommandBuffer commands;
+            uint32_t phase = 0;
+        };
+
+        struct SystemJob
+        {
+            SystemEntry* entry;
+            World* world;
+            Core::JobSystem* jobSystem;
+        };
+
+        static void execute_system(void* data);
+        void build_phases();
+
+        std::vector<SystemEntry> m_systems;
+        // フェーズ毎のシステム番号（登録順）
+        std::vector<std::vector<uint32_t>> m_phases;
+        std::vector<SystemJob> m_jobs;
+        std::vector<Core::JobDecl> m_decls;
+        bool m_isDirty = false;
+    };
+} // namespace Cue::Ecs
@@ -0,0 +1,249 @@
+#include "World.h"
+
+#include <cstring>
+
+namespace Cue::Ecs
+{
+    World::World()
+    {
+        // 1) コンポーネントを持たないエンティティ用のアーキタイプを 0 番に置く
+        get_or_create_archetype(ComponentMask{});
+    }
+
+    World::~World()
+    {
+    }
+
+    void World::reset()
+    {
+        // 1) 容量ごと手放す（clear では領域が残り、終了時のリーク判定に出てしまう）
+        std::vector<EntityRecord>().swap(m_records);
+        std::vector<uint32_t>().swap(m_freeIndices);
+        m_aliveCount = 0;
+        std::vector<std::unique_ptr<Archetype>>().swap(m_archetypes);
+        m_archetypeLookup = Core::FlatHashMap<ComponentMask, uint32_t>();
+        m_commands = CommandBuffer();
+        std::vector<Entity>().swap(m_pendingEntities);
+
+        // 2) コンストラクタと同じく空のアーキタイプを 0 番に置き直す
+        get_or_create_archetype(ComponentMask{});
+    }
+
+    Entity World::create_entity()
+    {
+        return create_entity_with_mask(ComponentMask{});
+    }
+
+    Entity World::create_entity_with_mask(const ComponentMask& mask)
+    {
+        // 1) 空きスロットを再利用する（世代は破棄時に進めてある）
+        uint32_t index = 0;
+        if (!m_freeIndices.empty())
+        {
+            index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_records.size());
+            m_records.push_back(EntityRecord{});
+        }
+
+        // 2) アーキタイプに行を確保する（コンポーネントの値は呼び出し側が書き込む）
+        EntityRecord& record = m_records[index];
+        const Entity entity{ index, record.generation };
+        record.archetype = get_or_create_archetype(mask);
+        m_archetypes[record.archetype]->push_row(entity, record.chunk, record.row);
+        ++m_aliveCount;
+        return entity;
+    }
+
+    bool World::destroy_entity(Entity entity)
+    {
+        if (!is_alive(entity))
+        {
+            return false;
+        }
+
+        // 1) 行を取り除き、スロットの世代を進めて古い ID を無効にする
+        EntityRecord& record = m_records[entity.index];
+        remove_from_archetype(record);
+        record.archetype = Archetype::k_invalidArchetype;
+        ++record.generation;
+        if (record.generation == CommandBuffer::k_pendingGeneration)
+        {
+            // 仮 ID と区別できなくなるため、その世代は飛ばす
+            record.generation = 0;
+        }
+        m_freeIndices.push_back(entity.index);
+        --m_aliveCount;
+        return true;
+    }
+
+    bool World::is_alive(Entity entity) const noexcept
+    {
+        return entity.index < m_records.size()
+            && m_records[entity.index].generation == entity.generation
+            && m_records[entity.index].archetype != Archetype::k_invalidArchetype;
+    }
+
+    bool World::add_component(Entity entity, ComponentId id, const void* data)
+    {
+        if (!is_alive(entity) || id >= k_maxComponents)
+        {
+            return false;
+        }
+
+        // 1) 持っていなければ、辺のキャッシュを引いて移動先のアーキタイプへ移す
+        const uint32_t srcIndex = m_records[entity.index].archetype;
+        if (!m_archetypes[srcIndex]->has_component(id))
+        {
+            uint32_t dstIndex = m_archetypes[srcIndex]->m_addEdges[id];
+            if (dstIndex == Archetype::k_invalidArchetype)
+            {
+                ComponentMask mask = m_archetypes[srcIndex]->get_mask();
+                mask.set(id);
+                dstIndex = get_or_create_archetype(mask);
+                m_archetypes[srcIndex]->m_addEdges[id] = dstIndex;
+            }
+            move_entity(entity, dstIndex);
+        }
+
+        // 2) 値を書き込む
+        std::memcpy(get_component(entity, id), data, get_component_info(id).size);
+        return true;
+    }
+
+    bool World::remove_component(Entity entity, ComponentId id)
+    {
+        if (!is_alive(entity) || id >= k_maxComponents)
+        {
+            return false;
+        }
+        const uint32_t srcIndex = m_records[entity.index].archetype;
+        if (!m_archetypes[srcIndex]->has_component(id))
+        {
+            return false;
+        }
+
+        // 1) 辺のキャッシュを引いて移動先のアーキタイプへ移す
+        uint32_t dstIndex = m_archetypes[srcIndex]->m_removeEdges[id];
+        if (dstIndex == Archetype::k_invalidArchetype)
+        {
+            ComponentMask mask = m_archetypes[srcIndex]->get_mask();
+            mask.reset(id);
+            dstIndex = get_or_create_archetype(mask);
+            m_archetypes[srcIndex]->m_removeEdges[id] = dstIndex;
+        }
+        move_entity(entity, dstIndex);
+        return true;
+    }
+
+    void* World::get_component(Entity entity, ComponentId id) noexcept
+    {
+        if (!is_alive(entity))
+        {
+            return nullptr;
+        }
+        const EntityRecord& record = m_records[entity.index];
+        const Archetype& archetype = *m_archetypes[record.archetype];
+        std::byte* column = static_cast<std::byte*>(archetype.get_column(archetype.get_chunk(record.chunk), id));
+        if (!column)
+        {
+            return nullptr;
+        }
+        return column + static_cast<size_t>(record.row) * get_component_info(id).size;
+    }
+
+    void World::flush_commands()
+    {
+        execute(m_commands);
+    }
+
+    void World::execute(CommandBuffer& commands)
+    {
+        // 1) 仮 ID の読み替え表を用意する
+        m_pendingEntities.assign(commands.m_pendingCount, Entity{});
+        const auto resolve = [this](Entity entity) noexcept
+        {
+            if (entity.generation == CommandBuffer::k_pendingGeneration)
+            {
+                return entity.index < m_pendingEntities.size() ? m_pendingEntities[entity.index] : Entity{};
+            }
+            return entity;
+        };
+
+        // 2) 記録順に適用する（既に無効なエンティティへのコマンドは無視する）
+        const std::byte* cursor = commands.m_data.data();
+        const std::byte* end = cursor + commands.m_data.size();
+        while (cursor < end)
+        {
+            CommandBuffer::CommandHeader header{};
+            std::memcpy(&header, cursor, sizeof(header));
+            const std::byte* payload = cursor + sizeof(header);
+            cursor = payload + header.payloadSize;
+
+            switch (header.type)
+            {
+            case CommandBuffer::CommandType::CreateEntity:
+                m_pendingEntities[header.entity.index] = create_entity();
+                break;
+            case CommandBuffer::CommandType::DestroyEntity:
+                destroy_entity(resolve(header.entity));
+                break;
+            case CommandBuffer::CommandType::AddComponent:
+                add_component(resolve(header.entity), header.component, payload);
+                break;
+            case CommandBuffer::CommandType::RemoveComponent:
+                remove_component(resolve(header.entity), header.component);
+                break;
+            }
+        }
+        commands.clear();
+    }
+
+    uint32_t World::get_or_create_archetype(const ComponentMask& mask)
+    {
+        if (const uint32_t* found = m_archetypeLookup.find(mask))
+        {
+            return *found;
+        }
+
+        // 1) 新しいアーキタイプは末尾に足す（クエリは増えた分だけを調べ直す）
+        const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+        m_archetypes.push_back(std::make_unique<Archetype>(mask));
+        m_archetypeLookup.try_emplace(mask, index);
+        return index;
+    }
+
+    void World::move_entity(Entity entity, uint32_t dstIndex)
+    {
+        EntityRecord& record = m_records[entity.index];
+        Archetype& src = *m_archetypes[record.archetype];
+        Archetype& dst = *m_archetypes[dstIndex];
+
+        // 1) 移動先に行を確保し、共通のコンポーネントをコピーする
+        uint32_t dstChunk = 0;
+        uint32_t dstRow = 0;
+        dst.push_row(entity, dstChunk, dstRow);
+        dst.copy_shared_components(src, record.chunk, record.row, dstChunk, dstRow);
+
+        // 2) 移動元から取り除き、記録を付け替える
+        remove_from_archetype(record);
+        record.archetype = dstIndex;
+        record.chunk = dstChunk;
+        record.row = dstRow;
+    }
+
+    void World::remove_from_archetype(const EntityRecord& record) noexcept
+    {
+        // 1) 穴を埋めるために移動してきたエンティティの位置を更新する
+        const Entity moved = m_archetypes[record.archetype]->remove_row(record.chunk, record.row);
+        if (moved.is_valid())
+        {
+            EntityRecord& movedRecord = m_records[moved.index];
+            movedRecord.chunk = record.chunk;
+            movedRecord.row = record.row;
+        }
+    }
+} // namespace Cue::Ecs
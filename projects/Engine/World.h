@@ -0,0 +1,107 @@
+#pragma once
+#include <FlatHashMap.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Archetype.h"
+#include "CommandBuffer.h"
+#include "Component.h"
+#include "Entity.h"
+
+namespace Cue::Ecs
+{
+    /// @brief エンティティとアーキタイプを保持する ECS のワールド
+    /// @details 構造変更はメインスレッドからだけ行う。走査中・並列実行中の変更は CommandBuffer を使う。
+    class World final
+    {
+    public:
+        World();
+        ~World();
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        /// @brief コンポーネントを持たないエンティティを作る
+        [[nodiscard]] Entity create_entity();
+        /// @brief 指定したコンポーネントを持つエンティティを作る（アーキタイプの移動を伴わない）
+        template<typename... Ts>
+        [[nodiscard]] Entity create_entity(const Ts&... components);
+        /// @brief エンティティを破棄する（既に無効なら false）
+        bool destroy_entity(Entity entity);
+        [[nodiscard]] bool is_alive(Entity entity) const noexcept;
+
+        /// @brief コンポーネントを追加する（既にあれば上書き、エンティティが無効なら false）
+        bool add_component(Entity entity, ComponentId id, const void* data);
+        template<typename T>
+        bool add_component(Entity entity, const T& value)
+        {
+            return add_component(entity, component_id<T>(), &value);
+        }
+        /// @brief コンポーネントを削除する（持っていなければ false）
+        bool remove_component(Entity entity, ComponentId id);
+        template<typename T>
+        bool remove_component(Entity entity)
+        {
+            return remove_component(entity, component_id<T>());
+        }
+        /// @brief コンポーネントへのポインタ（持っていなければ nullptr、構造変更で無効になる）
+        [[nodiscard]] void* get_component(Entity entity, ComponentId id) noexcept;
+        template<typename T>
+        [[nodiscard]] T* get_component(Entity entity) noexcept
+        {
+            return static_cast<T*>(get_component(entity, component_id<T>()));
+        }
+        template<typename T>
+        [[nodiscard]] bool has_component(Entity entity) const noexcept
+        {
+            const ComponentId id = component_id<T>();
+            return is_alive(entity) && m_archetypes[m_records[entity.index].archetype]->has_component(id);
+        }
+
+        /// @brief メインスレッド用の遅延コマンド（flush_commands で適用される）
+        [[nodiscard]] CommandBuffer& get_command_buffer() noexcept { return m_commands; }
+        /// @brief メインスレッド用の遅延コマンドを適用する
+        void flush_commands();
+        /// @brief 任意のコマンドバッファを記録順に適用して空にする
+        void execute(CommandBuffer& commands);
+
+        /// @brief 全てのエンティティとアーキタイプを破棄し、領域も手放して作った直後の状態に戻す
+        void reset();
+
+        [[nodiscard]] size_t get_entity_count() const noexcept { return m_aliveCount; }
+        /// @brief 作成済みのアーキタイプ数（増える一方なのでクエリの差分更新に使える）
+        [[nodiscard]] size_t get_archetype_count() const noexcept { return m_archetypes.size(); }
+        [[nodiscard]] Archetype& get_archetype(size_t index) noexcept { return *m_archetypes[index]; }
+    private:
+        struct EntityRecord
+        {
+            uint32_t archetype = Archetype::k_invalidArchetype;
+            uint32_t chunk = 0;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        Entity create_entity_with_mask(const ComponentMask& mask);
+        uint32_t get_or_create_archetype(const ComponentMask& mask);
+        void move_entity(Entity entity, uint32_t dstArchetype);
+        void remove_from_archetype(const EntityRecord& record) noexcept;
+
+        std::vector<EntityRecord> m_records;
+        std::vector<uint32_t> m_freeIndices;
+        size_t m_aliveCount = 0;
+        std::vector<std::unique_ptr<Archetype>> m_archetypes;
+        Core::FlatHashMap<ComponentMask, uint32_t> m_archetypeLookup;
+        CommandBuffer m_commands;
+        // execute で仮 ID を実 ID に読み替えるための表
+        std::vector<Entity> m_pendingEntities;
+    };
+
+    template<typename... Ts>
+    Entity World::create_entity(const Ts&... components)
+    {
+        const Entity entity = create_entity_with_mask(make_mask<Ts...>());
+        (add_component(entity, components), ...);
+        return entity;
+    }
+} // namespace Cue::Ecs
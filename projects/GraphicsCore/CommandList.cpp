@@ -0,0 +1,194 @@
+#include "CommandList.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Cue::Graphics
+{
+    namespace
+    {
+        static_assert(sizeof(CommandHeader) == 4, "CommandHeader must stay 4 bytes.");
+
+        constexpr size_t align4(size_t value) noexcept
+        {
+            return (value + 3) & ~static_cast<size_t>(3);
+        }
+    } // namespace
+
+    CommandList::CommandList()
+    {
+    }
+
+    CommandList::~CommandList()
+    {
+        shutdown();
+    }
+
+    Core::Result CommandList::initialize(size_t capacityBytes)
+    {
+        if (m_data)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "CommandList is already initialized.");
+        }
+        if (capacityBytes == 0)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "CommandList capacity must not be zero.");
+        }
+        m_data.reset(new (std::nothrow) std::byte[capacityBytes]);
+        if (!m_data)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::OutOfMemory, Core::Severity::Error, 0,
+                "CommandList failed to allocate its buffer.");
+        }
+        m_capacity = capacityBytes;
+        m_size = 0;
+        return Core::Result::ok();
+    }
+
+    void CommandList::shutdown()
+    {
+        m_data.reset();
+        m_capacity = 0;
+        m_size = 0;
+        m_commandCount = 0;
+    }
+
+    void CommandList::begin(uint64_t sortKey) noexcept
+    {
+        m_sortKey = sortKey;
+        m_size = 0;
+        m_commandCount = 0;
+        m_isOverflowed = false;
+    }
+
+    Core::Result CommandList::close() noexcept
+    {
+        if (m_isOverflowed)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::OutOfMemory, Core::Severity::Error, 0,
+                "CommandList ran out of space while recording.");
+        }
+        return Core::Result::ok();
+    }
+
+    template<typename T>
+    void CommandList::push(CommandType type, const T& payload, std::span<const uint32_t> extra) noexcept
+    {
+        // 1) 入り切らなければ捨てて close で知らせる
+        const size_t payloadBytes = align4(sizeof(T)) + extra.size_bytes();
+        const size_t total = sizeof(CommandHeader) + payloadBytes;
+        if (m_isOverflowed || m_size + total > m_capacity)
+        {
+            m_isOverflowed = true;
+            return;
+        }
+
+        // 2) ヘッダ・固定部・可変部の順に詰める
+        std::byte* cursor = m_data.get() + m_size;
+        const CommandHeader header{ type, static_cast<uint16_t>(payloadBytes / 4) };
+        std::memcpy(cursor, &header, sizeof(header));
+        std::memcpy(cursor + sizeof(header), &payload, sizeof(T));
+        if (!extra.empty())
+        {
+            std::memcpy(cursor + sizeof(header) + align4(sizeof(T)), extra.data(), extra.size_bytes());
+        }
+        m_size += total;
+        ++m_commandCount;
+    }
+
+    void CommandList::set_pipeline(uint32_t pipeline) noexcept
+    {
+        push(CommandType::SetPipeline, SetPipelineCommand{ pipeline });
+    }
+
+    void CommandList::set_vertex_buffer(uint32_t slot, uint32_t buffer, uint32_t offset, uint32_t stride) noexcept
+    {
+        push(CommandType::SetVertexBuffer, SetVertexBufferCommand{ slot, buffer, offset, stride });
+    }
+
+    void CommandList::set_index_buffer(uint32_t buffer, uint32_t offset, uint32_t indexSize) noexcept
+    {
+        push(CommandType::SetIndexBuffer, SetIndexBufferCommand{ buffer, offset, indexSize });
+    }
+
+    void CommandList::set_constants(uint32_t rootIndex, std::span<const uint32_t> values) noexcept
+    {
+        if (values.size() > k_maxConstants)
+        {
+            m_isOverflowed = true;
+            return;
+        }
+        push(CommandType::SetConstants, SetConstantsCommand{ rootIndex, static_cast<uint32_t>(values.size()) }, values);
+    }
+
+    void CommandList::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+        uint32_t firstInstance) noexcept
+    {
+        push(CommandType::Draw, DrawCommand{ vertexCount, instanceCount, firstVertex, firstInstance });
+    }
+
+    void CommandList::draw_indexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+        int32_t vertexOffset, uint32_t firstInstance) noexcept
+    {
+        push(CommandType::DrawIndexed,
+            DrawIndexedCommand{ indexCount, instanceCount, firstIndex, vertexOffset, firstInstance });
+    }
+
+    void CommandList::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) noexcept
+    {
+        push(CommandType::Dispatch, DispatchCommand{ groupCountX, groupCountY, groupCountZ });
+    }
+
+    void CommandList::barrier(const Barrier& barrier) noexcept
+    {
+        push(CommandType::Barrier, BarrierCommand{ barrier });
+    }
+
+    void CommandList::copy_buffer(uint32_t dst, uint64_t dstOffset, uint32_t src, uint64_t srcOffset,
+        uint64_t size) noexcept
+    {
+        push(CommandType::CopyBuffer, CopyBufferCommand{ dst, src, dstOffset, srcOffset, size });
+    }
+
+    std::span<const std::byte> CommandList::get_data() const noexcept
+    {
+        return std::span<const std::byte>(m_data.get(), m_size);
+    }
+
+    bool CommandReader::next(CommandHeader& outHeader, const std::byte*& outPayload) noexcept
+    {
+        if (m_isCorrupted || m_offset >= m_data.size())
+        {
+            return false;
+        }
+
+        // 1) ヘッダとペイロードが列の中に収まっているかを確かめる
+        if (m_data.size() - m_offset < sizeof(CommandHeader))
+        {
+            m_isCorrupted = true;
+            return false;
+        }
+        std::memcpy(&outHeader, m_data.data() + m_offset, sizeof(CommandHeader));
+        const size_t payloadBytes = static_cast<size_t>(outHeader.payloadSize) * 4;
+        if (outHeader.type >= CommandType::Count || m_data.size() - m_offset - sizeof(CommandHeader) < payloadBytes)
+        {
+            m_isCorrupted = true;
+            return false;
+        }
+        outPayload = m_data.data() + m_offset + sizeof(CommandHeader);
+        m_offset += sizeof(CommandHeader) + payloadBytes;
+        return true;
+    }
+
+    Core::Result submit(CommandQueue& queue, std::span<const CommandList*> lists)
+    {
+        // 1) 記録したスレッドや完了順に依らないよう、キーで並べ替えてから渡す
+        std::stable_sort(lists.begin(), lists.end(), [](const CommandList* a, const CommandList* b)
+        {
+            return a->get_sort_key() < b->get_sort_key();
+        });
+        return queue.execute(lists);
+    }
+} // namespace Cue::Graphics
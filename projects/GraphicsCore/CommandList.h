@@ -0,0 +1,190 @@
+#pragma once
+#include <Result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+
+#include "RenderGraph.h"
+
+namespace Cue::Graphics
+{
+    enum class CommandType : uint16_t
+    {
+        SetPipeline,
+        SetVertexBuffer,
+        SetIndexBuffer,
+        SetConstants,
+        Draw,
+        DrawIndexed,
+        Dispatch,
+        Barrier,
+        CopyBuffer,
+        Count,
+    };
+
+    /// @brief 各コマンドの先頭（payloadSize はヘッダを除いた 4 バイト単位の大きさ）
+    /// @details ペイロードは 4 バイト境界にしか揃わないので、読むときは read_command で写し取る。
+    struct CommandHeader
+    {
+        CommandType type;
+        uint16_t payloadSize;
+    };
+
+    // バックエンドのオブジェクトはハンドル値だけで表す（記録時に辞書を引かないように）
+    struct SetPipelineCommand
+    {
+        uint32_t pipeline;
+    };
+
+    struct SetVertexBufferCommand
+    {
+        uint32_t slot;
+        uint32_t buffer;
+        uint32_t offset;
+        uint32_t stride;
+    };
+
+    struct SetIndexBufferCommand
+    {
+        uint32_t buffer;
+        uint32_t offset;
+        // 2 なら 16bit、4 なら 32bit インデックス
+        uint32_t indexSize;
+    };
+
+    struct SetConstantsCommand
+    {
+        // 後ろに count 個の uint32_t が続く
+        uint32_t rootIndex;
+        uint32_t count;
+    };
+
+    struct DrawCommand
+    {
+        uint32_t vertexCount;
+        uint32_t instanceCount;
+        uint32_t firstVertex;
+        uint32_t firstInstance;
+    };
+
+    struct DrawIndexedCommand
+    {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
+    struct DispatchCommand
+    {
+        uint32_t groupCountX;
+        uint32_t groupCountY;
+        uint32_t groupCountZ;
+    };
+
+    struct BarrierCommand
+    {
+        Barrier barrier;
+    };
+
+    struct CopyBufferCommand
+    {
+        uint32_t dst;
+        uint32_t src;
+        uint64_t dstOffset;
+        uint64_t srcOffset;
+        uint64_t size;
+    };
+
+    /// @brief 1 スレッドが記録するコマンド列
+    /// @details 初期化時に確保した領域へヘッダとペイロードを詰めて書くだけなので、記録中に確保しない。
+    ///          領域が尽きた後の記録は捨てられ、close が失敗を返す。
+    class CommandList final
+    {
+    public:
+        // 定数の一括設定の上限（ルート定数の上限に合わせる）
+        static constexpr uint32_t k_maxConstants = 64;
+
+        CommandList();
+        ~CommandList();
+        CommandList(const CommandList&) = delete;
+        CommandList& operator=(const CommandList&) = delete;
+
+        [[nodiscard]] Core::Result initialize(size_t capacityBytes);
+        void shutdown();
+
+        /// @brief 記録を始める（sortKey は提出時の並び順、記録したスレッドに依らず決まる値を渡す）
+        void begin(uint64_t sortKey) noexcept;
+        /// @brief 記録を終える（領域が足りなかった場合は失敗）
+        [[nodiscard]] Core::Result close() noexcept;
+
+        void set_pipeline(uint32_t pipeline) noexcept;
+        void set_vertex_buffer(uint32_t slot, uint32_t buffer, uint32_t offset, uint32_t stride) noexcept;
+        void set_index_buffer(uint32_t buffer, uint32_t offset, uint32_t indexSize) noexcept;
+        void set_constants(uint32_t rootIndex, std::span<const uint32_t> values) noexcept;
+        void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) noexcept;
+        void draw_indexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+            int32_t vertexOffset, uint32_t firstInstance) noexcept;
+        void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) noexcept;
+        void barrier(const Barrier& barrier) noexcept;
+        void copy_buffer(uint32_t dst, uint64_t dstOffset, uint32_t src, uint64_t srcOffset, uint64_t size) noexcept;
+
+        [[nodiscard]] uint64_t get_sort_key() const noexcept { return m_sortKey; }
+        [[nodiscard]] uint32_t get_command_count() const noexcept { return m_commandCount; }
+        /// @brief 記録済みのバイト列（close 後に読む）
+        [[nodiscard]] std::span<const std::byte> get_data() const noexcept;
+    private:
+        template<typename T>
+        void push(CommandType type, const T& payload, std::span<const uint32_t> extra = {}) noexcept;
+
+        std::unique_ptr<std::byte[]> m_data;
+        size_t m_capacity = 0;
+        size_t m_size = 0;
+        uint64_t m_sortKey = 0;
+        uint32_t m_commandCount = 0;
+        bool m_isOverflowed = false;
+    };
+
+    /// @brief ペイロードを構造体へ写し取る（整列していない位置から読むため）
+    template<typename T>
+    [[nodiscard]] T read_command(const std::byte* payload) noexcept
+    {
+        T command;
+        std::memcpy(&command, payload, sizeof(T));
+        return command;
+    }
+
+    /// @brief コマンド列を先頭から読み出す
+    class CommandReader final
+    {
+    public:
+        explicit CommandReader(std::span<const std::byte> data) noexcept
+            : m_data(data)
+        {
+        }
+
+        /// @brief 次のコマンドを読む（終端か壊れた列なら false、壊れていれば is_corrupted が true）
+        [[nodiscard]] bool next(CommandHeader& outHeader, const std::byte*& outPayload) noexcept;
+        [[nodiscard]] bool is_corrupted() const noexcept { return m_isCorrupted; }
+    private:
+        std::span<const std::byte> m_data;
+        size_t m_offset = 0;
+        bool m_isCorrupted = false;
+    };
+
+    /// @brief 記録済みのコマンド列を受け取って実行する窓口
+    class CommandQueue
+    {
+    public:
+        CommandQueue() = default;
+        virtual ~CommandQueue() = default;
+        /// @brief 渡された順に実行する
+        virtual Core::Result execute(std::span<const CommandList* const> lists) = 0;
+    };
+
+    /// @brief sortKey の昇順に並べ替えて提出する（記録の完了順に依らず結果が決まる）
+    [[nodiscard]] Core::Result submit(CommandQueue& queue, std::span<const CommandList*> lists);
+} // namespace Cue::Graphics
@@ -0,0 +1,284 @@
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+namespace Cue::Graphics
+{
+    namespace
+    {
+        constexpr uint32_t k_endOfList = 0xFFFFFFFFu;
+
+        // 1 スレッドが同時に切り出せる割り当て器の数（超えたら最も長く使っていないものを追い出す）
+        constexpr uint32_t k_threadPageCount = 4;
+
+        // スレッド毎・割り当て器毎の切り出し中ページ
+        struct ThreadPage
+        {
+            const DescriptorAllocator* owner = nullptr;
+            uint64_t epoch = 0;
+            uint32_t cursor = 0;
+            uint32_t end = 0;
+        };
+        // 使った順に並べる（先頭が最新）。CBV/SRV/UAV とサンプラーを交互に使ってもページを捨てない
+        thread_local ThreadPage t_pages[k_threadPageCount];
+
+        /// @brief owner のページ（無ければ最も長く使っていない枠）を先頭へ寄せて返す
+        ThreadPage& find_thread_page(const DescriptorAllocator* owner) noexcept
+        {
+            uint32_t index = k_threadPageCount - 1;
+            for (uint32_t i = 0; i < k_threadPageCount; ++i)
+            {
+                if (t_pages[i].owner == owner)
+                {
+                    index = i;
+                    break;
+                }
+            }
+            std::rotate(t_pages, t_pages + index, t_pages + index + 1);
+            return t_pages[0];
+        }
+
+        // 作り直しやアドレス再利用で古いページを使わないよう、世代はプロセス内で一意にする
+        uint64_t next_epoch() noexcept
+        {
+            static std::atomic<uint64_t> s_epoch{ 0 };
+            return s_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+    } // namespace
+
+    struct DescriptorAllocator::Impl
+    {
+        struct RetiredFrame
+        {
+            uint64_t fenceValue;
+            // このフレームの終わりでのページの通し番号（ここまでを回収できる）
+            uint64_t pageEnd;
+        };
+
+        DescriptorAllocatorDesc desc{};
+        bool isInitialized = false;
+
+        // 常駐領域：次の空きを指す配列によるフリーリスト
+        std::mutex persistentMutex;
+        std::vector<uint32_t> nextFree;
+        uint32_t freeHead = k_endOfList;
+        uint32_t persistentUsed = 0;
+#ifdef CUE_DEBUG
+        std::vector<uint8_t> isAllocated;
+#endif
+
+        // フレーム領域：ページの通し番号で head/tail を持つリング
+        uint32_t ringBase = 0;
+        uint32_t pageCount = 0;
+        std::atomic<uint64_t> pageHead{ 0 };
+        std::atomic<uint64_t> pageTail{ 0 };
+        std::atomic<uint64_t> epoch{ 0 };
+        std::vector<RetiredFrame> retired;
+        size_t retiredBegin = 0;
+        size_t retiredCount = 0;
+
+        bool acquire_page(uint32_t& outBase) noexcept
+        {
+            // 1) 回収済みの範囲を越えない場合だけ head を進める
+            uint64_t head = pageHead.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const uint64_t tail = pageTail.load(std::memory_order_acquire);
+                if (head - tail >= pageCount)
+                {
+                    return false;
+                }
+                if (pageHead.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            outBase = ringBase + static_cast<uint32_t>(head % pageCount) * desc.pageSize;
+            return true;
+        }
+    };
+
+    DescriptorAllocator::DescriptorAllocator()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    DescriptorAllocator::~DescriptorAllocator()
+    {
+        shutdown();
+    }
+
+    Core::Result DescriptorAllocator::initialize(const DescriptorAllocatorDesc& desc)
+    {
+        Impl& impl = *m_impl;
+        if (impl.isInitialized)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "DescriptorAllocator is already initialized.");
+        }
+        if (desc.persistentCount > desc.capacity || desc.pageSize == 0 || desc.maxFramesInFlight == 0
+            || (desc.capacity - desc.persistentCount) / desc.pageSize == 0)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "DescriptorAllocator desc is invalid.");
+        }
+        impl.desc = desc;
+
+        // 1) 常駐領域のフリーリストを昇順に繋ぐ
+        impl.nextFree.resize(desc.persistentCount);
+        for (uint32_t i = 0; i < desc.persistentCount; ++i)
+        {
+            impl.nextFree[i] = (i + 1 < desc.persistentCount) ? i + 1 : k_endOfList;
+        }
+        impl.freeHead = desc.persistentCount != 0 ? 0 : k_endOfList;
+        impl.persistentUsed = 0;
+#ifdef CUE_DEBUG
+        impl.isAllocated.assign(desc.persistentCount, 0);
+#endif
+
+        // 2) 残りをページ単位のリングにする（端数は使わない）
+        impl.ringBase = desc.persistentCount;
+        impl.pageCount = (desc.capacity - desc.persistentCount) / desc.pageSize;
+        impl.pageHead.store(0, std::memory_order_relaxed);
+        impl.pageTail.store(0, std::memory_order_relaxed);
+        impl.retired.assign(desc.maxFramesInFlight, Impl::RetiredFrame{});
+        impl.retiredBegin = 0;
+        impl.retiredCount = 0;
+        impl.epoch.store(next_epoch(), std::memory_order_release);
+        impl.isInitialized = true;
+        return Core::Result::ok();
+    }
+
+    void DescriptorAllocator::shutdown()
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isInitialized)
+        {
+            return;
+        }
+        impl.nextFree.clear();
+        impl.retired.clear();
+        impl.epoch.store(next_epoch(), std::memory_order_release);
+        impl.isInitialized = false;
+    }
+
+    DescriptorRange DescriptorAllocator::allocate_persistent()
+    {
+        Impl& impl = *m_impl;
+        std::lock_guard lock(impl.persistentMutex);
+        if (impl.freeHead == k_endOfList)
+        {
+            return DescriptorRange{};
+        }
+        const uint32_t index = impl.freeHead;
+        impl.freeHead = impl.nextFree[index];
+        ++impl.persistentUsed;
+#ifdef CUE_DEBUG
+        impl.isAllocated[index] = 1;
+#endif
+        return DescriptorRange{ index, 1 };
+    }
+
+    void DescriptorAllocator::free_persistent(DescriptorRange range)
+    {
+        Impl& impl = *m_impl;
+        if (!range.is_valid())
+        {
+            return;
+        }
+        std::lock_guard lock(impl.persistentMutex);
+        assert(range.index < impl.desc.persistentCount && "descriptor is not from the persistent region");
+#ifdef CUE_DEBUG
+        // 二重解放はリストを壊すので即座に止める
+        assert(impl.isAllocated[range.index] && "descriptor freed twice");
+        impl.isAllocated[range.index] = 0;
+#endif
+        impl.nextFree[range.index] = impl.freeHead;
+        impl.freeHead = range.index;
+        --impl.persistentUsed;
+    }
+
+    DescriptorRange DescriptorAllocator::allocate_transient(uint32_t count)
+    {
+        Impl& impl = *m_impl;
+        if (count == 0 || count > impl.desc.pageSize)
+        {
+            return DescriptorRange{};
+        }
+
+        // 1) このスレッドがこの割り当て器から取ったページに収まればそのまま切り出す
+        ThreadPage& page = find_thread_page(this);
+        const uint64_t epoch = impl.epoch.load(std::memory_order_acquire);
+        if (page.owner == this && page.epoch == epoch && page.end - page.cursor >= count)
+        {
+            const DescriptorRange range{ page.cursor, count };
+            page.cursor += count;
+            return range;
+        }
+
+        // 2) 収まらなければ新しいページを取る（前のページの残りは捨てる）
+        uint32_t base = 0;
+        if (!impl.acquire_page(base))
+        {
+            return DescriptorRange{};
+        }
+        page.owner = this;
+        page.epoch = epoch;
+        page.cursor = base + count;
+        page.end = base + impl.desc.pageSize;
+        return DescriptorRange{ base, count };
+    }
+
+    void DescriptorAllocator::begin_frame(uint64_t completedFenceValue)
+    {
+        Impl& impl = *m_impl;
+
+        // 1) 完了したフレームのページを古い順に回収する
+        while (impl.retiredCount != 0)
+        {
+            const Impl::RetiredFrame& frame = impl.retired[impl.retiredBegin];
+            if (frame.fenceValue > completedFenceValue)
+            {
+                break;
+            }
+            impl.pageTail.store(frame.pageEnd, std::memory_order_release);
+            impl.retiredBegin = (impl.retiredBegin + 1) % impl.retired.size();
+            --impl.retiredCount;
+        }
+    }
+
+    Core::Result DescriptorAllocator::end_frame(uint64_t signaledFenceValue)
+    {
+        Impl& impl = *m_impl;
+        if (impl.retiredCount == impl.retired.size())
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "DescriptorAllocator has too many frames in flight.");
+        }
+
+        // 1) このフレームまでに配ったページをフェンス値と結び付ける
+        const size_t slot = (impl.retiredBegin + impl.retiredCount) % impl.retired.size();
+        impl.retired[slot] = Impl::RetiredFrame{ signaledFenceValue, impl.pageHead.load(std::memory_order_acquire) };
+        ++impl.retiredCount;
+
+        // 2) 各スレッドの切り出し中ページを次のフレームに持ち越さない
+        impl.epoch.store(next_epoch(), std::memory_order_release);
+        return Core::Result::ok();
+    }
+
+    uint32_t DescriptorAllocator::get_persistent_used_count() const noexcept
+    {
+        std::lock_guard lock(m_impl->persistentMutex);
+        return m_impl->persistentUsed;
+    }
+
+    uint32_t DescriptorAllocator::get_transient_used_page_count() const noexcept
+    {
+        return static_cast<uint32_t>(m_impl->pageHead.load(std::memory_order_acquire)
+            - m_impl->pageTail.load(std::memory_order_acquire));
+    }
+} // namespace Cue::Graphics
@@ -0,0 +1,68 @@
+#pragma once
+#include <Result.h>
+#include <cstdint>
+#include <memory>
+
+namespace Cue::Graphics
+{
+    /// @brief ディスクリプタヒープ内の連続した範囲
+    /// @details バックエンドは「ヒープ先頭 + index * インクリメントサイズ」で CPU/GPU ハンドルに変換する。
+    struct DescriptorRange
+    {
+        static constexpr uint32_t k_invalidIndex = 0xFFFFFFFFu;
+        uint32_t index = k_invalidIndex;
+        uint32_t count = 0;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept { return index != k_invalidIndex; }
+    };
+
+    struct DescriptorAllocatorDesc
+    {
+        // ヒープ全体のディスクリプタ数
+        uint32_t capacity = 65536;
+        // 先頭から常駐用に使う数（残りはフレーム毎のリング）
+        uint32_t persistentCount = 32768;
+        // リングをスレッドへ配る単位
+        uint32_t pageSize = 256;
+        // GPU が追いついていないフレームの上限（リングの記録用）
+        uint32_t maxFramesInFlight = 4;
+    };
+
+    /// @brief バックエンドに依存しないディスクリプタの割り当て器
+    /// @details 常駐領域はフリーリストで O(1) に確保・解放する（バインドレスのテーブル向け）。
+    ///          フレーム領域はリングで、スレッド毎・割り当て器毎にページを切り出すためロックを取らない。
+    ///          ページはフレーム末のフェンス値で記録され、その値の完了を begin_frame で知らされると戻る。
+    class DescriptorAllocator final
+    {
+    public:
+        DescriptorAllocator();
+        ~DescriptorAllocator();
+        DescriptorAllocator(const DescriptorAllocator&) = delete;
+        DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+        [[nodiscard]] Core::Result initialize(const DescriptorAllocatorDesc& desc);
+        void shutdown();
+
+        /// @brief 常駐ディスクリプタを 1 つ確保する（枯渇時は無効な範囲）
+        [[nodiscard]] DescriptorRange allocate_persistent();
+        /// @brief 常駐ディスクリプタを解放する
+        void free_persistent(DescriptorRange range);
+
+        /// @brief このフレームだけ使う連続したディスクリプタを確保する（ロックなし、ページサイズまで）
+        /// @return リングが埋まっているかページより大きければ無効な範囲
+        [[nodiscard]] DescriptorRange allocate_transient(uint32_t count);
+
+        /// @brief フレームの開始時に、GPU が完了したフェンス値までのページを回収する
+        void begin_frame(uint64_t completedFenceValue);
+        /// @brief フレームの終わりに、このフレームのページを signal したフェンス値で記録する
+        /// @details 呼び出し時点で他スレッドの allocate_transient は終わっていること。
+        [[nodiscard]] Core::Result end_frame(uint64_t signaledFenceValue);
+
+        [[nodiscard]] uint32_t get_persistent_used_count() const noexcept;
+        /// @brief 回収待ちを含めたリングの使用ページ数
+        [[nodiscard]] uint32_t get_transient_used_page_count() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Graphics
@@ -0,0 +1,723 @@
+#include "RenderGraph.h"
+
+#include <NameId.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Cue::Graphics
+{
+    namespace
+    {
+        // 配置リソースの既定のアライメント（D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT）
+        constexpr uint64_t k_placementAlignment = 64ull * 1024ull;
+        // MSAA テクスチャのアライメント（D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT）
+        constexpr uint64_t k_msaaPlacementAlignment = 4ull * 1024ull * 1024ull;
+        constexpr uint32_t k_invalidPass = 0xFFFFFFFFu;
+
+        uint32_t get_bytes_per_pixel(Format format) noexcept
+        {
+            switch (format)
+            {
+            case Format::R8_UNORM: return 1;
+            case Format::RG8_UNORM: return 2;
+            case Format::RGBA8_UNORM: return 4;
+            case Format::R16_FLOAT: return 2;
+            case Format::RG16_FLOAT: return 4;
+            case Format::RGBA16_FLOAT: return 8;
+            case Format::R32_FLOAT: return 4;
+            case Format::RG32_FLOAT: return 8;
+            case Format::RGBA32_FLOAT: return 16;
+            case Format::R11G11B10_FLOAT: return 4;
+            case Format::D32_FLOAT: return 4;
+            case Format::D24_UNORM_S8_UINT: return 4;
+            }
+            return 4;
+        }
+
+        constexpr uint64_t align_up(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint64_t estimate_texture_size(const TextureDesc& desc) noexcept
+        {
+            // 1) ミップを含めた総画素数に画素サイズを掛ける（実機の配置サイズの近似）
+            uint64_t bytes = 0;
+            for (uint32_t mip = 0; mip < std::max(desc.mipLevels, 1u); ++mip)
+            {
+                const uint64_t w = std::max(desc.width >> mip, 1u);
+                const uint64_t h = std::max(desc.height >> mip, 1u);
+                const uint64_t d = std::max(desc.depth >> mip, 1u);
+                bytes += w * h * d;
+            }
+            bytes *= static_cast<uint64_t>(get_bytes_per_pixel(desc.format)) * std::max(desc.sampleCount, 1u);
+            return align_up(bytes, desc.sampleCount > 1 ? k_msaaPlacementAlignment : k_placementAlignment);
+        }
+    } // namespace
+
+    const char* to_string(ResourceState state) noexcept
+    {
+        switch (state)
+        {
+        case ResourceState::Undefined: return "Undefined";
+        case ResourceState::RenderTarget: return "RenderTarget";
+        case ResourceState::DepthWrite: return "DepthWrite";
+        case ResourceState::DepthRead: return "DepthRead";
+        case ResourceState::ShaderRead: return "ShaderRead";
+        case ResourceState::UnorderedAccess: return "UnorderedAccess";
+        case ResourceState::CopySource: return "CopySource";
+        case ResourceState::CopyDest: return "CopyDest";
+        case ResourceState::VertexBuffer: return "VertexBuffer";
+        case ResourceState::IndexBuffer: return "IndexBuffer";
+        case ResourceState::IndirectArgument: return "IndirectArgument";
+        case ResourceState::Present: return "Present";
+        }
+        return "Unknown";
+    }
+
+    struct RenderGraph::Impl
+    {
+        struct ResourceNode
+        {
+            // 毎フレーム組み直すので文字列を持たず、表に登録した ID だけを持つ
+            Core::NameId name;
+            bool isTexture = false;
+            bool isImported = false;
+            TextureDesc texture{};
+            BufferDesc buffer{};
+            ResourceState initialState = ResourceState::Undefined;
+            ResourceState finalState = ResourceState::Undefined;
+
+            // compile の結果
+            uint32_t firstPass = k_invalidPass;
+            uint32_t lastPass = 0;
+            bool isPlaced = false;
+            TransientPlacement placement{};
+            ResourceHandle aliasBefore{};
+        };
+
+        struct Access
+        {
+            uint32_t resource;
+            ResourceState state;
+            bool isWrite;
+        };
+
+        struct PassNode
+        {
+            Core::NameId name;
+            RenderPassExecute execute;
+            std::vector<Access> accesses;
+            std::vector<uint32_t> dependencies;
+            bool hasSideEffect = false;
+            bool isCulled = false;
+            uint32_t barrierBegin = 0;
+            uint32_t barrierCount = 0;
+        };
+
+        std::vector<ResourceNode> resources;
+        std::vector<PassNode> passes;
+        std::vector<Barrier> barriers;
+        uint32_t finalBarrierBegin = 0;
+        uint32_t finalBarrierCount = 0;
+        RenderGraphStats stats{};
+        bool isCompiled = false;
+
+        ResourceHandle add_resource(std::string_view name, bool isTexture, const TextureDesc& texture,
+            const BufferDesc& buffer, bool isImported, ResourceState initialState, ResourceState finalState)
+        {
+            ResourceNode node{};
+            node.name = Core::NameId::intern(name);
+            node.isTexture = isTexture;
+            node.isImported = isImported;
+            node.texture = texture;
+            node.buffer = buffer;
+            node.initialState = initialState;
+            node.finalState = finalState;
+            resources.push_back(std::move(node));
+            isCompiled = false;
+            return ResourceHandle{ static_cast<uint32_t>(resources.size() - 1) };
+        }
+
+        Core::Result cull_passes();
+        void compute_lifetimes();
+        void place_transients();
+        void build_barriers();
+    };
+
+    Core::Result RenderGraph::Impl::cull_passes()
+    {
+        // 1) 読みをそれ以前の最後の書き込みへ結び、依存関係を作る
+        std::vector<uint32_t> lastWriter(resources.size(), k_invalidPass);
+        std::vector<uint32_t> stack;
+        for (uint32_t p = 0; p < passes.size(); ++p)
+        {
+            PassNode& pass = passes[p];
+            pass.dependencies.clear();
+            pass.isCulled = true;
+            for (const Access& access : pass.accesses)
+            {
+                if (access.isWrite)
+                {
+                    continue;
+                }
+                const uint32_t writer = lastWriter[access.resource];
+                if (writer != k_invalidPass)
+                {
+                    pass.dependencies.push_back(writer);
+                }
+                else if (!resources[access.resource].isImported)
+                {
+                    return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState,
+                        Core::Severity::Error, 0, "RenderGraph pass reads a transient resource before it is written.");
+                }
+            }
+            for (const Access& access : pass.accesses)
+            {
+                if (!access.isWrite)
+                {
+                    continue;
+                }
+                lastWriter[access.resource] = p;
+                // 取り込んだリソースへの書き込みはフレームの外から見えるので根になる
+                if (resources[access.resource].isImported)
+                {
+                    pass.hasSideEffect = true;
+                }
+            }
+            if (pass.hasSideEffect)
+            {
+                stack.push_back(p);
+            }
+        }
+
+        // 2) 根から依存を辿って到達したパスだけを残す
+        while (!stack.empty())
+        {
+            const uint32_t p = stack.back();
+            stack.pop_back();
+            if (!passes[p].isCulled)
+            {
+                continue;
+            }
+            passes[p].isCulled = false;
+            for (uint32_t dependency : passes[p].dependencies)
+            {
+                if (passes[dependency].isCulled)
+                {
+                    stack.push_back(dependency);
+                }
+            }
+        }
+        return Core::Result::ok();
+    }
+
+    void RenderGraph::Impl::compute_lifetimes()
+    {
+        // 1) 残ったパスでの最初と最後の使用位置を求める
+        for (ResourceNode& resource : resources)
+        {
+            resource.firstPass = k_invalidPass;
+            resource.lastPass = 0;
+            resource.isPlaced = false;
+            resource.aliasBefore = ResourceHandle{};
+        }
+        for (uint32_t p = 0; p < passes.size(); ++p)
+        {
+            if (passes[p].isCulled)
+            {
+                continue;
+            }
+            for (const Access& access : passes[p].accesses)
+            {
+                ResourceNode& resource = resources[access.resource];
+                resource.firstPass = std::min(resource.firstPass, p);
+                resource.lastPass = std::max(resource.lastPass, p);
+            }
+        }
+    }
+
+    void RenderGraph::Impl::place_transients()
+    {
+        struct Placed
+        {
+            uint32_t resource;
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        // 1) ヒープの種類を決める（描画先にするテクスチャは専用ヒープ）
+        std::vector<uint32_t> order;
+        for (uint32_t r = 0; r < resources.size(); ++r)
+        {
+            ResourceNode& resource = resources[r];
+            if (resource.isImported || resource.firstPass == k_invalidPass)
+            {
+                continue;
+            }
+            HeapGroup heap = HeapGroup::Buffer;
+            uint64_t size = align_up(resource.buffer.size, k_placementAlignment);
+            if (resource.isTexture)
+            {
+                heap = HeapGroup::Texture;
+                size = estimate_texture_size(resource.texture);
+                for (uint32_t p = resource.firstPass; p <= resource.lastPass; ++p)
+                {
+                    for (const Access& access : passes[p].accesses)
+                    {
+                        if (access.resource == r
+                            && (access.state == ResourceState::RenderTarget || access.state == ResourceState::DepthWrite))
+                        {
+                            heap = HeapGroup::RenderTarget;
+                        }
+                    }
+                }
+            }
+            resource.placement = TransientPlacement{ heap, 0, size };
+            stats.unaliasedBytes += size;
+            order.push_back(r);
+        }
+
+        // 2) 大きいものから、寿命が重なる配置済みリソースの隙間で最も低いオフセットに置く
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+        {
+            return resources[a].placement.size > resources[b].placement.size;
+        });
+        std::vector<Placed> placed;
+        std::vector<Placed> overlapping;
+        for (uint32_t r : order)
+        {
+            ResourceNode& resource = resources[r];
+            overlapping.clear();
+            for (const Placed& other : placed)
+            {
+                const ResourceNode& node = resources[other.resource];
+                if (node.placement.heap == resource.placement.heap
+                    && node.firstPass <= resource.lastPass && resource.firstPass <= node.lastPass)
+                {
+                    overlapping.push_back(other);
+                }
+            }
+            std::sort(overlapping.begin(), overlapping.end(), [](const Placed& a, const Placed& b)
+            {
+                return a.offset < b.offset;
+            });
+            uint64_t offset = 0;
+            for (const Placed& other : overlapping)
+            {
+                if (offset + resource.placement.size <= other.offset)
+                {
+                    break;
+                }
+                offset = std::max(offset, other.offset + other.size);
+            }
+            resource.placement.offset = offset;
+            resource.isPlaced = true;
+            placed.push_back(Placed{ r, offset, resource.placement.size });
+
+            uint64_t& heapBytes = stats.heapBytes[static_cast<size_t>(resource.placement.heap)];
+            heapBytes = std::max(heapBytes, offset + resource.placement.size);
+        }
+        for (uint64_t heapBytes : stats.heapBytes)
+        {
+            stats.transientBytes += heapBytes;
+        }
+
+        // 3) 同じメモリを直前まで使っていたリソースを探す（切り替え時にエイリアシングバリアを張る）
+        for (const Placed& current : placed)
+        {
+            ResourceNode& resource = resources[current.resource];
+            uint32_t latestLast = 0;
+            for (const Placed& other : placed)
+            {
+                const ResourceNode& node = resources[other.resource];
+                const bool isMemoryOverlapping = node.placement.heap == resource.placement.heap
+                    && other.offset < current.offset + current.size && current.offset < other.offset + other.size;
+                if (isMemoryOverlapping && node.lastPass < resource.firstPass
+                    && (!resource.aliasBefore.is_valid() || node.lastPass >= latestLast))
+                {
+                    resource.aliasBefore = ResourceHandle{ other.resource };
+                    latestLast = node.lastPass;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::Impl::build_barriers()
+    {
+        // 1) 各リソースの現在の状態を追い、パス毎に必要なバリアを 1 回分にまとめる
+        std::vector<ResourceState> current(resources.size());
+        std::vector<uint8_t> isLastUavWrite(resources.size(), 0);
+        for (size_t r = 0; r < resources.size(); ++r)
+        {
+            current[r] = resources[r].isImported ? resources[r].initialState : ResourceState::Undefined;
+        }
+        barriers.clear();
+        for (uint32_t p = 0; p < passes.size(); ++p)
+        {
+            PassNode& pass = passes[p];
+            pass.barrierBegin = static_cast<uint32_t>(barriers.size());
+            pass.barrierCount = 0;
+            if (pass.isCulled)
+            {
+                continue;
+            }
+            for (size_t a = 0; a < pass.accesses.size(); ++a)
+            {
+                const Access& access = pass.accesses[a];
+                const uint32_t r = access.resource;
+
+                // 同じパスで読みと書きの両方を宣言していれば書き込み側の状態を使う
+                bool isHandled = false;
+                ResourceState required = access.state;
+                bool isWrite = access.isWrite;
+                for (size_t b = 0; b < pass.accesses.size(); ++b)
+                {
+                    if (pass.accesses[b].resource != r)
+                    {
+                        continue;
+                    }
+                    if (b < a)
+                    {
+                        isHandled = true;
+                        break;
+                    }
+                    if (pass.accesses[b].isWrite)
+                    {
+                        required = pass.accesses[b].state;
+                        isWrite = true;
+                    }
+                }
+                if (isHandled)
+                {
+                    continue;
+                }
+
+                const ResourceNode& resource = resources[r];
+                if (resource.firstPass == p && resource.isPlaced && resource.aliasBefore.is_valid())
+                {
+                    barriers.push_back(Barrier{ BarrierType::Aliasing, ResourceHandle{ r }, resource.aliasBefore,
+                        ResourceState::Undefined, ResourceState::Undefined });
+                }
+                if (current[r] != required)
+                {
+                    barriers.push_back(Barrier{ BarrierType::Transition, ResourceHandle{ r }, ResourceHandle{},
+                        current[r], required });
+                    current[r] = required;
+                }
+                else if (required == ResourceState::UnorderedAccess && (isWrite || isLastUavWrite[r]))
+                {
+                    // UAV のまま続けて使う場合は書き込みの完了だけを待つ
+                    barriers.push_back(Barrier{ BarrierType::Uav, ResourceHandle{ r }, ResourceHandle{},
+                        required, required });
+                }
+                isLastUavWrite[r] = (required == ResourceState::UnorderedAccess && isWrite) ? 1 : 0;
+            }
+            pass.barrierCount = static_cast<uint32_t>(barriers.size()) - pass.barrierBegin;
+            stats.barrierBatchCount += pass.barrierCount != 0 ? 1u : 0u;
+        }
+
+        // 2) 取り込んだリソースを所定の状態へ戻す
+        finalBarrierBegin = static_cast<uint32_t>(barriers.size());
+        for (uint32_t r = 0; r < resources.size(); ++r)
+        {
+            if (resources[r].isImported && current[r] != resources[r].finalState)
+            {
+                barriers.push_back(Barrier{ BarrierType::Transition, ResourceHandle{ r }, ResourceHandle{},
+                    current[r], resources[r].finalState });
+            }
+        }
+        finalBarrierCount = static_cast<uint32_t>(barriers.size()) - finalBarrierBegin;
+        stats.barrierBatchCount += finalBarrierCount != 0 ? 1u : 0u;
+        stats.barrierCount = static_cast<uint32_t>(barriers.size());
+    }
+
+    RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) noexcept
+        : m_graph(graph)
+        , m_passIndex(passIndex)
+    {
+    }
+
+    ResourceHandle RenderGraphBuilder::create_texture(std::string_view name, const TextureDesc& desc)
+    {
+        return m_graph.m_impl->add_resource(name, true, desc, BufferDesc{}, false,
+            ResourceState::Undefined, ResourceState::Undefined);
+    }
+
+    ResourceHandle RenderGraphBuilder::create_buffer(std::string_view name, const BufferDesc& desc)
+    {
+        return m_graph.m_impl->add_resource(name, false, TextureDesc{}, desc, false,
+            ResourceState::Undefined, ResourceState::Undefined);
+    }
+
+    ResourceHandle RenderGraphBuilder::read(ResourceHandle resource, ResourceState state)
+    {
+        m_graph.m_impl->passes[m_passIndex].accesses.push_back({ resource.index, state, false });
+        return resource;
+    }
+
+    ResourceHandle RenderGraphBuilder::write(ResourceHandle resource, ResourceState state)
+    {
+        m_graph.m_impl->passes[m_passIndex].accesses.push_back({ resource.index, state, true });
+        return resource;
+    }
+
+    void RenderGraphBuilder::set_side_effect() noexcept
+    {
+        m_graph.m_impl->passes[m_passIndex].hasSideEffect = true;
+    }
+
+    RenderGraph::RenderGraph()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+    }
+
+    ResourceHandle RenderGraph::import_texture(std::string_view name, const TextureDesc& desc,
+        ResourceState initialState, ResourceState finalState)
+    {
+        return m_impl->add_resource(name, true, desc, BufferDesc{}, true, initialState, finalState);
+    }
+
+    ResourceHandle RenderGraph::import_buffer(std::string_view name, const BufferDesc& desc,
+        ResourceState initialState, ResourceState finalState)
+    {
+        return m_impl->add_resource(name, false, TextureDesc{}, desc, true, initialState, finalState);
+    }
+
+    void RenderGraph::add_pass(std::string_view name, const RenderPassSetup& setup, RenderPassExecute execute)
+    {
+        Impl::PassNode node{};
+        node.name = Core::NameId::intern(name);
+        node.execute = std::move(execute);
+        m_impl->passes.push_back(std::move(node));
+        m_impl->isCompiled = false;
+
+        RenderGraphBuilder builder(*this, static_cast<uint32_t>(m_impl->passes.size() - 1));
+        if (setup)
+        {
+            setup(builder);
+        }
+    }
+
+    Core::Result RenderGraph::compile()
+    {
+        Impl& impl = *m_impl;
+        impl.stats = RenderGraphStats{};
+        impl.isCompiled = false;
+
+        // 1) 宣言の妥当性を確かめる
+        for (const Impl::PassNode& pass : impl.passes)
+        {
+            for (const Impl::Access& access : pass.accesses)
+            {
+                if (access.resource >= impl.resources.size())
+                {
+                    return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg,
+                        Core::Severity::Error, 0, "RenderGraph pass uses an invalid resource handle.");
+                }
+            }
+        }
+
+        // 2) 不要なパスを間引き、寿命を求め、一時リソースを配置し、バリアを作る
+        Core::Result r = impl.cull_passes();
+        if (!r)
+        {
+            return r;
+        }
+        impl.compute_lifetimes();
+        impl.place_transients();
+        impl.build_barriers();
+
+        for (const Impl::PassNode& pass : impl.passes)
+        {
+            ++impl.stats.passCount;
+            impl.stats.culledPassCount += pass.isCulled ? 1u : 0u;
+        }
+        impl.isCompiled = true;
+        return Core::Result::ok();
+    }
+
+    Core::Result RenderGraph::execute(RenderGraphExecutor& executor)
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isCompiled)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState,
+                Core::Severity::Error, 0, "RenderGraph must be compiled before execute.");
+        }
+
+        // 1) 一時リソースの実体を用意する
+        for (uint32_t r = 0; r < impl.resources.size(); ++r)
+        {
+            if (impl.resources[r].isPlaced)
+            {
+                executor.create_transient(ResourceHandle{ r }, impl.resources[r].placement);
+            }
+        }
+
+        // 2) パス毎にまとめたバリアを張ってから実行する
+        const std::span<const Barrier> allBarriers(impl.barriers);
+        for (uint32_t p = 0; p < impl.passes.size(); ++p)
+        {
+            Impl::PassNode& pass = impl.passes[p];
+            if (pass.isCulled)
+            {
+                continue;
+            }
+            if (pass.barrierCount != 0)
+            {
+                executor.barriers(allBarriers.subspan(pass.barrierBegin, pass.barrierCount));
+            }
+            executor.begin_pass(pass.name.get_text());
+            if (pass.execute)
+            {
+                RenderPassContext context{ executor, *this, p };
+                pass.execute(context);
+            }
+            executor.end_pass();
+        }
+
+        // 3) 取り込んだリソースを所定の状態へ戻す
+        if (impl.finalBarrierCount != 0)
+        {
+            executor.barriers(allBarriers.subspan(impl.finalBarrierBegin, impl.finalBarrierCount));
+        }
+        return Core::Result::ok();
+    }
+
+    void RenderGraph::reset() noexcept
+    {
+        m_impl->resources.clear();
+        m_impl->passes.clear();
+        m_impl->barriers.clear();
+        m_impl->stats = RenderGraphStats{};
+        m_impl->isCompiled = false;
+    }
+
+    const RenderGraphStats& RenderGraph::get_stats() const noexcept
+    {
+        return m_impl->stats;
+    }
+
+    std::string_view RenderGraph::get_resource_name(ResourceHandle resource) const noexcept
+    {
+        return resource.index < m_impl->resources.size() ? m_impl->resources[resource.index].name.get_text()
+                                                         : std::string_view("<invalid>");
+    }
+
+    std::string_view RenderGraph::get_pass_name(uint32_t passIndex) const noexcept
+    {
+        return passIndex < m_impl->passes.size() ? m_impl->passes[passIndex].name.get_text()
+                                                 : std::string_view("<invalid>");
+    }
+
+    bool RenderGraph::is_pass_culled(uint32_t passIndex) const noexcept
+    {
+        return passIndex < m_impl->passes.size() && m_impl->passes[passIndex].isCulled;
+    }
+
+    bool RenderGraph::get_placement(ResourceHandle resource, TransientPlacement& outPlacement) const noexcept
+    {
+        if (resource.index >= m_impl->resources.size() || !m_impl->resources[resource.index].isPlaced)
+        {
+            return false;
+        }
+        outPlacement = m_impl->resources[resource.index].placement;
+        return true;
+    }
+
+    struct RecordingExecutor::Impl
+    {
+        const RenderGraph& graph;
+        std::string log;
+
+        void append(const char* format, auto... args)
+        {
+            char line[256];
+            const int length = std::snprintf(line, sizeof(line), format, args...);
+            if (length > 0)
+            {
+                log.append(line, std::min(static_cast<size_t>(length), sizeof(line) - 1));
+            }
+        }
+
+        void append_name(ResourceHandle resource)
+        {
+            log.append(graph.get_resource_name(resource));
+        }
+    };
+
+    RecordingExecutor::RecordingExecutor(const RenderGraph& graph)
+        : m_impl(std::make_unique<Impl>(Impl{ graph, {} }))
+    {
+    }
+
+    RecordingExecutor::~RecordingExecutor()
+    {
+    }
+
+    void RecordingExecutor::create_transient(ResourceHandle resource, const TransientPlacement& placement)
+    {
+        static constexpr const char* k_heapNames[] = { "Buffer", "Texture", "RenderTarget" };
+        m_impl->log.append("transient ");
+        m_impl->append_name(resource);
+        m_impl->append(" heap=%s offset=%llu size=%llu\n", k_heapNames[static_cast<size_t>(placement.heap)],
+            static_cast<unsigned long long>(placement.offset), static_cast<unsigned long long>(placement.size));
+    }
+
+    void RecordingExecutor::barriers(std::span<const Barrier> batch)
+    {
+        m_impl->append("barriers %zu\n", batch.size());
+        for (const Barrier& barrier : batch)
+        {
+            switch (barrier.type)
+            {
+            case BarrierType::Transition:
+                m_impl->log.append("  transition ");
+                m_impl->append_name(barrier.resource);
+                m_impl->append(" %s -> %s\n", to_string(barrier.before), to_string(barrier.after));
+                break;
+            case BarrierType::Uav:
+                m_impl->log.append("  uav ");
+                m_impl->append_name(barrier.resource);
+                m_impl->log.append("\n");
+                break;
+            case BarrierType::Aliasing:
+                m_impl->log.append("  aliasing ");
+                m_impl->append_name(barrier.aliasBefore);
+                m_impl->log.append(" -> ");
+                m_impl->append_name(barrier.resource);
+                m_impl->log.append("\n");
+                break;
+            }
+        }
+    }
+
+    void RecordingExecutor::begin_pass(std::string_view name)
+    {
+        m_impl->log.append("pass ");
+        m_impl->log.append(name);
+        m_impl->log.append("\n");
+    }
+
+    void RecordingExecutor::end_pass()
+    {
+    }
+
+    std::string_view RecordingExecutor::get_log() const noexcept
+    {
+        return m_impl->log;
+    }
+
+    void RecordingExecutor::clear() noexcept
+    {
+        m_impl->log.clear();
+    }
+} // namespace Cue::Graphics
@@ -0,0 +1,229 @@
+#pragma once
+#include <Result.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace Cue::Graphics
+{
+    /// @brief テクスチャの形式（一時リソースの大きさ見積もりに使う）
+    enum class Format : uint8_t
+    {
+        R8_UNORM,
+        RG8_UNORM,
+        RGBA8_UNORM,
+        R16_FLOAT,
+        RG16_FLOAT,
+        RGBA16_FLOAT,
+        R32_FLOAT,
+        RG32_FLOAT,
+        RGBA32_FLOAT,
+        R11G11B10_FLOAT,
+        D32_FLOAT,
+        D24_UNORM_S8_UINT,
+    };
+
+    /// @brief リソースの使われ方（バックエンドの状態遷移に対応する）
+    enum class ResourceState : uint8_t
+    {
+        Undefined,
+        RenderTarget,
+        DepthWrite,
+        DepthRead,
+        ShaderRead,
+        UnorderedAccess,
+        CopySource,
+        CopyDest,
+        VertexBuffer,
+        IndexBuffer,
+        IndirectArgument,
+        Present,
+    };
+
+    enum class BarrierType : uint8_t
+    {
+        // 状態遷移
+        Transition,
+        // UAV 書き込み同士の順序付け
+        Uav,
+        // 同じメモリを使っていた別リソースからの切り替え
+        Aliasing,
+    };
+
+    struct TextureDesc
+    {
+        uint32_t width = 1;
+        uint32_t height = 1;
+        uint32_t depth = 1;
+        uint32_t mipLevels = 1;
+        uint32_t sampleCount = 1;
+        Format format = Format::RGBA8_UNORM;
+    };
+
+    struct BufferDesc
+    {
+        uint64_t size = 0;
+    };
+
+    /// @brief グラフ内の仮想リソース
+    struct ResourceHandle
+    {
+        static constexpr uint32_t k_invalidIndex = 0xFFFFFFFFu;
+        uint32_t index = k_invalidIndex;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept { return index != k_invalidIndex; }
+    };
+
+    struct Barrier
+    {
+        BarrierType type = BarrierType::Transition;
+        ResourceHandle resource{};
+        // Aliasing のときは同じメモリを直前まで使っていたリソース（無ければ無効）
+        ResourceHandle aliasBefore{};
+        ResourceState before = ResourceState::Undefined;
+        ResourceState after = ResourceState::Undefined;
+    };
+
+    /// @brief 一時リソースを置くヒープの種類（D3D12 の Resource Heap Tier 1 に合わせて分ける）
+    enum class HeapGroup : uint8_t
+    {
+        Buffer,
+        Texture,
+        RenderTarget,
+        Count,
+    };
+
+    /// @brief 一時リソースの配置結果
+    struct TransientPlacement
+    {
+        HeapGroup heap = HeapGroup::Buffer;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    struct RenderGraphStats
+    {
+        uint32_t passCount = 0;
+        uint32_t culledPassCount = 0;
+        uint32_t barrierCount = 0;
+        uint32_t barrierBatchCount = 0;
+        // エイリアシングした場合に必要なヒープの合計
+        uint64_t transientBytes = 0;
+        // エイリアシングしなかった場合の合計（比較用）
+        uint64_t unaliasedBytes = 0;
+        uint64_t heapBytes[static_cast<size_t>(HeapGroup::Count)]{};
+    };
+
+    class RenderGraph;
+
+    /// @brief パスの setup で読み書きを宣言するためのビルダー
+    class RenderGraphBuilder final
+    {
+    public:
+        [[nodiscard]] ResourceHandle create_texture(std::string_view name, const TextureDesc& desc);
+        [[nodiscard]] ResourceHandle create_buffer(std::string_view name, const BufferDesc& desc);
+        /// @brief 読み取りを宣言する（同じパスで書く場合は read と write の両方を呼ぶ）
+        ResourceHandle read(ResourceHandle resource, ResourceState state = ResourceState::ShaderRead);
+        /// @brief 書き込みを宣言する
+        ResourceHandle write(ResourceHandle resource, ResourceState state = ResourceState::RenderTarget);
+        /// @brief 出力が他のパスに読まれなくても間引かない（GPU 読み戻し等）
+        void set_side_effect() noexcept;
+    private:
+        friend class RenderGraph;
+        RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) noexcept;
+
+        RenderGraph& m_graph;
+        uint32_t m_passIndex;
+    };
+
+    class RenderGraphExecutor;
+
+    /// @brief パス実行時に渡される情報
+    struct RenderPassContext
+    {
+        RenderGraphExecutor& executor;
+        const RenderGraph& graph;
+        uint32_t passIndex;
+    };
+
+    using RenderPassSetup = std::function<void(RenderGraphBuilder&)>;
+    using RenderPassExecute = std::function<void(RenderPassContext&)>;
+
+    /// @brief コンパイル済みのグラフを受け取るバックエンド側の窓口
+    /// @details D3D12 ではバリアをまとめて ResourceBarrier に渡し、ヒープに配置リソースを作る。
+    class RenderGraphExecutor
+    {
+    public:
+        RenderGraphExecutor() = default;
+        virtual ~RenderGraphExecutor() = default;
+        /// @brief 一時リソースの実体を用意する（execute の最初に一度ずつ呼ばれる）
+        virtual void create_transient(ResourceHandle resource, const TransientPlacement& placement) = 0;
+        /// @brief 1 回分にまとめたバリア
+        virtual void barriers(std::span<const Barrier> batch) = 0;
+        virtual void begin_pass(std::string_view name) = 0;
+        virtual void end_pass() = 0;
+    };
+
+    /// @brief パスとリソースの依存からフレームの実行計画を組み立てる
+    /// @details パスは追加順に並ぶ前提で、読みはそれ以前の最後の書き込みに依存する。
+    ///          compile で不要なパスの間引き、寿命の算出、一時リソースのエイリアシング、バリアの生成を行う。
+    class RenderGraph final
+    {
+    public:
+        RenderGraph();
+        ~RenderGraph();
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        /// @brief 外部のテクスチャを取り込む（間引き・エイリアシングの対象外で、最後に finalState へ戻す）
+        [[nodiscard]] ResourceHandle import_texture(std::string_view name, const TextureDesc& desc,
+            ResourceState initialState, ResourceState finalState);
+        [[nodiscard]] ResourceHandle import_buffer(std::string_view name, const BufferDesc& desc,
+            ResourceState initialState, ResourceState finalState);
+
+        /// @brief パスを追加する（setup はその場で呼ばれる）
+        void add_pass(std::string_view name, const RenderPassSetup& setup, RenderPassExecute execute);
+
+        [[nodiscard]] Core::Result compile();
+        /// @brief コンパイル済みの計画を実行する
+        [[nodiscard]] Core::Result execute(RenderGraphExecutor& executor);
+        /// @brief パスとリソースを捨てて次のフレームの構築に備える（確保済みの領域は再利用する）
+        void reset() noexcept;
+
+        [[nodiscard]] const RenderGraphStats& get_stats() const noexcept;
+        [[nodiscard]] std::string_view get_resource_name(ResourceHandle resource) const noexcept;
+        [[nodiscard]] std::string_view get_pass_name(uint32_t passIndex) const noexcept;
+        [[nodiscard]] bool is_pass_culled(uint32_t passIndex) const noexcept;
+        /// @brief 一時リソースの配置（取り込んだリソースや間引かれたリソースは false）
+        [[nodiscard]] bool get_placement(ResourceHandle resource, TransientPlacement& outPlacement) const noexcept;
+    private:
+        friend class RenderGraphBuilder;
+
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    /// @brief 実行内容を文字列に書き出すだけのエグゼキュータ（GPU 無しでの検証用）
+    class RecordingExecutor final : public RenderGraphExecutor
+    {
+    public:
+        explicit RecordingExecutor(const RenderGraph& graph);
+        ~RecordingExecutor() override;
+
+        void create_transient(ResourceHandle resource, const TransientPlacement& placement) override;
+        void barriers(std::span<const Barrier> batch) override;
+        void begin_pass(std::string_view name) override;
+        void end_pass() override;
+
+        /// @brief 記録したスケジュール（1 行 1 イベント）
+        [[nodiscard]] std::string_view get_log() const noexcept;
+        void clear() noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    [[nodiscard]] const char* to_string(ResourceState state) noexcept;
+} // namespace Cue::Graphics
@@ -0,0 +1,75 @@
+#include "ShaderCache.h"
+
+#include <cstring>
+
+namespace Cue::Graphics
+{
+    Core::Sha256Digest make_shader_cache_key(const ShaderCacheKeyDesc& desc) noexcept
+    {
+        // 各値に長さを前置するので、区切り文字を含むソースや定義でも衝突しない
+        Core::Sha256 hasher;
+        hasher.update_field("CueShader1");
+        hasher.update_field(desc.compilerVersion);
+        hasher.update_field(desc.profile);
+        hasher.update_field(desc.entryPoint);
+        uint8_t defineCount[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            defineCount[i] = static_cast<uint8_t>(static_cast<uint64_t>(desc.defines.size()) >> (i * 8));
+        }
+        hasher.update(std::as_bytes(std::span<const uint8_t>(defineCount)));
+        for (const ShaderDefine& define : desc.defines)
+        {
+            hasher.update_field(define.name);
+            hasher.update_field(define.value);
+        }
+        hasher.update_field(desc.source);
+        return hasher.finalize();
+    }
+
+    Core::Result ShaderCache::find(const Core::Sha256Digest& key, std::vector<std::byte>& outBytecode,
+        std::vector<std::byte>& outReflection)
+    {
+        std::vector<std::byte> payload;
+        Core::Result r = m_cache.find(key, payload);
+        if (!r)
+        {
+            return r;
+        }
+        uint32_t bytecodeSize = 0;
+        if (payload.size() < sizeof(bytecodeSize))
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Warning, 0,
+                "ShaderCache entry is malformed.");
+        }
+        std::memcpy(&bytecodeSize, payload.data(), sizeof(bytecodeSize));
+        if (bytecodeSize > payload.size() - sizeof(bytecodeSize))
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Warning, 0,
+                "ShaderCache entry is malformed.");
+        }
+        const std::byte* bytecode = payload.data() + sizeof(bytecodeSize);
+        const std::byte* end = payload.data() + payload.size();
+        outBytecode.assign(bytecode, bytecode + bytecodeSize);
+        outReflection.assign(bytecode + bytecodeSize, end);
+        return Core::Result::ok();
+    }
+
+    Core::Result ShaderCache::store(const Core::Sha256Digest& key, std::span<const std::byte> bytecode,
+        std::span<const std::byte> reflection)
+    {
+        if (bytecode.size() > 0xFFFFFFFFu)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "ShaderCache bytecode is too large.");
+        }
+        const uint32_t bytecodeSize = static_cast<uint32_t>(bytecode.size());
+        const auto* sizeBytes = reinterpret_cast<const std::byte*>(&bytecodeSize);
+        std::vector<std::byte> payload;
+        payload.reserve(sizeof(bytecodeSize) + bytecode.size() + reflection.size());
+        payload.insert(payload.end(), sizeBytes, sizeBytes + sizeof(bytecodeSize));
+        payload.insert(payload.end(), bytecode.begin(), bytecode.end());
+        payload.insert(payload.end(), reflection.begin(), reflection.end());
+        return m_cache.store(key, payload);
+    }
+} // namespace Cue::Graphics
@@ -0,0 +1,54 @@
+#pragma once
+#include <BlobCache.h>
+#include <Result.h>
+#include <Sha256.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Cue::Graphics
+{
+    struct ShaderDefine
+    {
+        std::string_view name{};
+        std::string_view value{};
+    };
+
+    /// @brief コンパイル結果を決める入力の全て（どれか 1 つでも違えば別の鍵になる）
+    struct ShaderCacheKeyDesc
+    {
+        // インクルードを展開した後のソース
+        std::string_view source{};
+        // 並び順も鍵に含む（呼び出し側で決まった順に並べること）
+        std::span<const ShaderDefine> defines{};
+        std::string_view entryPoint{};
+        // "vs_6_6" などのターゲット
+        std::string_view profile{};
+        // コンパイラとオプションを表す文字列（更新されれば古い結果は引かれなくなる）
+        std::string_view compilerVersion{};
+    };
+
+    [[nodiscard]] Core::Sha256Digest make_shader_cache_key(const ShaderCacheKeyDesc& desc) noexcept;
+
+    /// @brief コンパイル済みシェーダとリフレクション情報の永続キャッシュ
+    /// @details Core::BlobCache に [u32 バイトコード長][バイトコード][リフレクション] の形で格納する。
+    ///          パイプラインのバイナリは BlobCache を直接使えばよい。BlobCache と同様に複数スレッドから使える。
+    class ShaderCache final
+    {
+    public:
+        [[nodiscard]] Core::Result open(const Core::BlobCacheDesc& desc) { return m_cache.open(desc); }
+        void close() noexcept { m_cache.close(); }
+
+        /// @brief 見つかれば写す（無ければ Code::NotFound）
+        [[nodiscard]] Core::Result find(const Core::Sha256Digest& key, std::vector<std::byte>& outBytecode,
+            std::vector<std::byte>& outReflection);
+        [[nodiscard]] Core::Result store(const Core::Sha256Digest& key, std::span<const std::byte> bytecode,
+            std::span<const std::byte> reflection);
+
+        [[nodiscard]] Core::BlobCacheStats get_stats() const { return m_cache.get_stats(); }
+    private:
+        Core::BlobCache m_cache;
+    };
+} // namespace Cue::Graphics
@@ -0,0 +1,324 @@
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Cue::Graphics
+{
+    namespace
+    {
+        // ホストページの先頭アライメント（GPU のバッファ配置と同じ 64KB）
+        constexpr size_t k_hostPageAlignment = 64 * 1024;
+
+        constexpr uint64_t align_up(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        bool is_pow2(uint64_t v) noexcept
+        {
+            return v != 0 && (v & (v - 1)) == 0;
+        }
+    } // namespace
+
+    Core::Result HostUploadMemory::create_page(uint64_t size, UploadPage& outPage)
+    {
+        std::byte* memory = static_cast<std::byte*>(
+            ::operator new(static_cast<size_t>(size), std::align_val_t{ k_hostPageAlignment }, std::nothrow));
+        if (!memory)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::OutOfMemory, Core::Severity::Error, 0,
+                "HostUploadMemory failed to allocate a page.");
+        }
+        outPage.cpuAddress = memory;
+        outPage.gpuAddress = reinterpret_cast<uint64_t>(memory);
+        outPage.size = size;
+        outPage.nativeBuffer = memory;
+        return Core::Result::ok();
+    }
+
+    void HostUploadMemory::destroy_page(UploadPage& page)
+    {
+        ::operator delete(page.cpuAddress, std::align_val_t{ k_hostPageAlignment });
+        page = UploadPage{};
+    }
+
+    struct UploadRing::Impl
+    {
+        struct Page
+        {
+            UploadPage memory{};
+            std::atomic<uint64_t> offset{ 0 };
+            // 最後に使われたフレームのフェンス値（退役中のみ意味を持つ）
+            uint64_t fenceValue = 0;
+            // 大きな確保のための専用ページ（再利用せずに破棄する）
+            bool isDedicated = false;
+        };
+
+        UploadRingDesc desc{};
+        bool isInitialized = false;
+
+        std::atomic<Page*> current{ nullptr };
+        // ページの入れ替えだけを直列化する（確保の高速経路では取らない）
+        std::mutex pageMutex;
+        std::vector<std::unique_ptr<Page>> pages;
+        std::vector<Page*> freePages;
+        // このフレームで退役したページ（end_frame でフェンス値が付く）
+        std::vector<Page*> retiredThisFrame;
+        std::vector<Page*> inFlightPages;
+
+        Page* create_page(uint64_t size, bool isDedicated)
+        {
+            auto page = std::make_unique<Page>();
+            if (!desc.memory->create_page(size, page->memory))
+            {
+                return nullptr;
+            }
+            page->isDedicated = isDedicated;
+            pages.push_back(std::move(page));
+            return pages.back().get();
+        }
+
+        void destroy_page(Page* page)
+        {
+            desc.memory->destroy_page(page->memory);
+            auto it = std::find_if(pages.begin(), pages.end(), [page](const std::unique_ptr<Page>& p)
+            {
+                return p.get() == page;
+            });
+            if (it != pages.end())
+            {
+                *it = std::move(pages.back());
+                pages.pop_back();
+            }
+        }
+
+        static bool try_allocate(Page& page, uint64_t size, uint64_t alignment, uint64_t& outOffset) noexcept
+        {
+            // 1) 整列後の末尾がページに収まる間だけオフセットを進める
+            uint64_t offset = page.offset.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const uint64_t begin = align_up(offset, alignment);
+                if (begin + size > page.memory.size)
+                {
+                    return false;
+                }
+                if (page.offset.compare_exchange_weak(offset, begin + size,
+                    std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    outOffset = begin;
+                    return true;
+                }
+            }
+        }
+
+        static UploadAllocation make_allocation(const Page& page, uint64_t offset, uint64_t size) noexcept
+        {
+            UploadAllocation allocation{};
+            allocation.cpuAddress = page.memory.cpuAddress + offset;
+            allocation.gpuAddress = page.memory.gpuAddress + offset;
+            allocation.offset = offset;
+            allocation.size = size;
+            allocation.nativeBuffer = page.memory.nativeBuffer;
+            return allocation;
+        }
+    };
+
+    UploadRing::UploadRing()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    UploadRing::~UploadRing()
+    {
+        shutdown();
+    }
+
+    Core::Result UploadRing::initialize(const UploadRingDesc& desc)
+    {
+        Impl& impl = *m_impl;
+        if (impl.isInitialized)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "UploadRing is already initialized.");
+        }
+        if (!desc.memory || desc.pageSize == 0)
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "UploadRing desc is invalid.");
+        }
+        impl.desc = desc;
+
+        // 1) 起動時のページを作り、先頭を現在のページにする
+        for (uint32_t i = 0; i < std::max(desc.initialPageCount, 1u); ++i)
+        {
+            Impl::Page* page = impl.create_page(desc.pageSize, false);
+            if (!page)
+            {
+                impl.isInitialized = true;
+                shutdown();
+                return Core::Result::fail(Core::Facility::Graphics, Core::Code::OutOfMemory, Core::Severity::Error, 0,
+                    "UploadRing failed to create its initial pages.");
+            }
+            impl.freePages.push_back(page);
+        }
+        impl.current.store(impl.freePages.back(), std::memory_order_release);
+        impl.freePages.pop_back();
+        impl.isInitialized = true;
+        return Core::Result::ok();
+    }
+
+    void UploadRing::shutdown()
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isInitialized)
+        {
+            return;
+        }
+        for (std::unique_ptr<Impl::Page>& page : impl.pages)
+        {
+            impl.desc.memory->destroy_page(page->memory);
+        }
+        impl.pages.clear();
+        impl.freePages.clear();
+        impl.retiredThisFrame.clear();
+        impl.inFlightPages.clear();
+        impl.current.store(nullptr, std::memory_order_release);
+        impl.isInitialized = false;
+    }
+
+    UploadAllocation UploadRing::allocate(uint64_t size, uint64_t alignment)
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isInitialized || size == 0 || !is_pow2(alignment))
+        {
+            return UploadAllocation{};
+        }
+
+        // 1) 大きな確保は専用ページにする（共有ページを一度で使い切らないように）
+        if (size > impl.desc.pageSize / 2)
+        {
+            std::lock_guard lock(impl.pageMutex);
+            Impl::Page* page = impl.create_page(align_up(size, alignment), true);
+            if (!page)
+            {
+                return UploadAllocation{};
+            }
+            page->offset.store(size, std::memory_order_relaxed);
+            impl.retiredThisFrame.push_back(page);
+            return Impl::make_allocation(*page, 0, size);
+        }
+
+        for (;;)
+        {
+            // 2) 現在のページから切り出す（ロックなし）
+            Impl::Page* page = impl.current.load(std::memory_order_acquire);
+            uint64_t offset = 0;
+            if (Impl::try_allocate(*page, size, alignment, offset))
+            {
+                return Impl::make_allocation(*page, offset, size);
+            }
+
+            // 3) 埋まっていれば、まだ誰も入れ替えていない場合に限り次のページへ替える
+            std::lock_guard lock(impl.pageMutex);
+            if (impl.current.load(std::memory_order_relaxed) != page)
+            {
+                continue;
+            }
+            Impl::Page* next = nullptr;
+            if (!impl.freePages.empty())
+            {
+                next = impl.freePages.back();
+                impl.freePages.pop_back();
+            }
+            else
+            {
+                // GPU の完了を待たずにページを足す
+                next = impl.create_page(impl.desc.pageSize, false);
+                if (!next)
+                {
+                    return UploadAllocation{};
+                }
+            }
+            impl.retiredThisFrame.push_back(page);
+            impl.current.store(next, std::memory_order_release);
+        }
+    }
+
+    void UploadRing::begin_frame(uint64_t completedFenceValue)
+    {
+        Impl& impl = *m_impl;
+        std::lock_guard lock(impl.pageMutex);
+
+        // 1) 完了したページを空きに戻す（専用ページは破棄する）
+        size_t kept = 0;
+        for (Impl::Page* page : impl.inFlightPages)
+        {
+            if (page->fenceValue > completedFenceValue)
+            {
+                impl.inFlightPages[kept++] = page;
+                continue;
+            }
+            if (page->isDedicated)
+            {
+                impl.destroy_page(page);
+            }
+            else
+            {
+                page->offset.store(0, std::memory_order_relaxed);
+                impl.freePages.push_back(page);
+            }
+        }
+        impl.inFlightPages.resize(kept);
+    }
+
+    void UploadRing::end_frame(uint64_t signaledFenceValue)
+    {
+        Impl& impl = *m_impl;
+        std::lock_guard lock(impl.pageMutex);
+
+        // 1) このフレームで退役したページにフェンス値を付ける
+        for (Impl::Page* page : impl.retiredThisFrame)
+        {
+            page->fenceValue = signaledFenceValue;
+            impl.inFlightPages.push_back(page);
+        }
+        impl.retiredThisFrame.clear();
+
+        // 2) 使いかけの現在のページはそのまま次のフレームでも使う
+        //    （オフセットは進む一方なので、このフレームの内容は上書きされない。退役時のフェンス値はこれ以降になる）
+    }
+
+    void UploadRing::trim()
+    {
+        Impl& impl = *m_impl;
+        std::lock_guard lock(impl.pageMutex);
+        for (Impl::Page* page : impl.freePages)
+        {
+            impl.destroy_page(page);
+        }
+        impl.freePages.clear();
+    }
+
+    uint32_t UploadRing::get_page_count() const noexcept
+    {
+        std::lock_guard lock(m_impl->pageMutex);
+        return static_cast<uint32_t>(m_impl->pages.size());
+    }
+
+    uint32_t UploadRing::get_free_page_count() const noexcept
+    {
+        std::lock_guard lock(m_impl->pageMutex);
+        return static_cast<uint32_t>(m_impl->freePages.size());
+    }
+
+    uint32_t UploadRing::get_in_flight_page_count() const noexcept
+    {
+        std::lock_guard lock(m_impl->pageMutex);
+        return static_cast<uint32_t>(m_impl->inFlightPages.size() + m_impl->retiredThisFrame.size());
+    }
+} // namespace Cue::Graphics
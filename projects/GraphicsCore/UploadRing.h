@@ -0,0 +1,95 @@
+#pragma once
+#include <Result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Cue::Graphics
+{
+    /// @brief 常時マップされたアップロード用バッファ 1 枚
+    struct UploadPage
+    {
+        std::byte* cpuAddress = nullptr;
+        uint64_t gpuAddress = 0;
+        uint64_t size = 0;
+        // バックエンドのバッファ（D3D12 なら ID3D12Resource*）
+        void* nativeBuffer = nullptr;
+    };
+
+    /// @brief アップロード用バッファの作成・破棄をバックエンドへ委ねる窓口
+    class IUploadMemory
+    {
+    public:
+        IUploadMemory() = default;
+        virtual ~IUploadMemory() = default;
+        virtual Core::Result create_page(uint64_t size, UploadPage& outPage) = 0;
+        virtual void destroy_page(UploadPage& page) = 0;
+    };
+
+    /// @brief ホストメモリをそのまま使う実装（GPU 無しでの検証用、gpuAddress は CPU アドレスと同じ）
+    class HostUploadMemory final : public IUploadMemory
+    {
+    public:
+        Core::Result create_page(uint64_t size, UploadPage& outPage) override;
+        void destroy_page(UploadPage& page) override;
+    };
+
+    struct UploadRingDesc
+    {
+        IUploadMemory* memory = nullptr;
+        // 1 ページの大きさ（これより大きい確保は専用ページになる）
+        uint64_t pageSize = 4ull * 1024ull * 1024ull;
+        // 起動時に作っておくページ数
+        uint32_t initialPageCount = 2;
+    };
+
+    /// @brief アップロードバッファ内の確保結果
+    struct UploadAllocation
+    {
+        std::byte* cpuAddress = nullptr;
+        uint64_t gpuAddress = 0;
+        // nativeBuffer 先頭からのオフセット（コピー元の指定に使う）
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        void* nativeBuffer = nullptr;
+
+        [[nodiscard]] bool is_valid() const noexcept { return cpuAddress != nullptr; }
+    };
+
+    /// @brief 定数やステージングデータを GPU へ渡すためのリングバッファ
+    /// @details 現在のページからのオフセットを CAS で進めるため、複数スレッドから同時に確保できる。
+    ///          埋まったページは退役させてフェンス値の完了で再利用し、足りなければページを足す（待たない）。
+    class UploadRing final
+    {
+    public:
+        // 定数バッファのアライメント（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+        static constexpr uint64_t k_defaultAlignment = 256;
+
+        UploadRing();
+        ~UploadRing();
+        UploadRing(const UploadRing&) = delete;
+        UploadRing& operator=(const UploadRing&) = delete;
+
+        [[nodiscard]] Core::Result initialize(const UploadRingDesc& desc);
+        void shutdown();
+
+        /// @brief 整列した領域を確保する（alignment は 2 の冪、失敗時は無効な結果）
+        [[nodiscard]] UploadAllocation allocate(uint64_t size, uint64_t alignment = k_defaultAlignment);
+
+        /// @brief フレームの開始時に、GPU が完了したフェンス値までのページを回収する
+        /// @details 他スレッドが allocate していない時に呼ぶこと。
+        void begin_frame(uint64_t completedFenceValue);
+        /// @brief フレームの終わりに、このフレームで使ったページを signal したフェンス値で記録する
+        void end_frame(uint64_t signaledFenceValue);
+        /// @brief 空いているページを解放する（ピーク後にメモリを返したい時）
+        void trim();
+
+        [[nodiscard]] uint32_t get_page_count() const noexcept;
+        [[nodiscard]] uint32_t get_free_page_count() const noexcept;
+        /// @brief GPU の完了待ちのページ数
+        [[nodiscard]] uint32_t get_in_flight_page_count() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Graphics
@@ -1,4 +1,5 @@
 #include "d3d12_backend.h"
+#include <MemoryTracker.h>
 #include <Windows.h>
 
 #include "RenderDevice.h"
@@ -40,7 +41,8 @@ namespace Cue::Graphics::DX12
                 "WinPlatform is not set in D3D12Backend.");
         }
 
-        // 1) デバイス初期化失敗をそのまま返し、失敗点を保持する
+        // 1) デバイス初期化失敗をそのまま返し、失敗点を保持する（デバイスの確保は D3D12 に付ける）
+        CUE_MEMORY_TAG(Core::Facility::D3D12);
         Core::Result r = m_impl->m_renderDevice.initialize(true);
         if (!r)
         {
@@ -1,49 +1,37 @@
 #include "stdafx.h"
 
+#include <Utf.h>
+
 namespace Cue::Graphics::DX12
 {
+    // Windows の wchar_t は UTF-16 の 1 単位
+    static_assert(sizeof(wchar_t) == sizeof(char16_t), "wchar_t must be a UTF-16 code unit.");
+
     std::string to_utf8(std::wstring_view w) noexcept
     {
-        // 1) 空対策
-        if (w.empty())
-        {
-            return {};
-        }
-
-        // 2) 必要長取得
-        const int len = ::WideCharToMultiByte(CP_UTF8, 0, w.data(), static_cast<int>(w.size()), nullptr, 0, nullptr, nullptr);
-        if (len <= 0)
+        // 1) 最大長で確保して 1 回で変換し、書いた長さに縮める（不正な入力は空）
+        std::string s;
+        s.resize(Core::get_utf8_capacity(w.size()));
+        size_t written = 0;
+        const std::u16string_view src(reinterpret_cast<const char16_t*>(w.data()), w.size());
+        if (!Core::utf16_to_utf8(src, std::span<char>(s.data(), s.size()), written))
         {
             return {};
         }
-
-        // 3) 変換
-        std::string s;
-        s.resize(static_cast<size_t>(len));
-        ::WideCharToMultiByte(CP_UTF8, 0, w.data(), static_cast<int>(w.size()), s.data(), len, nullptr, nullptr);
-
+        s.resize(written);
         return s;
     }
     std::wstring to_utf16(std::string_view s) noexcept
     {
-        // 1) 空対策
-        if (s.empty())
-        {
-            return {};
-        }
-
-        // 2) 必要長取得
-        const int len = ::MultiByteToWideChar(CP_UTF8, 0, s.data(), static_cast<int>(s.size()), nullptr, 0);
-        if (len <= 0)
+        // 1) 最大長で確保して 1 回で変換し、書いた長さに縮める（不正な入力は空）
+        std::wstring w;
+        w.resize(Core::get_utf16_capacity(s.size()));
+        size_t written = 0;
+        if (!Core::utf8_to_utf16(s, std::span<char16_t>(reinterpret_cast<char16_t*>(w.data()), w.size()), written))
         {
             return {};
         }
-
-        // 3) 変換
-        std::wstring w;
-        w.resize(static_cast<size_t>(len));
-        ::MultiByteToWideChar(CP_UTF8, 0, s.data(), static_cast<int>(s.size()), w.data(), len);
-
+        w.resize(written);
         return w;
     }
 }
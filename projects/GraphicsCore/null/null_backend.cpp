@@ -0,0 +1,46 @@
+#include "null_backend.h"
+
+namespace Cue::Graphics
+{
+    std::unique_ptr<Backend> create_backend()
+    {
+        // 1) GPU 無し環境の既定backendとして Null 実装を返す
+        return std::make_unique<Null::NullBackend>();
+    }
+}
+
+namespace Cue::Graphics::Null
+{
+    struct NullBackend::Impl
+    {
+        bool m_isInitialized = false;
+    };
+
+    NullBackend::NullBackend()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    NullBackend::~NullBackend()
+    {
+    }
+    Core::Result NullBackend::initialize()
+    {
+        // 1) 実 backend と同じく二重初期化は不正な状態として扱う
+        if (m_impl->m_isInitialized)
+        {
+            return Core::Result::fail(
+                Core::Facility::Graphics,
+                Core::Code::InvalidState,
+                Core::Severity::Error,
+                0,
+                "NullBackend is already initialized.");
+        }
+        m_impl->m_isInitialized = true;
+        return Core::Result::ok();
+    }
+    Core::Result NullBackend::shutdown()
+    {
+        m_impl->m_isInitialized = false;
+        return Core::Result::ok();
+    }
+} // namespace Cue::Graphics::Null
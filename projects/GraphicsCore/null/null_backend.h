@@ -0,0 +1,21 @@
+#pragma once
+#include <GraphicsCore.h>
+#include "BackendFactory.h"
+#include <memory>
+
+namespace Cue::Graphics::Null
+{
+    /// @brief GPU を一切使わないバックエンド
+    /// @details エンジンループの計測や CI でのテストで、描画 API のコストを除外するために使う。
+    class NullBackend : public Backend
+    {
+    public:
+        NullBackend();
+        ~NullBackend() override;
+        Core::Result initialize() override;
+        Core::Result shutdown() override;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Graphics::Null
@@ -0,0 +1,193 @@
+#include "replay_queue.h"
+
+namespace Cue::Graphics::Null
+{
+    namespace
+    {
+        // D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION
+        constexpr uint32_t k_maxDispatchGroups = 65535;
+        constexpr uint64_t k_fnvOffset = 1469598103934665603ull;
+        constexpr uint64_t k_fnvPrime = 1099511628211ull;
+
+        // パディングを含めないよう、解読した値を 1 つずつ混ぜる
+        void mix(uint64_t& hash, uint64_t value) noexcept
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                hash ^= (value >> (i * 8)) & 0xFFu;
+                hash *= k_fnvPrime;
+            }
+        }
+
+        Core::Result invalid_command(std::string_view message,
+            const std::source_location& loc = std::source_location::current()) noexcept
+        {
+            return Core::Result::fail(Core::Facility::Graphics, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                message, loc);
+        }
+    } // namespace
+
+    ReplayQueue::ReplayQueue()
+    {
+        reset_stats();
+    }
+
+    ReplayQueue::~ReplayQueue()
+    {
+    }
+
+    void ReplayQueue::reset_stats() noexcept
+    {
+        m_stats = ReplayStats{};
+        m_stats.checksum = k_fnvOffset;
+    }
+
+    Core::Result ReplayQueue::execute(std::span<const CommandList* const> lists)
+    {
+        // 1) 渡された順に 1 本ずつ再生する
+        for (const CommandList* list : lists)
+        {
+            Core::Result r = replay(*list);
+            if (!r)
+            {
+                return r;
+            }
+            ++m_stats.listCount;
+        }
+        return Core::Result::ok();
+    }
+
+    Core::Result ReplayQueue::replay(const CommandList& list)
+    {
+        // 1) リスト毎に束縛状態を初期化する（D3D12 のコマンドリストと同じく持ち越さない）
+        bool hasPipeline = false;
+        bool hasIndexBuffer = false;
+
+        CommandReader reader(list.get_data());
+        CommandHeader header{};
+        const std::byte* payload = nullptr;
+        uint64_t& hash = m_stats.checksum;
+        while (reader.next(header, payload))
+        {
+            mix(hash, static_cast<uint64_t>(header.type));
+            switch (header.type)
+            {
+            case CommandType::SetPipeline:
+            {
+                const auto c = read_command<SetPipelineCommand>(payload);
+                mix(hash, c.pipeline);
+                hasPipeline = true;
+                break;
+            }
+            case CommandType::SetVertexBuffer:
+            {
+                const auto c = read_command<SetVertexBufferCommand>(payload);
+                mix(hash, (static_cast<uint64_t>(c.slot) << 32) | c.buffer);
+                mix(hash, (static_cast<uint64_t>(c.offset) << 32) | c.stride);
+                break;
+            }
+            case CommandType::SetIndexBuffer:
+            {
+                const auto c = read_command<SetIndexBufferCommand>(payload);
+                if (c.indexSize != 2 && c.indexSize != 4)
+                {
+                    return invalid_command("ReplayQueue: index size must be 2 or 4.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.buffer) << 32) | c.offset);
+                mix(hash, c.indexSize);
+                hasIndexBuffer = true;
+                break;
+            }
+            case CommandType::SetConstants:
+            {
+                const auto c = read_command<SetConstantsCommand>(payload);
+                if (static_cast<size_t>(header.payloadSize) * 4 != sizeof(c) + static_cast<size_t>(c.count) * 4)
+                {
+                    return invalid_command("ReplayQueue: constant count does not match the payload.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.rootIndex) << 32) | c.count);
+                for (uint32_t i = 0; i < c.count; ++i)
+                {
+                    mix(hash, read_command<uint32_t>(payload + sizeof(c) + static_cast<size_t>(i) * 4));
+                }
+                break;
+            }
+            case CommandType::Draw:
+            {
+                const auto c = read_command<DrawCommand>(payload);
+                if (!hasPipeline)
+                {
+                    return invalid_command("ReplayQueue: draw without a pipeline.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.vertexCount) << 32) | c.instanceCount);
+                mix(hash, (static_cast<uint64_t>(c.firstVertex) << 32) | c.firstInstance);
+                break;
+            }
+            case CommandType::DrawIndexed:
+            {
+                const auto c = read_command<DrawIndexedCommand>(payload);
+                if (!hasPipeline || !hasIndexBuffer)
+                {
+                    return invalid_command("ReplayQueue: indexed draw without a pipeline or index buffer.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.indexCount) << 32) | c.instanceCount);
+                mix(hash, (static_cast<uint64_t>(c.firstIndex) << 32) | static_cast<uint32_t>(c.vertexOffset));
+                mix(hash, c.firstInstance);
+                break;
+            }
+            case CommandType::Dispatch:
+            {
+                const auto c = read_command<DispatchCommand>(payload);
+                if (!hasPipeline)
+                {
+                    return invalid_command("ReplayQueue: dispatch without a pipeline.");
+                }
+                if (c.groupCountX > k_maxDispatchGroups || c.groupCountY > k_maxDispatchGroups
+                    || c.groupCountZ > k_maxDispatchGroups)
+                {
+                    return invalid_command("ReplayQueue: dispatch exceeds the group count limit.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.groupCountX) << 32) | c.groupCountY);
+                mix(hash, c.groupCountZ);
+                break;
+            }
+            case CommandType::Barrier:
+            {
+                const auto c = read_command<BarrierCommand>(payload);
+                if (c.barrier.type == BarrierType::Transition && c.barrier.before == c.barrier.after)
+                {
+                    return invalid_command("ReplayQueue: transition barrier does not change the state.");
+                }
+                mix(hash, static_cast<uint64_t>(c.barrier.type));
+                mix(hash, (static_cast<uint64_t>(c.barrier.resource.index) << 32) | c.barrier.aliasBefore.index);
+                mix(hash, (static_cast<uint64_t>(c.barrier.before) << 8) | static_cast<uint64_t>(c.barrier.after));
+                break;
+            }
+            case CommandType::CopyBuffer:
+            {
+                const auto c = read_command<CopyBufferCommand>(payload);
+                if (c.size == 0)
+                {
+                    return invalid_command("ReplayQueue: empty buffer copy.");
+                }
+                mix(hash, (static_cast<uint64_t>(c.dst) << 32) | c.src);
+                mix(hash, c.dstOffset);
+                mix(hash, c.srcOffset);
+                mix(hash, c.size);
+                break;
+            }
+            case CommandType::Count:
+                break;
+            }
+            ++m_stats.commandCounts[static_cast<size_t>(header.type)];
+            ++m_stats.commandCount;
+        }
+
+        // 2) 途中で読めなくなった列は壊れている
+        if (reader.is_corrupted())
+        {
+            return invalid_command("ReplayQueue: command stream is corrupted.");
+        }
+        return Core::Result::ok();
+    }
+} // namespace Cue::Graphics::Null
@@ -0,0 +1,34 @@
+#pragma once
+#include <CommandList.h>
+#include <cstdint>
+
+namespace Cue::Graphics::Null
+{
+    /// @brief 再生したコマンドの集計
+    struct ReplayStats
+    {
+        uint64_t listCount = 0;
+        uint64_t commandCount = 0;
+        uint64_t commandCounts[static_cast<size_t>(CommandType::Count)]{};
+        // 再生した内容のハッシュ（提出順が決定的かどうかの確認に使う）
+        uint64_t checksum = 0;
+    };
+
+    /// @brief コマンド列を CPU で解読して検証するだけのキュー
+    /// @details GPU 無しで記録のスループットや提出順を計測するために使う。
+    class ReplayQueue final : public CommandQueue
+    {
+    public:
+        ReplayQueue();
+        ~ReplayQueue() override;
+
+        Core::Result execute(std::span<const CommandList* const> lists) override;
+
+        [[nodiscard]] const ReplayStats& get_stats() const noexcept { return m_stats; }
+        void reset_stats() noexcept;
+    private:
+        Core::Result replay(const CommandList& list);
+
+        ReplayStats m_stats{};
+    };
+} // namespace Cue::Graphics::Null
@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Core
+#include <Profiler.h>
+
+// Platform
+#include <FramePacer.h>
+#include <headless_platform.h>
+
+// Graphics
+#include <null_backend.h>
+
+// Engine
+#include <Engine.h>
+
+namespace
+{
+    constexpr uint64_t k_defaultFrameCount = 10000;
+
+    struct RunnerOptions
+    {
+        uint64_t frameCount = 0;
+        double seconds = 0.0;
+        uint32_t workerCount = 0;
+        // 0 なら待たずに最大速度で回す
+        double targetFps = 0.0;
+        const char* csvPath = nullptr;
+        const char* tracePath = nullptr;
+        uint32_t traceFrames = 8;
+        // 合成入力の 1 秒あたりのイベント数（0 で入力なし）
+        double inputRate = 0.0;
+        // フレームパケットのリング数（1 で直列、2〜3 で描画スレッドと並走）
+        uint32_t pipelineDepth = 1;
+        // 合成負荷：シミュレーションと描画がそれぞれ 1 フレームに使う時間と描画対象数
+        uint32_t simUs = 0;
+        uint32_t renderUs = 0;
+        uint32_t objectCount = 0;
+    };
+
+    bool parse_options(int argc, char** argv, RunnerOptions& options)
+    {
+        // 1) 引数は "--name value" 形式のみ受け付ける
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool hasValue = (i + 1) < argc;
+            if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            {
+                options.frameCount = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue)
+            {
+                options.seconds = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--workers") == 0 && hasValue)
+            {
+                options.workerCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--fps") == 0 && hasValue)
+            {
+                options.targetFps = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+            {
+                options.csvPath = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--trace") == 0 && hasValue)
+            {
+                options.tracePath = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--trace-frames") == 0 && hasValue)
+            {
+                options.traceFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--input-rate") == 0 && hasValue)
+            {
+                options.inputRate = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--pipeline") == 0 && hasValue)
+            {
+                options.pipelineDepth = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--sim-us") == 0 && hasValue)
+            {
+                options.simUs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--render-us") == 0 && hasValue)
+            {
+                options.renderUs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--objects") == 0 && hasValue)
+            {
+                options.objectCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else
+            {
+                std::fprintf(stderr,
+                    "usage: HeadlessRunner [--frames N] [--seconds S] [--workers N] [--fps N] [--csv path]"
+                    " [--trace path] [--trace-frames N] [--input-rate N] [--pipeline N] [--sim-us N]"
+                    " [--render-us N] [--objects N]\n");
+                return false;
+            }
+        }
+
+        // 2) 上限が無いと終わらないので、どちらも未指定なら既定のフレーム数で回す
+        if (options.frameCount == 0 && options.seconds <= 0.0)
+        {
+            options.frameCount = k_defaultFrameCount;
+        }
+        return true;
+    }
+
+    // 合成描画の読み出しが最適化で消えないよう結果を置く先
+    volatile float g_renderSink = 0.0f;
+
+    /// @brief 合成負荷：指定時間だけ CPU を使い続ける（スリープでは並走の効果が測れない）
+    void spin_for(uint32_t microseconds)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+        }
+    }
+
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    void report(const std::vector<double>& frameTimesUs)
+    {
+        // 1) 外れ値の影響を見たいので平均だけでなく分位点も出す
+        std::vector<double> sorted = frameTimesUs;
+        std::sort(sorted.begin(), sorted.end());
+
+        double total = 0.0;
+        for (double t : sorted)
+        {
+            total += t;
+        }
+        const double average = sorted.empty() ? 0.0 : total / static_cast<double>(sorted.size());
+
+        std::printf("frames   : %zu\n", sorted.size());
+        std::printf("total us : %.3f\n", total);
+        std::printf("min us   : %.3f\n", sorted.empty() ? 0.0 : sorted.front());
+        std::printf("avg us   : %.3f\n", average);
+        std::printf("p50 us   : %.3f\n", percentile(sorted, 0.50));
+        std::printf("p99 us   : %.3f\n", percentile(sorted, 0.99));
+        std::printf("max us   : %.3f\n", sorted.empty() ? 0.0 : sorted.back());
+    }
+
+    void report_pacing(const Cue::Platform::FrameTimeStats& stats)
+    {
+        // 1) 開始間隔の揺れと期限超過を出す（tick の処理時間とは別物）
+        std::printf("paced frames : %llu (missed %llu)\n",
+            static_cast<unsigned long long>(stats.frameCount), static_cast<unsigned long long>(stats.missedCount));
+        std::printf("paced ms     : min %.3f avg %.3f p50 %.3f p99 %.3f max %.3f\n",
+            stats.minMs, stats.avgMs, stats.p50Ms, stats.p99Ms, stats.maxMs);
+    }
+
+    void report_input(const Cue::InputLatencyStats& stats)
+    {
+        // 1) 入力が届いてから取り込むフレームが始まるまで（フレーム間隔の分だけ待つのが上限の目安）
+        std::printf("input events : %llu (dropped %llu)\n",
+            static_cast<unsigned long long>(stats.eventCount), static_cast<unsigned long long>(stats.droppedCount));
+        std::printf("input us     : min %.3f avg %.3f p50 %.3f p99 %.3f max %.3f\n",
+            stats.minUs, stats.avgUs, stats.p50Us, stats.p99Us, stats.maxUs);
+    }
+
+    void report_pipeline(const Cue::FramePipelineStats& stats, uint32_t depth, double wallSeconds)
+    {
+        // 1) 実時間あたりのフレーム数が直列と並走の比較の指標（tick の時間は背圧の待ちを含む）
+        std::printf("pipeline     : depth %u, %.1f frames/s\n", depth,
+            wallSeconds > 0.0 ? static_cast<double>(stats.consumedCount) / wallSeconds : 0.0);
+        std::printf("pipeline ms  : stalled %llu frames (%.3f ms), render idle %.3f ms\n",
+            static_cast<unsigned long long>(stats.stallCount), stats.stallMs, stats.renderIdleMs);
+    }
+
+    bool write_csv(const char* path, const std::vector<double>& frameTimesUs)
+    {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file)
+        {
+            std::fprintf(stderr, "HeadlessRunner: failed to open %s\n", path);
+            return false;
+        }
+        std::fprintf(file, "frame,tick_us\n");
+        for (size_t i = 0; i < frameTimesUs.size(); ++i)
+        {
+            std::fprintf(file, "%zu,%.3f\n", i, frameTimesUs[i]);
+        }
+        std::fclose(file);
+        return true;
+    }
+
+    int report_failure(const Cue::Core::Result& r)
+    {
+        const Cue::Core::ResultDiagnostic diagnostic = r.get_diagnostic();
+        std::fprintf(stderr, "HeadlessRunner: %.*s (%s:%u)\n",
+            static_cast<int>(diagnostic.message.size()), diagnostic.message.data(), diagnostic.file, diagnostic.line);
+        return EXIT_FAILURE;
+    }
+}
+
+// GPU もウィンドウも使わずに Engine::tick を回し、フレーム毎の CPU コストを計測する
+int main(int argc, char** argv)
+{
+    RunnerOptions options;
+    if (!parse_options(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // 1) ヘッドレス環境を構築する
+    Cue::Platform::Headless::HeadlessPlatform platform;
+    platform.set_frame_limit(options.frameCount);
+    platform.set_time_budget(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(options.seconds)));
+
+    Cue::Core::Result r = platform.setup();
+    if (!r)
+    {
+        return report_failure(r);
+    }
+    r = platform.start();
+    if (!r)
+    {
+        return report_failure(r);
+    }
+
+    Cue::Graphics::Null::NullBackend backend;
+    r = backend.initialize();
+    if (!r)
+    {
+        return report_failure(r);
+    }
+
+    // 計測用の領域とペーサーはエンジンより先に用意する
+    // （計測中に再確保が起きないようにし、shutdown のリーク報告の基準より前の確保にする）
+    std::vector<double> frameTimesUs;
+    frameTimesUs.reserve(options.frameCount != 0 ? static_cast<size_t>(options.frameCount) : 1u << 20);
+    Cue::Platform::FramePacer pacer;
+    Cue::Platform::FramePacerDesc pacerDesc{};
+    pacerDesc.targetFps = options.targetFps;
+    r = pacer.initialize(pacerDesc);
+    if (!r)
+    {
+        return report_failure(r);
+    }
+
+    Cue::Engine engine;
+    Cue::EngineInitInfo initInfo;
+    initInfo.platform = &platform;
+    initInfo.graphicsBackend = &backend;
+    initInfo.workerCount = options.workerCount;
+    initInfo.framePipeline.depth = options.pipelineDepth;
+    initInfo.framePipeline.objectCapacity = options.objectCount;
+
+    // 合成負荷：描画対象を詰める抽出と、パケットだけを読む描画
+    const uint32_t objectCount = options.objectCount;
+    const uint32_t renderUs = options.renderUs;
+    initInfo.extractFrame = [objectCount](Cue::Ecs::World&, Cue::FramePacket& packet)
+        {
+            const float t = static_cast<float>(packet.constants.timeSeconds);
+            for (uint32_t i = 0; i < objectCount; ++i)
+            {
+                Cue::RenderObject object{};
+                object.world.r[3] = { static_cast<float>(i), t, 0.0f, 1.0f };
+                object.meshId = i;
+                packet.objects.push_back(object);
+            }
+        };
+    initInfo.renderFrame = [renderUs](const Cue::FramePacket& packet)
+        {
+            float sum = 0.0f;
+            for (const Cue::RenderObject& object : packet.objects)
+            {
+                sum += object.world.r[3].x;
+            }
+            g_renderSink = sum;
+            spin_for(renderUs);
+            return Cue::Core::Result::ok();
+        };
+    r = engine.initialize(initInfo);
+    if (!r)
+    {
+        return report_failure(r);
+    }
+    if (options.simUs != 0)
+    {
+        Cue::Ecs::SystemDesc simDesc{};
+        simDesc.name = "SyntheticSim";
+        simDesc.function = [simUs = options.simUs](Cue::Ecs::SystemContext&) { spin_for(simUs); };
+        engine.get_system_scheduler().add_system(std::move(simDesc));
+    }
+
+
+    // 2) 入力を別スレッドから積む（ポンプを別スレッドで回した時と同じ形）
+    if (options.inputRate > 0.0)
+    {
+        Cue::Platform::Headless::SyntheticInputDesc inputDesc{};
+        inputDesc.eventsPerSecond = options.inputRate;
+        r = platform.start_synthetic_input(inputDesc);
+        if (!r)
+        {
+            engine.shutdown();
+            return report_failure(r);
+        }
+    }
+
+    // 3) フレームループ（Editor と同じ順序で回す）
+    const auto loopBegin = std::chrono::steady_clock::now();
+    while (platform.poll_message())
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        r = engine.tick();
+        const auto end = std::chrono::steady_clock::now();
+        if (!r)
+        {
+            engine.shutdown();
+            return report_failure(r);
+        }
+        frameTimesUs.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        pacer.wait_for_next_frame();
+    }
+
+    // 4) 直近のフレームを Perfetto で見られる形式で書き出す（エンジン停止前に取る）
+    if (options.tracePath)
+    {
+        r = Cue::Core::Profiler::export_chrome_trace(options.tracePath, options.traceFrames);
+        if (!r)
+        {
+            engine.shutdown();
+            return report_failure(r);
+        }
+    }
+
+    // 5) 生産者を止めてから集計を取る（描画は shutdown で残りを描き切る）
+    platform.stop_synthetic_input();
+    const Cue::InputLatencyStats inputStats = engine.get_input_latency_stats();
+
+    engine.shutdown();
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopBegin).count();
+    const Cue::FramePipelineStats pipelineStats = engine.get_frame_pipeline_stats();
+    (void)backend.shutdown();
+    (void)platform.shutdown();
+
+    // 6) 結果を出力する
+    report(frameTimesUs);
+    if (options.targetFps > 0.0)
+    {
+        report_pacing(pacer.get_stats());
+    }
+    if (options.inputRate > 0.0)
+    {
+        report_input(inputStats);
+    }
+    report_pipeline(pipelineStats, options.pipelineDepth, wallSeconds);
+    if (options.csvPath && !write_csv(options.csvPath, frameTimesUs))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
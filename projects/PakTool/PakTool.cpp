@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// Core
+#include <Compression.h>
+#include <JobSystem.h>
+#include <Pak.h>
+
+namespace
+{
+    int report_failure(const Cue::Core::Result& r)
+    {
+        const Cue::Core::ResultDiagnostic diagnostic = r.get_diagnostic();
+        std::fprintf(stderr, "PakTool: %.*s (native=%u)\n",
+            static_cast<int>(diagnostic.message.size()), diagnostic.message.data(), r.get_native());
+        return EXIT_FAILURE;
+    }
+
+    std::string to_utf8(const std::filesystem::path& path)
+    {
+        const std::u8string text = path.generic_u8string();
+        return std::string(text.begin(), text.end());
+    }
+}
+
+// ディレクトリ以下のファイルを 1 つの pak にまとめる（仮想パスは入力ディレクトリからの相対パス）
+// 既定ではブロック圧縮する（--store で無圧縮、--block-size でブロックの大きさを KB で指定）
+int main(int argc, char** argv)
+{
+    // 1) オプションを読む
+    uint32_t blockSize = Cue::Core::k_defaultCompressedBlockSize;
+    int argIndex = 1;
+    for (; argIndex < argc && argv[argIndex][0] == '-' && argv[argIndex][1] == '-'; ++argIndex)
+    {
+        const std::string option(argv[argIndex]);
+        if (option == "--store")
+        {
+            blockSize = 0;
+        }
+        else if (option == "--block-size" && argIndex + 1 < argc)
+        {
+            blockSize = static_cast<uint32_t>(std::strtoul(argv[++argIndex], nullptr, 10)) * 1024u;
+            if (blockSize < Cue::Core::k_minCompressedBlockSize || blockSize > Cue::Core::k_maxCompressedBlockSize)
+            {
+                std::fprintf(stderr, "PakTool: --block-size must be between %u and %u KB\n",
+                    Cue::Core::k_minCompressedBlockSize / 1024u, Cue::Core::k_maxCompressedBlockSize / 1024u);
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::fprintf(stderr, "PakTool: unknown option %s\n", argv[argIndex]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (argc - argIndex < 2)
+    {
+        std::fprintf(stderr, "usage: PakTool [--store | --block-size KB] <output.pak> <input-dir> [input-dir...]\n");
+        return EXIT_FAILURE;
+    }
+
+    // 2) 入力ディレクトリを辿って登録する
+    Cue::Core::PakWriter writer;
+    for (int i = argIndex + 1; i < argc; ++i)
+    {
+        const std::filesystem::path root(reinterpret_cast<const char8_t*>(argv[i]));
+        std::error_code error;
+        for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+        {
+            if (!it->is_regular_file(error))
+            {
+                continue;
+            }
+            writer.add_file(to_utf8(it->path().lexically_relative(root)), to_utf8(it->path()));
+        }
+        if (error)
+        {
+            std::fprintf(stderr, "PakTool: failed to enumerate %s (%s)\n", argv[i], error.message().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 3) ブロックの圧縮はワーカーに分けて書き出す
+    Cue::Core::JobSystem jobSystem;
+    if (blockSize != 0)
+    {
+        const Cue::Core::Result r = jobSystem.initialize();
+        if (!r)
+        {
+            return report_failure(r);
+        }
+        writer.set_compression(blockSize, &jobSystem);
+    }
+    const Cue::Core::Result r = writer.write(argv[argIndex]);
+    jobSystem.shutdown();
+    if (!r)
+    {
+        return report_failure(r);
+    }
+    const Cue::Core::PakWriteStats& stats = writer.get_stats();
+    std::printf("PakTool: wrote %zu entries (%u compressed) to %s, %.2f MB -> %.2f MB (%.1f%%)\n",
+        writer.get_entry_count(), stats.compressedCount, argv[argIndex],
+        static_cast<double>(stats.sourceBytes) / (1024.0 * 1024.0),
+        static_cast<double>(stats.storedBytes) / (1024.0 * 1024.0),
+        stats.sourceBytes != 0 ? 100.0 * static_cast<double>(stats.storedBytes) / static_cast<double>(stats.sourceBytes) : 100.0);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,267 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CUE_PACER_PAUSE() _mm_pause()
+#else
+#define CUE_PACER_PAUSE() std::this_thread::yield()
+#endif
+
+namespace Cue::Platform
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct FramePacer::Impl
+    {
+        FramePacerDesc desc{};
+        Clock::duration period{};
+        Clock::time_point deadline{};
+        Clock::time_point lastFrame{};
+        bool isInitialized = false;
+        bool hasLastFrame = false;
+
+        // 実測したスリープの寝過ごし量（スピン区間を決める）
+        Clock::duration oversleep{};
+
+        std::vector<uint32_t> buckets;
+        uint64_t frameCount = 0;
+        uint64_t missedCount = 0;
+        Clock::duration total{};
+        Clock::duration minTime = Clock::duration::max();
+        Clock::duration maxTime{};
+
+#if defined(_WIN32)
+        HANDLE timer = nullptr;
+#endif
+
+        void sleep_until(Clock::time_point target) noexcept
+        {
+#if defined(_WIN32)
+            // 1) 高精度の待機可能タイマーで相対時間だけ待つ（100ns 単位、負値で相対指定）
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(target - Clock::now());
+            if (remaining.count() <= 0)
+            {
+                return;
+            }
+            if (timer)
+            {
+                LARGE_INTEGER dueTime{};
+                dueTime.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100);
+                if (::SetWaitableTimerEx(timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+                {
+                    ::WaitForSingleObject(timer, INFINITE);
+                    return;
+                }
+            }
+            // 高精度タイマーが使えない環境では timeBeginPeriod(1) 前提のミリ秒スリープに落とす
+            ::Sleep(static_cast<DWORD>(remaining.count() / 1000000));
+#else
+            // 1) steady_clock は CLOCK_MONOTONIC なので、絶対時刻で眠れば割り込みで延びない
+            const auto since = std::chrono::duration_cast<std::chrono::nanoseconds>(target.time_since_epoch());
+            timespec ts{};
+            ts.tv_sec = static_cast<time_t>(since.count() / 1000000000);
+            ts.tv_nsec = static_cast<long>(since.count() % 1000000000);
+            while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+            {
+            }
+#endif
+        }
+
+        void record(Clock::duration frameTime, bool isMissed) noexcept
+        {
+            // 1) 固定幅の区間に積む（範囲外は最後の区間）
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(frameTime).count();
+            const size_t bucket = std::min<size_t>(static_cast<size_t>(std::max<int64_t>(us, 0)) / k_bucketWidthUs,
+                k_bucketCount - 1);
+            ++buckets[bucket];
+
+            // 2) 端の値と平均は区間に丸めず正確に持つ
+            ++frameCount;
+            missedCount += isMissed ? 1u : 0u;
+            total += frameTime;
+            minTime = std::min(minTime, frameTime);
+            maxTime = std::max(maxTime, frameTime);
+        }
+
+        double percentile_ms(double p) const noexcept
+        {
+            // 1) 累積が目標を越えた区間の中央値を返す
+            const uint64_t target = static_cast<uint64_t>(p * static_cast<double>(frameCount - 1)) + 1;
+            uint64_t accumulated = 0;
+            for (size_t i = 0; i < buckets.size(); ++i)
+            {
+                accumulated += buckets[i];
+                if (accumulated >= target)
+                {
+                    const double centerUs = (static_cast<double>(i) + 0.5) * k_bucketWidthUs;
+                    // 区間の中央が実測の範囲を外れないよう端の値で挟む
+                    const double minMs = std::chrono::duration<double, std::milli>(minTime).count();
+                    const double maxMs = std::chrono::duration<double, std::milli>(maxTime).count();
+                    return std::clamp(centerUs / 1000.0, minMs, maxMs);
+                }
+            }
+            return std::chrono::duration<double, std::milli>(maxTime).count();
+        }
+    };
+
+    FramePacer::FramePacer()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+
+    FramePacer::~FramePacer()
+    {
+        shutdown();
+    }
+
+    Core::Result FramePacer::initialize(const FramePacerDesc& desc)
+    {
+        if (m_impl->isInitialized)
+        {
+            return Core::Result::fail(Core::Facility::Platform, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "FramePacer is already initialized.");
+        }
+        if (desc.targetFps < 0.0 || desc.spinThreshold.count() < 0)
+        {
+            return Core::Result::fail(Core::Facility::Platform, Core::Code::InvalidArg, Core::Severity::Error, 0,
+                "FramePacer desc is invalid.");
+        }
+
+#if defined(_WIN32)
+        // 1) 高精度の待機可能タイマーを作る（Windows 10 1803 より前では失敗するのでミリ秒スリープに落とす）
+        m_impl->timer = ::CreateWaitableTimerExW(nullptr, nullptr,
+            CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+
+        // 2) 集計領域を一度だけ確保する
+        m_impl->desc = desc;
+        m_impl->buckets.assign(k_bucketCount, 0);
+        m_impl->isInitialized = true;
+        set_target_fps(desc.targetFps);
+        reset_stats();
+        return Core::Result::ok();
+    }
+
+    void FramePacer::shutdown()
+    {
+        if (!m_impl->isInitialized)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        if (m_impl->timer)
+        {
+            ::CloseHandle(m_impl->timer);
+            m_impl->timer = nullptr;
+        }
+#endif
+        m_impl->isInitialized = false;
+    }
+
+    void FramePacer::set_target_fps(double targetFps) noexcept
+    {
+        m_impl->desc.targetFps = std::max(targetFps, 0.0);
+        m_impl->period = m_impl->desc.targetFps > 0.0
+            ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_impl->desc.targetFps))
+            : Clock::duration::zero();
+        // 周期が変わったら次のフレームから数え直す
+        m_impl->hasLastFrame = false;
+    }
+
+    void FramePacer::wait_for_next_frame()
+    {
+        Impl& impl = *m_impl;
+        if (!impl.isInitialized)
+        {
+            return;
+        }
+        Clock::time_point now = Clock::now();
+        if (!impl.hasLastFrame)
+        {
+            // 1) 最初のフレームは基準時刻を決めるだけ
+            impl.lastFrame = now;
+            impl.deadline = now + impl.period;
+            impl.hasLastFrame = true;
+            return;
+        }
+
+        // 2) 期限に間に合っていれば、粗く眠ってから最後の区間だけスピンする
+        const bool isPaced = impl.period > Clock::duration::zero();
+        const bool isMissed = isPaced && now > impl.deadline;
+        if (isPaced && !isMissed)
+        {
+            const Clock::duration margin = std::max<Clock::duration>(impl.desc.spinThreshold, impl.oversleep);
+            const Clock::time_point wakeTarget = impl.deadline - margin;
+            if (now < wakeTarget)
+            {
+                impl.sleep_until(wakeTarget);
+                now = Clock::now();
+                // 寝過ごしを徐々に忘れつつ最大値を覚える（一時的な遅れでスピンし続けないように）
+                const Clock::duration late = now > wakeTarget ? now - wakeTarget : Clock::duration::zero();
+                impl.oversleep = std::max(late, impl.oversleep - impl.oversleep / 16);
+                impl.oversleep = std::min<Clock::duration>(impl.oversleep, impl.period / 2);
+            }
+            while (now < impl.deadline)
+            {
+                CUE_PACER_PAUSE();
+                now = Clock::now();
+            }
+        }
+
+        // 3) フレーム時間を記録し、次の期限を決める
+        impl.record(now - impl.lastFrame, isMissed);
+        impl.lastFrame = now;
+        if (isPaced)
+        {
+            impl.deadline += impl.period;
+            if (impl.deadline <= now)
+            {
+                // 大きく遅れたときに取り戻そうと連続で走らないよう、今から数え直す
+                impl.deadline = now + impl.period;
+            }
+        }
+    }
+
+    FrameTimeStats FramePacer::get_stats() const noexcept
+    {
+        const Impl& impl = *m_impl;
+        FrameTimeStats stats{};
+        if (impl.frameCount == 0)
+        {
+            return stats;
+        }
+        stats.frameCount = impl.frameCount;
+        stats.missedCount = impl.missedCount;
+        stats.minMs = std::chrono::duration<double, std::milli>(impl.minTime).count();
+        stats.maxMs = std::chrono::duration<double, std::milli>(impl.maxTime).count();
+        stats.avgMs = std::chrono::duration<double, std::milli>(impl.total).count() / static_cast<double>(impl.frameCount);
+        stats.p50Ms = impl.percentile_ms(0.50);
+        stats.p99Ms = impl.percentile_ms(0.99);
+        return stats;
+    }
+
+    void FramePacer::reset_stats() noexcept
+    {
+        Impl& impl = *m_impl;
+        std::fill(impl.buckets.begin(), impl.buckets.end(), 0u);
+        impl.frameCount = 0;
+        impl.missedCount = 0;
+        impl.total = Clock::duration::zero();
+        impl.minTime = Clock::duration::max();
+        impl.maxTime = Clock::duration::zero();
+    }
+} // namespace Cue::Platform
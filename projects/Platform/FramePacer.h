@@ -0,0 +1,59 @@
+#pragma once
+#include <Result.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace Cue::Platform
+{
+    struct FramePacerDesc
+    {
+        // 目標フレームレート（0 で上限なし：待たずに計測だけ行う）
+        double targetFps = 60.0;
+        // 期限の直前はこの時間だけ眠らずに回して、OS のスリープ精度による揺れを抑える
+        std::chrono::microseconds spinThreshold{ 1000 };
+    };
+
+    /// @brief フレーム時間の集計
+    struct FrameTimeStats
+    {
+        uint64_t frameCount = 0;
+        // 期限までに作業が終わらなかったフレーム数
+        uint64_t missedCount = 0;
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /// @brief フレームの開始間隔を目標フレームレートに揃える
+    /// @details 大半は OS のスリープで待ち、最後の短い区間だけスピンする。
+    ///          フレーム時間は固定幅のヒストグラムに積むので、毎フレームの確保は無い。
+    class FramePacer final
+    {
+    public:
+        // ヒストグラムの 1 区間の幅と区間数（これを超えるフレームは最後の区間に入る）
+        static constexpr uint32_t k_bucketWidthUs = 50;
+        static constexpr uint32_t k_bucketCount = 4096;
+
+        FramePacer();
+        ~FramePacer();
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        [[nodiscard]] Core::Result initialize(const FramePacerDesc& desc);
+        void shutdown();
+
+        /// @brief フレームの終わりに呼び、次のフレームの開始時刻まで待つ
+        void wait_for_next_frame();
+        /// @brief 目標フレームレートを変える（0 で上限なし）
+        void set_target_fps(double targetFps) noexcept;
+
+        [[nodiscard]] FrameTimeStats get_stats() const noexcept;
+        void reset_stats() noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Platform
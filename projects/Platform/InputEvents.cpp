@@ -0,0 +1,137 @@
+#include "InputEvents.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace Cue::Platform
+{
+    namespace
+    {
+        // 容量の上限（イベント 32 バイトで 2MB）
+        constexpr uint32_t k_maxCapacity = 1u << 16;
+
+        uint32_t round_up_pow2(uint32_t v) noexcept
+        {
+            uint32_t p = 1;
+            while (p < v)
+            {
+                p <<= 1;
+            }
+            return p;
+        }
+    }
+
+    uint64_t get_input_timestamp() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    struct InputEventQueue::Impl
+    {
+        std::unique_ptr<InputEvent[]> events;
+        uint32_t mask = 0;
+
+        // 生産者と消費者が別々に書くので偽共有を避ける
+        alignas(64) std::atomic<uint64_t> tail{ 0 };
+        uint64_t cachedHead = 0;
+        std::atomic<uint64_t> dropped{ 0 };
+        alignas(64) std::atomic<uint64_t> head{ 0 };
+        uint64_t cachedTail = 0;
+    };
+
+    InputEventQueue::InputEventQueue()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    InputEventQueue::~InputEventQueue()
+    {
+    }
+    Core::Result InputEventQueue::initialize(uint32_t capacity)
+    {
+        if (m_impl->events)
+        {
+            return Core::Result::fail(Core::Facility::Platform, Core::Code::InvalidState, Core::Severity::Error, 0,
+                "InputEventQueue is already initialized.");
+        }
+        if (capacity == 0 || capacity > k_maxCapacity)
+        {
+            return Core::Result::fail(Core::Facility::Platform, Core::Code::InvalidArg, Core::Severity::Error, capacity,
+                "InputEventQueue capacity is out of range.");
+        }
+
+        // 1) 確保はここだけ（以降の push/pop は確保しない）
+        const uint32_t rounded = round_up_pow2(capacity);
+        m_impl->events = std::make_unique_for_overwrite<InputEvent[]>(rounded);
+        m_impl->mask = rounded - 1;
+        m_impl->tail.store(0, std::memory_order_relaxed);
+        m_impl->head.store(0, std::memory_order_relaxed);
+        m_impl->cachedHead = 0;
+        m_impl->cachedTail = 0;
+        m_impl->dropped.store(0, std::memory_order_relaxed);
+        return Core::Result::ok();
+    }
+    void InputEventQueue::shutdown()
+    {
+        m_impl->events.reset();
+        m_impl->mask = 0;
+    }
+    bool InputEventQueue::push(const InputEvent& event) noexcept
+    {
+        Impl& impl = *m_impl;
+        if (!impl.events)
+        {
+            return false;
+        }
+
+        // 1) 手元の head で空きが足りなければ、消費者の進み具合を読み直す
+        const uint64_t tail = impl.tail.load(std::memory_order_relaxed);
+        if (tail - impl.cachedHead > impl.mask)
+        {
+            impl.cachedHead = impl.head.load(std::memory_order_acquire);
+            if (tail - impl.cachedHead > impl.mask)
+            {
+                impl.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        // 2) 書いてから公開する
+        impl.events[tail & impl.mask] = event;
+        impl.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    uint32_t InputEventQueue::pop(std::span<InputEvent> out) noexcept
+    {
+        Impl& impl = *m_impl;
+        if (!impl.events || out.empty())
+        {
+            return 0;
+        }
+
+        // 1) 手元の tail に残りが無ければ、生産者の進み具合を読み直す
+        const uint64_t head = impl.head.load(std::memory_order_relaxed);
+        if (impl.cachedTail == head)
+        {
+            impl.cachedTail = impl.tail.load(std::memory_order_acquire);
+        }
+        const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(impl.cachedTail - head, out.size()));
+
+        // 2) 写し終えてから枠を返す
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            out[i] = impl.events[(head + i) & impl.mask];
+        }
+        impl.head.store(head + count, std::memory_order_release);
+        return count;
+    }
+    uint32_t InputEventQueue::get_capacity() const noexcept
+    {
+        return m_impl->events ? m_impl->mask + 1 : 0;
+    }
+    uint64_t InputEventQueue::get_dropped_count() const noexcept
+    {
+        return m_impl->dropped.load(std::memory_order_relaxed);
+    }
+} // namespace Cue::Platform
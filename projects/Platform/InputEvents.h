@@ -0,0 +1,110 @@
+#pragma once
+#include <Result.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace Cue::Platform
+{
+    enum class InputEventType : uint8_t
+    {
+        None = 0,
+        // code: 仮想キー、scanCode: ハードウェアのスキャンコード
+        KeyDown,
+        KeyUp,
+        // code: 入力された文字（UTF-32）
+        Char,
+        // x, y: クライアント座標
+        MouseMove,
+        // x, y: 加速前の移動量（Raw Input）
+        MouseRawDelta,
+        // button: 押されたボタン、x, y: クライアント座標
+        MouseButtonDown,
+        MouseButtonUp,
+        // x: 横、y: 縦の回転量（1 ノッチ = k_wheelDelta）
+        MouseWheel,
+        // x, y: 新しいクライアントサイズ
+        Resize,
+        FocusGained,
+        FocusLost,
+    };
+
+    enum class MouseButton : uint8_t
+    {
+        None = 0,
+        Left,
+        Right,
+        Middle,
+        X1,
+        X2,
+    };
+
+    /// @brief 修飾キーのビット
+    namespace InputModifier
+    {
+        constexpr uint16_t k_shift = 1u << 0;
+        constexpr uint16_t k_control = 1u << 1;
+        constexpr uint16_t k_alt = 1u << 2;
+    }
+
+    /// @brief InputEvent::flags のビット
+    namespace InputFlag
+    {
+        // キーの押しっぱなしによる繰り返し
+        constexpr uint32_t k_repeat = 1u << 0;
+    }
+
+    // ホイール 1 ノッチ分の回転量
+    constexpr int32_t k_wheelDelta = 120;
+
+    /// @brief OS に依存しない固定長の入力イベント
+    struct InputEvent
+    {
+        // get_input_timestamp の時刻（OS からイベントを受け取った時点）
+        uint64_t timestampNs = 0;
+        InputEventType type = InputEventType::None;
+        MouseButton button = MouseButton::None;
+        uint16_t modifiers = 0;
+        uint32_t code = 0;
+        uint32_t scanCode = 0;
+        int32_t x = 0;
+        int32_t y = 0;
+        uint32_t flags = 0;
+    };
+
+    static_assert(sizeof(InputEvent) == 32, "InputEvent must stay a fixed 32-byte record.");
+
+    /// @brief 入力の時刻（steady_clock のナノ秒、スレッド間で比較できる）
+    [[nodiscard]] uint64_t get_input_timestamp() noexcept;
+
+    /// @brief プラットフォーム層（生産者 1 つ）からエンジン（消費者 1 つ）へ入力を渡す SPSC リング
+    /// @details push と pop はそれぞれ 1 つのスレッドからだけ呼ぶ。ロックも確保もしないので、
+    ///          メッセージポンプを別スレッドで回しても tick を止めない。満杯なら新しい方を捨てて数える。
+    class InputEventQueue final
+    {
+    public:
+        InputEventQueue();
+        ~InputEventQueue();
+        InputEventQueue(const InputEventQueue&) = delete;
+        InputEventQueue& operator=(const InputEventQueue&) = delete;
+
+        /// @brief リングを確保する
+        /// @param capacity 容量（イベント数、2 の冪に切り上げる）
+        [[nodiscard]] Core::Result initialize(uint32_t capacity = 1024);
+        void shutdown();
+
+        /// @brief 生産者側：1 件積む
+        /// @return 満杯・未初期化で捨てた場合は false
+        bool push(const InputEvent& event) noexcept;
+        /// @brief 消費者側：古い順に out へ取り出す
+        /// @return 取り出した件数
+        uint32_t pop(std::span<InputEvent> out) noexcept;
+
+        [[nodiscard]] uint32_t get_capacity() const noexcept;
+        /// @brief 満杯で捨てたイベント数（累計）
+        [[nodiscard]] uint64_t get_dropped_count() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Platform
@@ -2,6 +2,8 @@
 #include <Result.h>
 #include <memory>
 
+#include "InputEvents.h"
+
 namespace Cue::Platform
 {
     class IPlatform
@@ -15,5 +17,7 @@ namespace Cue::Platform
         virtual void end_frame() = 0;
         virtual bool poll_message() = 0;
         virtual Core::Result shutdown() = 0;
+        /// @brief OS の入力イベントを積むリング（プラットフォームが生産者、エンジンが消費者）
+        [[nodiscard]] virtual InputEventQueue& get_input_queue() noexcept = 0;
     };
 } // namespace Cue
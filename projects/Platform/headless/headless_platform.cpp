@@ -0,0 +1,283 @@
+#include "headless_platform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Cue::Platform
+{
+    std::unique_ptr<IPlatform> create_platform()
+    {
+        return std::make_unique<Headless::HeadlessPlatform>();
+    }
+}
+
+namespace Cue::Platform::Headless
+{
+    namespace
+    {
+        // 合成イベントのマウス座標が動く範囲
+        constexpr int32_t k_syntheticWidth = 1920;
+        constexpr int32_t k_syntheticHeight = 1080;
+
+        uint32_t next_random(uint32_t& state) noexcept
+        {
+            // xorshift32（0 にならないよう種は 1 以上にしておく）
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        /// @brief 実機の入力に近い割合（大半がマウス移動）でイベントを 1 件作る
+        InputEvent make_synthetic_event(uint32_t& state, int32_t& mouseX, int32_t& mouseY) noexcept
+        {
+            InputEvent event{};
+            const uint32_t r = next_random(state);
+            const uint32_t kind = r & 15;
+            if (kind < 10)
+            {
+                mouseX = std::clamp(mouseX + static_cast<int32_t>((r >> 4) & 15) - 7, 0, k_syntheticWidth - 1);
+                mouseY = std::clamp(mouseY + static_cast<int32_t>((r >> 8) & 15) - 7, 0, k_syntheticHeight - 1);
+                event.type = InputEventType::MouseMove;
+                event.x = mouseX;
+                event.y = mouseY;
+            }
+            else if (kind < 12)
+            {
+                event.type = InputEventType::MouseRawDelta;
+                event.x = static_cast<int32_t>((r >> 4) & 15) - 7;
+                event.y = static_cast<int32_t>((r >> 8) & 15) - 7;
+            }
+            else if (kind < 14)
+            {
+                event.type = kind == 12 ? InputEventType::KeyDown : InputEventType::KeyUp;
+                event.code = 'A' + (r >> 4) % 26;
+                event.scanCode = 0x10 + (r >> 4) % 26;
+            }
+            else if (kind == 14)
+            {
+                event.type = InputEventType::MouseWheel;
+                event.y = (r & 0x100) ? k_wheelDelta : -k_wheelDelta;
+            }
+            else
+            {
+                event.type = (r & 0x100) ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp;
+                event.button = MouseButton::Left;
+                event.x = mouseX;
+                event.y = mouseY;
+            }
+            return event;
+        }
+    }
+
+    struct HeadlessPlatform::Impl
+    {
+        using Clock = std::chrono::steady_clock;
+
+        uint64_t m_frameLimit = 0;
+        std::chrono::nanoseconds m_timeBudget{ 0 };
+        Clock::time_point m_startTime{};
+        uint64_t m_frameCount = 0;
+        bool m_isSetup = false;
+        bool m_isStarted = false;
+        bool m_isInFrame = false;
+        bool m_shouldQuit = false;
+
+        InputEventQueue m_inputQueue;
+        uint32_t m_inputCapacity = 1024;
+        std::thread m_inputThread;
+        std::atomic<bool> m_isInputRunning{ false };
+        std::atomic<uint64_t> m_syntheticCount{ 0 };
+
+        /// @brief 合成スレッド本体：期限までに溜まった分をまとめて積み、次の期限まで眠る
+        void run_synthetic_input(SyntheticInputDesc desc)
+        {
+            const auto period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / desc.eventsPerSecond));
+            uint32_t state = desc.seed != 0 ? desc.seed : 1;
+            int32_t mouseX = k_syntheticWidth / 2;
+            int32_t mouseY = k_syntheticHeight / 2;
+            Clock::time_point next = Clock::now();
+            while (m_isInputRunning.load(std::memory_order_acquire))
+            {
+                // 1) 期限を過ぎた分を積む（時刻は積む直前に取る）
+                const Clock::time_point now = Clock::now();
+                while (next <= now)
+                {
+                    InputEvent event = make_synthetic_event(state, mouseX, mouseY);
+                    event.timestampNs = get_input_timestamp();
+                    m_inputQueue.push(event);
+                    m_syntheticCount.fetch_add(1, std::memory_order_relaxed);
+                    next += period;
+                }
+
+                // 2) 次の期限まで眠る
+                std::this_thread::sleep_until(next);
+            }
+        }
+    };
+
+    HeadlessPlatform::HeadlessPlatform()
+        : m_impl(std::make_unique<Impl>())
+    {
+    }
+    HeadlessPlatform::~HeadlessPlatform()
+    {
+        stop_synthetic_input();
+    }
+    Core::Result HeadlessPlatform::setup()
+    {
+        // 1) 二重初期化は状態が壊れるので拒否する
+        if (m_impl->m_isSetup)
+        {
+            return Core::Result::fail(
+                Core::Facility::Platform,
+                Core::Code::InvalidState,
+                Core::Severity::Error,
+                0, "HeadlessPlatform is already set up.");
+        }
+
+        // 2) 入力リングを確保する
+        Core::Result r = m_impl->m_inputQueue.initialize(m_impl->m_inputCapacity);
+        if (!r)
+        {
+            return r;
+        }
+
+        // 3) 計測をやり直せるようにカウンタを初期化する
+        m_impl->m_frameCount = 0;
+        m_impl->m_shouldQuit = false;
+        m_impl->m_isSetup = true;
+        return Core::Result::ok();
+    }
+    Core::Result HeadlessPlatform::start()
+    {
+        if (!m_impl->m_isSetup)
+        {
+            return Core::Result::fail(
+                Core::Facility::Platform,
+                Core::Code::InvalidState,
+                Core::Severity::Error,
+                0, "HeadlessPlatform::start called before setup.");
+        }
+
+        // 1) 時間上限は start からの経過で判定する
+        m_impl->m_startTime = Impl::Clock::now();
+        m_impl->m_isStarted = true;
+        return Core::Result::ok();
+    }
+    void HeadlessPlatform::begin_frame()
+    {
+        m_impl->m_isInFrame = true;
+    }
+    void HeadlessPlatform::end_frame()
+    {
+        // 1) begin_frame と対になったフレームだけを完了として数える
+        if (m_impl->m_isInFrame)
+        {
+            ++m_impl->m_frameCount;
+            m_impl->m_isInFrame = false;
+        }
+    }
+    bool HeadlessPlatform::poll_message()
+    {
+        // 1) 起動していなければループを回さない
+        if (!m_impl->m_isStarted || m_impl->m_shouldQuit)
+        {
+            return false;
+        }
+
+        // 2) フレーム数の上限
+        if (m_impl->m_frameLimit != 0 && m_impl->m_frameCount >= m_impl->m_frameLimit)
+        {
+            return false;
+        }
+
+        // 3) 時間の上限（無制限なら時計を読まない）
+        if (m_impl->m_timeBudget.count() != 0)
+        {
+            const auto elapsed = Impl::Clock::now() - m_impl->m_startTime;
+            if (elapsed >= m_impl->m_timeBudget)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    Core::Result HeadlessPlatform::shutdown()
+    {
+        // 1) 生産者を止めてからリングを手放す
+        stop_synthetic_input();
+        m_impl->m_inputQueue.shutdown();
+        m_impl->m_isStarted = false;
+        m_impl->m_isSetup = false;
+        return Core::Result::ok();
+    }
+    InputEventQueue& HeadlessPlatform::get_input_queue() noexcept
+    {
+        return m_impl->m_inputQueue;
+    }
+    void HeadlessPlatform::set_frame_limit(uint64_t frameCount) noexcept
+    {
+        m_impl->m_frameLimit = frameCount;
+    }
+    void HeadlessPlatform::set_time_budget(std::chrono::nanoseconds budget) noexcept
+    {
+        m_impl->m_timeBudget = budget;
+    }
+    void HeadlessPlatform::request_quit() noexcept
+    {
+        m_impl->m_shouldQuit = true;
+    }
+    uint64_t HeadlessPlatform::get_frame_count() const noexcept
+    {
+        return m_impl->m_frameCount;
+    }
+    void HeadlessPlatform::set_input_capacity(uint32_t capacity) noexcept
+    {
+        m_impl->m_inputCapacity = capacity;
+    }
+    Core::Result HeadlessPlatform::start_synthetic_input(const SyntheticInputDesc& desc)
+    {
+        // 1) リングが無い・既に動いている・間隔が決まらない場合は拒否する
+        if (!m_impl->m_isSetup || m_impl->m_isInputRunning.load(std::memory_order_relaxed))
+        {
+            return Core::Result::fail(
+                Core::Facility::Platform,
+                Core::Code::InvalidState,
+                Core::Severity::Error,
+                0, "Synthetic input requires setup and must not already be running.");
+        }
+        if (!(desc.eventsPerSecond > 0.0))
+        {
+            return Core::Result::fail(
+                Core::Facility::Platform,
+                Core::Code::InvalidArg,
+                Core::Severity::Error,
+                0, "Synthetic input rate must be positive.");
+        }
+
+        // 2) 生産者スレッドを起動する
+        m_impl->m_syntheticCount.store(0, std::memory_order_relaxed);
+        m_impl->m_isInputRunning.store(true, std::memory_order_release);
+        m_impl->m_inputThread = std::thread([impl = m_impl.get(), desc]() { impl->run_synthetic_input(desc); });
+        return Core::Result::ok();
+    }
+    void HeadlessPlatform::stop_synthetic_input()
+    {
+        m_impl->m_isInputRunning.store(false, std::memory_order_release);
+        if (m_impl->m_inputThread.joinable())
+        {
+            m_impl->m_inputThread.join();
+        }
+    }
+    bool HeadlessPlatform::push_input(const InputEvent& event) noexcept
+    {
+        return m_impl->m_inputQueue.push(event);
+    }
+    uint64_t HeadlessPlatform::get_synthetic_event_count() const noexcept
+    {
+        return m_impl->m_syntheticCount.load(std::memory_order_relaxed);
+    }
+} // namespace Cue::Platform::Headless
@@ -0,0 +1,63 @@
+#pragma once
+#include <Platform.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "PlatformFactory.h"
+
+namespace Cue::Platform::Headless
+{
+    /// @brief 合成入力の設定
+    struct SyntheticInputDesc
+    {
+        // 1 秒あたりに積むイベント数
+        double eventsPerSecond = 1000.0;
+        // 乱数の種（同じ種なら同じ並びになる）
+        uint32_t seed = 1;
+    };
+
+    /// @brief ウィンドウを持たないプラットフォーム
+    /// @details GPU やウィンドウシステムの無い環境で Engine::tick を繰り返し回し、
+    ///          フレームループの CPU コストを再現性のある条件で計測するために使う。
+    ///          poll_message はフレーム数か経過時間の上限に達した時点で false を返す。
+    ///          入力は合成スレッド（ポンプを別スレッドで回した場合の代わり）か push_input で積む。
+    class HeadlessPlatform : public IPlatform
+    {
+    public:
+        HeadlessPlatform();
+        ~HeadlessPlatform() override;
+
+        Core::Result setup() override;
+        Core::Result start() override;
+        void begin_frame() override;
+        void end_frame() override;
+        bool poll_message() override;
+        Core::Result shutdown() override;
+        InputEventQueue& get_input_queue() noexcept override;
+
+        /// @brief 実行するフレーム数の上限を設定する
+        /// @param frameCount 上限フレーム数（0 で無制限）
+        void set_frame_limit(uint64_t frameCount) noexcept;
+        /// @brief 実行時間の上限を設定する
+        /// @param budget start からの経過時間の上限（0 で無制限）
+        void set_time_budget(std::chrono::nanoseconds budget) noexcept;
+        /// @brief 次の poll_message で終了させる
+        void request_quit() noexcept;
+        /// @brief end_frame まで完了したフレーム数
+        [[nodiscard]] uint64_t get_frame_count() const noexcept;
+
+        /// @brief 入力リングの容量を設定する（setup より前に呼ぶ）
+        void set_input_capacity(uint32_t capacity) noexcept;
+        /// @brief 一定間隔で入力イベントを積むスレッドを起動する（setup の後に呼ぶ）
+        [[nodiscard]] Core::Result start_synthetic_input(const SyntheticInputDesc& desc);
+        /// @brief 合成スレッドを止める（shutdown でも止まる）
+        void stop_synthetic_input();
+        /// @brief 呼び出したスレッドから 1 件積む（SPSC なので合成スレッドの動作中は使わない）
+        bool push_input(const InputEvent& event) noexcept;
+        /// @brief 合成スレッドが積もうとしたイベント数（捨てられた分を含む）
+        [[nodiscard]] uint64_t get_synthetic_event_count() const noexcept;
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+} // namespace Cue::Platform::Headless
@@ -1,6 +1,9 @@
 #include "pch.h"
 #include "WinApp.h"
 
+#include <atomic>
+#include <future>
+#include <thread>
 #include <timeapi.h>
 #include <wrl.h>
 #ifdef CUE_DEBUG
@@ -11,6 +14,39 @@
 
 namespace Cue::Platform::Win
 {
+    namespace
+    {
+        // ポンプスレッドにウィンドウの破棄を頼むメッセージ（DestroyWindow は生成したスレッドでしか呼べない）
+        constexpr UINT k_destroyMessage = WM_APP + 1;
+
+        uint16_t get_modifiers() noexcept
+        {
+            uint16_t modifiers = 0;
+            if (::GetKeyState(VK_SHIFT) < 0)
+            {
+                modifiers |= InputModifier::k_shift;
+            }
+            if (::GetKeyState(VK_CONTROL) < 0)
+            {
+                modifiers |= InputModifier::k_control;
+            }
+            if (::GetKeyState(VK_MENU) < 0)
+            {
+                modifiers |= InputModifier::k_alt;
+            }
+            return modifiers;
+        }
+
+        int32_t get_x(LPARAM lParam) noexcept
+        {
+            return static_cast<int16_t>(LOWORD(lParam));
+        }
+        int32_t get_y(LPARAM lParam) noexcept
+        {
+            return static_cast<int16_t>(HIWORD(lParam));
+        }
+    }
+
     struct WinApp::Impl
     {
         // Windowsアプリケーションに関する実装の詳細をここに記述
@@ -19,7 +55,104 @@ namespace Cue::Platform::Win
         uint32_t m_height = 0;
         bool m_isComInitialized = false;
         bool m_isTimePeriodSet = false;
-        bool m_shouldClose = false;
+        // ポンプを別スレッドで回す時はメインスレッドから読むので atomic にする
+        std::atomic<bool> m_shouldClose{ false };
+
+        // 入力の積み先（ポンプを回すスレッドが唯一の生産者）
+        InputEventQueue* m_inputQueue = nullptr;
+        // WM_CHAR で届いたサロゲートの上位（下位が届いたら 1 文字にする）
+        WCHAR m_highSurrogate = 0;
+
+        std::thread m_pumpThread;
+        bool m_isPumpThreaded = false;
+
+        void push_input(InputEvent event) noexcept
+        {
+            // 1) OS から受け取った時点の時刻と修飾キーを付けて積む（満杯ならリング側で数えて捨てる）
+            if (!m_inputQueue)
+            {
+                return;
+            }
+            event.timestampNs = get_input_timestamp();
+            event.modifiers = get_modifiers();
+            m_inputQueue->push(event);
+        }
+
+        void push_key(InputEventType type, WPARAM wParam, LPARAM lParam) noexcept
+        {
+            InputEvent event{};
+            event.type = type;
+            event.code = static_cast<uint32_t>(wParam);
+            // lParam の 16-23bit がスキャンコード、24bit が拡張キー
+            event.scanCode = static_cast<uint32_t>((lParam >> 16) & 0xFF) | ((lParam & (1 << 24)) ? 0xE000u : 0u);
+            if (type == InputEventType::KeyDown && (lParam & (1 << 30)))
+            {
+                event.flags |= InputFlag::k_repeat;
+            }
+            push_input(event);
+        }
+
+        void push_char(WPARAM wParam) noexcept
+        {
+            // 1) UTF-16 のサロゲートペアは 2 回に分けて届くので揃ってから積む
+            const WCHAR unit = static_cast<WCHAR>(wParam);
+            uint32_t codePoint = unit;
+            if (unit >= 0xD800 && unit <= 0xDBFF)
+            {
+                m_highSurrogate = unit;
+                return;
+            }
+            if (unit >= 0xDC00 && unit <= 0xDFFF)
+            {
+                if (m_highSurrogate == 0)
+                {
+                    return;
+                }
+                codePoint = 0x10000u + ((static_cast<uint32_t>(m_highSurrogate) - 0xD800u) << 10) + (unit - 0xDC00u);
+            }
+            m_highSurrogate = 0;
+
+            InputEvent event{};
+            event.type = InputEventType::Char;
+            event.code = codePoint;
+            push_input(event);
+        }
+
+        void push_mouse(InputEventType type, MouseButton button, LPARAM lParam) noexcept
+        {
+            InputEvent event{};
+            event.type = type;
+            event.button = button;
+            event.x = get_x(lParam);
+            event.y = get_y(lParam);
+            push_input(event);
+        }
+
+        void push_raw_input(LPARAM lParam) noexcept
+        {
+            // 1) マウスの相対移動だけを拾う（絶対座標のタブレット等は MouseMove で足りる）
+            RAWINPUT raw{};
+            UINT size = sizeof(raw);
+            if (::GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &raw, &size,
+                sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1))
+            {
+                return;
+            }
+            if (raw.header.dwType != RIM_TYPEMOUSE || (raw.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) != 0)
+            {
+                return;
+            }
+            if (raw.data.mouse.lLastX == 0 && raw.data.mouse.lLastY == 0)
+            {
+                return;
+            }
+
+            InputEvent event{};
+            event.type = InputEventType::MouseRawDelta;
+            event.x = static_cast<int32_t>(raw.data.mouse.lLastX);
+            event.y = static_cast<int32_t>(raw.data.mouse.lLastY);
+            push_input(event);
+        }
 
         LRESULT on_message(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         {
@@ -28,12 +161,90 @@ namespace Cue::Platform::Win
             case WM_CLOSE:
                 // 1) 破棄はエンジン側の終了手順に委譲する
                 // 2) メインループを抜けるためのフラグを立てる
-                m_shouldClose = true;
+                m_shouldClose.store(true, std::memory_order_release);
                 return 0;
 
             case WM_SIZE:
                 m_width = static_cast<uint32_t>(LOWORD(lParam));
                 m_height = static_cast<uint32_t>(HIWORD(lParam));
+                {
+                    InputEvent event{};
+                    event.type = InputEventType::Resize;
+                    event.x = static_cast<int32_t>(m_width);
+                    event.y = static_cast<int32_t>(m_height);
+                    push_input(event);
+                }
+                return 0;
+
+            case WM_SETFOCUS:
+            case WM_KILLFOCUS:
+                {
+                    InputEvent event{};
+                    event.type = msg == WM_SETFOCUS ? InputEventType::FocusGained : InputEventType::FocusLost;
+                    push_input(event);
+                }
+                return 0;
+
+            case WM_KEYDOWN:
+                push_key(InputEventType::KeyDown, wParam, lParam);
+                return 0;
+            case WM_KEYUP:
+                push_key(InputEventType::KeyUp, wParam, lParam);
+                return 0;
+            case WM_SYSKEYDOWN:
+            case WM_SYSKEYUP:
+                // Alt+F4 などの既定の処理を残すため DefWindowProc にも流す
+                push_key(msg == WM_SYSKEYDOWN ? InputEventType::KeyDown : InputEventType::KeyUp, wParam, lParam);
+                break;
+            case WM_CHAR:
+                push_char(wParam);
+                return 0;
+
+            case WM_MOUSEMOVE:
+                push_mouse(InputEventType::MouseMove, MouseButton::None, lParam);
+                return 0;
+            case WM_LBUTTONDOWN:
+                push_mouse(InputEventType::MouseButtonDown, MouseButton::Left, lParam);
+                return 0;
+            case WM_LBUTTONUP:
+                push_mouse(InputEventType::MouseButtonUp, MouseButton::Left, lParam);
+                return 0;
+            case WM_RBUTTONDOWN:
+                push_mouse(InputEventType::MouseButtonDown, MouseButton::Right, lParam);
+                return 0;
+            case WM_RBUTTONUP:
+                push_mouse(InputEventType::MouseButtonUp, MouseButton::Right, lParam);
+                return 0;
+            case WM_MBUTTONDOWN:
+                push_mouse(InputEventType::MouseButtonDown, MouseButton::Middle, lParam);
+                return 0;
+            case WM_MBUTTONUP:
+                push_mouse(InputEventType::MouseButtonUp, MouseButton::Middle, lParam);
+                return 0;
+            case WM_XBUTTONDOWN:
+            case WM_XBUTTONUP:
+                push_mouse(msg == WM_XBUTTONDOWN ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp,
+                    HIWORD(wParam) == XBUTTON1 ? MouseButton::X1 : MouseButton::X2, lParam);
+                return TRUE;
+            case WM_MOUSEWHEEL:
+            case WM_MOUSEHWHEEL:
+                {
+                    // ホイールの座標はスクリーン座標で届くので使わない
+                    const int32_t delta = static_cast<int16_t>(HIWORD(wParam));
+                    InputEvent event{};
+                    event.type = InputEventType::MouseWheel;
+                    event.x = msg == WM_MOUSEHWHEEL ? delta : 0;
+                    event.y = msg == WM_MOUSEWHEEL ? delta : 0;
+                    push_input(event);
+                }
+                return 0;
+            case WM_INPUT:
+                // 後始末のため DefWindowProc にも流す
+                push_raw_input(lParam);
+                break;
+
+            case k_destroyMessage:
+                ::DestroyWindow(hwnd);
                 return 0;
 
             case WM_DESTROY:
@@ -69,6 +280,87 @@ namespace Cue::Platform::Win
 
             return ::DefWindowProcW(hwnd, msg, wParam, lParam);
         }
+
+        /// @brief 呼び出したスレッドが所有するウィンドウを作る（メッセージはこのスレッドで受け取る）
+        Core::Result create_native_window(WinApp* owner, uint32_t w, uint32_t h)
+        {
+            constexpr wchar_t k_className[] = L"CueWindowClass";
+            HINSTANCE hInstance = ::GetModuleHandleW(nullptr);
+
+            // 1) ウィンドウクラスを登録する
+            WNDCLASSEXW wc{};
+            wc.cbSize = sizeof(wc);
+            wc.lpfnWndProc = &Impl::window_proc;
+            wc.lpszClassName = k_className;
+            wc.hInstance = hInstance;
+            wc.hCursor = ::LoadCursorW(nullptr, IDC_ARROW);
+
+            if (!::RegisterClassExW(&wc))
+            {
+                const DWORD err = ::GetLastError();
+                if (err != ERROR_CLASS_ALREADY_EXISTS)
+                {
+                    return Core::Result::fail(
+                        Core::Facility::Platform,
+                        Core::Code::CreationFailed,
+                        Core::Severity::Fatal,
+                        0, "Failed to register window class.");
+                }
+            }
+
+            // 2) クライアントサイズを維持するために調整して生成する
+            RECT rc{ 0, 0, static_cast<LONG>(w), static_cast<LONG>(h) };
+            ::AdjustWindowRect(&rc, WS_OVERLAPPEDWINDOW, FALSE);
+
+            HWND hwnd = ::CreateWindowExW(
+                0,
+                k_className,
+                L"Cue Engine",
+                WS_OVERLAPPEDWINDOW,
+                CW_USEDEFAULT, CW_USEDEFAULT,
+                rc.right - rc.left,
+                rc.bottom - rc.top,
+                nullptr, nullptr,
+                hInstance,
+                owner // WM_NCCREATEで拾う
+            );
+
+            if (!hwnd)
+            {
+                return Core::Result::fail(
+                    Core::Facility::Platform,
+                    Core::Code::CreationFailed,
+                    Core::Severity::Fatal,
+                    0, "Failed to create window.");
+            }
+
+            m_hwnd = hwnd;
+
+            // 3) 加速前のマウス移動量を WM_INPUT で受け取る（失敗しても MouseMove は届くので続ける）
+            if (m_inputQueue)
+            {
+                RAWINPUTDEVICE device{};
+                device.usUsagePage = 0x01; // Generic Desktop
+                device.usUsage = 0x02;     // Mouse
+                device.dwFlags = 0;
+                device.hwndTarget = hwnd;
+                ::RegisterRawInputDevices(&device, 1, sizeof(device));
+            }
+            return Core::Result::ok();
+        }
+
+        /// @brief ポンプスレッド本体：WM_QUIT まで待ちながら配送する
+        void run_pump() noexcept
+        {
+            MSG msg{};
+            while (::GetMessageW(&msg, nullptr, 0, 0) > 0)
+            {
+                ::TranslateMessage(&msg);
+                ::DispatchMessageW(&msg);
+            }
+            // ウィンドウが無くなったらメインループも終わらせる
+            m_shouldClose.store(true, std::memory_order_release);
+        }
     };
     WinApp::WinApp()
         : m_impl(std::make_unique<Impl>())
@@ -80,13 +372,18 @@ namespace Cue::Platform::Win
     }
     WinApp::~WinApp()
     {
+        // ポンプスレッドが残っていると std::thread の破棄で落ちるので先に止める
+        if (m_impl && m_impl->m_pumpThread.joinable())
+        {
+            (void)destroy_window();
+        }
         if (m_impl && m_impl->m_isComInitialized)
         {
             // COM終了処理
             ::CoUninitialize();
         }
     }
-    Core::Result WinApp::create_window(uint32_t w, uint32_t h)
+    Core::Result WinApp::create_window(uint32_t w, uint32_t h, InputEventQueue* inputQueue, bool isPumpThreaded)
     {
         // 1) スレッド前提の初期化に失敗している場合は継続できない
         if (!m_impl->m_isComInitialized)
@@ -124,62 +421,40 @@ namespace Cue::Platform::Win
 
         m_impl->m_width = w;
         m_impl->m_height = h;
+        m_impl->m_inputQueue = inputQueue;
+        m_impl->m_shouldClose.store(false, std::memory_order_relaxed);
+        m_impl->m_isPumpThreaded = isPumpThreaded;
 
-        constexpr wchar_t k_className[] = L"CueWindowClass";
-        HINSTANCE hInstance = ::GetModuleHandleW(nullptr);
-
-        // 3) ウィンドウクラスを登録する
-        WNDCLASSEXW wc{};
-        wc.cbSize = sizeof(wc);
-        wc.lpfnWndProc = &Impl::window_proc;
-        wc.lpszClassName = k_className;
-        wc.hInstance = hInstance;
-        wc.hCursor = ::LoadCursorW(nullptr, IDC_ARROW);
-
-        if (!::RegisterClassExW(&wc))
+        // 3) 同じスレッドで作る（メッセージは pump_messages で配送する）
+        if (!isPumpThreaded)
         {
-            const DWORD err = ::GetLastError();
-            if (err != ERROR_CLASS_ALREADY_EXISTS)
+            const Core::Result r = m_impl->create_native_window(this, w, h);
+            if (!r)
             {
                 rollbackTimePeriod();
-                return Core::Result::fail(
-                    Core::Facility::Platform,
-                    Core::Code::CreationFailed,
-                    Core::Severity::Fatal,
-                    0, "Failed to register window class.");
             }
+            return r;
         }
 
-        // 4) クライアントサイズを維持するために調整して生成する
-        RECT rc{ 0, 0, static_cast<LONG>(w), static_cast<LONG>(h) };
-        ::AdjustWindowRect(&rc, WS_OVERLAPPEDWINDOW, FALSE);
-
-        HWND hwnd = ::CreateWindowExW(
-            0,
-            k_className,
-            L"Cue Engine",
-            WS_OVERLAPPEDWINDOW,
-            CW_USEDEFAULT, CW_USEDEFAULT,
-            rc.right - rc.left,
-            rc.bottom - rc.top,
-            nullptr, nullptr,
-            hInstance,
-            this // WM_NCCREATEで拾う
-        );
-
-        if (!hwnd)
+        // 4) 専用スレッドで作って配送し続ける（ウィンドウのメッセージは所有スレッドにしか届かない）
+        std::promise<Core::Result> created;
+        std::future<Core::Result> future = created.get_future();
+        m_impl->m_pumpThread = std::thread([this, w, h, &created]()
+            {
+                const Core::Result r = m_impl->create_native_window(this, w, h);
+                created.set_value(r);
+                if (r)
+                {
+                    m_impl->run_pump();
+                }
+            });
+        const Core::Result r = future.get();
+        if (!r)
         {
+            m_impl->m_pumpThread.join();
             rollbackTimePeriod();
-            return Core::Result::fail(
-                Core::Facility::Platform,
-                Core::Code::CreationFailed,
-                Core::Severity::Fatal,
-                0, "Failed to create window.");
         }
-
-        m_impl->m_hwnd = hwnd;
-
-        return Core::Result::ok();
+        return r;
     }
     Core::Result WinApp::destroy_window()
     {
@@ -191,7 +466,17 @@ namespace Cue::Platform::Win
             m_impl->m_isTimePeriodSet = false;
         }
 
-        if (m_impl && m_impl->m_hwnd)
+        if (m_impl->m_pumpThread.joinable())
+        {
+            // 生成したスレッドでしか破棄できないので頼んでから終了を待つ
+            if (m_impl->m_hwnd)
+            {
+                ::PostMessageW(m_impl->m_hwnd, k_destroyMessage, 0, 0);
+            }
+            m_impl->m_pumpThread.join();
+            m_impl->m_hwnd = nullptr;
+        }
+        else if (m_impl->m_hwnd)
         {
             ::DestroyWindow(m_impl->m_hwnd);
             m_impl->m_hwnd = nullptr;
@@ -200,16 +485,22 @@ namespace Cue::Platform::Win
     }
     Core::Result WinApp::show_window(bool isMaximized)
     {
-        // ウィンドウを表示
+        // ウィンドウを表示（別スレッドのウィンドウでも所有スレッドへ送られる）
         ::ShowWindow(m_impl->m_hwnd, isMaximized ? SW_MAXIMIZE : SW_SHOW);
         return Core::Result::ok();
     }
     bool WinApp::pump_messages()
     {
+        // 1) 専用スレッドが配送している時は終了要求だけを見る
+        if (m_impl->m_isPumpThreaded)
+        {
+            return !m_impl->m_shouldClose.load(std::memory_order_acquire);
+        }
+
         MSG msg{};
-        // 1) キューを掃き出して終了メッセージを検知する
-        // 2) 閉じる要求が来ていればループを終了する
-        if (m_impl->m_shouldClose)
+        // 2) キューを掃き出して終了メッセージを検知する
+        // 3) 閉じる要求が来ていればループを終了する
+        if (m_impl->m_shouldClose.load(std::memory_order_relaxed))
         {
             return false;
         }
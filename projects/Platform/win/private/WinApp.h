@@ -4,6 +4,7 @@
 #include <memory>
 
 // Cue engine includes
+#include "InputEvents.h"
 #include "Result.h"
 
 namespace Cue::Platform::Win
@@ -17,12 +18,15 @@ namespace Cue::Platform::Win
         ~WinApp();
 
         /// @brief ウィンドウの作成
-        [[nodiscard]] Core::Result create_window(uint32_t w, uint32_t h);
+        /// @param inputQueue OS の入力を変換して積む先（nullptr なら積まない）
+        /// @param isPumpThreaded true ならウィンドウの生成とメッセージポンプを専用スレッドで行う
+        [[nodiscard]] Core::Result create_window(uint32_t w, uint32_t h,
+            InputEventQueue* inputQueue = nullptr, bool isPumpThreaded = false);
         /// @brief ウィンドウの破棄
         [[nodiscard]] Core::Result destroy_window();
         /// @brief ウィンドウの表示
         [[nodiscard]] Core::Result show_window(bool isMaximized);
-        /// @brief ウィンドウのメッセージポンプ
+        /// @brief ウィンドウのメッセージポンプ（専用スレッドで回している時は終了要求を見るだけ）
         [[nodiscard]] bool pump_messages();
     private:
         struct Impl;
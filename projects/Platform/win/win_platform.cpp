@@ -15,18 +15,32 @@ namespace Cue::Platform::Win
     struct WinPlatform::Impl
     {
         WinApp app;
+        InputEventQueue inputQueue;
+        bool isPumpThreaded = false;
     };
     
-    WinPlatform::WinPlatform()
+    WinPlatform::WinPlatform(bool isPumpThreaded)
         : impl(std::make_unique<Impl>())
     {
+        impl->isPumpThreaded = isPumpThreaded;
     }
     WinPlatform::~WinPlatform()
     {
     }
     Core::Result WinPlatform::setup()
     {
-        return impl->app.create_window(800, 600);
+        // 1) ウィンドウの生成直後から届く入力（WM_SIZE 等）を受けられるよう先にリングを作る
+        Core::Result r = impl->inputQueue.initialize();
+        if (!r)
+        {
+            return r;
+        }
+        r = impl->app.create_window(800, 600, &impl->inputQueue, impl->isPumpThreaded);
+        if (!r)
+        {
+            impl->inputQueue.shutdown();
+        }
+        return r;
     }
     Core::Result WinPlatform::start()
     {
@@ -38,6 +52,13 @@ namespace Cue::Platform::Win
     }
     Core::Result WinPlatform::shutdown()
     {
-        return impl->app.destroy_window();
+        // 1) 生産者（ポンプ）を止めてからリングを手放す
+        const Core::Result r = impl->app.destroy_window();
+        impl->inputQueue.shutdown();
+        return r;
+    }
+    InputEventQueue& WinPlatform::get_input_queue() noexcept
+    {
+        return impl->inputQueue;
     }
 } // namespace Cue
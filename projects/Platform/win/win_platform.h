@@ -8,7 +8,8 @@ namespace Cue::Platform::Win
     class WinPlatform : public IPlatform
     {
     public:
-        WinPlatform();
+        /// @param isPumpThreaded true ならメッセージポンプを専用スレッドで回し、入力はリング経由で渡す
+        explicit WinPlatform(bool isPumpThreaded = false);
         ~WinPlatform() override;
 
         Core::Result setup() override;
@@ -17,6 +18,7 @@ namespace Cue::Platform::Win
         void end_frame() override {}
         bool poll_message() override;
         Core::Result shutdown() override;
+        InputEventQueue& get_input_queue() noexcept override;
     private:
         struct Impl;
         std::unique_ptr<Impl> impl;
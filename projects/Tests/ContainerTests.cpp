@@ -0,0 +1,339 @@
+#include <FlatHashMap.h>
+#include <SlotMap.h>
+#include <SmallVector.h>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    /// @brief 生存数を数える要素（構築と破棄の釣り合いを見る）
+    struct Counted
+    {
+        static inline int s_liveCount = 0;
+
+        explicit Counted(int value = 0) noexcept
+            : value(value)
+        {
+            ++s_liveCount;
+        }
+        Counted(const Counted& other) noexcept
+            : value(other.value)
+        {
+            ++s_liveCount;
+        }
+        Counted(Counted&& other) noexcept
+            : value(other.value)
+        {
+            ++s_liveCount;
+        }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) = default;
+        ~Counted()
+        {
+            --s_liveCount;
+        }
+
+        int value;
+    };
+
+    /// @brief 確保の回数と残りのバイト数を数える
+    class CountingResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocationCount = 0;
+        size_t liveBytes = 0;
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocationCount;
+            liveBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            liveBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /// @brief 全てのキーが同じ値になるハッシュ（衝突の多い状況を作る）
+    struct CollidingHash
+    {
+        size_t operator()(int) const noexcept { return 42; }
+    };
+}
+
+CUE_TEST(SmallVector, StaysInlineUntilFull)
+{
+    CountingResource resource;
+    {
+        Core::SmallVector<int, 4> values(&resource);
+        for (int i = 0; i < 4; ++i)
+        {
+            values.push_back(i);
+        }
+        CUE_CHECK(values.is_inline());
+        CUE_CHECK(resource.allocationCount == 0);
+
+        values.push_back(4);
+        CUE_CHECK(!values.is_inline());
+        CUE_CHECK(resource.allocationCount == 1);
+        CUE_CHECK(values.size() == 5);
+        for (int i = 0; i < 5; ++i)
+        {
+            CUE_CHECK(values[i] == i);
+        }
+    }
+    CUE_CHECK(resource.liveBytes == 0);
+}
+
+CUE_TEST(SmallVector, PushOwnElementWhileGrowing)
+{
+    // 確保し直す時に、引数が古い領域を指していても壊れないこと
+    Core::SmallVector<std::string, 2> values;
+    values.push_back("a long string that does not fit into SSO");
+    values.push_back(values[0]);
+    values.push_back(values[1]);
+    CUE_REQUIRE(values.size() == 3);
+    CUE_CHECK(values[2] == values[0]);
+}
+
+CUE_TEST(SmallVector, CopyMoveAndErase)
+{
+    {
+        Core::SmallVector<Counted, 3> values;
+        for (int i = 0; i < 8; ++i)
+        {
+            values.emplace_back(i);
+        }
+        Core::SmallVector<Counted, 3> copy = values;
+        CUE_CHECK(copy.size() == 8 && copy[7].value == 7);
+
+        // ヒープ上なら領域ごと引き取る
+        const Counted* data = values.data();
+        Core::SmallVector<Counted, 3> moved = std::move(values);
+        CUE_CHECK(moved.data() == data);
+        CUE_CHECK(values.empty() && values.is_inline());
+
+        moved.erase(moved.begin() + 1);
+        CUE_CHECK(moved.size() == 7 && moved[1].value == 2);
+        moved.swap_erase(0);
+        CUE_CHECK(moved.size() == 6 && moved[0].value == 7);
+
+        // インラインの間は要素を 1 つずつ移す
+        Core::SmallVector<Counted, 3> small;
+        small.emplace_back(1);
+        small.emplace_back(2);
+        copy = std::move(small);
+        CUE_CHECK(copy.size() == 2 && copy[1].value == 2);
+
+        copy.resize(5, Counted(9));
+        CUE_CHECK(copy.size() == 5 && copy[4].value == 9);
+        copy.resize(1);
+        CUE_CHECK(copy.size() == 1 && copy.back().value == 1);
+    }
+    CUE_CHECK(Counted::s_liveCount == 0);
+}
+
+CUE_TEST(FlatHashMap, MatchesUnorderedMap)
+{
+    // 挿入と削除を混ぜて、同じ操作をした std::unordered_map と中身が一致すること
+    std::mt19937 rng(3);
+    Core::FlatHashMap<uint32_t, uint32_t> map;
+    std::unordered_map<uint32_t, uint32_t> expected;
+    bool isAllMatched = true;
+    for (uint32_t iteration = 0; iteration < 200000 && isAllMatched; ++iteration)
+    {
+        const uint32_t key = rng() % 4096;
+        const uint32_t roll = rng() % 10;
+        if (roll < 5)
+        {
+            const auto [value, isInserted] = map.try_emplace(key, iteration);
+            const auto [it, isExpectedInserted] = expected.try_emplace(key, iteration);
+            isAllMatched = isAllMatched && isInserted == isExpectedInserted && *value == it->second;
+        }
+        else if (roll < 8)
+        {
+            isAllMatched = isAllMatched && map.erase(key) == (expected.erase(key) != 0);
+        }
+        else
+        {
+            const uint32_t* value = map.find(key);
+            const auto it = expected.find(key);
+            isAllMatched = isAllMatched && (value != nullptr) == (it != expected.end()) && (!value || *value == it->second);
+        }
+        isAllMatched = isAllMatched && map.size() == expected.size();
+    }
+    CUE_CHECK(isAllMatched);
+
+    size_t visited = 0;
+    for (const auto& entry : map)
+    {
+        const auto it = expected.find(entry.key);
+        CUE_CHECK(it != expected.end() && it->second == entry.value);
+        ++visited;
+    }
+    CUE_CHECK(visited == expected.size());
+}
+
+CUE_TEST(FlatHashMap, ManyCollisions)
+{
+    // 全キーが同じグループから探索を始めても、見つかり・消せること
+    Core::FlatHashMap<int, int, CollidingHash> map;
+    for (int i = 0; i < 200; ++i)
+    {
+        map[i] = i * 3;
+    }
+    for (int i = 0; i < 200; i += 2)
+    {
+        CUE_CHECK(map.erase(i));
+    }
+    bool isAllFound = true;
+    for (int i = 0; i < 200; ++i)
+    {
+        const int* value = map.find(i);
+        isAllFound = isAllFound && ((i % 2 == 0) ? value == nullptr : (value && *value == i * 3));
+    }
+    CUE_CHECK(isAllFound);
+    CUE_CHECK(map.size() == 100);
+}
+
+CUE_TEST(FlatHashMap, TombstonesDoNotGrowTable)
+{
+    // 挿入と削除を繰り返しても、削除済みを詰め直すだけで容量は増えない
+    Core::FlatHashMap<uint32_t, uint32_t> map;
+    map.reserve(100);
+    const size_t capacity = map.get_capacity();
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        map.try_emplace(i, i);
+        if (i >= 64)
+        {
+            map.erase(i - 64);
+        }
+    }
+    CUE_CHECK(map.size() == 64);
+    CUE_CHECK(map.get_capacity() == capacity);
+}
+
+CUE_TEST(FlatHashMap, UpstreamAndLifetime)
+{
+    CountingResource resource;
+    {
+        Core::FlatHashMap<int, Counted> map(&resource);
+        for (int i = 0; i < 1000; ++i)
+        {
+            map.try_emplace(i, i);
+        }
+        CUE_CHECK(Counted::s_liveCount == 1000);
+
+        // 走査しながら消す
+        for (auto it = map.begin(); it != map.end();)
+        {
+            it = (it->key % 3 == 0) ? map.erase(it) : ++it;
+        }
+        CUE_CHECK(map.size() == 666);
+
+        Core::FlatHashMap<int, Counted> copy = map;
+        CUE_CHECK(copy.size() == 666 && copy.find(1)->value == 1);
+        Core::FlatHashMap<int, Counted> moved = std::move(map);
+        CUE_CHECK(map.empty() && moved.size() == 666);
+        moved.clear();
+        CUE_CHECK(moved.empty() && !moved.contains(1));
+    }
+    CUE_CHECK(Counted::s_liveCount == 0);
+    CUE_CHECK(resource.liveBytes == 0);
+}
+
+CUE_TEST(SlotMap, HandlesSurviveErase)
+{
+    Core::SlotMap<int> map;
+    std::vector<Core::SlotHandle> handles;
+    for (int i = 0; i < 100; ++i)
+    {
+        handles.push_back(map.insert(i));
+    }
+    for (int i = 0; i < 100; i += 3)
+    {
+        CUE_CHECK(map.erase(handles[i]));
+    }
+    bool isAllResolved = true;
+    for (int i = 0; i < 100; ++i)
+    {
+        const int* value = map.get(handles[i]);
+        isAllResolved = isAllResolved && ((i % 3 == 0) ? value == nullptr : (value && *value == i));
+    }
+    CUE_CHECK(isAllResolved);
+    CUE_CHECK(map.size() == 66);
+
+    // 詰めた並びの合計が残った要素と一致すること
+    int sum = 0;
+    for (const int value : map)
+    {
+        sum += value;
+    }
+    int expected = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        expected += (i % 3 == 0) ? 0 : i;
+    }
+    CUE_CHECK(sum == expected);
+}
+
+CUE_TEST(SlotMap, StaleHandleAfterReuse)
+{
+    Core::SlotMap<std::string> map;
+    CUE_CHECK(!map.contains(Core::SlotHandle{}));
+    CUE_CHECK(!map.contains(Core::SlotHandle{ 0, 0 }));
+
+    const Core::SlotHandle first = map.emplace("first");
+    CUE_CHECK(map.erase(first));
+    CUE_CHECK(!map.erase(first));
+
+    // 同じスロットを使い回しても、古いハンドルは新しい要素を指さない
+    const Core::SlotHandle second = map.emplace("second");
+    CUE_CHECK(second.index == first.index);
+    CUE_CHECK(second.generation != first.generation);
+    CUE_CHECK(map.get(first) == nullptr);
+    CUE_REQUIRE(map.get(second) != nullptr);
+    CUE_CHECK(*map.get(second) == "second");
+
+    map.clear();
+    CUE_CHECK(map.empty() && !map.contains(second));
+}
+
+CUE_TEST(SlotMap, EraseWhileIterating)
+{
+    Core::SlotMap<int> map;
+    for (int i = 0; i < 50; ++i)
+    {
+        (void)map.insert(i);
+    }
+    // 末尾から消せば、移ってくる要素は走査済みの位置から来ない
+    for (size_t i = map.size(); i-- > 0;)
+    {
+        if (map.data()[i] % 2 == 0)
+        {
+            map.erase(map.get_handle(i));
+        }
+    }
+    CUE_CHECK(map.size() == 25);
+    bool isAllOdd = true;
+    for (const int value : map)
+    {
+        isAllOdd = isAllOdd && value % 2 == 1;
+    }
+    CUE_CHECK(isAllOdd);
+}
@@ -0,0 +1,150 @@
+#include <Culling.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+    namespace Math = Cue::Math;
+
+    std::vector<Cue::Aabb> make_scene(uint32_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 8.0f);
+        std::vector<Cue::Aabb> bounds(count);
+        for (Cue::Aabb& box : bounds)
+        {
+            const Math::Float3 center{ position(rng), position(rng) * 0.1f, position(rng) };
+            const Math::Float3 half{ size(rng), size(rng), size(rng) };
+            box = { center - half, center + half };
+        }
+        return bounds;
+    }
+
+    /// @brief 透視のカメラ 1 つと、上から見下ろす平行投影のカメラ 2 つ
+    std::vector<Cue::Frustum> make_cameras()
+    {
+        const Math::Float4x4 view = Math::look_at({ 0.0f, 20.0f, -300.0f }, { 50.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+        const Math::Float4x4 projection = Math::perspective(1.0f, 16.0f / 9.0f, 0.1f, 600.0f);
+        const Math::Float4x4 shadowView = Math::look_at({ 0.0f, 300.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+        return {
+            Cue::make_frustum(view * projection),
+            Cue::make_frustum(shadowView * Math::orthographic(200.0f, 200.0f, 1.0f, 600.0f)),
+            Cue::make_frustum(shadowView * Math::orthographic(800.0f, 800.0f, 1.0f, 600.0f)),
+        };
+    }
+
+    std::vector<uint32_t> cull_brute_force(const Cue::Frustum& frustum, const std::vector<Cue::Aabb>& bounds)
+    {
+        std::vector<uint32_t> visible;
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            if (Cue::is_visible(frustum, bounds[i]))
+            {
+                visible.push_back(i);
+            }
+        }
+        return visible;
+    }
+
+    /// @brief BVH の結果を並べ替えて、総当たりと同じ集合か比べる
+    bool matches_brute_force(const std::vector<Cue::Frustum>& frustums, std::vector<std::vector<uint32_t>>& visible,
+        const std::vector<Cue::Aabb>& bounds)
+    {
+        bool isAllMatched = true;
+        for (size_t c = 0; c < frustums.size(); ++c)
+        {
+            std::sort(visible[c].begin(), visible[c].end());
+            isAllMatched = isAllMatched && visible[c] == cull_brute_force(frustums[c], bounds);
+        }
+        return isAllMatched;
+    }
+}
+
+CUE_TEST(Culling, FrustumFromPerspective)
+{
+    // 原点から +z を向いたカメラ
+    const Math::Float4x4 view = Math::look_at({}, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f });
+    const Cue::Frustum frustum = Cue::make_frustum(view * Math::perspective(1.5f, 1.0f, 1.0f, 100.0f));
+    CUE_CHECK(Cue::is_visible(frustum, { { -1.0f, -1.0f, 9.0f }, { 1.0f, 1.0f, 11.0f } }));
+    CUE_CHECK(!Cue::is_visible(frustum, { { -1.0f, -1.0f, -11.0f }, { 1.0f, 1.0f, -9.0f } }));
+    CUE_CHECK(!Cue::is_visible(frustum, { { -1.0f, -1.0f, 101.0f }, { 1.0f, 1.0f, 102.0f } }));
+    CUE_CHECK(!Cue::is_visible(frustum, { { 50.0f, -1.0f, 9.0f }, { 52.0f, 1.0f, 11.0f } }));
+    // 平面を跨ぐ箱は残す
+    CUE_CHECK(Cue::is_visible(frustum, { { -1.0f, -1.0f, 99.0f }, { 1.0f, 1.0f, 102.0f } }));
+}
+
+CUE_TEST(Culling, MatchesBruteForce)
+{
+    const std::vector<Cue::Aabb> bounds = make_scene(20000, 1);
+    const std::vector<Cue::Frustum> frustums = make_cameras();
+    Cue::CullingBvh bvh;
+    CUE_REQUIRE(bvh.build(bounds));
+    const Cue::CullingBvhStats stats = bvh.get_stats();
+    CUE_CHECK(stats.objectCount == 20000);
+    CUE_CHECK(stats.subtreeCount > 1);
+
+    std::vector<std::vector<uint32_t>> visible(frustums.size());
+    CUE_REQUIRE(bvh.cull(frustums, visible, nullptr));
+    CUE_CHECK(matches_brute_force(frustums, visible, bounds));
+    CUE_CHECK(!visible[0].empty() && visible[0].size() < bounds.size());
+
+    // 並列に回しても集合も並びも変わらない
+    Core::JobSystem jobSystem;
+    CUE_REQUIRE(jobSystem.initialize({ 4, 1024 }));
+    std::vector<std::vector<uint32_t>> serial(frustums.size());
+    std::vector<std::vector<uint32_t>> parallel(frustums.size());
+    CUE_REQUIRE(bvh.cull(frustums, serial, nullptr));
+    CUE_REQUIRE(bvh.cull(frustums, parallel, &jobSystem));
+    CUE_CHECK(serial == parallel);
+    jobSystem.shutdown();
+}
+
+CUE_TEST(Culling, RefitAfterMove)
+{
+    std::vector<Cue::Aabb> bounds = make_scene(5000, 2);
+    const std::vector<Cue::Frustum> frustums = make_cameras();
+    Cue::CullingBvh bvh;
+    CUE_REQUIRE(bvh.build(bounds));
+
+    // 1 割の物体を大きく動かす
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> offset(-200.0f, 200.0f);
+    for (uint32_t i = 0; i < bounds.size(); i += 10)
+    {
+        const Math::Float3 delta{ offset(rng), 0.0f, offset(rng) };
+        bounds[i] = { bounds[i].min + delta, bounds[i].max + delta };
+        bvh.update(i, bounds[i]);
+    }
+
+    std::vector<std::vector<uint32_t>> visible(frustums.size());
+    CUE_CHECK(bvh.cull(frustums, visible, nullptr).get_code() == Core::Code::InvalidState);
+    bvh.refit();
+    CUE_REQUIRE(bvh.cull(frustums, visible, nullptr));
+    CUE_CHECK(matches_brute_force(frustums, visible, bounds));
+    CUE_CHECK(bvh.get_bounds(10).min.x == bounds[10].min.x);
+}
+
+CUE_TEST(Culling, SmallAndEmptyScenes)
+{
+    // 部分木を選ぶ時に物体が直に付く節点まで開き切る大きさも含める
+    const std::vector<Cue::Frustum> frustums = make_cameras();
+    std::vector<std::vector<uint32_t>> visible(frustums.size());
+    for (const uint32_t count : { 0u, 1u, 3u, 5u, 17u, 70u, 300u })
+    {
+        const std::vector<Cue::Aabb> bounds = make_scene(count, count);
+        Cue::CullingBvh bvh;
+        CUE_REQUIRE(bvh.build(bounds));
+        CUE_REQUIRE(bvh.cull(frustums, visible, nullptr));
+        CUE_CHECK(matches_brute_force(frustums, visible, bounds));
+    }
+
+    Cue::CullingBvh bvh;
+    CUE_REQUIRE(bvh.build({}));
+    std::vector<std::vector<uint32_t>> tooFew(1);
+    CUE_CHECK(bvh.cull(frustums, tooFew, nullptr).get_code() == Core::Code::InvalidArg);
+}
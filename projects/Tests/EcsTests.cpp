@@ -0,0 +1,160 @@
+#include <JobSystem.h>
+#include <Query.h>
+#include <SystemScheduler.h>
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+    namespace Ecs = Cue::Ecs;
+
+    struct Position
+    {
+        float x, y, z;
+    };
+    struct Velocity
+    {
+        float x, y, z;
+    };
+    struct Tagged
+    {
+    };
+}
+
+CUE_TEST(Ecs, QueryVisitsMatchingEntities)
+{
+    Ecs::World world;
+    std::vector<Ecs::Entity> moving;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        moving.push_back(world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }, Velocity{ 1.0f, 2.0f, 3.0f }));
+        (void)world.create_entity(Position{ -1.0f, 0.0f, 0.0f });
+    }
+    Ecs::Query<Position, const Velocity> query;
+    CUE_CHECK(query.count(world) == moving.size());
+    CUE_CHECK(Ecs::Query<const Position>{}.count(world) == moving.size() * 2);
+
+    query.for_each(world, [](Position& p, const Velocity& v)
+        {
+            p.x += v.x;
+            p.y += v.y;
+            p.z += v.z;
+        });
+    bool isAllMoved = true;
+    for (size_t i = 0; i < moving.size(); ++i)
+    {
+        const Position* p = world.get_component<Position>(moving[i]);
+        isAllMoved = isAllMoved && p && p->x == static_cast<float>(i) + 1.0f && p->z == 3.0f;
+    }
+    CUE_CHECK(isAllMoved);
+}
+
+CUE_TEST(Ecs, ComponentChurnKeepsData)
+{
+    // アーキタイプ間を行き来しても、他の列の値は保たれる
+    Ecs::World world;
+    std::vector<Ecs::Entity> entities;
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        entities.push_back(world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }, Velocity{}));
+    }
+    std::mt19937 rng(1);
+    for (int i = 0; i < 20000; ++i)
+    {
+        const Ecs::Entity entity = entities[rng() % entities.size()];
+        if (world.has_component<Tagged>(entity))
+        {
+            (void)world.remove_component<Tagged>(entity);
+        }
+        else
+        {
+            (void)world.add_component(entity, Tagged{});
+        }
+    }
+    bool isAllKept = true;
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        const Position* p = world.get_component<Position>(entities[i]);
+        isAllKept = isAllKept && p && p->x == static_cast<float>(i) && world.has_component<Velocity>(entities[i]);
+    }
+    CUE_CHECK(isAllKept);
+    CUE_CHECK(Ecs::Query<const Tagged>{}.count(world) + Ecs::Query<const Position>{}.count(world) >= entities.size());
+}
+
+CUE_TEST(Ecs, DestroyedHandleIsStale)
+{
+    Ecs::World world;
+    const Ecs::Entity first = world.create_entity(Position{});
+    CUE_CHECK(world.is_alive(first));
+    CUE_CHECK(world.destroy_entity(first));
+    CUE_CHECK(!world.is_alive(first));
+    CUE_CHECK(!world.destroy_entity(first));
+
+    // 同じスロットを再利用しても、古いハンドルでは触れない
+    const Ecs::Entity second = world.create_entity(Position{ 5.0f, 0.0f, 0.0f });
+    CUE_CHECK(world.is_alive(second));
+    CUE_CHECK(world.get_component<Position>(first) == nullptr);
+    CUE_CHECK(world.get_entity_count() == 1);
+}
+
+CUE_TEST(Ecs, CommandBufferDefersChanges)
+{
+    Ecs::World world;
+    std::vector<Ecs::Entity> entities;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        entities.push_back(world.create_entity(Position{ static_cast<float>(i), 0.0f, 0.0f }));
+    }
+    for (size_t i = 0; i < entities.size(); i += 2)
+    {
+        world.get_command_buffer().destroy_entity(entities[i]);
+    }
+    const Ecs::Entity created = world.get_command_buffer().create_entity();
+    world.get_command_buffer().add_component(created, Velocity{ 9.0f, 9.0f, 9.0f });
+    CUE_CHECK(world.get_entity_count() == entities.size());
+    CUE_CHECK(world.is_alive(entities[0]));
+
+    world.flush_commands();
+    CUE_CHECK(world.get_entity_count() == entities.size() / 2 + 1);
+    CUE_CHECK(!world.is_alive(entities[0]));
+    CUE_CHECK(world.get_component<Position>(entities[1])->x == 1.0f);
+    CUE_CHECK(Ecs::Query<const Velocity>{}.count(world) == 1);
+}
+
+CUE_TEST(Ecs, SchedulerGroupsByConflicts)
+{
+    Core::JobSystem jobSystem;
+    CUE_REQUIRE(jobSystem.initialize({ 4, 1024 }));
+    Ecs::World world;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        (void)world.create_entity(Position{}, Velocity{ 1.0f, 0.0f, 0.0f });
+    }
+
+    std::atomic<uint32_t> readCount{ 0 };
+    Ecs::SystemScheduler scheduler;
+    scheduler.add_system({ "move", Ecs::make_mask<Velocity>(), Ecs::make_mask<Position>(), [](Ecs::SystemContext& context)
+        {
+            Ecs::Query<Position, const Velocity> query;
+            query.parallel_for_each(context.world, context.jobSystem, [](Position& p, const Velocity& v) { p.x += v.x; });
+        } });
+    scheduler.add_system({ "read_velocity", Ecs::make_mask<Velocity>(), {}, [&readCount](Ecs::SystemContext&) { ++readCount; } });
+    scheduler.add_system({ "read_position", Ecs::make_mask<Position>(), {}, [&readCount](Ecs::SystemContext& context)
+        {
+            // move の後のフェーズで走るので、更新後の値が見える
+            Ecs::Query<const Position> query;
+            bool isMoved = true;
+            query.for_each(context.world, [&isMoved](const Position& p) { isMoved = isMoved && p.x == 1.0f; });
+            readCount += isMoved ? 1 : 0;
+            context.commands.add_component(context.commands.create_entity(), Tagged{});
+        } });
+    scheduler.run(world, jobSystem);
+
+    CUE_CHECK(scheduler.get_phase_count() == 2);
+    CUE_CHECK(readCount.load() == 2);
+    CUE_CHECK(world.get_entity_count() == 10001);
+}
@@ -0,0 +1,229 @@
+#include <Engine.h>
+#include <FramePipeline.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <headless_platform.h>
+#include <null_backend.h>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    /// @brief depth 段のリングに frameCount 枚流し、順番と数が崩れないことを確かめる
+    bool run_pipeline(uint32_t depth, uint64_t frameCount)
+    {
+        Cue::FramePipeline pipeline;
+        if (!pipeline.initialize({ depth, 16 }))
+        {
+            return false;
+        }
+        std::atomic<bool> isOrdered{ true };
+        const auto render = [&pipeline, &isOrdered]()
+            {
+                uint64_t expected = 0;
+                while (const Cue::FramePacket* packet = pipeline.begin_read())
+                {
+                    if (packet->constants.frameIndex != expected++)
+                    {
+                        isOrdered = false;
+                    }
+                    pipeline.end_read();
+                }
+            };
+        std::thread renderThread;
+        if (depth > 1)
+        {
+            renderThread = std::thread(render);
+        }
+        for (uint64_t i = 0; i < frameCount; ++i)
+        {
+            Cue::FramePacket* packet = pipeline.begin_write();
+            packet->constants.frameIndex = i;
+            pipeline.end_write();
+            if (depth == 1)
+            {
+                const Cue::FramePacket* read = pipeline.begin_read();
+                isOrdered = isOrdered && read->constants.frameIndex == i;
+                pipeline.end_read();
+            }
+        }
+        pipeline.request_stop();
+        if (renderThread.joinable())
+        {
+            renderThread.join();
+        }
+        return isOrdered && pipeline.get_stats().consumedCount == frameCount;
+    }
+
+    /// @brief ヘッドレス + Null バックエンドで Engine を立てる
+    class EngineHarness final
+    {
+    public:
+        explicit EngineHarness(Cue::EngineInitInfo initInfo)
+        {
+            initInfo.platform = &m_platform;
+            initInfo.graphicsBackend = &m_backend;
+            initInfo.logger.isStderrEnabled = false;
+            initInfo.isMemoryReportEnabled = false;
+            if (!m_platform.setup() || !m_platform.start() || !m_backend.initialize())
+            {
+                return;
+            }
+            m_isReady = static_cast<bool>(m_engine.initialize(initInfo));
+        }
+        ~EngineHarness()
+        {
+            if (m_isReady)
+            {
+                m_engine.shutdown();
+            }
+            (void)m_backend.shutdown();
+            (void)m_platform.shutdown();
+        }
+        EngineHarness(const EngineHarness&) = delete;
+        EngineHarness& operator=(const EngineHarness&) = delete;
+
+        [[nodiscard]] bool is_ready() const noexcept { return m_isReady; }
+        [[nodiscard]] Cue::Engine& get_engine() noexcept { return m_engine; }
+        [[nodiscard]] Cue::Platform::Headless::HeadlessPlatform& get_platform() noexcept { return m_platform; }
+    private:
+        Cue::Platform::Headless::HeadlessPlatform m_platform;
+        Cue::Graphics::Null::NullBackend m_backend;
+        Cue::Engine m_engine;
+        bool m_isReady = false;
+    };
+}
+
+CUE_TEST(FramePipeline, KeepsOrderAtEveryDepth)
+{
+    for (uint32_t depth = 1; depth <= 3; ++depth)
+    {
+        CUE_CHECK(run_pipeline(depth, 2000));
+    }
+}
+
+CUE_TEST(FramePipeline, RejectsBadDepthAndStops)
+{
+    Cue::FramePipeline pipeline;
+    CUE_CHECK(!pipeline.initialize({ 0, 1 }));
+    CUE_CHECK(!pipeline.initialize({ 4, 1 }));
+    CUE_REQUIRE(pipeline.initialize({ 2, 1 }));
+    pipeline.request_stop();
+    CUE_CHECK(pipeline.begin_write() == nullptr);
+    CUE_CHECK(pipeline.begin_read() == nullptr);
+}
+
+CUE_TEST(Engine, TicksAndDrainsInput)
+{
+    EngineHarness harness({});
+    CUE_REQUIRE(harness.is_ready());
+    Cue::Engine& engine = harness.get_engine();
+    CUE_CHECK(engine.tick());
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Cue::Platform::InputEvent event{};
+        event.type = Cue::Platform::InputEventType::KeyDown;
+        event.code = i;
+        event.timestampNs = Cue::Platform::get_input_timestamp();
+        CUE_REQUIRE(harness.get_platform().push_input(event));
+    }
+    CUE_CHECK(engine.tick());
+    CUE_CHECK(engine.get_frame_input().size() == 10);
+    CUE_CHECK(engine.get_frame_input()[9].code == 9);
+    CUE_CHECK(engine.get_input_latency_stats().eventCount == 10);
+
+    // 取り込んだ入力はそのフレームだけのもの
+    CUE_CHECK(engine.tick());
+    CUE_CHECK(engine.get_frame_input().empty());
+}
+
+CUE_TEST(Engine, PipelinedRenderSeesEveryFrame)
+{
+    std::atomic<uint64_t> renderedCount{ 0 };
+    std::atomic<bool> isOrdered{ true };
+    Cue::EngineInitInfo initInfo{};
+    initInfo.framePipeline.depth = 2;
+    initInfo.framePipeline.objectCapacity = 4;
+    initInfo.extractFrame = [](Cue::Ecs::World&, Cue::FramePacket& packet)
+        {
+            Cue::RenderObject object{};
+            object.meshId = static_cast<uint32_t>(packet.constants.frameIndex);
+            packet.objects.push_back(object);
+        };
+    initInfo.renderFrame = [&renderedCount, &isOrdered](const Cue::FramePacket& packet)
+        {
+            isOrdered = isOrdered && packet.objects.size() == 1 && packet.objects[0].meshId == packet.constants.frameIndex;
+            ++renderedCount;
+            return Core::Result::ok();
+        };
+    {
+        EngineHarness harness(std::move(initInfo));
+        CUE_REQUIRE(harness.is_ready());
+        for (int i = 0; i < 100; ++i)
+        {
+            CUE_REQUIRE(harness.get_engine().tick());
+        }
+        // shutdown で描画スレッドが残りを描き切る
+    }
+    CUE_CHECK(renderedCount.load() == 100);
+    CUE_CHECK(isOrdered.load());
+}
+
+CUE_TEST(Engine, RejectsMissingPlatform)
+{
+    Cue::EngineInitInfo initInfo{};
+    initInfo.logger.isStderrEnabled = false;
+    Cue::Engine engine;
+    const Core::Result r = engine.initialize(initInfo);
+    CUE_CHECK(!r);
+    CUE_CHECK(r.get_code() == Core::Code::InvalidState);
+}
+
+CUE_TEST(Engine, ShutdownLeavesNoLeaks)
+{
+    if (!Core::is_memory_tracking_enabled())
+    {
+        return;
+    }
+    Cue::Platform::Headless::HeadlessPlatform platform;
+    Cue::Graphics::Null::NullBackend backend;
+    CUE_REQUIRE(platform.setup() && platform.start() && backend.initialize());
+
+    // エンジンが作るものは全て shutdown で手放され、プロセスの寿命で持つものは報告に出ない
+    Cue::EngineInitInfo initInfo{};
+    initInfo.platform = &platform;
+    initInfo.graphicsBackend = &backend;
+    initInfo.workerCount = 4;
+    initInfo.framePipeline.depth = 2;
+    initInfo.framePipeline.objectCapacity = 4;
+    initInfo.logger.isStderrEnabled = false;
+    initInfo.isMemoryReportEnabled = false;
+    initInfo.renderFrame = [](const Cue::FramePacket&) { return Core::Result::ok(); };
+    Cue::Engine engine;
+    const Core::MemorySnapshot baseline = Core::take_memory_snapshot();
+    CUE_REQUIRE(engine.initialize(initInfo));
+
+    Cue::Ecs::SystemDesc spawn{};
+    spawn.name = "Spawn";
+    spawn.function = [&engine](Cue::Ecs::SystemContext& context)
+        {
+            (void)context.commands.create_entity();
+            engine.get_logger().log(Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Info, 0,
+                "Spawned an entity."));
+        };
+    engine.get_system_scheduler().add_system(std::move(spawn));
+    for (int i = 0; i < 100; ++i)
+    {
+        CUE_CHECK(engine.tick());
+    }
+    CUE_CHECK(engine.get_world().get_entity_count() == 100);
+    engine.shutdown();
+    CUE_CHECK(Core::write_memory_report(nullptr, baseline) == 0);
+
+    (void)backend.shutdown();
+    (void)platform.shutdown();
+}
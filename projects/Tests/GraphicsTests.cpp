@@ -0,0 +1,403 @@
+#include <CommandList.h>
+#include <DescriptorAllocator.h>
+#include <RenderGraph.h>
+#include <ShaderCache.h>
+#include <UploadRing.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <replay_queue.h>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+    namespace Graphics = Cue::Graphics;
+
+    bool is_overlapped(const Graphics::TransientPlacement& a, const Graphics::TransientPlacement& b)
+    {
+        return a.heap == b.heap && a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+    }
+
+    /// @brief pipeline を使い分けた 1 本のコマンドリストを記録する
+    void record_draws(Graphics::CommandList& list, uint32_t sortKey, uint32_t drawCount)
+    {
+        const uint32_t constants[4] = { 1, 2, 3, 4 };
+        list.begin(sortKey);
+        list.set_pipeline(sortKey);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            list.set_constants(0, constants);
+            list.set_vertex_buffer(0, i, 0, 32);
+            list.draw(3, 1, i, 0);
+        }
+    }
+}
+
+CUE_TEST(RenderGraph, CullsAliasesAndBarriers)
+{
+    Graphics::RenderGraph graph;
+    const Graphics::TextureDesc full{ 1920, 1080, 1, 1, 1, Graphics::Format::RGBA8_UNORM };
+    const Graphics::ResourceHandle backBuffer = graph.import_texture("backbuffer", full,
+        Graphics::ResourceState::Present, Graphics::ResourceState::Present);
+    Graphics::ResourceHandle albedo, normal, depth, ao, hdr, bloom, debug;
+    graph.add_pass("gbuffer", [&](Graphics::RenderGraphBuilder& b)
+        {
+            albedo = b.write(b.create_texture("albedo", full));
+            Graphics::TextureDesc n = full;
+            n.format = Graphics::Format::RGBA16_FLOAT;
+            normal = b.write(b.create_texture("normal", n));
+            Graphics::TextureDesc d = full;
+            d.format = Graphics::Format::D32_FLOAT;
+            depth = b.write(b.create_texture("depth", d), Graphics::ResourceState::DepthWrite);
+        }, {});
+    graph.add_pass("ssao", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(depth);
+            b.read(normal);
+            Graphics::TextureDesc a = full;
+            a.format = Graphics::Format::R8_UNORM;
+            ao = b.write(b.create_texture("ao", a), Graphics::ResourceState::UnorderedAccess);
+        }, {});
+    graph.add_pass("lighting", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(albedo);
+            b.read(normal);
+            b.read(depth);
+            b.read(ao);
+            Graphics::TextureDesc h = full;
+            h.format = Graphics::Format::RGBA16_FLOAT;
+            hdr = b.write(b.create_texture("hdr", h));
+        }, {});
+    graph.add_pass("bloom", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(hdr);
+            bloom = b.write(b.create_texture("bloom", { 960, 540, 1, 1, 1, Graphics::Format::RGBA16_FLOAT }));
+        }, {});
+    // 誰も読まないので間引かれる
+    graph.add_pass("debug", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(depth);
+            debug = b.write(b.create_texture("debug", full));
+        }, {});
+    // 読まれなくても副作用があるので残る
+    graph.add_pass("readback", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(ao);
+            b.set_side_effect();
+        }, {});
+    graph.add_pass("tonemap", [&](Graphics::RenderGraphBuilder& b)
+        {
+            b.read(hdr);
+            b.read(bloom);
+            b.write(backBuffer);
+        }, {});
+    CUE_REQUIRE(graph.compile());
+
+    const Graphics::RenderGraphStats& stats = graph.get_stats();
+    CUE_CHECK(stats.passCount == 7);
+    CUE_CHECK(stats.culledPassCount == 1);
+    CUE_CHECK(graph.is_pass_culled(4));
+    CUE_CHECK(!graph.is_pass_culled(5));
+    CUE_CHECK(stats.barrierCount > 0);
+    CUE_CHECK(stats.barrierBatchCount <= stats.barrierCount);
+    CUE_CHECK(stats.transientBytes < stats.unaliasedBytes);
+
+    // 同時に生きているリソースは重ならない
+    Graphics::TransientPlacement albedoPlacement, normalPlacement, hdrPlacement, bloomPlacement;
+    CUE_REQUIRE(graph.get_placement(albedo, albedoPlacement));
+    CUE_REQUIRE(graph.get_placement(normal, normalPlacement));
+    CUE_REQUIRE(graph.get_placement(hdr, hdrPlacement));
+    CUE_REQUIRE(graph.get_placement(bloom, bloomPlacement));
+    CUE_CHECK(!is_overlapped(albedoPlacement, normalPlacement));
+    CUE_CHECK(!is_overlapped(albedoPlacement, hdrPlacement));
+    CUE_CHECK(!is_overlapped(hdrPlacement, bloomPlacement));
+    Graphics::TransientPlacement importedPlacement;
+    CUE_CHECK(!graph.get_placement(backBuffer, importedPlacement));
+
+    Graphics::RecordingExecutor executor(graph);
+    CUE_REQUIRE(graph.execute(executor));
+    const std::string_view log = executor.get_log();
+    CUE_CHECK(log.find("tonemap") != std::string_view::npos);
+    CUE_CHECK(log.find("debug") == std::string_view::npos);
+}
+
+CUE_TEST(RenderGraph, ResetReusesGraph)
+{
+    Graphics::RenderGraph graph;
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        graph.reset();
+        const Graphics::ResourceHandle backBuffer = graph.import_texture("backbuffer", { 64, 64, 1, 1, 1, Graphics::Format::RGBA8_UNORM },
+            Graphics::ResourceState::Present, Graphics::ResourceState::Present);
+        graph.add_pass("clear", [&](Graphics::RenderGraphBuilder& b) { b.write(backBuffer); }, {});
+        CUE_REQUIRE(graph.compile());
+        CUE_CHECK(graph.get_stats().passCount == 1);
+        CUE_CHECK(graph.get_stats().culledPassCount == 0);
+    }
+}
+
+CUE_TEST(DescriptorAllocator, PersistentExhaustsAndFrees)
+{
+    Graphics::DescriptorAllocator allocator;
+    CUE_REQUIRE(allocator.initialize({ .capacity = 4096, .persistentCount = 1024, .pageSize = 64 }));
+    std::vector<Graphics::DescriptorRange> ranges;
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+        ranges.push_back(allocator.allocate_persistent());
+    }
+    CUE_CHECK(std::all_of(ranges.begin(), ranges.end(), [](const Graphics::DescriptorRange& r) { return r.is_valid() && r.index < 1024; }));
+    CUE_CHECK(!allocator.allocate_persistent().is_valid());
+    CUE_CHECK(allocator.get_persistent_used_count() == 1024);
+    for (const Graphics::DescriptorRange& range : ranges)
+    {
+        allocator.free_persistent(range);
+    }
+    CUE_CHECK(allocator.get_persistent_used_count() == 0);
+}
+
+CUE_TEST(DescriptorAllocator, TransientRecyclesByFence)
+{
+    Graphics::DescriptorAllocator allocator;
+    CUE_REQUIRE(allocator.initialize({ .capacity = 65536, .persistentCount = 32768, .pageSize = 256 }));
+    uint64_t fence = 0;
+    std::atomic<uint32_t> failureCount{ 0 };
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        // GPU は 2 フレーム遅れで追いつく想定
+        allocator.begin_frame(fence >= 2 ? fence - 2 : 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&allocator, &failureCount]()
+                {
+                    for (uint32_t i = 0; i < 500; ++i)
+                    {
+                        const Graphics::DescriptorRange range = allocator.allocate_transient(1 + i % 8);
+                        if (!range.is_valid() || range.index < 32768 || range.index + range.count > 65536)
+                        {
+                            ++failureCount;
+                        }
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        CUE_REQUIRE(allocator.end_frame(++fence));
+    }
+    CUE_CHECK(failureCount.load() == 0);
+    CUE_CHECK(allocator.get_transient_used_page_count() < 128);
+}
+
+CUE_TEST(DescriptorAllocator, TransientPagePerAllocator)
+{
+    // CBV/SRV/UAV とサンプラーのように 2 つの割り当て器を交互に使っても、それぞれ 1 ページで足りる
+    Graphics::DescriptorAllocator resources;
+    Graphics::DescriptorAllocator samplers;
+    CUE_REQUIRE(resources.initialize({ .capacity = 4096, .persistentCount = 1024, .pageSize = 64 }));
+    CUE_REQUIRE(samplers.initialize({ .capacity = 2048, .persistentCount = 1024, .pageSize = 64 }));
+    bool isContiguous = true;
+    Graphics::DescriptorRange previous = resources.allocate_transient(1);
+    for (uint32_t i = 0; i < 63; ++i)
+    {
+        CUE_CHECK(samplers.allocate_transient(1).is_valid());
+        const Graphics::DescriptorRange range = resources.allocate_transient(1);
+        isContiguous = isContiguous && range.index == previous.index + 1;
+        previous = range;
+    }
+    CUE_CHECK(isContiguous);
+    CUE_CHECK(resources.get_transient_used_page_count() == 1);
+    CUE_CHECK(samplers.get_transient_used_page_count() == 1);
+
+    // フレームを締めたら次のページから切り出す
+    CUE_REQUIRE(resources.end_frame(1));
+    CUE_CHECK(resources.allocate_transient(1).is_valid());
+    CUE_CHECK(resources.get_transient_used_page_count() == 2);
+}
+
+CUE_TEST(UploadRing, DataSurvivesUntilFence)
+{
+    Graphics::HostUploadMemory memory;
+    Graphics::UploadRing ring;
+    Graphics::UploadRingDesc desc{};
+    desc.memory = &memory;
+    desc.pageSize = 256 * 1024;
+    CUE_REQUIRE(ring.initialize(desc));
+
+    struct Written
+    {
+        Graphics::UploadAllocation allocation;
+        uint8_t tag;
+    };
+    std::deque<std::vector<Written>> inFlight;
+    uint64_t fence = 0;
+    constexpr uint64_t k_lag = 3;
+    uint64_t corruptCount = 0;
+    std::atomic<uint32_t> invalidCount{ 0 };
+    for (int frame = 0; frame < 60; ++frame)
+    {
+        // 1) GPU が読み終えたフレームの中身が上書きされていないこと
+        if (fence >= k_lag)
+        {
+            for (const Written& w : inFlight.front())
+            {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(w.allocation.cpuAddress);
+                corruptCount += std::any_of(bytes, bytes + w.allocation.size, [&w](uint8_t b) { return b != w.tag; }) ? 1 : 0;
+            }
+            inFlight.pop_front();
+            ring.begin_frame(fence - k_lag + 1);
+        }
+
+        // 2) 4 スレッドから大小混ぜて確保する
+        std::vector<Written> current;
+        std::mutex mutex;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    std::mt19937 rng(frame * 10 + t);
+                    std::vector<Written> local;
+                    for (int i = 0; i < 200; ++i)
+                    {
+                        const uint64_t size = rng() % 50 == 0 ? 200000 : 1 + rng() % 1024;
+                        const Graphics::UploadAllocation allocation = ring.allocate(size, 256u << (rng() % 2));
+                        if (!allocation.is_valid() || allocation.gpuAddress % 256 != 0)
+                        {
+                            ++invalidCount;
+                            continue;
+                        }
+                        const uint8_t tag = static_cast<uint8_t>(frame * 7 + t + i);
+                        std::memset(allocation.cpuAddress, tag, size);
+                        local.push_back({ allocation, tag });
+                    }
+                    std::lock_guard lock(mutex);
+                    current.insert(current.end(), local.begin(), local.end());
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        inFlight.push_back(std::move(current));
+        ring.end_frame(++fence);
+    }
+    CUE_CHECK(invalidCount.load() == 0);
+    CUE_CHECK(corruptCount == 0);
+    CUE_CHECK(ring.get_in_flight_page_count() > 0);
+
+    ring.begin_frame(fence);
+    ring.trim();
+    CUE_CHECK(ring.get_free_page_count() == 0);
+    ring.shutdown();
+}
+
+CUE_TEST(CommandList, SubmitIsDeterministic)
+{
+    // 記録するスレッドの順番が変わっても、提出の並びと再生結果は同じ
+    constexpr uint32_t k_listCount = 8;
+    std::vector<std::unique_ptr<Graphics::CommandList>> lists;
+    for (uint32_t i = 0; i < k_listCount; ++i)
+    {
+        lists.push_back(std::make_unique<Graphics::CommandList>());
+        CUE_REQUIRE(lists.back()->initialize(1u << 20));
+    }
+    uint64_t checksums[2] = {};
+    for (uint32_t run = 0; run < 2; ++run)
+    {
+        std::vector<uint32_t> order(k_listCount);
+        for (uint32_t i = 0; i < k_listCount; ++i)
+        {
+            order[i] = i;
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(run));
+        std::atomic<uint32_t> failureCount{ 0 };
+        std::vector<std::thread> threads;
+        for (const uint32_t index : order)
+        {
+            threads.emplace_back([&lists, &failureCount, index]()
+                {
+                    record_draws(*lists[index], index, 1000);
+                    failureCount += lists[index]->close() ? 0 : 1;
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        CUE_REQUIRE(failureCount.load() == 0);
+
+        std::vector<const Graphics::CommandList*> submitted;
+        for (uint32_t k = k_listCount; k-- > 0;)
+        {
+            submitted.push_back(lists[order[k]].get());
+        }
+        Graphics::Null::ReplayQueue queue;
+        CUE_REQUIRE(Graphics::submit(queue, submitted));
+        CUE_CHECK(queue.get_stats().commandCount == k_listCount * (1 + 3 * 1000));
+        checksums[run] = queue.get_stats().checksum;
+    }
+    CUE_CHECK(checksums[0] == checksums[1]);
+}
+
+CUE_TEST(CommandList, ReplayRejectsDrawWithoutPipeline)
+{
+    Graphics::CommandList list;
+    CUE_REQUIRE(list.initialize(256));
+    list.begin(0);
+    list.draw(1, 1, 0, 0);
+    CUE_REQUIRE(list.close());
+    Graphics::Null::ReplayQueue queue;
+    const Graphics::CommandList* lists[] = { &list };
+    CUE_CHECK(!queue.execute(lists));
+}
+
+CUE_TEST(ShaderCache, KeyCoversEveryInput)
+{
+    const Graphics::ShaderDefine defines[] = { { "A", "1" }, { "B", "2" } };
+    const Graphics::ShaderDefine reordered[] = { { "B", "2" }, { "A", "1" } };
+    const Graphics::ShaderDefine shifted[] = { { "A", "1B" }, { "", "2" } };
+    const Core::Sha256Digest key = Graphics::make_shader_cache_key({ "src", defines, "main", "vs_6_6", "dxc1" });
+    CUE_CHECK(key == Graphics::make_shader_cache_key({ "src", defines, "main", "vs_6_6", "dxc1" }));
+    CUE_CHECK(!(key == Graphics::make_shader_cache_key({ "src", reordered, "main", "vs_6_6", "dxc1" })));
+    CUE_CHECK(!(key == Graphics::make_shader_cache_key({ "src", shifted, "main", "vs_6_6", "dxc1" })));
+    CUE_CHECK(!(key == Graphics::make_shader_cache_key({ "src", defines, "main", "vs_6_6", "dxc2" })));
+    CUE_CHECK(!(key == Graphics::make_shader_cache_key({ "src", defines, "main", "ps_6_6", "dxc1" })));
+}
+
+CUE_TEST(ShaderCache, StoresBytecodeAndReflection)
+{
+    Graphics::ShaderCache cache;
+    const std::string path = (Cue::Test::make_temp_directory("shader_cache") / "shaders.bin").string();
+    CUE_REQUIRE(cache.open({ path }));
+    const Graphics::ShaderDefine defines[] = { { "A", "1" } };
+    const Core::Sha256Digest key = Graphics::make_shader_cache_key({ "src", defines, "main", "vs_6_6", "dxc1" });
+    std::vector<std::byte> bytecode(333);
+    std::vector<std::byte> reflection(55);
+    for (size_t i = 0; i < bytecode.size(); ++i)
+    {
+        bytecode[i] = static_cast<std::byte>(i * 3);
+    }
+    for (size_t i = 0; i < reflection.size(); ++i)
+    {
+        reflection[i] = static_cast<std::byte>(i * 5 + 1);
+    }
+    CUE_REQUIRE(cache.store(key, bytecode, reflection));
+
+    std::vector<std::byte> foundBytecode;
+    std::vector<std::byte> foundReflection;
+    CUE_REQUIRE(cache.find(key, foundBytecode, foundReflection));
+    CUE_CHECK(foundBytecode == bytecode);
+    CUE_CHECK(foundReflection == reflection);
+    const Core::Sha256Digest otherKey = Graphics::make_shader_cache_key({ "src", {}, "main", "vs_6_6", "dxc1" });
+    CUE_CHECK(!cache.find(otherKey, foundBytecode, foundReflection));
+}
@@ -0,0 +1,84 @@
+#include <JobSystem.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    std::atomic<uint64_t> g_leafCount{ 0 };
+}
+
+CUE_TEST(JobSystem, NestedForkJoin)
+{
+    // ワーカー数を変えても、ジョブの中で待つ入れ子の分岐が詰まらないこと
+    for (uint32_t workerCount = 1; workerCount <= 4; ++workerCount)
+    {
+        Core::JobSystem jobSystem;
+        CUE_REQUIRE(jobSystem.initialize({ workerCount, 4096 }));
+        g_leafCount = 0;
+        for (int repeat = 0; repeat < 10; ++repeat)
+        {
+            Core::JobCounter counter;
+            std::vector<Core::JobDecl> jobs(1000, Core::JobDecl{ [](void* data)
+                {
+                    Core::JobSystem* js = static_cast<Core::JobSystem*>(data);
+                    const Core::JobDecl leaf{ [](void*) { g_leafCount.fetch_add(1, std::memory_order_relaxed); }, nullptr };
+                    const Core::JobDecl leaves[4] = { leaf, leaf, leaf, leaf };
+                    Core::JobCounter inner;
+                    js->run(leaves, 4, &inner);
+                    js->wait(inner);
+                }, &jobSystem });
+            jobSystem.run(jobs.data(), static_cast<uint32_t>(jobs.size()), &counter);
+            jobSystem.wait(counter);
+        }
+        CUE_CHECK(g_leafCount.load() == 10u * 1000u * 4u);
+    }
+}
+
+CUE_TEST(JobSystem, ParallelForCoversRange)
+{
+    Core::JobSystem jobSystem;
+    CUE_REQUIRE(jobSystem.initialize({ 4, 1024 }));
+    std::vector<uint32_t> visits(100003, 0);
+    jobSystem.parallel_for(static_cast<uint32_t>(visits.size()), 1000, [&visits](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                ++visits[i];
+            }
+        });
+    bool isEachOnce = true;
+    for (const uint32_t v : visits)
+    {
+        isEachOnce = isEachOnce && v == 1;
+    }
+    CUE_CHECK(isEachOnce);
+
+    // 空の範囲は本体を呼ばない
+    bool isCalled = false;
+    jobSystem.parallel_for(0, 16, [&isCalled](uint32_t, uint32_t) { isCalled = true; });
+    CUE_CHECK(!isCalled);
+}
+
+CUE_TEST(JobSystem, SubmitFromExternalThread)
+{
+    Core::JobSystem jobSystem;
+    CUE_REQUIRE(jobSystem.initialize({ 2, 1024 }));
+    std::atomic<int> count{ 0 };
+    std::thread([&jobSystem, &count]()
+        {
+            Core::JobCounter counter;
+            const Core::JobDecl job{ [](void* data) { static_cast<std::atomic<int>*>(data)->fetch_add(1); }, &count };
+            for (int i = 0; i < 100; ++i)
+            {
+                jobSystem.run(job, &counter);
+            }
+            jobSystem.wait(counter);
+        }).join();
+    CUE_CHECK(count.load() == 100);
+    CUE_CHECK(jobSystem.get_worker_count() == 2);
+}
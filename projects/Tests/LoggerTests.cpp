@@ -0,0 +1,122 @@
+#include <Logger.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    std::string read_text(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path);
+        std::stringstream text;
+        text << stream.rdbuf();
+        return text.str();
+    }
+
+    /// @brief 4 スレッドから一斉に書き、書けた数と捨てた数の合計を確かめる
+    void log_from_threads(Core::LogOverflowPolicy policy, const std::filesystem::path& path)
+    {
+        const std::string pathText = path.string();
+        Core::Logger logger;
+        Core::LoggerDesc desc{};
+        desc.filePath = pathText.c_str();
+        desc.isStderrEnabled = false;
+        desc.overflowPolicy = policy;
+        desc.ringCapacity = 4096;
+        CUE_REQUIRE(logger.initialize(desc));
+
+        constexpr uint32_t k_threadCount = 4;
+        constexpr uint32_t k_logCount = 20000;
+        const Core::Result r = Core::Result::fail(Core::Facility::IO, Core::Code::IoError, Core::Severity::Error, 5, "disk on fire");
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < k_threadCount; ++t)
+        {
+            threads.emplace_back([&logger, &r]()
+                {
+                    for (uint32_t i = 0; i < k_logCount; ++i)
+                    {
+                        (void)logger.log(r);
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        logger.flush();
+
+        CUE_CHECK(logger.get_written_count() + logger.get_dropped_count() == k_threadCount * k_logCount);
+        if (policy == Core::LogOverflowPolicy::Block)
+        {
+            CUE_CHECK(logger.get_dropped_count() == 0);
+        }
+        logger.shutdown();
+        CUE_CHECK(read_text(path).find("disk on fire") != std::string::npos);
+    }
+}
+
+CUE_TEST(Logger, DropPolicyAccountsEveryMessage)
+{
+    log_from_threads(Core::LogOverflowPolicy::Drop, Cue::Test::make_temp_directory("logger_drop") / "log.txt");
+}
+
+CUE_TEST(Logger, BlockPolicyKeepsEveryMessage)
+{
+    log_from_threads(Core::LogOverflowPolicy::Block, Cue::Test::make_temp_directory("logger_block") / "log.txt");
+}
+
+CUE_TEST(Logger, FiltersBelowMinSeverity)
+{
+    const std::filesystem::path path = Cue::Test::make_temp_directory("logger_filter") / "log.txt";
+    const std::string pathText = path.string();
+    Core::Logger logger;
+    Core::LoggerDesc desc{};
+    desc.filePath = pathText.c_str();
+    desc.isStderrEnabled = false;
+    desc.minSeverity = Core::Severity::Error;
+    CUE_REQUIRE(logger.initialize(desc));
+    (void)logger.log(Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Warning, 0, "quiet warning"));
+    (void)logger.log(Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Error, 0, "loud error"));
+    logger.shutdown();
+
+    const std::string text = read_text(path);
+    CUE_CHECK(text.find("quiet warning") == std::string::npos);
+    CUE_CHECK(text.find("loud error") != std::string::npos);
+}
+
+CUE_TEST(Logger, ReusesRingsOfFinishedThreads)
+{
+    Core::Logger logger;
+    Core::LoggerDesc desc{};
+    desc.isStderrEnabled = false;
+    desc.ringCapacity = 16;
+    CUE_REQUIRE(logger.initialize(desc));
+
+    // 上限を大きく超える数のスレッドが入れ替わりに書いても、終わったスレッドのリングを使い回して捨てない
+    constexpr uint32_t k_batchCount = 16;
+    constexpr uint32_t k_threadsPerBatch = 50;
+    const Core::Result r = Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Info, 0, "short-lived thread");
+    for (uint32_t batch = 0; batch < k_batchCount; ++batch)
+    {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < k_threadsPerBatch; ++t)
+        {
+            threads.emplace_back([&logger, &r]() { (void)logger.log(r); });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        logger.flush();
+    }
+    static_assert(k_batchCount * k_threadsPerBatch > Core::Logger::k_maxThreads);
+    logger.shutdown();
+    CUE_CHECK(logger.get_written_count() == k_batchCount * k_threadsPerBatch);
+    CUE_CHECK(logger.get_dropped_count() == 0);
+}
@@ -0,0 +1,154 @@
+#include <MathBatch.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Math = Cue::Math;
+
+    float get_max_difference(const Math::float4x4& a, const Math::float4x4& b)
+    {
+        float difference = 0.0f;
+        for (int row = 0; row < 4; ++row)
+        {
+            difference = std::max({ difference, std::fabs(a.r[row].x - b.r[row].x), std::fabs(a.r[row].y - b.r[row].y),
+                std::fabs(a.r[row].z - b.r[row].z), std::fabs(a.r[row].w - b.r[row].w) });
+        }
+        return difference;
+    }
+
+    Math::float4x4 make_random_matrix(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+        Math::float4x4 m;
+        for (int row = 0; row < 4; ++row)
+        {
+            m.r[row] = { distribution(rng), distribution(rng), distribution(rng), distribution(rng) };
+        }
+        return m;
+    }
+}
+
+CUE_TEST(Math, MatrixMatchesScalar)
+{
+    // SIMD 版とスカラー参照実装の差が誤差の範囲に収まること
+    std::mt19937 rng(1);
+    float worstMultiply = 0.0f;
+    float worstTranspose = 0.0f;
+    float worstInverse = 0.0f;
+    float worstIdentity = 0.0f;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const Math::float4x4 a = make_random_matrix(rng);
+        const Math::float4x4 b = make_random_matrix(rng);
+        worstMultiply = std::max(worstMultiply, get_max_difference(Math::multiply(a, b), Math::Scalar::multiply(a, b)));
+        worstTranspose = std::max(worstTranspose, get_max_difference(Math::transpose(a), Math::Scalar::transpose(a)));
+        float determinant = 0.0f;
+        float referenceDeterminant = 0.0f;
+        const Math::float4x4 inverse = Math::inverse(a, &determinant);
+        const Math::float4x4 reference = Math::Scalar::inverse(a, &referenceDeterminant);
+        if (std::fabs(referenceDeterminant) > 0.5f)
+        {
+            worstInverse = std::max(worstInverse, get_max_difference(inverse, reference));
+            worstIdentity = std::max(worstIdentity, get_max_difference(Math::multiply(a, inverse), Math::identity()));
+        }
+    }
+    CUE_CHECK(worstMultiply < 1e-5f);
+    CUE_CHECK(worstTranspose == 0.0f);
+    CUE_CHECK(worstInverse < 1e-3f);
+    CUE_CHECK(worstIdentity < 1e-3f);
+}
+
+CUE_TEST(Math, SingularInverse)
+{
+    Math::float4x4 singular = Math::identity();
+    singular.r[3] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float determinant = 1.0f;
+    (void)Math::inverse(singular, &determinant);
+    CUE_CHECK(determinant == 0.0f);
+}
+
+CUE_TEST(Math, Quaternion)
+{
+    const Math::quaternion qa = Math::from_axis_angle({ 0.0f, 1.0f, 0.0f }, 0.7f);
+    const Math::quaternion qb = Math::from_axis_angle({ 1.0f, 0.0f, 0.0f }, 1.2f);
+
+    // 合成した回転は、順に回した結果と一致する
+    const Math::float3 p{ 1.0f, 2.0f, 3.0f };
+    const Math::float3 sequential = Math::transform_point(Math::transform_point(p, Math::to_matrix(qa)), Math::to_matrix(qb));
+    const Math::float3 composed = Math::transform_point(p, Math::to_matrix(Math::multiply(qa, qb)));
+    CUE_CHECK(std::fabs(sequential.x - composed.x) + std::fabs(sequential.y - composed.y) + std::fabs(sequential.z - composed.z) < 1e-5f);
+
+    // z 軸回りに 90 度回すと x 軸が y 軸へ移る
+    const Math::float3 rotated = Math::transform_point({ 1.0f, 0.0f, 0.0f }, Math::to_matrix(Math::from_axis_angle({ 0.0f, 0.0f, 1.0f }, Math::k_pi / 2.0f)));
+    CUE_CHECK(std::fabs(rotated.x) < 1e-6f && std::fabs(rotated.y - 1.0f) < 1e-6f && std::fabs(rotated.z) < 1e-6f);
+
+    float worstSlerp = 0.0f;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float t = static_cast<float>(i) / 999.0f;
+        const Math::quaternion s = Math::slerp(qa, qb, t);
+        const Math::quaternion reference = Math::Scalar::slerp(qa, qb, t);
+        worstSlerp = std::max({ worstSlerp, std::fabs(s.x - reference.x), std::fabs(s.y - reference.y),
+            std::fabs(s.z - reference.z), std::fabs(s.w - reference.w) });
+    }
+    CUE_CHECK(worstSlerp < 1e-5f);
+
+    // 反対側の半球の四元数でも最短経路を補間する
+    const Math::quaternion negated{ -qb.x, -qb.y, -qb.z, -qb.w };
+    const Math::quaternion half = Math::slerp(qa, negated, 0.5f);
+    const Math::quaternion halfReference = Math::Scalar::slerp(qa, negated, 0.5f);
+    CUE_CHECK(std::fabs(half.x - halfReference.x) + std::fabs(half.w - halfReference.w) < 1e-5f);
+}
+
+CUE_TEST(Math, BatchMatchesScalar)
+{
+    // 端数が出る個数で、SIMD の本体と余りの両方を通す
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+    constexpr size_t k_count = 10003;
+    std::vector<float> x(k_count), y(k_count), z(k_count);
+    std::vector<float> ox(k_count), oy(k_count), oz(k_count);
+    std::vector<float> rx(k_count), ry(k_count), rz(k_count);
+    for (size_t i = 0; i < k_count; ++i)
+    {
+        x[i] = distribution(rng);
+        y[i] = distribution(rng);
+        z[i] = distribution(rng);
+    }
+    const Math::float4x4 m = Math::multiply(Math::to_matrix(Math::from_axis_angle({ 0.0f, 1.0f, 0.0f }, 0.7f)), Math::translation({ 1.0f, 2.0f, 3.0f }));
+    Math::transform_points(m, { x.data(), y.data(), z.data() }, { ox.data(), oy.data(), oz.data() }, k_count);
+    Math::Scalar::transform_points(m, { x.data(), y.data(), z.data() }, { rx.data(), ry.data(), rz.data() }, k_count);
+    float worstPoint = 0.0f;
+    for (size_t i = 0; i < k_count; ++i)
+    {
+        worstPoint = std::max({ worstPoint, std::fabs(ox[i] - rx[i]), std::fabs(oy[i] - ry[i]), std::fabs(oz[i] - rz[i]) });
+    }
+    CUE_CHECK(worstPoint < 1e-5f);
+
+    std::vector<Math::float4x4> matrices(1001), transformed(1001), reference(1001);
+    for (Math::float4x4& matrix : matrices)
+    {
+        matrix = make_random_matrix(rng);
+    }
+    Math::transform_matrices(matrices.data(), m, transformed.data(), matrices.size());
+    Math::Scalar::transform_matrices(matrices.data(), m, reference.data(), matrices.size());
+    float worstMatrix = 0.0f;
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        worstMatrix = std::max(worstMatrix, get_max_difference(transformed[i], reference[i]));
+    }
+    CUE_CHECK(worstMatrix < 1e-5f);
+
+    Math::multiply_matrices(matrices.data(), transformed.data(), reference.data(), matrices.size());
+    worstMatrix = 0.0f;
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        worstMatrix = std::max(worstMatrix, get_max_difference(reference[i], Math::Scalar::multiply(matrices[i], transformed[i])));
+    }
+    CUE_CHECK(worstMatrix < 1e-4f);
+}
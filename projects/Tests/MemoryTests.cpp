@@ -0,0 +1,251 @@
+#include <FrameArena.h>
+#include <JobSystem.h>
+#include <MemoryTracker.h>
+#include <PoolAllocator.h>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    struct alignas(256) OverAligned
+    {
+        char bytes[300];
+    };
+}
+
+CUE_TEST(FrameArena, ParallelAllocateAndRewind)
+{
+    Core::FrameArena arena;
+    CUE_REQUIRE(arena.initialize({ .bytesPerFrame = 1u << 20, .frameCount = 3, .blockSize = 4096 }));
+    Core::JobSystem jobSystem;
+    CUE_REQUIRE(jobSystem.initialize({ 4, 1024 }));
+
+    for (uint32_t frame = 0; frame < 6; ++frame)
+    {
+        std::atomic<uint32_t> failureCount{ 0 };
+        jobSystem.parallel_for(1000, 10, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    int* p = arena.try_allocate_array<int>(16);
+                    if (!p || reinterpret_cast<uintptr_t>(p) % alignof(int) != 0)
+                    {
+                        ++failureCount;
+                        continue;
+                    }
+                    for (int k = 0; k < 16; ++k)
+                    {
+                        p[k] = k;
+                    }
+                }
+            });
+        CUE_CHECK(failureCount.load() == 0);
+
+        void* aligned = arena.try_allocate(20000, 256);
+        CUE_CHECK(aligned && reinterpret_cast<uintptr_t>(aligned) % 256 == 0);
+        CUE_CHECK(arena.get_used_bytes() >= 1000 * 16 * sizeof(int));
+        CUE_CHECK(arena.try_allocate(2u << 20) == nullptr);
+        CUE_CHECK(arena.begin_frame());
+        CUE_CHECK(arena.get_frame_index() == frame + 1);
+    }
+}
+
+CUE_TEST(FrameArena, OverflowsToUpstream)
+{
+    Core::FrameArena arena;
+    CUE_REQUIRE(arena.initialize({ .bytesPerFrame = 64u * 1024u, .frameCount = 2, .blockSize = 4096 }));
+    {
+        // pmr コンテナは容量不足分を upstream へ退避して動き続ける
+        std::pmr::vector<std::pmr::string> strings(&arena);
+        for (int i = 0; i < 100; ++i)
+        {
+            strings.emplace_back("some fairly long string that exceeds the small buffer");
+        }
+        std::pmr::vector<char> huge(&arena);
+        huge.resize(1u << 20);
+        CUE_CHECK(strings.back() == "some fairly long string that exceeds the small buffer");
+    }
+    CUE_CHECK(arena.get_overflow_bytes() >= (1u << 20));
+    CUE_CHECK(arena.begin_frame());
+}
+
+#ifdef CUE_DEBUG
+CUE_TEST(FrameArena, DetectsOverrun)
+{
+    Core::FrameArena arena;
+    CUE_REQUIRE(arena.initialize({ .bytesPerFrame = 64u * 1024u, .frameCount = 2, .blockSize = 4096 }));
+    char* p = static_cast<char*>(arena.try_allocate(10, 1));
+    CUE_REQUIRE(p);
+    p[10] = 'x';
+    CUE_CHECK(!arena.begin_frame());
+}
+#endif
+
+CUE_TEST(PoolAllocator, ReusesSlots)
+{
+    Core::PoolAllocator<std::string> pool(4);
+    std::vector<std::string*> strings;
+    for (int i = 0; i < 10; ++i)
+    {
+        strings.push_back(pool.create("a string long enough to live on the heap " + std::to_string(i)));
+    }
+    CUE_CHECK(pool.get_live_count() == 10);
+    CUE_CHECK(pool.get_page_count() == 3);
+    CUE_CHECK(*strings[9] == "a string long enough to live on the heap 9");
+
+    for (std::string* s : strings)
+    {
+        pool.destroy(s);
+    }
+    CUE_CHECK(pool.get_live_count() == 0);
+
+    // 解放したスロットを使い回し、ページは増えない
+    for (int i = 0; i < 10; ++i)
+    {
+        strings[i] = pool.create("again");
+    }
+    CUE_CHECK(pool.get_page_count() == 3);
+    for (std::string* s : strings)
+    {
+        pool.destroy(s);
+    }
+}
+
+#ifdef CUE_DEBUG
+CUE_TEST(PoolAllocator, DetectsOverrun)
+{
+    Core::PoolAllocator<uint32_t> pool(4);
+    uint32_t* p = pool.allocate_object();
+    CUE_REQUIRE(p);
+    CUE_CHECK(pool.check_guards());
+    reinterpret_cast<unsigned char*>(p)[sizeof(uint32_t)] = 0;
+    pool.deallocate_object(p);
+    CUE_CHECK(!pool.check_guards());
+    CUE_CHECK(pool.get_live_count() == 0);
+    // 壊れたスロットは払い出さない
+    uint32_t* q = pool.allocate_object();
+    CUE_CHECK(q != p);
+    pool.deallocate_object(q);
+}
+#endif
+
+CUE_TEST(PoolAllocator, LargeRequestsGoUpstream)
+{
+    Core::PoolAllocator<int> pool(16);
+    std::pmr::vector<int> values(&pool);
+    values.resize(100);
+    values[99] = 7;
+    CUE_CHECK(values[99] == 7);
+    CUE_CHECK(pool.get_live_count() == 0);
+}
+
+CUE_TEST(MemoryTracker, TagsAndCrossThreadFree)
+{
+    if (!Core::is_memory_tracking_enabled())
+    {
+        return;
+    }
+    const Core::MemoryTagStats graphicsBefore = Core::get_memory_stats(Core::Facility::Graphics);
+    {
+        CUE_MEMORY_TAG(Core::Facility::Graphics);
+        auto bytes = std::make_unique<char[]>(1000);
+        CUE_CHECK(Core::get_memory_stats(Core::Facility::Graphics).liveBytes - graphicsBefore.liveBytes == 1000);
+        {
+            CUE_MEMORY_TAG(Core::Facility::IO);
+            int* volatile value = new int(3);
+            CUE_CHECK(Core::get_thread_memory_tag() == Core::Facility::IO);
+            delete value;
+        }
+        CUE_CHECK(Core::get_thread_memory_tag() == Core::Facility::Graphics);
+    }
+    CUE_CHECK(Core::get_memory_stats(Core::Facility::Graphics).liveBytes == graphicsBefore.liveBytes);
+    CUE_CHECK(Core::get_memory_stats(Core::Facility::Graphics).peakBytes >= 1000);
+
+    // 別スレッドで解放しても確保時のタグから引く
+    const uint64_t platformBefore = Core::get_memory_stats(Core::Facility::Platform).liveCount;
+    int* volatile values = nullptr;
+    {
+        CUE_MEMORY_TAG(Core::Facility::Platform);
+        values = new int[10];
+    }
+    CUE_CHECK(Core::get_memory_stats(Core::Facility::Platform).liveCount == platformBefore + 1);
+    std::thread([&values]() { delete[] values; }).join();
+    CUE_CHECK(Core::get_memory_stats(Core::Facility::Platform).liveCount == platformBefore);
+}
+
+CUE_TEST(MemoryTracker, KeepsAlignment)
+{
+    CUE_MEMORY_TAG(Core::Facility::D3D12);
+    auto single = std::make_unique<OverAligned>();
+    CUE_CHECK(reinterpret_cast<uintptr_t>(single.get()) % 256 == 0);
+    std::vector<OverAligned> many(3);
+    CUE_CHECK(reinterpret_cast<uintptr_t>(many.data()) % 256 == 0);
+}
+
+CUE_TEST(MemoryTracker, BudgetWarnsOnce)
+{
+    if (!Core::is_memory_tracking_enabled())
+    {
+        return;
+    }
+    const uint64_t base = Core::get_memory_stats(Core::Facility::IO).liveBytes;
+    Core::set_memory_budget(Core::Facility::IO, base + 4096);
+    CUE_CHECK(Core::check_memory_budgets());
+
+    std::vector<std::unique_ptr<char[]>> keep;
+    keep.reserve(16);
+    {
+        CUE_MEMORY_TAG(Core::Facility::IO);
+        for (int i = 0; i < 8; ++i)
+        {
+            keep.push_back(std::make_unique<char[]>(1024));
+        }
+    }
+    const Core::Result warning = Core::check_memory_budgets();
+    CUE_CHECK(!warning);
+    CUE_CHECK(warning.get_facility() == Core::Facility::IO);
+    CUE_CHECK(warning.get_severity() == Core::Severity::Warning);
+    // 同じ超過は 2 度返さない
+    CUE_CHECK(Core::check_memory_budgets());
+    keep.clear();
+    Core::set_memory_budget(Core::Facility::IO, 0);
+}
+
+CUE_TEST(MemoryTracker, FrameCountAndReport)
+{
+    if (!Core::is_memory_tracking_enabled())
+    {
+        return;
+    }
+    Core::begin_memory_frame();
+    {
+        CUE_MEMORY_TAG(Core::Facility::Core);
+        for (int i = 0; i < 5; ++i)
+        {
+            int* volatile value = new int;
+            delete value;
+        }
+    }
+    Core::begin_memory_frame();
+    CUE_CHECK(Core::get_memory_stats(Core::Facility::Core).frameCount >= 5);
+
+    const Core::MemorySnapshot baseline = Core::take_memory_snapshot();
+    std::FILE* report = std::tmpfile();
+    CUE_REQUIRE(report);
+    char* volatile leaked = nullptr;
+    {
+        CUE_MEMORY_TAG(Core::Facility::Graphics);
+        leaked = new char[77];
+    }
+    CUE_CHECK(Core::write_memory_report(report, baseline) >= 1);
+    std::fclose(report);
+    delete[] leaked;
+}
@@ -0,0 +1,115 @@
+#include <NameId.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    static_assert(Core::NameId("RenderDevice_D3D12Device").get_hash() == Core::hash_name("RenderDevice_D3D12Device"));
+    static_assert(Core::NameId("GBuffer") != Core::NameId("GBuffer2"));
+
+    constexpr Core::NameId k_gbuffer = "GBuffer";
+}
+
+CUE_TEST(NameId, CompileTimeMatchesInterned)
+{
+    const Core::NameId interned = Core::NameId::intern("GBuffer");
+    CUE_CHECK(interned == k_gbuffer);
+    CUE_CHECK(interned.get_hash() == k_gbuffer.get_hash());
+    // 登録後はコンパイル時に作った側からも文字列が引ける
+    CUE_CHECK(k_gbuffer.get_text() == "GBuffer");
+    CUE_CHECK(k_gbuffer.get_text().data()[7] == '\0');
+}
+
+CUE_TEST(NameId, ConcurrentIntern)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 20000; ++i)
+    {
+        names.push_back("textures/キャラクター/chara_" + std::to_string(i) + ".dds");
+    }
+    const Core::NameTableStats before = Core::get_name_table_stats();
+
+    // 同じ文字列を複数スレッドから重ねて登録しても 1 件にまとまる
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&names, t]()
+            {
+                for (size_t i = 0; i < names.size(); ++i)
+                {
+                    (void)Core::NameId::intern(names[(i * 7 + t) % names.size()]);
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bool isAllFound = true;
+    for (const std::string& name : names)
+    {
+        isAllFound = isAllFound && Core::NameId::from_string(name).get_text() == name;
+    }
+    CUE_CHECK(isAllFound);
+
+    const Core::NameTableStats after = Core::get_name_table_stats();
+    CUE_CHECK(after.entryCount - before.entryCount == names.size());
+    CUE_CHECK(after.collisionCount == before.collisionCount);
+}
+
+CUE_TEST(NameId, GrowsPastInitialCapacity)
+{
+    // 最初の表（65536 枠）の 7/8 を超えて登録しても、全ての文字列を引ける
+    const Core::NameTableStats before = Core::get_name_table_stats();
+    const uint32_t count = before.capacity;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([count, t]()
+            {
+                for (uint32_t i = t; i < count; i += 4)
+                {
+                    (void)Core::NameId::intern("grow/" + std::to_string(i));
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bool isAllFound = true;
+    uint64_t textBytes = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const std::string name = "grow/" + std::to_string(i);
+        isAllFound = isAllFound && Core::NameId::from_string(name).get_text() == name;
+        textBytes += name.size();
+    }
+    CUE_CHECK(isAllFound);
+
+    // 表を移る途中に登録した名前も、文字列は 1 度しか写さない
+    const Core::NameTableStats after = Core::get_name_table_stats();
+    CUE_CHECK(after.entryCount - before.entryCount == count);
+    CUE_CHECK(after.textBytes - before.textBytes == textBytes);
+    CUE_CHECK(after.growCount > before.growCount);
+    CUE_CHECK(after.capacity > before.capacity);
+    CUE_CHECK(after.collisionCount == before.collisionCount);
+}
+
+CUE_TEST(NameId, UsableAsHashKey)
+{
+    std::unordered_map<Core::NameId, int> map;
+    map[Core::NameId::intern("Albedo")] = 1;
+    map[Core::NameId::intern("Normal")] = 2;
+    CUE_CHECK(map.at(Core::NameId("Albedo")) == 1);
+    CUE_CHECK(map.at(Core::NameId::from_string(std::string("Nor") + "mal")) == 2);
+    CUE_CHECK(map.find(Core::NameId("Depth")) == map.end());
+}
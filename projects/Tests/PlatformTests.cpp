@@ -0,0 +1,212 @@
+#include <FramePacer.h>
+#include <InputEvents.h>
+#include <chrono>
+#include <headless_platform.h>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Platform = Cue::Platform;
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+CUE_TEST(Input, QueueCapacityAndOverflow)
+{
+    Platform::InputEventQueue queue;
+    CUE_CHECK(!queue.push({}));
+    CUE_REQUIRE(queue.initialize(100));
+    CUE_CHECK(queue.get_capacity() == 128);
+    CUE_CHECK(!queue.initialize(4));
+
+    for (uint32_t i = 0; i < 128; ++i)
+    {
+        CUE_REQUIRE(queue.push({}));
+    }
+    // 満杯なら捨てて数える（生産側は待たない）
+    CUE_CHECK(!queue.push({}));
+    CUE_CHECK(queue.get_dropped_count() == 1);
+
+    std::vector<Platform::InputEvent> events(256);
+    CUE_CHECK(queue.pop(events) == 128);
+    CUE_CHECK(queue.pop(events) == 0);
+}
+
+CUE_TEST(Input, ProducerConsumerOrder)
+{
+    Platform::InputEventQueue queue;
+    CUE_REQUIRE(queue.initialize(1024));
+    constexpr uint32_t k_eventCount = 200000;
+    std::thread producer([&queue]()
+        {
+            for (uint32_t i = 0; i < k_eventCount;)
+            {
+                Platform::InputEvent event{};
+                event.code = i;
+                event.timestampNs = Platform::get_input_timestamp();
+                if (queue.push(event))
+                {
+                    ++i;
+                }
+            }
+        });
+
+    std::vector<Platform::InputEvent> events(256);
+    uint32_t expected = 0;
+    uint64_t lastTimestamp = 0;
+    bool isOrdered = true;
+    while (expected < k_eventCount && isOrdered)
+    {
+        const uint32_t count = queue.pop(std::span(events).first(1 + expected % 200));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            isOrdered = isOrdered && events[i].code == expected && events[i].timestampNs >= lastTimestamp;
+            lastTimestamp = events[i].timestampNs;
+            ++expected;
+        }
+    }
+    producer.join();
+    CUE_CHECK(isOrdered);
+}
+
+CUE_TEST(Input, SyntheticInputIsAccounted)
+{
+    Platform::Headless::HeadlessPlatform platform;
+    CUE_CHECK(!platform.start_synthetic_input({}));
+    CUE_REQUIRE(platform.setup());
+    CUE_REQUIRE(platform.start_synthetic_input({ 20000.0, 7 }));
+
+    std::vector<Platform::InputEvent> events(1024);
+    uint64_t receivedCount = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100))
+    {
+        receivedCount += platform.get_input_queue().pop(events);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    platform.stop_synthetic_input();
+    receivedCount += platform.get_input_queue().pop(events);
+
+    // 受け取った数と捨てた数の合計が生成した数と一致する
+    CUE_CHECK(platform.get_synthetic_event_count() > 0);
+    CUE_CHECK(receivedCount + platform.get_input_queue().get_dropped_count() == platform.get_synthetic_event_count());
+    CUE_CHECK(platform.shutdown());
+}
+
+CUE_TEST(FramePacer, HoldsTargetFps)
+{
+    Platform::FramePacer pacer;
+    CUE_CHECK(!pacer.initialize({ -1.0 }));
+    CUE_REQUIRE(pacer.initialize({ 200.0 }));
+    CUE_CHECK(!pacer.initialize({ 200.0 }));
+
+    // 最初の呼び出しは基準時刻を決めるだけなので数えない
+    constexpr uint32_t k_frameCount = 60;
+    pacer.wait_for_next_frame();
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < k_frameCount; ++i)
+    {
+        pacer.wait_for_next_frame();
+    }
+    const double totalMs = elapsed_ms(start);
+
+    // 周期 5ms より早く抜けない（遅れは負荷次第なので、上限は他のテストと並べて走っても収まる幅にする）
+    const Platform::FrameTimeStats stats = pacer.get_stats();
+    CUE_CHECK(stats.frameCount == k_frameCount);
+    CUE_CHECK(totalMs >= 5.0 * (k_frameCount - 1));
+    CUE_CHECK(stats.p50Ms >= 4.5);
+    CUE_CHECK(stats.avgMs >= 4.5 && stats.avgMs < 25.0);
+}
+
+CUE_TEST(FramePacer, UnlockedDoesNotWait)
+{
+    Platform::FramePacer pacer;
+    CUE_REQUIRE(pacer.initialize({ 0.0 }));
+
+    // 上限なしでは待たずに計測だけ行い、期限切れも数えない
+    constexpr uint32_t k_frameCount = 1000;
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i <= k_frameCount; ++i)
+    {
+        pacer.wait_for_next_frame();
+    }
+    const Platform::FrameTimeStats stats = pacer.get_stats();
+    CUE_CHECK(stats.frameCount == k_frameCount);
+    CUE_CHECK(stats.missedCount == 0);
+    CUE_CHECK(elapsed_ms(start) < 100.0);
+
+    // 途中で上限を付けると次のフレームから待つ
+    pacer.set_target_fps(100.0);
+    pacer.reset_stats();
+    pacer.wait_for_next_frame();
+    const Clock::time_point pacedStart = Clock::now();
+    pacer.wait_for_next_frame();
+    CUE_CHECK(elapsed_ms(pacedStart) >= 10.0);
+    CUE_CHECK(pacer.get_stats().frameCount == 1);
+}
+
+CUE_TEST(FramePacer, CountsMissedDeadlines)
+{
+    Platform::FramePacer pacer;
+    CUE_REQUIRE(pacer.initialize({ 20.0 }));
+
+    // 周期 50ms のうち 2 フレームだけ作業が期限を大きく越える
+    constexpr uint32_t k_frameCount = 10;
+    pacer.wait_for_next_frame();
+    for (uint32_t i = 0; i < k_frameCount; ++i)
+    {
+        if (i == 3 || i == 7)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(120));
+        }
+        pacer.wait_for_next_frame();
+    }
+
+    // 遅れた後は今から数え直すので、取り戻そうとして続けて落とすことはない
+    const Platform::FrameTimeStats stats = pacer.get_stats();
+    CUE_CHECK(stats.frameCount == k_frameCount);
+    CUE_CHECK(stats.missedCount == 2);
+    CUE_CHECK(stats.maxMs >= 120.0);
+
+    pacer.reset_stats();
+    CUE_CHECK(pacer.get_stats().frameCount == 0);
+    CUE_CHECK(pacer.get_stats().missedCount == 0);
+}
+
+CUE_TEST(FramePacer, FrameTimeStats)
+{
+    Platform::FramePacer pacer;
+    CUE_REQUIRE(pacer.initialize({ 0.0 }));
+    CUE_CHECK(pacer.get_stats().frameCount == 0);
+
+    // 100 フレームのうち 98 は 1ms、2 は 12ms 掛かる
+    constexpr uint32_t k_frameCount = 100;
+    pacer.wait_for_next_frame();
+    for (uint32_t i = 0; i < k_frameCount; ++i)
+    {
+        const bool isLong = i == 40 || i == 80;
+        std::this_thread::sleep_for(std::chrono::milliseconds(isLong ? 12 : 1));
+        pacer.wait_for_next_frame();
+    }
+
+    const Platform::FrameTimeStats stats = pacer.get_stats();
+    CUE_CHECK(stats.frameCount == k_frameCount);
+    CUE_CHECK(stats.minMs >= 1.0);
+    CUE_CHECK(stats.minMs <= stats.p50Ms);
+    CUE_CHECK(stats.p50Ms <= stats.p99Ms);
+    CUE_CHECK(stats.p99Ms <= stats.maxMs);
+    CUE_CHECK(stats.minMs <= stats.avgMs && stats.avgMs <= stats.maxMs);
+    // 中央値は短いフレームに、99 パーセンタイルは長いフレームに入る
+    CUE_CHECK(stats.p50Ms < 12.0);
+    CUE_CHECK(stats.p99Ms >= 12.0);
+    CUE_CHECK(stats.maxMs >= 12.0);
+    // 平均は区間に丸めず実測から出す（長い 2 フレーム分だけ中央値より大きい）
+    CUE_CHECK(stats.avgMs >= 1.0 + 2.0 * 11.0 / k_frameCount);
+}
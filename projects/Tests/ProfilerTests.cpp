@@ -0,0 +1,158 @@
+#include <Profiler.h>
+#include <fstream>
+#include <latch>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    /// @brief 直近 frameCount フレーム分を書き出して JSON の文字列を返す
+    std::string export_trace(const char* directory, uint32_t frameCount)
+    {
+        const std::filesystem::path path = Cue::Test::make_temp_directory(directory) / "trace.json";
+        if (!Core::Profiler::export_chrome_trace(path.string().c_str(), frameCount))
+        {
+            return {};
+        }
+        std::ifstream stream(path);
+        std::stringstream text;
+        text << stream.rdbuf();
+        return text.str();
+    }
+
+    size_t count_occurrences(const std::string& text, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t p = text.find(pattern); p != std::string::npos; p = text.find(pattern, p + pattern.size()))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    /// @brief pattern を含むイベントの tid を集める
+    std::set<uint32_t> collect_thread_ids(const std::string& text, const std::string& pattern)
+    {
+        std::set<uint32_t> ids;
+        for (size_t p = text.find(pattern); p != std::string::npos; p = text.find(pattern, p + pattern.size()))
+        {
+            const size_t tid = text.find("\"tid\":", p);
+            if (tid != std::string::npos)
+            {
+                ids.insert(static_cast<uint32_t>(std::stoul(text.substr(tid + 6))));
+            }
+        }
+        return ids;
+    }
+}
+
+CUE_TEST(Profiler, RecordsNestedZones)
+{
+    // マクロは Release で消えるので、ProfileScope を直に使う
+    Core::Profiler::mark_frame();
+    {
+        const Core::ProfileScope outer("ProfilerTests::Outer");
+        for (int i = 0; i < 3; ++i)
+        {
+            const Core::ProfileScope inner("ProfilerTests::Inner");
+        }
+    }
+    Core::Profiler::set_enabled(false);
+    {
+        const Core::ProfileScope ignored("ProfilerTests::WhileDisabled");
+    }
+    Core::Profiler::set_enabled(true);
+
+    const std::string json = export_trace("profiler_nested", 1);
+    CUE_REQUIRE(!json.empty());
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests::Outer\",\"ph\":\"X\"") == 1);
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests::Inner\",\"ph\":\"X\"") == 3);
+    CUE_CHECK(json.find("ProfilerTests::WhileDisabled") == std::string::npos);
+}
+
+CUE_TEST(Profiler, CollectsZonesFromFinishedThreads)
+{
+    // 同時に動いたスレッドのゾーンは、終わった後もリングが使い回されるまでは書き出せる
+    constexpr uint32_t k_threadCount = 4;
+    constexpr uint32_t k_zoneCount = 10;
+    Core::Profiler::mark_frame();
+    std::latch isAllRecorded(k_threadCount);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < k_threadCount; ++t)
+    {
+        threads.emplace_back([&isAllRecorded]()
+            {
+                Core::Profiler::set_thread_name("ProfilerTests Worker");
+                for (uint32_t i = 0; i < k_zoneCount; ++i)
+                {
+                    const Core::ProfileScope zone("ProfilerTests::Work");
+                }
+                isAllRecorded.arrive_and_wait();
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    const std::string json = export_trace("profiler_threads", 1);
+    CUE_REQUIRE(!json.empty());
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests::Work\"") == k_threadCount * k_zoneCount);
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests Worker\"") == k_threadCount);
+    CUE_CHECK(collect_thread_ids(json, "\"ProfilerTests::Work\"").size() == k_threadCount);
+}
+
+CUE_TEST(Profiler, ReusesBuffersOfFinishedThreads)
+{
+    // 上限を超える数のスレッドが入れ替わりに記録しても、最後のスレッドまで記録できる
+    constexpr uint32_t k_threadCount = Core::Profiler::k_maxThreads + 64;
+    Core::Profiler::mark_frame();
+    for (uint32_t t = 0; t < k_threadCount; ++t)
+    {
+        const bool isLast = t + 1 == k_threadCount;
+        std::thread([isLast]()
+            {
+                const Core::ProfileScope zone(isLast ? "ProfilerTests::LastThread" : "ProfilerTests::ShortLived");
+            }).join();
+    }
+
+    // 使い回したリングには前のスレッドの分を残さない
+    const std::string json = export_trace("profiler_reuse", 1);
+    CUE_REQUIRE(!json.empty());
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests::LastThread\"") == 1);
+    CUE_CHECK(count_occurrences(json, "\"ProfilerTests::ShortLived\"") < k_threadCount - 1);
+}
+
+CUE_TEST(Profiler, ExportsChromeTraceJson)
+{
+    // 範囲より前のフレームのゾーンは書き出さない
+    Core::Profiler::mark_frame();
+    {
+        const Core::ProfileScope zone("ProfilerTests::OldFrame");
+    }
+    Core::Profiler::mark_frame();
+    Core::Profiler::set_thread_name("ProfilerTests \"Main\"");
+    {
+        const Core::ProfileScope zone("ProfilerTests::NewFrame");
+    }
+
+    const std::string json = export_trace("profiler_json", 1);
+    CUE_REQUIRE(!json.empty());
+    CUE_CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CUE_CHECK(json.size() >= 4 && json.compare(json.size() - 4, 4, "\n]}\n") == 0);
+    CUE_CHECK(json.find("ProfilerTests::OldFrame") == std::string::npos);
+    CUE_CHECK(json.find("{\"name\":\"ProfilerTests::NewFrame\",\"ph\":\"X\",\"pid\":1,\"tid\":") != std::string::npos);
+    CUE_CHECK(count_occurrences(json, "\"ph\":\"i\"") == 1);
+    // スレッド名の引用符はエスケープする
+    CUE_CHECK(json.find("\"args\":{\"name\":\"ProfilerTests \\\"Main\\\"\"}") != std::string::npos);
+
+    const std::filesystem::path missing = Cue::Test::make_temp_directory("profiler_missing") / "no_such_dir" / "trace.json";
+    CUE_CHECK(Core::Profiler::export_chrome_trace(missing.string().c_str(), 1).get_code() == Core::Code::IoError);
+}
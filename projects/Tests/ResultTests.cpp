@@ -0,0 +1,159 @@
+#include <Result.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    static_assert(sizeof(Core::Result) == 8);
+    static_assert(std::is_trivially_copyable_v<Core::Expected<int>>);
+    static_assert(!std::is_trivially_copyable_v<Core::Expected<std::string>>);
+
+    Core::Expected<int> parse_positive(int value)
+    {
+        if (value < 0)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::InvalidArg, Core::Severity::Error, 0, "negative");
+        }
+        return value * 2;
+    }
+
+    Core::Expected<std::unique_ptr<int>> make_boxed(int value)
+    {
+        if (value < 0)
+        {
+            return Core::Result::fail(Core::Facility::Core, Core::Code::OutOfMemory, Core::Severity::Error, 0, "no memory");
+        }
+        return std::make_unique<int>(value);
+    }
+
+    /// @brief スレッドの終了時、診断表を返した後に破棄されて失敗を作る
+    struct TeardownFailure
+    {
+        Core::Result* out = nullptr;
+
+        ~TeardownFailure()
+        {
+            if (out)
+            {
+                *out = Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Error, 0, "teardown");
+            }
+        }
+    };
+
+    thread_local TeardownFailure t_teardownFailure;
+}
+
+CUE_TEST(Result, PacksAllFields)
+{
+    const uint32_t line = __LINE__ + 1;
+    const Core::Result r = Core::Result::fail(Core::Facility::D3D12, Core::Code::CreationFailed, Core::Severity::Fatal, 0x887A0005u, "device removed");
+    CUE_CHECK(!r);
+    CUE_CHECK(r.get_facility() == Core::Facility::D3D12);
+    CUE_CHECK(r.get_code() == Core::Code::CreationFailed);
+    CUE_CHECK(r.get_severity() == Core::Severity::Fatal);
+    CUE_CHECK(r.get_native() == 0x887A0005u);
+
+    const Core::ResultDiagnostic diagnostic = r.get_diagnostic();
+    CUE_CHECK(diagnostic.message == "device removed");
+    CUE_CHECK(diagnostic.line == line);
+    CUE_CHECK(std::strstr(diagnostic.file, "ResultTests.cpp") != nullptr);
+}
+
+CUE_TEST(Result, OkHasNoDiagnostic)
+{
+    CUE_CHECK(Core::Result::ok());
+    CUE_CHECK(Core::Result::ok().get_diagnostic().message.empty());
+    CUE_CHECK(Core::Result{}.get_code() == Core::Code::Ok);
+}
+
+CUE_TEST(Result, DiagnosticReadableFromOtherThread)
+{
+    Core::Result fromWorker;
+    std::thread([&fromWorker]()
+        {
+            fromWorker = Core::Result::fail(Core::Facility::IO, Core::Code::NotFound, Core::Severity::Warning, 2, "from worker");
+        }).join();
+    CUE_CHECK(fromWorker.get_diagnostic().message == "from worker");
+
+    // 終了したスレッドの表を使い回しても、各スレッドが自分の失敗を引ける
+    bool isAllFound = true;
+    for (int i = 0; i < 100; ++i)
+    {
+        std::thread([&isAllFound]()
+            {
+                const Core::Result r = Core::Result::fail(Core::Facility::IO, Core::Code::IoError, Core::Severity::Error, 1, "thread");
+                isAllFound = isAllFound && r.get_diagnostic().message == "thread";
+            }).join();
+    }
+    CUE_CHECK(isAllFound);
+}
+
+CUE_TEST(Result, NoDiagnosticAfterThreadReleasedTable)
+{
+    // 先に作った thread_local ほど後に破棄されるので、表を返した後に失敗が作られる
+    Core::Result fromTeardown;
+    std::thread([&fromTeardown]()
+        {
+            t_teardownFailure.out = &fromTeardown;
+            (void)Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Info, 0, "acquire");
+        }).join();
+    CUE_CHECK(fromTeardown.get_code() == Core::Code::Unknown);
+    CUE_CHECK(fromTeardown.get_diagnostic().message.empty());
+
+    // 返した表を次のスレッドが借りても、その記録は上書きされない
+    Core::Result fromNext;
+    std::thread([&fromNext]()
+        {
+            fromNext = Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Error, 0, "next");
+        }).join();
+    CUE_CHECK(fromNext.get_diagnostic().message == "next");
+}
+
+CUE_TEST(Result, StaleDiagnosticIsEmpty)
+{
+    const Core::Result r = Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Error, 0, "old");
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+        (void)Core::Result::fail(Core::Facility::Core, Core::Code::Unknown, Core::Severity::Info, i, "newer");
+    }
+    // 診断は上書きされて引けないが、値そのものは残る
+    CUE_CHECK(r.get_diagnostic().message.empty());
+    CUE_CHECK(r.get_code() == Core::Code::Unknown);
+}
+
+CUE_TEST(Expected, ValueAndError)
+{
+    const Core::Expected<int> value = parse_positive(4);
+    CUE_REQUIRE(value.has_value());
+    CUE_CHECK(*value == 8);
+    CUE_CHECK(value.get_result());
+
+    const Core::Expected<int> error = parse_positive(-1);
+    CUE_CHECK(!error);
+    CUE_CHECK(error.get_result().get_code() == Core::Code::InvalidArg);
+    CUE_CHECK(error.get_result().get_diagnostic().message == "negative");
+    CUE_CHECK(error.value_or(7) == 7);
+}
+
+CUE_TEST(Expected, MoveOnlyValue)
+{
+    Core::Expected<std::unique_ptr<int>> boxed = make_boxed(3);
+    CUE_REQUIRE(boxed.has_value());
+    CUE_CHECK(**boxed == 3);
+
+    Core::Expected<std::unique_ptr<int>> moved = std::move(boxed);
+    CUE_REQUIRE(moved.has_value());
+    CUE_CHECK(**moved == 3);
+
+    Core::Expected<std::unique_ptr<int>> failed = make_boxed(-1);
+    CUE_CHECK(!failed);
+    failed = std::move(moved);
+    CUE_REQUIRE(failed.has_value());
+    CUE_CHECK(**failed == 3);
+}
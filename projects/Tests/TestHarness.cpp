@@ -0,0 +1,125 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace Cue::Test
+{
+    namespace
+    {
+        struct TestEntry
+        {
+            const char* suite;
+            const char* name;
+            TestFunction function;
+        };
+
+        std::vector<TestEntry>& get_registry()
+        {
+            // 静的初期化の順序に依らないよう関数内の静的変数に置く
+            static std::vector<TestEntry> registry;
+            return registry;
+        }
+
+        // 実行中のテストの失敗数（テストは呼び出しスレッドで 1 つずつ回す）
+        uint32_t g_failureCount = 0;
+
+        std::filesystem::path get_temp_root()
+        {
+            return std::filesystem::temp_directory_path() / ("cue_tests_" + std::to_string(getpid()));
+        }
+    }
+
+    TestRegistration::TestRegistration(const char* suite, const char* name, TestFunction function) noexcept
+    {
+        get_registry().push_back({ suite, name, function });
+    }
+
+    void report_failure(const char* expression, const char* file, int line) noexcept
+    {
+        std::fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", file, line, expression);
+        ++g_failureCount;
+    }
+
+    std::filesystem::path make_temp_directory(std::string_view name)
+    {
+        const std::filesystem::path path = get_temp_root() / name;
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+        std::filesystem::create_directories(path, error);
+        return path;
+    }
+} // namespace Cue::Test
+
+// 登録されたテストを回す（--suite で 1 スイートだけ、--list で一覧）
+int main(int argc, char** argv)
+{
+    const char* suite = nullptr;
+    bool isListOnly = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--suite") == 0 && (i + 1) < argc)
+        {
+            suite = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--list") == 0)
+        {
+            isListOnly = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: cue_tests [--suite name] [--list]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 1) スイート・名前の順に並べて回す（登録順は翻訳単位の初期化順で決まらないため）
+    std::vector<Cue::Test::TestEntry> entries;
+    for (const Cue::Test::TestEntry& entry : Cue::Test::get_registry())
+    {
+        if (!suite || std::strcmp(entry.suite, suite) == 0)
+        {
+            entries.push_back(entry);
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Cue::Test::TestEntry& a, const Cue::Test::TestEntry& b)
+        {
+            return std::strcmp(a.suite, b.suite) < 0;
+        });
+    if (entries.empty())
+    {
+        std::fprintf(stderr, "cue_tests: no tests matched\n");
+        return EXIT_FAILURE;
+    }
+
+    uint32_t failedCount = 0;
+    for (const Cue::Test::TestEntry& entry : entries)
+    {
+        if (isListOnly)
+        {
+            std::printf("%s.%s\n", entry.suite, entry.name);
+            continue;
+        }
+        std::printf("[ RUN  ] %s.%s\n", entry.suite, entry.name);
+        std::fflush(stdout);
+        Cue::Test::g_failureCount = 0;
+        entry.function();
+        const bool isPassed = Cue::Test::g_failureCount == 0;
+        std::printf("[ %s ] %s.%s\n", isPassed ? " OK " : "FAIL", entry.suite, entry.name);
+        failedCount += isPassed ? 0 : 1;
+    }
+
+    // 2) 一時ディレクトリを片付ける
+    std::error_code error;
+    std::filesystem::remove_all(Cue::Test::get_temp_root(), error);
+    if (!isListOnly)
+    {
+        std::printf("%zu test(s), %u failed\n", entries.size(), failedCount);
+    }
+    return failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
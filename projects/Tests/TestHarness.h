@@ -0,0 +1,47 @@
+#pragma once
+#include <filesystem>
+#include <string_view>
+
+namespace Cue::Test
+{
+    using TestFunction = void (*)();
+
+    /// @brief 静的初期化でテストを登録する（CUE_TEST から使う）
+    struct TestRegistration final
+    {
+        TestRegistration(const char* suite, const char* name, TestFunction function) noexcept;
+    };
+
+    /// @brief 失敗を記録する（テストは続ける）
+    void report_failure(const char* expression, const char* file, int line) noexcept;
+
+    /// @brief テスト専用の空の一時ディレクトリを作る（プロセスの終わりにまとめて消す）
+    [[nodiscard]] std::filesystem::path make_temp_directory(std::string_view name);
+} // namespace Cue::Test
+
+// スイート単位で ctest に登録する（スイート名は CMakeLists.txt の一覧にも足すこと）
+#define CUE_TEST(suite, name) \
+    static void cue_test_##suite##_##name(); \
+    static const ::Cue::Test::TestRegistration cueTestRegistration_##suite##_##name(#suite, #name, cue_test_##suite##_##name); \
+    static void cue_test_##suite##_##name()
+
+// 失敗しても続ける
+#define CUE_CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            ::Cue::Test::report_failure(#expression, __FILE__, __LINE__); \
+        } \
+    } while (0)
+
+// 失敗したらそのテストを打ち切る（以降の手順が前提を失う場合に使う）
+#define CUE_REQUIRE(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            ::Cue::Test::report_failure(#expression, __FILE__, __LINE__); \
+            return; \
+        } \
+    } while (0)
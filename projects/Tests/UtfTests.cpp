@@ -0,0 +1,295 @@
+#include <Utf.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace
+{
+    namespace Core = Cue::Core;
+
+    /// @brief 参照実装：厳密に検査しながらコードポイントへ戻す
+    bool decode_utf8(std::string_view text, std::vector<uint32_t>& outCodePoints)
+    {
+        outCodePoints.clear();
+        size_t i = 0;
+        while (i < text.size())
+        {
+            const uint8_t lead = static_cast<uint8_t>(text[i]);
+            if (lead < 0x80)
+            {
+                outCodePoints.push_back(lead);
+                ++i;
+                continue;
+            }
+            size_t length = 0;
+            uint32_t codePoint = 0;
+            if (lead >= 0xC2 && lead <= 0xDF)
+            {
+                length = 2;
+                codePoint = lead & 0x1F;
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                length = 3;
+                codePoint = lead & 0x0F;
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                length = 4;
+                codePoint = lead & 0x07;
+            }
+            else
+            {
+                return false;
+            }
+            if (i + length > text.size())
+            {
+                return false;
+            }
+            for (size_t k = 1; k < length; ++k)
+            {
+                const uint8_t c = static_cast<uint8_t>(text[i + k]);
+                if ((c & 0xC0) != 0x80)
+                {
+                    return false;
+                }
+                codePoint = (codePoint << 6) | (c & 0x3F);
+            }
+            if ((length == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)))
+                || (length == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)))
+            {
+                return false;
+            }
+            outCodePoints.push_back(codePoint);
+            i += length;
+        }
+        return true;
+    }
+
+    bool decode_utf16(std::u16string_view text, std::vector<uint32_t>& outCodePoints)
+    {
+        outCodePoints.clear();
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const uint32_t c = text[i];
+            if (c >= 0xD800 && c <= 0xDBFF)
+            {
+                if (i + 1 >= text.size() || text[i + 1] < 0xDC00 || text[i + 1] > 0xDFFF)
+                {
+                    return false;
+                }
+                outCodePoints.push_back(0x10000 + ((c - 0xD800) << 10) + (text[i + 1] - 0xDC00));
+                ++i;
+            }
+            else if (c >= 0xDC00 && c <= 0xDFFF)
+            {
+                return false;
+            }
+            else
+            {
+                outCodePoints.push_back(c);
+            }
+        }
+        return true;
+    }
+
+    std::string encode_utf8(const std::vector<uint32_t>& codePoints)
+    {
+        std::string text;
+        for (const uint32_t cp : codePoints)
+        {
+            if (cp < 0x80)
+            {
+                text += static_cast<char>(cp);
+            }
+            else if (cp < 0x800)
+            {
+                text += static_cast<char>(0xC0 | (cp >> 6));
+                text += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                text += static_cast<char>(0xE0 | (cp >> 12));
+                text += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                text += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                text += static_cast<char>(0xF0 | (cp >> 18));
+                text += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                text += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                text += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+        return text;
+    }
+
+    std::u16string encode_utf16(const std::vector<uint32_t>& codePoints)
+    {
+        std::u16string text;
+        for (uint32_t cp : codePoints)
+        {
+            if (cp < 0x10000)
+            {
+                text += static_cast<char16_t>(cp);
+            }
+            else
+            {
+                cp -= 0x10000;
+                text += static_cast<char16_t>(0xD800 + (cp >> 10));
+                text += static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+            }
+        }
+        return text;
+    }
+
+    /// @brief ASCII 主体・漢字主体・全範囲の混在の 3 種類で文字を選ぶ
+    uint32_t random_code_point(std::mt19937& rng, uint32_t mode)
+    {
+        const uint32_t roll = rng() % 100;
+        if (mode == 0)
+        {
+            return roll < 95 ? 0x20 + rng() % 95 : 0x3040 + rng() % 0x60;
+        }
+        if (mode == 1)
+        {
+            return roll < 85 ? 0x4E00 + rng() % 0x5000 : roll < 92 ? 0x3040 + rng() % 0x60 : 0x30 + rng() % 10;
+        }
+        if (roll < 30)
+        {
+            return rng() % 0x80;
+        }
+        if (roll < 50)
+        {
+            return 0x80 + rng() % 0x780;
+        }
+        if (roll < 80)
+        {
+            uint32_t cp = 0;
+            do
+            {
+                cp = 0x800 + rng() % 0xF800;
+            } while (cp >= 0xD800 && cp <= 0xDFFF);
+            return cp;
+        }
+        return 0x10000 + rng() % 0x100000;
+    }
+}
+
+CUE_TEST(Utf, RoundTripMatchesReference)
+{
+    std::mt19937 rng(1);
+    std::vector<uint32_t> codePoints;
+    std::u16string wide;
+    std::string narrow;
+    bool isAllMatched = true;
+    for (uint32_t iteration = 0; iteration < 20000 && isAllMatched; ++iteration)
+    {
+        codePoints.clear();
+        const size_t length = rng() % 80;
+        for (size_t k = 0; k < length; ++k)
+        {
+            codePoints.push_back(random_code_point(rng, iteration % 3));
+        }
+        const std::string expected8 = encode_utf8(codePoints);
+        const std::u16string expected16 = encode_utf16(codePoints);
+
+        size_t written = 0;
+        wide.assign(Core::get_utf16_capacity(expected8.size()), u'\0');
+        isAllMatched = isAllMatched && Core::utf8_to_utf16(expected8, wide, written)
+            && std::u16string_view(wide.data(), written) == expected16;
+
+        narrow.assign(Core::get_utf8_capacity(expected16.size()), '\0');
+        isAllMatched = isAllMatched && Core::utf16_to_utf8(expected16, narrow, written)
+            && std::string_view(narrow.data(), written) == expected8;
+    }
+    CUE_CHECK(isAllMatched);
+}
+
+CUE_TEST(Utf, RejectsWhatReferenceRejects)
+{
+    // 壊した入力の合否と、通った場合の中身が参照実装と一致すること
+    std::mt19937 rng(2);
+    std::vector<uint32_t> codePoints;
+    std::vector<uint32_t> decoded;
+    bool isAllAgreed = true;
+    for (uint32_t iteration = 0; iteration < 20000 && isAllAgreed; ++iteration)
+    {
+        codePoints.clear();
+        const size_t length = 1 + rng() % 60;
+        for (size_t k = 0; k < length; ++k)
+        {
+            codePoints.push_back(random_code_point(rng, iteration % 3));
+        }
+
+        std::string broken8 = encode_utf8(codePoints);
+        for (uint32_t j = 0; j < 1 + rng() % 3; ++j)
+        {
+            broken8[rng() % broken8.size()] = static_cast<char>(rng());
+        }
+        std::u16string wide(broken8.size(), u'\0');
+        size_t written = 0;
+        bool isExpected = decode_utf8(broken8, decoded);
+        bool isConverted = static_cast<bool>(Core::utf8_to_utf16(broken8, wide, written));
+        isAllAgreed = isAllAgreed && isExpected == isConverted
+            && (!isExpected || std::u16string_view(wide.data(), written) == encode_utf16(decoded));
+
+        std::u16string broken16 = encode_utf16(codePoints);
+        broken16[rng() % broken16.size()] = static_cast<char16_t>(rng() % 4 == 0 ? 0xD800 + rng() % 0x800 : rng());
+        std::string narrow(broken16.size() * 3, '\0');
+        isExpected = decode_utf16(broken16, decoded);
+        isConverted = static_cast<bool>(Core::utf16_to_utf8(broken16, narrow, written));
+        isAllAgreed = isAllAgreed && isExpected == isConverted
+            && (!isExpected || std::string_view(narrow.data(), written) == encode_utf8(decoded));
+    }
+    CUE_CHECK(isAllAgreed);
+}
+
+CUE_TEST(Utf, RejectsKnownInvalidSequences)
+{
+    // 冗長な表現・サロゲート・範囲外・途切れ・SIMD の区間の後ろに置いたサロゲート
+    const char* const invalid[] = {
+        "\xC0\x80", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF8", "\x80", "\xE3\x81",
+        "\xE3\x81\x82\xE3\x81\x82\xE3\x81\x82\xE3\x81\x82\xE3\x81\x82\xE3\x81\x82\xED\xA0\x80\x20\x20\x20\x20",
+    };
+    for (const char* text : invalid)
+    {
+        std::u16string wide(64, u'\0');
+        size_t written = 0;
+        CUE_CHECK(!Core::utf8_to_utf16(text, wide, written));
+    }
+    const char16_t lone[] = { u'a', 0xDC00, u'b' };
+    std::string narrow(16, '\0');
+    size_t written = 0;
+    CUE_CHECK(!Core::utf16_to_utf8(std::u16string_view(lone, 3), narrow, written));
+}
+
+CUE_TEST(Utf, ShortDestinationFails)
+{
+    const std::string text = "アセット/テクスチャ_01.dds";
+    std::vector<char16_t> small(3);
+    size_t written = 0;
+    CUE_CHECK(!Core::utf8_to_utf16(text, small, written));
+    CUE_CHECK(written <= small.size());
+
+    const std::u16string wide = u"テクスチャ";
+    std::vector<char> narrow(wide.size() * 3 - 1);
+    CUE_CHECK(!Core::utf16_to_utf8(wide, narrow, written));
+    CUE_CHECK(written <= narrow.size());
+}
+
+CUE_TEST(Utf, PmrStrings)
+{
+    std::pmr::u16string wide;
+    CUE_REQUIRE(Core::utf8_to_utf16("アセット/テクスチャ_01.dds", wide));
+    CUE_CHECK(wide.size() == 17);
+    std::pmr::string back;
+    CUE_REQUIRE(Core::utf16_to_utf8(wide, back));
+    CUE_CHECK(back == "アセット/テクスチャ_01.dds");
+
+    std::pmr::u16string failed = u"leftover";
+    CUE_CHECK(!Core::utf8_to_utf16("\xC0\x80", failed));
+    CUE_CHECK(failed.empty());
+}